@@ -19,17 +19,28 @@ JitCodeBuffer::JitCodeBuffer(size_t size)
   m_free_code_ptr = m_code_ptr;
   m_code_size = size;
   m_code_used = 0;
+  m_total_size = size;
+  m_owns_buffer = true;
 
   if (!m_code_ptr)
     Panic("Failed to allocate code space.");
 }
 
+JitCodeBuffer::JitCodeBuffer(void* buffer, size_t size)
+  : m_code_ptr(buffer), m_free_code_ptr(buffer), m_code_size(size), m_code_used(0), m_total_size(size),
+    m_owns_buffer(false)
+{
+}
+
 JitCodeBuffer::~JitCodeBuffer()
 {
+  if (!m_owns_buffer)
+    return;
+
 #if defined(Y_PLATFORM_WINDOWS)
-  VirtualFree(m_code_ptr, m_code_size, MEM_RELEASE);
+  VirtualFree(m_code_ptr, 0, MEM_RELEASE);
 #elif defined(Y_PLATFORM_LINUX) || defined(Y_PLATFORM_ANDROID)
-  munmap(m_code_ptr, m_code_size);
+  munmap(m_code_ptr, m_total_size);
 #endif
 }
 
@@ -57,6 +68,13 @@ void JitCodeBuffer::Reset()
   m_code_used = 0;
 }
 
+void* JitCodeBuffer::SplitTail(size_t size)
+{
+  Assert(m_code_used == 0 && size < m_code_size);
+  m_code_size -= size;
+  return reinterpret_cast<char*>(m_code_ptr) + m_code_size;
+}
+
 void JitCodeBuffer::Align(u32 alignment, u8 padding_value)
 {
   DebugAssert(Common::IsPow2(alignment));
@@ -5,13 +5,22 @@ class JitCodeBuffer
 {
 public:
   JitCodeBuffer(size_t size = 64 * 1024 * 1024);
+
+  /// Uses an existing region of executable memory, which is not freed when the buffer is destroyed.
+  JitCodeBuffer(void* buffer, size_t size);
+
   ~JitCodeBuffer();
 
   void* GetFreeCodePointer() const { return m_free_code_ptr; }
   size_t GetFreeCodeSpace() const { return (m_code_size - m_code_used); }
+  size_t GetUsedCodeSpace() const { return m_code_used; }
   void CommitCode(size_t length);
   void Reset();
 
+  /// Removes size bytes from the end of the buffer, returning a pointer to the start of the removed region.
+  /// The region can be used by another buffer. Only valid before any code has been written.
+  void* SplitTail(size_t size);
+
   /// Adjusts the free code pointer to the specified alignment, padding with bytes.
   /// Assumes alignment is a power-of-two.
   void Align(u32 alignment, u8 padding_value);
@@ -21,5 +30,7 @@ private:
   void* m_free_code_ptr;
   size_t m_code_size;
   size_t m_code_used;
+  size_t m_total_size;
+  bool m_owns_buffer;
 };
 
@@ -0,0 +1,199 @@
+#include "jit_perf_map.h"
+#include "YBaseLib/Log.h"
+#include <cinttypes>
+#include <cstring>
+
+#if defined(Y_PLATFORM_LINUX)
+#include <elf.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+Log_SetChannel(JitPerfMap);
+
+#if defined(Y_PLATFORM_LINUX)
+
+// See tools/perf/Documentation/jitdump-specification.txt in the Linux source tree.
+namespace JitDump {
+static constexpr u32 MAGIC = 0x4A695444; // "JiTD"
+static constexpr u32 VERSION = 1;
+static constexpr u32 JIT_CODE_LOAD = 0;
+static constexpr u32 JIT_CODE_CLOSE = 3;
+
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 total_size;
+  u32 elf_mach;
+  u32 pad1;
+  u32 pid;
+  u64 timestamp;
+  u64 flags;
+};
+
+struct RecordHeader
+{
+  u32 id;
+  u32 total_size;
+  u64 timestamp;
+};
+
+struct CodeLoadRecord
+{
+  RecordHeader header;
+  u32 pid;
+  u32 tid;
+  u64 vma;
+  u64 code_addr;
+  u64 code_size;
+  u64 code_index;
+  // Followed by the null-terminated name, and the code bytes.
+};
+
+// Must match the clock used by perf record, i.e. "-k mono".
+static u64 GetTimestamp()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<u64>(ts.tv_sec) * UINT64_C(1000000000) + static_cast<u64>(ts.tv_nsec);
+}
+} // namespace JitDump
+
+#endif
+
+JitPerfMap::JitPerfMap() = default;
+
+JitPerfMap::~JitPerfMap()
+{
+  Close();
+}
+
+bool JitPerfMap::Open(Format format)
+{
+  Close();
+
+#if defined(Y_PLATFORM_LINUX)
+  m_format = format;
+  m_code_index = 0;
+  if (format == Format::JitDump)
+    return OpenJitDump();
+
+  char filename[64];
+  std::snprintf(filename, sizeof(filename), "/tmp/perf-%d.map", static_cast<int>(getpid()));
+  m_file = std::fopen(filename, "w");
+  if (!m_file)
+  {
+    Log_ErrorPrintf("Failed to open perf map '%s'", filename);
+    return false;
+  }
+
+  Log_InfoPrintf("Writing JIT symbols to '%s'", filename);
+  return true;
+#else
+  Log_ErrorPrintf("Perf maps are not supported on this platform");
+  return false;
+#endif
+}
+
+#if defined(Y_PLATFORM_LINUX)
+
+bool JitPerfMap::OpenJitDump()
+{
+  char filename[64];
+  std::snprintf(filename, sizeof(filename), "/tmp/jit-%d.dump", static_cast<int>(getpid()));
+  m_file = std::fopen(filename, "w+b");
+  if (!m_file)
+  {
+    Log_ErrorPrintf("Failed to open jitdump file '%s'", filename);
+    return false;
+  }
+
+  // perf finds the dump through an executable mapping of the file, which it records as an mmap event.
+  m_marker_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  m_marker = mmap(nullptr, m_marker_size, PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(m_file), 0);
+  if (m_marker == MAP_FAILED)
+  {
+    Log_ErrorPrintf("Failed to map jitdump file '%s'", filename);
+    m_marker = nullptr;
+    std::fclose(m_file);
+    m_file = nullptr;
+    return false;
+  }
+
+  JitDump::FileHeader header = {};
+  header.magic = JitDump::MAGIC;
+  header.version = JitDump::VERSION;
+  header.total_size = sizeof(header);
+#if defined(Y_CPU_X64)
+  header.elf_mach = EM_X86_64;
+#elif defined(Y_CPU_ARM64)
+  header.elf_mach = EM_AARCH64;
+#endif
+  header.pid = static_cast<u32>(getpid());
+  header.timestamp = JitDump::GetTimestamp();
+  std::fwrite(&header, sizeof(header), 1, m_file);
+  std::fflush(m_file);
+
+  Log_InfoPrintf("Writing JIT symbols to '%s'", filename);
+  return true;
+}
+
+#endif
+
+void JitPerfMap::Close()
+{
+  if (!m_file)
+    return;
+
+#if defined(Y_PLATFORM_LINUX)
+  if (m_format == Format::JitDump)
+  {
+    JitDump::RecordHeader record = {};
+    record.id = JitDump::JIT_CODE_CLOSE;
+    record.total_size = sizeof(record);
+    record.timestamp = JitDump::GetTimestamp();
+    std::fwrite(&record, sizeof(record), 1, m_file);
+
+    munmap(m_marker, m_marker_size);
+    m_marker = nullptr;
+    m_marker_size = 0;
+  }
+#endif
+
+  std::fclose(m_file);
+  m_file = nullptr;
+}
+
+void JitPerfMap::RegisterCode(const void* code, size_t size, const char* name)
+{
+  if (!m_file)
+    return;
+
+#if defined(Y_PLATFORM_LINUX)
+  if (m_format == Format::PerfMap)
+  {
+    std::fprintf(m_file, "%" PRIxPTR " %zx %s\n", reinterpret_cast<uintptr_t>(code), size, name);
+    std::fflush(m_file);
+    return;
+  }
+
+  // The code is copied into the dump, since it'll be overwritten when the code cache is flushed.
+  const size_t name_length = std::strlen(name) + 1;
+  JitDump::CodeLoadRecord record = {};
+  record.header.id = JitDump::JIT_CODE_LOAD;
+  record.header.total_size = static_cast<u32>(sizeof(record) + name_length + size);
+  record.header.timestamp = JitDump::GetTimestamp();
+  record.pid = static_cast<u32>(getpid());
+  record.tid = static_cast<u32>(syscall(SYS_gettid));
+  record.vma = static_cast<u64>(reinterpret_cast<uintptr_t>(code));
+  record.code_addr = record.vma;
+  record.code_size = size;
+  record.code_index = m_code_index++;
+  std::fwrite(&record, sizeof(record), 1, m_file);
+  std::fwrite(name, name_length, 1, m_file);
+  std::fwrite(code, size, 1, m_file);
+  std::fflush(m_file);
+#endif
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "types.h"
+#include <cstdio>
+
+/// Writes symbols for JIT-compiled code, so that Linux perf can attribute samples to it instead of an anonymous
+/// mapping. Two formats are supported:
+///   - PerfMap: /tmp/perf-<pid>.map, read by perf report/top directly. This format has no notion of time, so
+///     addresses which are reused after a code cache flush will show the name of whichever block perf picks.
+///   - JitDump: /tmp/jit-<pid>.dump, for use with "perf record -k mono" followed by "perf inject --jit". Each load is
+///     timestamped, so samples in reused code are attributed to the block which occupied the address at the time.
+/// Only available on Linux. Not thread-safe, all code must be registered from the same thread.
+class JitPerfMap
+{
+public:
+  enum class Format
+  {
+    PerfMap,
+    JitDump
+  };
+
+  JitPerfMap();
+  ~JitPerfMap();
+
+  bool IsOpen() const { return (m_file != nullptr); }
+
+  bool Open(Format format);
+  void Close();
+
+  /// Adds a symbol for a region of code. The code must have been completely written. Neither format has a record for
+  /// unloading code, see above for how addresses which are reused after a flush are handled.
+  void RegisterCode(const void* code, size_t size, const char* name);
+
+private:
+  bool OpenJitDump();
+
+  std::FILE* m_file = nullptr;
+  Format m_format = Format::PerfMap;
+  void* m_marker = nullptr;
+  size_t m_marker_size = 0;
+  u64 m_code_index = 0;
+};
@@ -509,6 +509,8 @@ void SDLHostInterface::RenderMainMenuBar()
         SetCPUBackend(CPU::BackendType::CachedInterpreter);
       if (ImGui::MenuItem("Recompiler", nullptr, current_backend == CPU::BackendType::Recompiler))
         SetCPUBackend(CPU::BackendType::Recompiler);
+      if (ImGui::MenuItem("Tiered Recompiler", nullptr, current_backend == CPU::BackendType::TieredRecompiler))
+        SetCPUBackend(CPU::BackendType::TieredRecompiler);
 
       ImGui::EndMenu();
     }
@@ -530,6 +532,15 @@ void SDLHostInterface::RenderMainMenuBar()
     if (ImGui::MenuItem("Flush Code Cache"))
       FlushCPUCodeCache();
 
+    if (ImGui::MenuItem("Dump Block Profile"))
+      DumpCPUBlockProfile();
+
+    if (ImGui::MenuItem("Profile IO Ports", nullptr, IsIOPortProfilingEnabled()))
+      SetIOPortProfilingEnabled(!IsIOPortProfilingEnabled());
+
+    if (ImGui::MenuItem("Dump IO Port Profile"))
+      DumpIOPortProfile();
+
     ImGui::Separator();
 
     if (ImGui::BeginMenu("Load State"))
@@ -684,6 +695,14 @@ void SDLHostInterface::RenderStatsWindow()
     ImGui::NewLine();
 
     ImGui::Text("Code Block Count: %" PRIu64, stats.cpu_stats.num_code_cache_blocks);
+    ImGui::Text("Code Cache Size: %" PRIu64 " KB", stats.cpu_stats.code_cache_size / 1024);
+    ImGui::Text("Evicted Regions/Blocks: %" PRIu64 "/%" PRIu64, stats.cpu_stats.code_cache_regions_evicted,
+                stats.cpu_stats.code_cache_blocks_evicted);
+    ImGui::Text("Blocks Invalidated: %" PRIu64, stats.cpu_stats.code_cache_blocks_invalidated);
+    ImGui::Text("TLB Hits/Misses/Flushes: %" PRIu64 "/%" PRIu64 "/%" PRIu64, stats.cpu_stats.tlb_hits,
+                stats.cpu_stats.tlb_misses, stats.cpu_stats.tlb_flushes);
+    ImGui::Text("TLB Address Space Reuses: %" PRIu64, stats.cpu_stats.tlb_address_space_reuses);
+    ImGui::Text("Idle Cycles Skipped: %" PRIu64, stats.cpu_stats.idle_cycles_skipped);
     ImGui::Text("Blocks Executed: %" PRIu64, stats.cpu_delta_code_cache_blocks_executed);
     ImGui::Text("Cached Instructions Executed: %" PRIu64, stats.cpu_delta_code_cache_instructions_executed);
     ImGui::Text("Instructions Interpreted: %" PRIu64, stats.cpu_delta_instructions_interpreted);
@@ -7,12 +7,15 @@ Log_SetChannel(CPU_8086_TestSystem);
 DEFINE_OBJECT_TYPE_INFO(CPU_8086_TestSystem);
 
 CPU_8086_TestSystem::CPU_8086_TestSystem(CPU_8086::Model cpu_model /* = CPU_8086::MODEL_8086 */,
-                                         float cpu_frequency /* = 1000000.0f */, u32 ram_size /* = 1024 * 1024 */)
+                                         float cpu_frequency /* = 1000000.0f */,
+                                         CPU::BackendType cpu_backend /* = CPU::BackendType::Interpreter */,
+                                         u32 ram_size /* = 1024 * 1024 */)
   : System()
 {
   m_bus = new Bus(20);
   m_bus->AllocateRAM(ram_size);
   m_cpu = CreateComponent<CPU_8086::CPU>("CPU", cpu_model, cpu_frequency);
+  m_cpu->SetBackend(cpu_backend);
   AddComponents();
 }
 
@@ -6,10 +6,10 @@
 #include <gtest/gtest.h>
 Log_SetChannel(CPU_X86_Test186);
 
-static bool RunTest(const char* code_file, const char* expected_ouput_file)
+static bool RunTest(CPU::BackendType cpu_backend, const char* code_file, const char* expected_ouput_file)
 {
-  StubSystemPointer<CPU_8086_TestSystem> system =
-    StubHostInterface::CreateSystem<CPU_8086_TestSystem>(CPU_8086::MODEL_80186, 1000000.0f, 1024 * 1024);
+  StubSystemPointer<CPU_8086_TestSystem> system = StubHostInterface::CreateSystem<CPU_8086_TestSystem>(
+    CPU_8086::MODEL_80186, 1000000.0f, cpu_backend, 1024 * 1024);
   system->AddROMFile(code_file, 0xF0000, 65536);
 
   PODArray<byte> expected_buffer;
@@ -71,8 +71,16 @@ static bool RunTest(const char* code_file, const char* expected_ouput_file)
   return result;
 }
 
+// Test on both the interpreter and the cached interpreter
 #define MAKE_TEST(name, code_file, results_file)                                                                       \
-  TEST(CPU_8086_Test186, name) { EXPECT_TRUE(RunTest(code_file, results_file)); }
+  TEST(CPU_8086_Test186_Interpreter, name)                                                                             \
+  {                                                                                                                    \
+    EXPECT_TRUE(RunTest(CPU::BackendType::Interpreter, code_file, results_file));                                      \
+  }                                                                                                                    \
+  TEST(CPU_8086_Test186_CachedInterpreter, name)                                                                       \
+  {                                                                                                                    \
+    EXPECT_TRUE(RunTest(CPU::BackendType::CachedInterpreter, code_file, results_file));                                \
+  }
 
 MAKE_TEST(add, "test186/add.bin", "test186/res_add.bin")
 MAKE_TEST(bcdcnv, "test186/bcdcnv.bin", "test186/res_bcdcnv.bin")
@@ -38,6 +38,15 @@ bool CPU_X86_TestSystem::Initialize()
     }
   }
 
+  for (const ROMData& rom : m_rom_data)
+  {
+    if (!m_bus->CreateROMRegionFromBuffer(rom.data.data(), static_cast<u32>(rom.data.size()), rom.load_address))
+    {
+      Log_ErrorPrintf("Failed to create ROM region at 0x%08X.", rom.load_address);
+      return false;
+    }
+  }
+
   // Mirror top 64KB.
   m_bus->MirrorRegion(UINT32_C(0xF0000), 0x10000, UINT32_C(0xFFFF0000));
   return true;
@@ -48,6 +57,11 @@ void CPU_X86_TestSystem::AddROMFile(const char* filename, PhysicalMemoryAddress
   m_rom_files.push_back({filename, load_address, expected_size});
 }
 
+void CPU_X86_TestSystem::AddROMData(std::vector<u8> data, PhysicalMemoryAddress load_address)
+{
+  m_rom_data.push_back({std::move(data), load_address});
+}
+
 bool CPU_X86_TestSystem::Execute(SimulationTime timeout /* = SecondsToSimulationTime(60) */)
 {
   if (!Initialize())
@@ -27,6 +27,7 @@ public:
   CPU_X86::CPU* GetX86CPU() const { return static_cast<CPU_X86::CPU*>(m_cpu); }
 
   void AddROMFile(const char* filename, PhysicalMemoryAddress load_address, u32 expected_size = 0);
+  void AddROMData(std::vector<u8> data, PhysicalMemoryAddress load_address);
 
   bool Execute(SimulationTime timeout = SecondsToSimulationTime(60));
 
@@ -44,4 +45,11 @@ private:
     u32 expected_size;
   };
   std::vector<ROMFile> m_rom_files;
+
+  struct ROMData
+  {
+    std::vector<u8> data;
+    PhysicalMemoryAddress load_address;
+  };
+  std::vector<ROMData> m_rom_data;
 };
@@ -88,4 +88,8 @@ TEST(CPU_X86_Test386, CachedInterpreter)
 TEST(CPU_X86_Test386, Recompiler)
 {
   RunTest386(CPU::BackendType::Recompiler);
+}
+TEST(CPU_X86_Test386, TieredRecompiler)
+{
+  RunTest386(CPU::BackendType::TieredRecompiler);
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "../stub_host_interface.h"
+#include "pce/bus.h"
+#include "system.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <vector>
+
+// Runs a loop long enough for its blocks to be compiled on the worker thread, published, and then leave through
+// exits which haven't been linked yet.
+TEST(CPU_X86_TieredRecompiler, UnlinkedExitFromPublishedBlock)
+{
+  static constexpr u8 code[] = {
+    0x31, 0xC0,       // 0000: xor ax, ax
+    0x8E, 0xD8,       // 0002: mov ds, ax
+    0xBA, 0xE8, 0x03, // 0004: mov dx, 1000
+    0xB9, 0xE8, 0x03, // 0007: outer: mov cx, 1000
+    0x05, 0x03, 0x00, // 000A: inner: add ax, 3
+    0xE2, 0xFB,       // 000D: loop inner
+    0x4A,             // 000F: dec dx
+    0x75, 0xF5,       // 0010: jnz outer
+    0xA3, 0x00, 0x00, // 0012: mov [0000], ax
+    0xF4              // 0015: hlt
+  };
+  static constexpr u8 reset_vector[] = {
+    0xEA, 0x00, 0x00, 0x00, 0xF0 // FFF0: jmp far F000:0000
+  };
+
+  std::vector<u8> rom(CPU_X86_TestSystem::BIOS_ROM_SIZE, 0xF4);
+  std::copy(std::begin(code), std::end(code), rom.begin());
+  std::copy(std::begin(reset_vector), std::end(reset_vector), rom.begin() + 0xFFF0);
+
+  StubSystemPointer<CPU_X86_TestSystem> system = StubHostInterface::CreateSystem<CPU_X86_TestSystem>(
+    CPU_X86::MODEL_386, 100000000.0f, CPU::BackendType::TieredRecompiler, 1024 * 1024);
+  system->AddROMData(std::move(rom), CPU_X86_TestSystem::BIOS_ROM_ADDRESS);
+
+  EXPECT_TRUE(system->Execute(SecondsToSimulationTime(10))) << "system did not initialize or execution timed out";
+  ASSERT_TRUE(system->GetX86CPU()->IsHalted()) << "CPU is not halted indicating the test did not finish";
+
+  // 1000 * 1000 * 3, truncated to 16 bits.
+  u8 result_low = 0, result_high = 0;
+  EXPECT_TRUE(system->GetBus()->CheckedReadMemoryByte(0, &result_low));
+  EXPECT_TRUE(system->GetBus()->CheckedReadMemoryByte(1, &result_high));
+  EXPECT_EQ(0xC6C0u, ZeroExtend32(result_low) | (ZeroExtend32(result_high) << 8));
+}
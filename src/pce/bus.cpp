@@ -11,11 +11,17 @@
 #include "pce/mmio.h"
 #include "pce/system.h"
 #include "xxhash.h"
+#include <algorithm>
 #include <array>
+#include <cinttypes>
 #include <cmath>
 #include <cstring>
 #include <functional>
 #include <limits>
+#ifdef ENABLE_FASTMEM
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 Log_SetChannel(Bus);
 
 DEFINE_OBJECT_TYPE_INFO(Bus);
@@ -25,6 +31,16 @@ Bus::Bus(u32 memory_address_bits, const ObjectTypeInfo* type_info /* = &s_type_i
   AllocateMemoryPages(memory_address_bits);
   m_ioport_handlers = new IOPortConnection*[NUM_IOPORTS];
   std::memset(m_ioport_handlers, 0, sizeof(IOPortConnection*) * NUM_IOPORTS);
+
+  m_ioport_read_byte_handlers = std::make_unique<IOPortHandler<IOPortReadByteFunction>[]>(NUM_IOPORTS);
+  m_ioport_read_word_handlers = std::make_unique<IOPortHandler<IOPortReadWordFunction>[]>(NUM_IOPORTS);
+  m_ioport_read_dword_handlers = std::make_unique<IOPortHandler<IOPortReadDWordFunction>[]>(NUM_IOPORTS);
+  m_ioport_write_byte_handlers = std::make_unique<IOPortHandler<IOPortWriteByteFunction>[]>(NUM_IOPORTS);
+  m_ioport_write_word_handlers = std::make_unique<IOPortHandler<IOPortWriteWordFunction>[]>(NUM_IOPORTS);
+  m_ioport_write_dword_handlers = std::make_unique<IOPortHandler<IOPortWriteDWordFunction>[]>(NUM_IOPORTS);
+  m_ioport_idle_reads = std::make_unique<bool[]>(NUM_IOPORTS);
+  for (u32 port = 0; port < NUM_IOPORTS; port++)
+    UpdateIOPortDispatch(static_cast<u16>(port));
 }
 
 Bus::~Bus()
@@ -50,9 +66,29 @@ Bus::~Bus()
   }
 
   delete[] m_physical_memory_pages;
+
+  DisableFastmem();
+#ifdef ENABLE_FASTMEM
+  if (m_ram_fd >= 0)
+    close(m_ram_fd);
+  if (m_ram_mapped)
+  {
+    munmap(m_ram_ptr, m_ram_size);
+    m_ram_ptr = nullptr;
+  }
+#endif
   delete[] m_ram_ptr;
 }
 
+void Bus::SetMemoryAddressMask(PhysicalMemoryAddress mask)
+{
+  if (m_physical_memory_address_mask == mask)
+    return;
+
+  m_physical_memory_address_mask = mask;
+  NotifyPageMappingChange();
+}
+
 bool Bus::Initialize(System* system)
 {
   m_system = system;
@@ -181,6 +217,77 @@ void Bus::RemoveIOPortConnection(u16 port, const void* owner)
     conn = conn->next;
     delete temp;
   }
+
+  UpdateIOPortDispatch(port);
+}
+
+void Bus::UpdateIOPortDispatch(u16 port)
+{
+  const IOPortConnection* first_conn = m_ioport_handlers[port];
+
+  // Reads go to the first connection with a handler. Wider accesses without one are split into narrower accesses.
+  IOPortHandler<IOPortReadByteFunction> read_byte = {&Bus::ReadUnconnectedIOPortByte, this};
+  IOPortHandler<IOPortReadWordFunction> read_word = {&Bus::ReadIOPortWordAsBytes, this};
+  IOPortHandler<IOPortReadDWordFunction> read_dword = {&Bus::ReadIOPortDWordAsWords, this};
+  bool idle_read = true;
+  for (const IOPortConnection* conn = first_conn; conn; conn = conn->next)
+  {
+    // Only idle if every connection which can be read from is.
+    if (!conn->idle_read && (conn->read_byte.function || conn->read_word.function || conn->read_dword.function))
+      idle_read = false;
+    if (conn->read_byte.function && read_byte.function == &Bus::ReadUnconnectedIOPortByte)
+      read_byte = conn->read_byte;
+    if (conn->read_word.function && read_word.function == &Bus::ReadIOPortWordAsBytes)
+      read_word = conn->read_word;
+    if (conn->read_dword.function && read_dword.function == &Bus::ReadIOPortDWordAsWords)
+      read_dword = conn->read_dword;
+  }
+
+  // Writes go to every connection with a handler, so ports with more than one walk the connection list.
+  // Wider writes are only passed through when the first connection handles them, otherwise they are split.
+  IOPortHandler<IOPortWriteByteFunction> write_byte = {&Bus::WriteUnconnectedIOPortByte, this};
+  IOPortHandler<IOPortWriteWordFunction> write_word = {&Bus::WriteIOPortWordAsBytes, this};
+  IOPortHandler<IOPortWriteDWordFunction> write_dword = {&Bus::WriteIOPortDWordAsWords, this};
+  u32 write_byte_count = 0, write_word_count = 0, write_dword_count = 0;
+  for (const IOPortConnection* conn = first_conn; conn; conn = conn->next)
+  {
+    if (conn->write_byte.function)
+    {
+      if (write_byte_count++ == 0)
+        write_byte = conn->write_byte;
+      else
+        write_byte = {&Bus::WriteSharedIOPortByte, this};
+    }
+    if (conn->write_word.function && first_conn->write_word.function)
+    {
+      if (write_word_count++ == 0)
+        write_word = conn->write_word;
+      else
+        write_word = {&Bus::WriteSharedIOPortWord, this};
+    }
+    if (conn->write_dword.function && first_conn->write_dword.function)
+    {
+      if (write_dword_count++ == 0)
+        write_dword = conn->write_dword;
+      else
+        write_dword = {&Bus::WriteSharedIOPortDWord, this};
+    }
+  }
+
+  m_ioport_read_byte_handlers[port] = read_byte;
+  m_ioport_read_word_handlers[port] = read_word;
+  m_ioport_read_dword_handlers[port] = read_dword;
+  m_ioport_write_byte_handlers[port] = write_byte;
+  m_ioport_write_word_handlers[port] = write_word;
+  m_ioport_write_dword_handlers[port] = write_dword;
+  m_ioport_idle_reads[port] = (idle_read && first_conn != nullptr);
+}
+
+// Calls a handler connected as a std::function, which is passed as the context.
+template<typename Handler, typename... Args>
+static auto CallIOPortHandler(void* context, Args... args)
+{
+  return (*static_cast<const Handler*>(context))(args...);
 }
 
 void Bus::ConnectIOPortRead(u16 port, const void* owner, IOPortReadByteHandler read_callback)
@@ -190,6 +297,8 @@ void Bus::ConnectIOPortRead(u16 port, const void* owner, IOPortReadByteHandler r
     connection = CreateIOPortConnection(port, owner);
 
   connection->read_byte_handler = std::move(read_callback);
+  connection->read_byte = {&CallIOPortHandler<IOPortReadByteHandler, u16>, &connection->read_byte_handler};
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::ConnectIOPortReadWord(u16 port, const void* owner, IOPortReadWordHandler read_callback)
@@ -199,6 +308,8 @@ void Bus::ConnectIOPortReadWord(u16 port, const void* owner, IOPortReadWordHandl
     connection = CreateIOPortConnection(port, owner);
 
   connection->read_word_handler = std::move(read_callback);
+  connection->read_word = {&CallIOPortHandler<IOPortReadWordHandler, u16>, &connection->read_word_handler};
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::ConnectIOPortReadDWord(u16 port, const void* owner, IOPortReadDWordHandler read_callback)
@@ -208,6 +319,8 @@ void Bus::ConnectIOPortReadDWord(u16 port, const void* owner, IOPortReadDWordHan
     connection = CreateIOPortConnection(port, owner);
 
   connection->read_dword_handler = std::move(read_callback);
+  connection->read_dword = {&CallIOPortHandler<IOPortReadDWordHandler, u16>, &connection->read_dword_handler};
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::ConnectIOPortWrite(u16 port, const void* owner, IOPortWriteByteHandler write_callback)
@@ -217,6 +330,8 @@ void Bus::ConnectIOPortWrite(u16 port, const void* owner, IOPortWriteByteHandler
     connection = CreateIOPortConnection(port, owner);
 
   connection->write_byte_handler = std::move(write_callback);
+  connection->write_byte = {&CallIOPortHandler<IOPortWriteByteHandler, u16, u8>, &connection->write_byte_handler};
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::ConnectIOPortWriteWord(u16 port, const void* owner, IOPortWriteWordHandler write_callback)
@@ -226,6 +341,8 @@ void Bus::ConnectIOPortWriteWord(u16 port, const void* owner, IOPortWriteWordHan
     connection = CreateIOPortConnection(port, owner);
 
   connection->write_word_handler = std::move(write_callback);
+  connection->write_word = {&CallIOPortHandler<IOPortWriteWordHandler, u16, u16>, &connection->write_word_handler};
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::ConnectIOPortWriteDWord(u16 port, const void* owner, IOPortWriteDWordHandler write_callback)
@@ -235,6 +352,74 @@ void Bus::ConnectIOPortWriteDWord(u16 port, const void* owner, IOPortWriteDWordH
     connection = CreateIOPortConnection(port, owner);
 
   connection->write_dword_handler = std::move(write_callback);
+  connection->write_dword = {&CallIOPortHandler<IOPortWriteDWordHandler, u16, u32>, &connection->write_dword_handler};
+  UpdateIOPortDispatch(port);
+}
+
+void Bus::ConnectIOPortRead(u16 port, const void* owner, IOPortReadByteFunction read_function, void* context)
+{
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
+
+  connection->read_byte_handler = nullptr;
+  connection->read_byte = {read_function, context};
+  UpdateIOPortDispatch(port);
+}
+
+void Bus::ConnectIOPortReadWord(u16 port, const void* owner, IOPortReadWordFunction read_function, void* context)
+{
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
+
+  connection->read_word_handler = nullptr;
+  connection->read_word = {read_function, context};
+  UpdateIOPortDispatch(port);
+}
+
+void Bus::ConnectIOPortReadDWord(u16 port, const void* owner, IOPortReadDWordFunction read_function, void* context)
+{
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
+
+  connection->read_dword_handler = nullptr;
+  connection->read_dword = {read_function, context};
+  UpdateIOPortDispatch(port);
+}
+
+void Bus::ConnectIOPortWrite(u16 port, const void* owner, IOPortWriteByteFunction write_function, void* context)
+{
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
+
+  connection->write_byte_handler = nullptr;
+  connection->write_byte = {write_function, context};
+  UpdateIOPortDispatch(port);
+}
+
+void Bus::ConnectIOPortWriteWord(u16 port, const void* owner, IOPortWriteWordFunction write_function, void* context)
+{
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
+
+  connection->write_word_handler = nullptr;
+  connection->write_word = {write_function, context};
+  UpdateIOPortDispatch(port);
+}
+
+void Bus::ConnectIOPortWriteDWord(u16 port, const void* owner, IOPortWriteDWordFunction write_function, void* context)
+{
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
+
+  connection->write_dword_handler = nullptr;
+  connection->write_dword = {write_function, context};
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::DisconnectIOPort(u16 port, const void* owner)
@@ -269,131 +454,252 @@ void Bus::DisconnectIOPorts(const void* owner)
 
 u8 Bus::ReadIOPortByte(u16 port)
 {
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  while (conn)
-  {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->read_byte_handler)
-      return current->read_byte_handler(port);
-  }
-
-  Log_DebugPrintf("Unknown IO port 0x%04X (read)", port);
-  return 0xFF;
+  const IOPortHandler<IOPortReadByteFunction>& handler = m_ioport_read_byte_handlers[port];
+  if (!m_ioport_profile)
+    return handler.function(handler.context, port);
+
+  const u64 start_time = Timer::GetValue();
+  const u8 value = handler.function(handler.context, port);
+  AddIOPortProfileSample(port, start_time);
+  return value;
 }
 
 u16 Bus::ReadIOPortWord(u16 port)
 {
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  while (conn)
+  const IOPortHandler<IOPortReadWordFunction>& handler = m_ioport_read_word_handlers[port];
+  if (!m_ioport_profile)
+    return handler.function(handler.context, port);
+
+  const u64 start_time = Timer::GetValue();
+  const u16 value = handler.function(handler.context, port);
+  AddIOPortProfileSample(port, start_time);
+  return value;
+}
+
+u32 Bus::ReadIOPortDWord(u16 port)
+{
+  const IOPortHandler<IOPortReadDWordFunction>& handler = m_ioport_read_dword_handlers[port];
+  if (!m_ioport_profile)
+    return handler.function(handler.context, port);
+
+  const u64 start_time = Timer::GetValue();
+  const u32 value = handler.function(handler.context, port);
+  AddIOPortProfileSample(port, start_time);
+  return value;
+}
+
+void Bus::WriteIOPortByte(u16 port, u8 value)
+{
+  const IOPortHandler<IOPortWriteByteFunction>& handler = m_ioport_write_byte_handlers[port];
+  if (!m_ioport_profile)
   {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->read_word_handler)
-      return current->read_word_handler(port);
+    handler.function(handler.context, port, value);
+    return;
   }
 
-  // If this port does not support 16-bit IO, write as two 8-bit ports.
-  const u8 b0 = ReadIOPortByte(port + 0);
-  const u8 b1 = ReadIOPortByte(port + 1);
-  return ZeroExtend16(b0) | (ZeroExtend16(b1) << 8);
+  const u64 start_time = Timer::GetValue();
+  handler.function(handler.context, port, value);
+  AddIOPortProfileSample(port, start_time);
 }
 
-u32 Bus::ReadIOPortDWord(u16 port)
+void Bus::WriteIOPortWord(u16 port, u16 value)
 {
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  while (conn)
+  const IOPortHandler<IOPortWriteWordFunction>& handler = m_ioport_write_word_handlers[port];
+  if (!m_ioport_profile)
   {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->read_dword_handler)
-      return current->read_dword_handler(port);
+    handler.function(handler.context, port, value);
+    return;
   }
 
-  // If this port does not support 32-bit IO, write as two 16-bit ports, which will
-  // turn into 2 8-bit ports.
-  const u16 b0 = ReadIOPortWord(port + 0);
-  const u16 b1 = ReadIOPortWord(port + 2);
-  return ZeroExtend32(b0) | (ZeroExtend32(b1) << 16);
+  const u64 start_time = Timer::GetValue();
+  handler.function(handler.context, port, value);
+  AddIOPortProfileSample(port, start_time);
 }
 
-void Bus::WriteIOPortByte(u16 port, u8 value)
+void Bus::WriteIOPortDWord(u16 port, u32 value)
 {
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  if (!conn)
+  const IOPortHandler<IOPortWriteDWordFunction>& handler = m_ioport_write_dword_handlers[port];
+  if (!m_ioport_profile)
   {
-    Log_DebugPrintf("Unknown IO port 0x%04X (write), value = %04X", port, value);
+    handler.function(handler.context, port, value);
     return;
   }
 
-  do
-  {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->write_byte_handler)
-      current->write_byte_handler(port, value);
-  } while (conn);
+  const u64 start_time = Timer::GetValue();
+  handler.function(handler.context, port, value);
+  AddIOPortProfileSample(port, start_time);
+}
+
+u8 Bus::ReadUnconnectedIOPortByte(void* context, u16 port)
+{
+  Log_DebugPrintf("Unknown IO port 0x%04X (read)", port);
+  return 0xFF;
+}
 
-  // Log_TracePrintf("Write to ioport 0x%04X: 0x%02X", port, value);
+u16 Bus::ReadIOPortWordAsBytes(void* context, u16 port)
+{
+  // If this port does not support 16-bit IO, read as two 8-bit ports.
+  const Bus* bus = static_cast<const Bus*>(context);
+  const IOPortHandler<IOPortReadByteFunction>& b0_handler = bus->m_ioport_read_byte_handlers[u16(port + 0)];
+  const IOPortHandler<IOPortReadByteFunction>& b1_handler = bus->m_ioport_read_byte_handlers[u16(port + 1)];
+  const u8 b0 = b0_handler.function(b0_handler.context, port + 0);
+  const u8 b1 = b1_handler.function(b1_handler.context, port + 1);
+  return ZeroExtend16(b0) | (ZeroExtend16(b1) << 8);
 }
 
-void Bus::WriteIOPortWord(u16 port, u16 value)
+u32 Bus::ReadIOPortDWordAsWords(void* context, u16 port)
+{
+  // If this port does not support 32-bit IO, read as two 16-bit ports, which may turn into 8-bit ports.
+  const Bus* bus = static_cast<const Bus*>(context);
+  const IOPortHandler<IOPortReadWordFunction>& b0_handler = bus->m_ioport_read_word_handlers[u16(port + 0)];
+  const IOPortHandler<IOPortReadWordFunction>& b1_handler = bus->m_ioport_read_word_handlers[u16(port + 2)];
+  const u16 b0 = b0_handler.function(b0_handler.context, port + 0);
+  const u16 b1 = b1_handler.function(b1_handler.context, port + 2);
+  return ZeroExtend32(b0) | (ZeroExtend32(b1) << 16);
+}
+
+void Bus::WriteUnconnectedIOPortByte(void* context, u16 port, u8 value)
+{
+  Log_DebugPrintf("Unknown IO port 0x%04X (write), value = %04X", port, value);
+}
+
+void Bus::WriteIOPortWordAsBytes(void* context, u16 port, u16 value)
 {
   // If this port does not support 16-bit IO, write as two 8-bit ports.
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  if (!conn || !conn->write_word_handler)
+  const Bus* bus = static_cast<const Bus*>(context);
+  const IOPortHandler<IOPortWriteByteFunction>& b0_handler = bus->m_ioport_write_byte_handlers[u16(port + 0)];
+  const IOPortHandler<IOPortWriteByteFunction>& b1_handler = bus->m_ioport_write_byte_handlers[u16(port + 1)];
+  b0_handler.function(b0_handler.context, port + 0, Truncate8(value >> 0));
+  b1_handler.function(b1_handler.context, port + 1, Truncate8(value >> 8));
+}
+
+void Bus::WriteIOPortDWordAsWords(void* context, u16 port, u32 value)
+{
+  // If this port does not support 32-bit IO, write as two 16-bit ports (which may turn into 8-bit ports).
+  const Bus* bus = static_cast<const Bus*>(context);
+  const IOPortHandler<IOPortWriteWordFunction>& b0_handler = bus->m_ioport_write_word_handlers[u16(port + 0)];
+  const IOPortHandler<IOPortWriteWordFunction>& b1_handler = bus->m_ioport_write_word_handlers[u16(port + 2)];
+  b0_handler.function(b0_handler.context, port + 0, Truncate16(value >> 0));
+  b1_handler.function(b1_handler.context, port + 2, Truncate16(value >> 16));
+}
+
+void Bus::WriteSharedIOPortByte(void* context, u16 port, u8 value)
+{
+  const Bus* bus = static_cast<const Bus*>(context);
+  for (const IOPortConnection* conn = bus->m_ioport_handlers[port]; conn; conn = conn->next)
   {
-    WriteIOPortByte(port + 0, Truncate8(value >> 0));
-    WriteIOPortByte(port + 1, Truncate8(value >> 8));
-    return;
+    if (conn->write_byte.function)
+      conn->write_byte.function(conn->write_byte.context, port, value);
   }
+}
 
-  do
+void Bus::WriteSharedIOPortWord(void* context, u16 port, u16 value)
+{
+  const Bus* bus = static_cast<const Bus*>(context);
+  for (const IOPortConnection* conn = bus->m_ioport_handlers[port]; conn; conn = conn->next)
   {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->write_word_handler)
-      current->write_word_handler(port, value);
-  } while (conn);
-
-  // Log_TracePrintf("Write to ioport 0x%04X: 0x%04X", port, ZeroExtend32(value));
+    if (conn->write_word.function)
+      conn->write_word.function(conn->write_word.context, port, value);
+  }
 }
 
-void Bus::WriteIOPortDWord(u16 port, u32 value)
+void Bus::WriteSharedIOPortDWord(void* context, u16 port, u32 value)
 {
-  // If this port does not support 32-bit IO, write as two 16-bit ports
-  // (which will turn into 2 8-bit ports).
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  if (!conn || !conn->write_dword_handler)
+  const Bus* bus = static_cast<const Bus*>(context);
+  for (const IOPortConnection* conn = bus->m_ioport_handlers[port]; conn; conn = conn->next)
   {
-    WriteIOPortWord(port + 0, Truncate16(value >> 0));
-    WriteIOPortWord(port + 2, Truncate16(value >> 16));
-    return;
+    if (conn->write_dword.function)
+      conn->write_dword.function(conn->write_dword.context, port, value);
   }
+}
 
-  do
+void Bus::ConnectIOPortReadToPointer(u16 port, const void* owner, const u8* var)
+{
+  ConnectIOPortRead(port, owner, [](void* context, u16) { return *static_cast<const u8*>(context); },
+                    const_cast<u8*>(var));
+}
+
+void Bus::ConnectIOPortWriteToPointer(u16 port, const void* owner, u8* var)
+{
+  ConnectIOPortWrite(port, owner, [](void* context, u16, u8 value) { *static_cast<u8*>(context) = value; }, var);
+}
+
+void Bus::SetIOPortReadIdle(u16 port, const void* owner, bool idle /* = true */)
+{
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
   {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->write_dword_handler)
-      current->write_dword_handler(port, value);
-  } while (conn);
+    Log_WarningPrintf("Marking unconnected IO port %04X as idle", ZeroExtend32(port));
+    return;
+  }
 
-  // Log_TracePrintf("Write to ioport 0x%04X: 0x%04X", port, ZeroExtend32(value));
+  connection->idle_read = idle;
+  UpdateIOPortDispatch(port);
 }
 
-void Bus::ConnectIOPortReadToPointer(u16 port, const void* owner, const u8* var)
+void Bus::SetIOPortProfilingEnabled(bool enabled)
 {
-  IOPortReadByteHandler read_handler = [var](u16 cb_port) { return *var; };
+  if (IsIOPortProfilingEnabled() == enabled)
+    return;
 
-  ConnectIOPortRead(port, owner, std::move(read_handler));
+  if (enabled)
+  {
+    Log_InfoPrintf("IO port profiling enabled");
+    m_ioport_profile = std::make_unique<IOPortProfile[]>(NUM_IOPORTS);
+  }
+  else
+  {
+    Log_InfoPrintf("IO port profiling disabled");
+    m_ioport_profile.reset();
+  }
 }
 
-void Bus::ConnectIOPortWriteToPointer(u16 port, const void* owner, u8* var)
+void Bus::AddIOPortProfileSample(u16 port, u64 start_time)
 {
-  IOPortWriteByteHandler write_handler = [var](u32 cb_port, u8 cb_value) { *var = cb_value; };
+  IOPortProfile& profile = m_ioport_profile[port];
+  profile.access_count++;
+  profile.time += Timer::GetValue() - start_time;
+}
+
+void Bus::DumpIOPortProfile(u32 count)
+{
+  if (!m_ioport_profile)
+  {
+    Log_WarningPrintf("IO port profiling is not enabled");
+    return;
+  }
+
+  std::vector<u16> ports;
+  u64 total_accesses = 0;
+  u64 total_time = 0;
+  for (u32 port = 0; port < NUM_IOPORTS; port++)
+  {
+    const IOPortProfile& profile = m_ioport_profile[port];
+    if (profile.access_count == 0)
+      continue;
+
+    ports.push_back(static_cast<u16>(port));
+    total_accesses += profile.access_count;
+    total_time += profile.time;
+  }
+
+  Log_InfoPrintf("IO port profile: %zu ports, %" PRIu64 " accesses, %.3f ms in handlers", ports.size(),
+                 total_accesses, Timer::ConvertValueToMilliseconds(total_time));
+
+  // Sort by time spent in the handlers, the most expensive ports are the interesting ones.
+  std::sort(ports.begin(), ports.end(),
+            [this](u16 lhs, u16 rhs) { return m_ioport_profile[lhs].time > m_ioport_profile[rhs].time; });
+  if (ports.size() > count)
+    ports.resize(count);
 
-  ConnectIOPortWrite(port, owner, std::move(write_handler));
+  for (const u16 port : ports)
+  {
+    const IOPortProfile& profile = m_ioport_profile[port];
+    const double time_ms = Timer::ConvertValueToMilliseconds(profile.time);
+    Log_InfoPrintf("  port %04X: %" PRIu64 " accesses, %.3f ms (%.1f%%), %.0f ns/access", port, profile.access_count,
+                   time_ms, (total_time > 0) ? (100.0 * double(profile.time) / double(total_time)) : 0.0,
+                   Timer::ConvertValueToNanoseconds(profile.time) / double(profile.access_count));
+  }
 }
 
 void Bus::ReadMemoryBlock(PhysicalMemoryAddress address, u32 length, void* destination)
@@ -485,10 +791,19 @@ void Bus::WriteMemoryBlock(PhysicalMemoryAddress address, u32 length, const void
 
     // Fast path?
     const PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
-    const u32 size_in_page = std::min(length, MEMORY_PAGE_SIZE);
+    const u32 size_in_page = std::min(length, MEMORY_PAGE_SIZE - page_offset);
     if (page.type & PhysicalMemoryPage::kWritableRAM)
     {
+      // Block writes (e.g. bus master DMA) have to fire the same callbacks as CPU writes.
+      const bool watched = (page.type & PhysicalMemoryPage::kWriteWatch) != 0;
+      const bool code = (page.type & PhysicalMemoryPage::kCachedCode) != 0 &&
+                        (page.code_bitmap & GetCodeBitmapMask(page_offset, size_in_page)) != 0;
       std::memcpy(page.ram_ptr + page_offset, source_ptr, size_in_page);
+      if (watched)
+        m_write_watch_callback(page_number * MEMORY_PAGE_SIZE + page_offset, size_in_page);
+      if (code)
+        m_code_invalidate_callback(page_number * MEMORY_PAGE_SIZE + page_offset, size_in_page);
+
       source_ptr += size_in_page;
       address += size_in_page;
       length -= size_in_page;
@@ -578,7 +893,20 @@ void Bus::AllocateRAM(u32 size)
 {
   DebugAssert(size > 0 && !m_ram_ptr);
   Assert((size % MEMORY_PAGE_SIZE) == 0);
-  m_ram_ptr = new byte[size];
+
+#ifdef ENABLE_FASTMEM
+  // Map RAM rather than allocating it from the heap, so that it can be replaced with a shared memory file in place if
+  // fastmem is enabled later.
+  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr != MAP_FAILED)
+  {
+    m_ram_ptr = static_cast<byte*>(ptr);
+    m_ram_mapped = true;
+  }
+#endif
+
+  if (!m_ram_ptr)
+    m_ram_ptr = new byte[size];
   m_ram_size = size;
   m_ram_assigned = 0;
   std::memset(m_ram_ptr, 0x00, m_ram_size);
@@ -599,11 +927,15 @@ u32 Bus::CreateRAMRegion(PhysicalMemoryAddress start, PhysicalMemoryAddress end)
     page->ram_ptr = m_ram_ptr + m_ram_assigned;
     page->type = PhysicalMemoryPage::kReadableRAM | PhysicalMemoryPage::kWritableRAM;
     m_physical_memory_page_ram_index[current_page] = page->ram_ptr;
+    MapFastmemPage(current_page);
     m_ram_assigned += MEMORY_PAGE_SIZE;
     allocated_ram += MEMORY_PAGE_SIZE;
     remaining_ram -= MEMORY_PAGE_SIZE;
   }
 
+  if (allocated_ram > 0)
+    NotifyPageMappingChange();
+
   return allocated_ram;
 }
 
@@ -656,6 +988,7 @@ void Bus::MirrorRegion(PhysicalMemoryAddress start, u32 size, PhysicalMemoryAddr
       dst_page->ram_ptr = src_page->ram_ptr;
       dst_page->type |= (src_page->type & (PhysicalMemoryPage::kReadableRAM | PhysicalMemoryPage::kWritableRAM)) |
                         PhysicalMemoryPage::kMirror;
+      MapFastmemPage(current_dst_page);
     }
 
     if (src_page->mmio_handler)
@@ -688,6 +1021,8 @@ void Bus::MirrorRegion(PhysicalMemoryAddress start, u32 size, PhysicalMemoryAddr
       dst_page->type |= PhysicalMemoryPage::kMirror;
     }
   }
+
+  NotifyPageMappingChange();
 }
 
 template<typename T>
@@ -776,12 +1111,20 @@ bool Bus::IsWritablePage(PhysicalMemoryAddress address) const
   return IsWritablePage(m_physical_memory_pages[page_number]);
 }
 
-void Bus::MarkPageAsCode(PhysicalMemoryAddress address)
+void Bus::MarkPageAsCode(PhysicalMemoryAddress address, u64 code_bitmap /* = ~u64(0) */)
 {
   u32 page_number = address / MEMORY_PAGE_SIZE;
   DebugAssert(page_number < m_num_physical_memory_pages);
-  m_physical_memory_pages[page_number].type |= PhysicalMemoryPage::kCachedCode;
-  m_physical_memory_page_ram_index[page_number] = nullptr;
+
+  PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  page.code_bitmap |= code_bitmap;
+  if (page.type & PhysicalMemoryPage::kCachedCode)
+    return;
+
+  page.type |= PhysicalMemoryPage::kCachedCode;
+  UpdateFastmemPageProtection(page_number);
+  if (UpdatePageRAMPointer(page_number))
+    NotifyPageMappingChange(page_number);
 }
 
 void Bus::UnmarkPageAsCode(PhysicalMemoryAddress address)
@@ -790,13 +1133,34 @@ void Bus::UnmarkPageAsCode(PhysicalMemoryAddress address)
   DebugAssert(page_number < m_num_physical_memory_pages);
 
   PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  if (!(page.type & PhysicalMemoryPage::kCachedCode))
+    return;
+
   page.type &= ~PhysicalMemoryPage::kCachedCode;
-  if (page.IsReadableWritableRAM())
-    m_physical_memory_page_ram_index[page_number] = page.ram_ptr;
+  page.code_bitmap = 0;
+  UpdateFastmemPageProtection(page_number);
+  if (UpdatePageRAMPointer(page_number))
+    NotifyPageMappingChange(page_number);
+}
+
+void Bus::SetPageCodeBitmap(PhysicalMemoryAddress address, u64 code_bitmap)
+{
+  u32 page_number = address / MEMORY_PAGE_SIZE;
+  DebugAssert(page_number < m_num_physical_memory_pages);
+
+  PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  if (!(page.type & PhysicalMemoryPage::kCachedCode))
+    return;
+
+  if (code_bitmap == 0)
+    UnmarkPageAsCode(address);
+  else
+    page.code_bitmap = code_bitmap;
 }
 
 void Bus::ClearPageCodeFlags()
 {
+  bool changed = false;
   for (u32 i = 0; i < m_num_physical_memory_pages; i++)
   {
     PhysicalMemoryPage& page = m_physical_memory_pages[i];
@@ -804,9 +1168,13 @@ void Bus::ClearPageCodeFlags()
       continue;
 
     page.type &= ~PhysicalMemoryPage::kCachedCode;
-    if (page.IsReadableWritableRAM())
-      m_physical_memory_page_ram_index[i] = page.ram_ptr;
+    page.code_bitmap = 0;
+    UpdateFastmemPageProtection(i);
+    changed |= UpdatePageRAMPointer(i);
   }
+
+  if (changed)
+    NotifyPageMappingChange();
 }
 
 void Bus::SetCodeInvalidationCallback(CodeInvalidateCallback callback)
@@ -816,7 +1184,100 @@ void Bus::SetCodeInvalidationCallback(CodeInvalidateCallback callback)
 
 void Bus::ClearCodeInvalidationCallback()
 {
-  m_code_invalidate_callback = [](PhysicalMemoryAddress) {};
+  m_code_invalidate_callback = [](PhysicalMemoryAddress, u32) {};
+}
+
+void Bus::SetPageMappingChangeCallback(PageMappingChangeCallback callback)
+{
+  m_page_mapping_change_callback = std::move(callback);
+}
+
+void Bus::ClearPageMappingChangeCallback()
+{
+  m_page_mapping_change_callback = nullptr;
+}
+
+void Bus::WatchPageWrites(PhysicalMemoryAddress address)
+{
+  const u32 page_number = (address & m_physical_memory_address_mask) / MEMORY_PAGE_SIZE;
+  DebugAssert(page_number < m_num_physical_memory_pages);
+
+  PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  if (!page.ram_ptr || page.IsWriteWatched())
+    return;
+
+  page.type |= PhysicalMemoryPage::kWriteWatch;
+  UpdateFastmemPageProtection(page_number);
+  if (UpdatePageRAMPointer(page_number))
+    NotifyPageMappingChange(page_number);
+}
+
+void Bus::UnwatchPageWrites(PhysicalMemoryAddress address)
+{
+  const u32 page_number = (address & m_physical_memory_address_mask) / MEMORY_PAGE_SIZE;
+  DebugAssert(page_number < m_num_physical_memory_pages);
+
+  PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  if (!page.IsWriteWatched())
+    return;
+
+  page.type &= ~PhysicalMemoryPage::kWriteWatch;
+  UpdateFastmemPageProtection(page_number);
+  if (UpdatePageRAMPointer(page_number))
+    NotifyPageMappingChange(page_number);
+}
+
+void Bus::ClearPageWriteWatches()
+{
+  bool changed = false;
+  for (u32 i = 0; i < m_num_physical_memory_pages; i++)
+  {
+    PhysicalMemoryPage& page = m_physical_memory_pages[i];
+    if (!page.IsWriteWatched())
+      continue;
+
+    page.type &= ~PhysicalMemoryPage::kWriteWatch;
+    UpdateFastmemPageProtection(i);
+    changed |= UpdatePageRAMPointer(i);
+  }
+
+  if (changed)
+    NotifyPageMappingChange();
+}
+
+void Bus::SetWriteWatchCallback(WriteWatchCallback callback)
+{
+  m_write_watch_callback = std::move(callback);
+}
+
+void Bus::ClearWriteWatchCallback()
+{
+  m_write_watch_callback = nullptr;
+}
+
+bool Bus::UpdatePageRAMPointer(u32 page_number)
+{
+  // Only pages which can be accessed without side effects are exposed through the index.
+  const PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  byte* ram_ptr =
+    (page.IsReadableWritableRAM() && !page.HasCachedCode() && !page.IsWriteWatched()) ? page.ram_ptr : nullptr;
+  if (m_physical_memory_page_ram_index[page_number] == ram_ptr)
+    return false;
+
+  m_physical_memory_page_ram_index[page_number] = ram_ptr;
+  return true;
+}
+
+void Bus::NotifyPageMappingChange(u32 page_number)
+{
+  if (m_page_mapping_change_callback)
+    m_page_mapping_change_callback(page_number * MEMORY_PAGE_SIZE, m_physical_memory_pages[page_number].ram_ptr);
+}
+
+void Bus::NotifyPageMappingChange()
+{
+  if (m_page_mapping_change_callback)
+    m_page_mapping_change_callback(ALL_PAGES_CHANGED, nullptr);
 }
 
 void Bus::SetPageRAMState(PhysicalMemoryAddress page_address, bool readable_memory, bool writable_memory)
@@ -832,7 +1293,7 @@ void Bus::SetPageRAMState(PhysicalMemoryAddress page_address, bool readable_memo
   // If it's code, we need to invalidate it.
   // TODO: This is only really required if we change states..
   if (page.type & PhysicalMemoryPage::kCachedCode)
-    m_code_invalidate_callback(page_address & MEMORY_PAGE_MASK);
+    m_code_invalidate_callback(page_address & MEMORY_PAGE_MASK, MEMORY_PAGE_SIZE);
 
   if (readable_memory)
     page.type |= PhysicalMemoryPage::kReadableRAM;
@@ -843,7 +1304,9 @@ void Bus::SetPageRAMState(PhysicalMemoryAddress page_address, bool readable_memo
   else
     page.type &= ~PhysicalMemoryPage::kWritableRAM;
 
-  m_physical_memory_page_ram_index[page_number] = page.IsReadableWritableRAM() ? page.ram_ptr : nullptr;
+  UpdateFastmemPageProtection(page_number);
+  if (UpdatePageRAMPointer(page_number))
+    NotifyPageMappingChange(page_number);
 }
 
 void Bus::SetPagesRAMState(PhysicalMemoryAddress start_address, u32 size, bool readable_memory, bool writable_memory)
@@ -856,6 +1319,126 @@ void Bus::SetPagesRAMState(PhysicalMemoryAddress start_address, u32 size, bool r
     SetPageRAMState(current_page, readable_memory, writable_memory);
 }
 
+#ifdef ENABLE_FASTMEM
+static int GetFastmemPageProtection(const Bus::PhysicalMemoryPage& page)
+{
+  if (!page.IsReadableRAM())
+    return PROT_NONE;
+  else if (!page.IsWritableRAM() || page.HasCachedCode() || page.IsWriteWatched())
+    return PROT_READ;
+  else
+    return PROT_READ | PROT_WRITE;
+}
+#endif
+
+bool Bus::EnableFastmem()
+{
+#ifdef ENABLE_FASTMEM
+  if (m_fastmem_base)
+    return true;
+  if (m_ram_fd < 0 && !CreateSharedRAM())
+    return false;
+
+  void* base = mmap(nullptr, FASTMEM_WINDOW_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (base == MAP_FAILED)
+  {
+    Log_ErrorPrintf("Failed to reserve fastmem address range");
+    return false;
+  }
+
+  m_fastmem_base = static_cast<byte*>(base);
+  for (u32 i = 0; i < m_num_physical_memory_pages; i++)
+    MapFastmemPage(i);
+
+  Log_InfoPrintf("Fastmem view created at %p", base);
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool Bus::CreateSharedRAM()
+{
+#ifdef ENABLE_FASTMEM
+  if (!m_ram_mapped)
+    return false;
+
+  const int fd = memfd_create("pce_ram", MFD_CLOEXEC);
+  if (fd < 0 || ftruncate(fd, static_cast<off_t>(m_ram_size)) != 0)
+  {
+    Log_ErrorPrintf("Failed to create shared memory for RAM, fastmem will not be available");
+    if (fd >= 0)
+      close(fd);
+    return false;
+  }
+
+  // Copy the current contents, then replace the anonymous mapping so the page RAM pointers stay valid.
+  void* temp = mmap(nullptr, m_ram_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (temp == MAP_FAILED)
+  {
+    Log_ErrorPrintf("Failed to map shared memory for RAM, fastmem will not be available");
+    close(fd);
+    return false;
+  }
+  std::memcpy(temp, m_ram_ptr, m_ram_size);
+  munmap(temp, m_ram_size);
+
+  if (mmap(m_ram_ptr, m_ram_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+  {
+    Log_ErrorPrintf("Failed to remap RAM to shared memory, fastmem will not be available");
+    close(fd);
+    return false;
+  }
+
+  m_ram_fd = fd;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void Bus::DisableFastmem()
+{
+#ifdef ENABLE_FASTMEM
+  if (!m_fastmem_base)
+    return;
+
+  munmap(m_fastmem_base, FASTMEM_WINDOW_SIZE);
+  m_fastmem_base = nullptr;
+#endif
+}
+
+void Bus::MapFastmemPage(u32 page_number)
+{
+#ifdef ENABLE_FASTMEM
+  const PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  if (!m_fastmem_base || !page.ram_ptr)
+    return;
+
+  // Mirrored pages share the same offset in the file as the source page.
+  byte* view_ptr = m_fastmem_base + static_cast<size_t>(page_number) * MEMORY_PAGE_SIZE;
+  const off_t file_offset = static_cast<off_t>(page.ram_ptr - m_ram_ptr);
+  if (mmap(view_ptr, MEMORY_PAGE_SIZE, GetFastmemPageProtection(page), MAP_SHARED | MAP_FIXED, m_ram_fd,
+           file_offset) == MAP_FAILED)
+  {
+    Panic("Failed to map page into fastmem view");
+  }
+#endif
+}
+
+void Bus::UpdateFastmemPageProtection(u32 page_number)
+{
+#ifdef ENABLE_FASTMEM
+  const PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  if (!m_fastmem_base || !page.ram_ptr)
+    return;
+
+  byte* view_ptr = m_fastmem_base + static_cast<size_t>(page_number) * MEMORY_PAGE_SIZE;
+  if (mprotect(view_ptr, MEMORY_PAGE_SIZE, GetFastmemPageProtection(page)) != 0)
+    Panic("Failed to change fastmem page protection");
+#endif
+}
+
 void Bus::Stall(SimulationTime time)
 {
   Log_DebugPrintf("Stalling bus for %" PRId64 " ns", time);
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <cstring>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 
 #include "YBaseLib/Barrier.h"
@@ -15,6 +16,11 @@
 #include "pce/mmio.h"
 #include "pce/types.h"
 
+// Map physical RAM into a reserved host address range for the recompiler?
+#if defined(Y_PLATFORM_LINUX) && defined(Y_CPU_X64)
+#define ENABLE_FASTMEM 1
+#endif
+
 class StateWrapper;
 class TimingManager;
 
@@ -26,16 +32,31 @@ class Bus : public Object
 
 public:
   using CodeHashType = u64;
-  using CodeInvalidateCallback = std::function<void(PhysicalMemoryAddress)>;
+  using CodeInvalidateCallback = std::function<void(PhysicalMemoryAddress address, u32 size)>;
+  using PageMappingChangeCallback = std::function<void(PhysicalMemoryAddress page_address, const byte* ram_ptr)>;
+  using WriteWatchCallback = std::function<void(PhysicalMemoryAddress address, u32 size)>;
 
   static constexpr u32 MEMORY_PAGE_SIZE = 0x1000; // 4KiB
   static constexpr u32 MEMORY_PAGE_NUMBER_SHIFT = 12;
+
+  // Passed to the page mapping change callback when more than one page may have changed.
+  static constexpr PhysicalMemoryAddress ALL_PAGES_CHANGED = 0xFFFFFFFF;
   static constexpr u32 MEMORY_PAGE_OFFSET_MASK = PhysicalMemoryAddress(MEMORY_PAGE_SIZE - 1);
   static constexpr u32 MEMORY_PAGE_MASK = ~MEMORY_PAGE_OFFSET_MASK;
   static constexpr u32 NUM_IOPORTS = 0x10000;
+  static constexpr u64 FASTMEM_WINDOW_SIZE = u64(1) << 32;
 
   static constexpr u32 GetMemoryPageIndex(PhysicalMemoryAddress address) { return address >> MEMORY_PAGE_NUMBER_SHIFT; }
 
+  // Code is tracked in 64-byte chunks within each page, so writes to data sharing a page with code don't invalidate it.
+  static constexpr u32 CODE_BITMAP_CHUNK_SHIFT = 6;
+  static constexpr u64 GetCodeBitmapMask(u32 page_offset, u32 size)
+  {
+    const u32 first_chunk = page_offset >> CODE_BITMAP_CHUNK_SHIFT;
+    const u32 num_chunks = ((page_offset + size - 1) >> CODE_BITMAP_CHUNK_SHIFT) - first_chunk + 1;
+    return ((num_chunks >= 64) ? ~u64(0) : ((u64(1) << num_chunks) - 1)) << first_chunk;
+  }
+
   Bus(u32 memory_address_bits, const ObjectTypeInfo* type_info = &s_type_info);
   ~Bus();
 
@@ -44,7 +65,7 @@ public:
   virtual bool DoState(StateWrapper& sw);
 
   PhysicalMemoryAddress GetMemoryAddressMask() const { return m_physical_memory_address_mask; }
-  void SetMemoryAddressMask(PhysicalMemoryAddress mask) { m_physical_memory_address_mask = mask; }
+  void SetMemoryAddressMask(PhysicalMemoryAddress mask);
   u32 GetMemoryPageCount() const { return m_num_physical_memory_pages; }
   u32 GetUnassignedRAMSize() const { return m_ram_size - m_ram_assigned; }
 
@@ -75,6 +96,14 @@ public:
   using IOPortWriteWordHandler = std::function<void(u16 port, u16 value)>;
   using IOPortWriteDWordHandler = std::function<void(u16 port, u32 value)>;
 
+  // Devirtualized IO port handlers, which are passed the context pointer they were connected with.
+  using IOPortReadByteFunction = u8 (*)(void* context, u16 port);
+  using IOPortReadWordFunction = u16 (*)(void* context, u16 port);
+  using IOPortReadDWordFunction = u32 (*)(void* context, u16 port);
+  using IOPortWriteByteFunction = void (*)(void* context, u16 port, u8 value);
+  using IOPortWriteWordFunction = void (*)(void* context, u16 port, u16 value);
+  using IOPortWriteDWordFunction = void (*)(void* context, u16 port, u32 value);
+
   // IO port connections
   void ConnectIOPortRead(u16 port, const void* owner, IOPortReadByteHandler read_callback);
   void ConnectIOPortWrite(u16 port, const void* owner, IOPortWriteByteHandler write_callback);
@@ -88,10 +117,23 @@ public:
   void ConnectIOPortWriteWord(u16 port, const void* owner, IOPortWriteWordHandler write_callback);
   void ConnectIOPortWriteDWord(u16 port, const void* owner, IOPortWriteDWordHandler write_callback);
 
+  // Function pointer connections, which skip the std::function call. Preferred for frequently-accessed ports.
+  void ConnectIOPortRead(u16 port, const void* owner, IOPortReadByteFunction read_function, void* context);
+  void ConnectIOPortReadWord(u16 port, const void* owner, IOPortReadWordFunction read_function, void* context);
+  void ConnectIOPortReadDWord(u16 port, const void* owner, IOPortReadDWordFunction read_function, void* context);
+  void ConnectIOPortWrite(u16 port, const void* owner, IOPortWriteByteFunction write_function, void* context);
+  void ConnectIOPortWriteWord(u16 port, const void* owner, IOPortWriteWordFunction write_function, void* context);
+  void ConnectIOPortWriteDWord(u16 port, const void* owner, IOPortWriteDWordFunction write_function, void* context);
+
   // Connecting an IO port to a single variable
   void ConnectIOPortReadToPointer(u16 port, const void* owner, const u8* var);
   void ConnectIOPortWriteToPointer(u16 port, const void* owner, u8* var);
 
+  // Marks reads of a connected port as idle - the value only changes when a device event runs, and reading it again
+  // has no side effects. The CPU can skip ahead to the next event when a loop only polls idle ports.
+  void SetIOPortReadIdle(u16 port, const void* owner, bool idle = true);
+  bool IsIOPortReadIdle(u16 port) const { return m_ioport_idle_reads[port]; }
+
   // IO port handler accessors (mainly for CPU)
   u8 ReadIOPortByte(u16 port);
   u16 ReadIOPortWord(u16 port);
@@ -100,6 +142,11 @@ public:
   void WriteIOPortWord(u16 port, u16 value);
   void WriteIOPortDWord(u16 port, u32 value);
 
+  // IO port profiling - counts accesses and the host time spent in the handlers of each port.
+  bool IsIOPortProfilingEnabled() const { return static_cast<bool>(m_ioport_profile); }
+  void SetIOPortProfilingEnabled(bool enabled);
+  void DumpIOPortProfile(u32 count);
+
   // Reads/writes memory. Words must be within the same 4KiB page.
   // Reads of unmapped memory return -1.
   template<typename T>
@@ -148,14 +195,34 @@ public:
 
   // Hashes a block of code for use in backend code caches.
   CodeHashType GetCodeHash(PhysicalMemoryAddress address, u32 length);
-  void MarkPageAsCode(PhysicalMemoryAddress address);
+
+  // Marks the chunks of a page in code_bitmap (see GetCodeBitmapMask) as containing code.
+  void MarkPageAsCode(PhysicalMemoryAddress address, u64 code_bitmap = ~u64(0));
   void UnmarkPageAsCode(PhysicalMemoryAddress address);
   void ClearPageCodeFlags();
 
-  // Code invalidate callback - executed when pages marked as code are modified.
+  // Replaces the code chunks of a page which is marked as code. Unmarks the page if the bitmap is zero.
+  void SetPageCodeBitmap(PhysicalMemoryAddress address, u64 code_bitmap);
+
+  // Code invalidate callback - executed when code in pages marked as code is modified.
   void SetCodeInvalidationCallback(CodeInvalidateCallback callback);
   void ClearCodeInvalidationCallback();
 
+  // Page mapping change callback - executed when the RAM pointer of a page changes, e.g. RAM state changes, or pages
+  // being marked/unmarked as code. The callback receives the page address and the RAM backing the page, or
+  // ALL_PAGES_CHANGED and null for mirroring, address mask changes and other changes to many pages. Pointers obtained
+  // through GetRAMPagePointer() for the changed pages should not be used after this is called.
+  void SetPageMappingChangeCallback(PageMappingChangeCallback callback);
+  void ClearPageMappingChangeCallback();
+
+  // Write watches - writes which modify a watched RAM page go through the bus and execute the write watch callback.
+  // Used by the CPU to detect changes to paging structures.
+  void WatchPageWrites(PhysicalMemoryAddress address);
+  void UnwatchPageWrites(PhysicalMemoryAddress address);
+  void ClearPageWriteWatches();
+  void SetWriteWatchCallback(WriteWatchCallback callback);
+  void ClearWriteWatchCallback();
+
   // Change page types.
   void SetPageRAMState(PhysicalMemoryAddress page_address, bool readable_memory, bool writable_memory);
   void SetPagesRAMState(PhysicalMemoryAddress start_address, u32 size, bool readable_memory, bool writable_memory);
@@ -170,6 +237,24 @@ public:
     return m_physical_memory_page_ram_index[(address & m_physical_memory_address_mask) >> MEMORY_PAGE_NUMBER_SHIFT];
   }
 
+  // Gets the RAM backing a page, even if it can't be accessed directly (e.g. it contains code). Null for MMIO/ROM.
+  // This is the pointer passed to the page mapping change callback.
+  const byte* GetRAMPageBacking(PhysicalMemoryAddress address) const
+  {
+    return m_physical_memory_pages[(address & m_physical_memory_address_mask) >> MEMORY_PAGE_NUMBER_SHIFT].ram_ptr;
+  }
+
+  // Fastmem - maps RAM pages into a 4GiB host address range at their physical addresses. MMIO pages are left
+  // inaccessible, and pages containing code are read-only, so accesses to them fault and have to be handled.
+  bool EnableFastmem();
+  void DisableFastmem();
+  byte* GetFastmemBase() const { return m_fastmem_base; }
+  bool IsFastmemAddress(const void* ptr) const
+  {
+    return (m_fastmem_base && static_cast<const byte*>(ptr) >= m_fastmem_base &&
+            static_cast<const byte*>(ptr) < (m_fastmem_base + FASTMEM_WINDOW_SIZE));
+  }
+
 public:
   struct PhysicalMemoryPage
   {
@@ -179,16 +264,19 @@ public:
       kWritableRAM = 2,
       kCachedCode = 4,
       kMirror = 8,
+      kWriteWatch = 16,
     };
 
     byte* ram_ptr;
     MMIO* mmio_handler;
+    u64 code_bitmap;
     u8 type;
 
     bool IsReadableRAM() const { return (type & kReadableRAM) != 0; }
     bool IsWritableRAM() const { return (type & kWritableRAM) != 0; }
     bool HasCachedCode() const { return (type & kCachedCode) != 0; }
     bool IsMirror() const { return (type & kMirror) != 0; }
+    bool IsWriteWatched() const { return (type & kWriteWatch) != 0; }
     bool IsMMIO() const { return (mmio_handler != nullptr); }
     bool IsReadableMMIO() const { return IsMMIO() && !IsReadableRAM(); }
     bool IsWritableMMIO() const { return IsMMIO() && !IsWritableRAM(); }
@@ -198,10 +286,26 @@ public:
     }
   };
 
+  template<typename F>
+  struct IOPortHandler
+  {
+    F function;
+    void* context;
+  };
+
   struct IOPortConnection
   {
     const void* owner;
     IOPortConnection* next;
+    IOPortHandler<IOPortReadByteFunction> read_byte;
+    IOPortHandler<IOPortReadWordFunction> read_word;
+    IOPortHandler<IOPortReadDWordFunction> read_dword;
+    IOPortHandler<IOPortWriteByteFunction> write_byte;
+    IOPortHandler<IOPortWriteWordFunction> write_word;
+    IOPortHandler<IOPortWriteDWordFunction> write_dword;
+    bool idle_read;
+
+    // Handlers connected as std::function are called through the function pointers above.
     IOPortReadByteHandler read_byte_handler;
     IOPortReadWordHandler read_word_handler;
     IOPortReadDWordHandler read_dword_handler;
@@ -210,6 +314,12 @@ public:
     IOPortWriteDWordHandler write_dword_handler;
   };
 
+  struct IOPortProfile
+  {
+    u64 access_count;
+    u64 time;
+  };
+
   void AllocateMemoryPages(u32 memory_address_bits);
 
   template<typename T>
@@ -217,6 +327,20 @@ public:
   static bool IsCachablePage(const PhysicalMemoryPage& page);
   static bool IsWritablePage(const PhysicalMemoryPage& page);
 
+  // Updates the RAM pointer index for a page after its type changes. Returns true if the pointer changed.
+  bool UpdatePageRAMPointer(u32 page_number);
+
+  // Invokes the page mapping change callback, for a single page or for all pages.
+  void NotifyPageMappingChange(u32 page_number);
+  void NotifyPageMappingChange();
+
+  // Fastmem view updates, called when the RAM assignment or page type changes.
+  void MapFastmemPage(u32 page_number);
+  void UpdateFastmemPageProtection(u32 page_number);
+
+  // Moves RAM to a shared memory file at the same address, so that it can be mapped into the fastmem view.
+  bool CreateSharedRAM();
+
   // Generic memory read/write handler
   template<typename T, bool aligned>
   bool ReadMemoryT(PhysicalMemoryAddress address, T* value);
@@ -231,6 +355,22 @@ public:
   IOPortConnection* CreateIOPortConnection(u16 port, const void* owner);
   void RemoveIOPortConnection(u16 port, const void* owner);
 
+  // Rebuilds the dispatch table entries of a port, after its connections change.
+  void UpdateIOPortDispatch(u16 port);
+
+  // Dispatch table entries for unconnected, split and shared ports. The context is the bus.
+  static u8 ReadUnconnectedIOPortByte(void* context, u16 port);
+  static u16 ReadIOPortWordAsBytes(void* context, u16 port);
+  static u32 ReadIOPortDWordAsWords(void* context, u16 port);
+  static void WriteUnconnectedIOPortByte(void* context, u16 port, u8 value);
+  static void WriteIOPortWordAsBytes(void* context, u16 port, u16 value);
+  static void WriteIOPortDWordAsWords(void* context, u16 port, u32 value);
+  static void WriteSharedIOPortByte(void* context, u16 port, u8 value);
+  static void WriteSharedIOPortWord(void* context, u16 port, u16 value);
+  static void WriteSharedIOPortDWord(void* context, u16 port, u32 value);
+
+  void AddIOPortProfileSample(u16 port, u64 start_time);
+
   System* m_system = nullptr;
 
   // System memory map
@@ -245,15 +385,38 @@ public:
   IOPortConnection** m_ioport_handlers = nullptr;
   std::unordered_map<const void*, std::vector<u16>> m_ioport_owners;
 
+  // Flat dispatch tables, indexed by port. The connection lists are only walked for ports with several writers.
+  std::unique_ptr<IOPortHandler<IOPortReadByteFunction>[]> m_ioport_read_byte_handlers;
+  std::unique_ptr<IOPortHandler<IOPortReadWordFunction>[]> m_ioport_read_word_handlers;
+  std::unique_ptr<IOPortHandler<IOPortReadDWordFunction>[]> m_ioport_read_dword_handlers;
+  std::unique_ptr<IOPortHandler<IOPortWriteByteFunction>[]> m_ioport_write_byte_handlers;
+  std::unique_ptr<IOPortHandler<IOPortWriteWordFunction>[]> m_ioport_write_word_handlers;
+  std::unique_ptr<IOPortHandler<IOPortWriteDWordFunction>[]> m_ioport_write_dword_handlers;
+  std::unique_ptr<bool[]> m_ioport_idle_reads;
+
+  // Per-port access counts and handler time, only allocated while profiling.
+  std::unique_ptr<IOPortProfile[]> m_ioport_profile;
+
   // Code invalidate callback - executed when pages marked as code are modified.
   CodeInvalidateCallback m_code_invalidate_callback;
 
+  // Page mapping change callback - executed when the RAM pointer index is modified.
+  PageMappingChangeCallback m_page_mapping_change_callback;
+
+  // Write watch callback - executed when watched pages are modified.
+  WriteWatchCallback m_write_watch_callback;
+
   // Amount of RAM allocated overall
   // Do not access this pointer directly
   byte* m_ram_ptr = nullptr;
   u32 m_ram_size = 0;
   u32 m_ram_assigned = 0;
 
+  // When fastmem is enabled, RAM is backed by a shared memory file so it can be mapped a second time.
+  int m_ram_fd = -1;
+  bool m_ram_mapped = false;
+  byte* m_fastmem_base = nullptr;
+
   // List of ROM regions allocated.
   // This does not include mirrors.
   struct ROMRegion
@@ -75,7 +75,10 @@ void Bus::WriteMemoryTyped(PhysicalMemoryAddress address, T value)
   PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
   if (page.type & PhysicalMemoryPage::kWritableRAM)
   {
-    if (!(page.type & PhysicalMemoryPage::kCachedCode))
+    const bool watched = (page.type & PhysicalMemoryPage::kWriteWatch) != 0;
+    const bool code = (page.type & PhysicalMemoryPage::kCachedCode) != 0 &&
+                      (page.code_bitmap & GetCodeBitmapMask(page_offset, sizeof(value))) != 0;
+    if (!watched && !code)
     {
       std::memcpy(page.ram_ptr + page_offset, &value, sizeof(value));
       return;
@@ -87,9 +90,12 @@ void Bus::WriteMemoryTyped(PhysicalMemoryAddress address, T value)
       return;
     }
 
-    // Copy value in and fire callback.
+    // Copy value in and fire callbacks.
     std::memcpy(page.ram_ptr + page_offset, &value, sizeof(value));
-    m_code_invalidate_callback(address & MEMORY_PAGE_MASK);
+    if (watched)
+      m_write_watch_callback(address, sizeof(value));
+    if (code)
+      m_code_invalidate_callback(address, sizeof(value));
     return;
   }
 
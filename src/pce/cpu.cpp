@@ -1,5 +1,6 @@
 #include "cpu.h"
 #include "common/state_wrapper.h"
+#include <algorithm>
 
 DEFINE_OBJECT_TYPE_INFO(CPU);
 BEGIN_OBJECT_PROPERTY_MAP(CPU)
@@ -24,6 +25,7 @@ void CPU::Reset()
   BaseClass::Reset();
   m_pending_cycles = 0;
   m_execution_downcount = 0;
+  m_partial_time = 0;
 }
 
 bool CPU::DoState(StateWrapper& sw)
@@ -33,6 +35,7 @@ bool CPU::DoState(StateWrapper& sw)
 
   sw.Do(&m_pending_cycles);
   sw.Do(&m_execution_downcount);
+  sw.Do(&m_partial_time);
 
   double frequency = m_frequency;
   sw.Do(&frequency);
@@ -57,15 +60,18 @@ void CPU::SetFrequency(float frequency)
 
 void CPU::SetExecutionDowncount(SimulationTime time_downcount)
 {
-  m_execution_downcount = static_cast<CycleCount>(static_cast<float>(time_downcount) * m_rcp_cycle_period);
-  if ((static_cast<SimulationTime>(m_execution_downcount) * m_cycle_period) < time_downcount)
-    m_execution_downcount++;
+  // Round up, so that at least time_downcount has passed once the downcount reaches zero. Any partial nanosecond
+  // from the last commit counts towards the time.
+  const SimulationTicks ticks = SimulationTimeToTicks(time_downcount) - m_partial_time;
+  m_execution_downcount = std::max<CycleCount>((ticks + m_cycle_period - 1) / m_cycle_period, 0);
 }
 
 void CPU::SetIRQState(bool state) {}
 
 void CPU::SignalNMI() {}
 
+void CPU::DumpBlockProfile(u32 count) {}
+
 DebuggerInterface* CPU::GetDebuggerInterface()
 {
   return nullptr;
@@ -84,6 +90,9 @@ const char* CPU::BackendTypeToString(BackendType type)
     case BackendType::Recompiler:
       return "Recompiler";
 
+    case BackendType::TieredRecompiler:
+      return "Tiered Recompiler";
+
     default:
       return "Unknown";
   }
@@ -91,6 +100,5 @@ const char* CPU::BackendTypeToString(BackendType type)
 
 void CPU::UpdateCyclePeriod()
 {
-  m_cycle_period = static_cast<float>(double(1000000000) / double(m_frequency));
-  m_rcp_cycle_period = static_cast<float>(1.0 / (double(1000000000) / double(m_frequency)));
+  m_cycle_period = std::max<SimulationTicks>(FrequencyToCyclePeriodTicks(m_frequency), 1);
 }
@@ -14,7 +14,8 @@ public:
   {
     Interpreter,
     CachedInterpreter,
-    Recompiler
+    Recompiler,
+    TieredRecompiler
   };
 
   struct ExecutionStats
@@ -26,6 +27,15 @@ public:
     u64 num_code_cache_blocks;
     u64 code_cache_blocks_executed;
     u64 code_cache_instructions_executed;
+    u64 code_cache_size;
+    u64 code_cache_regions_evicted;
+    u64 code_cache_blocks_evicted;
+    u64 code_cache_blocks_invalidated;
+    u64 tlb_hits;
+    u64 tlb_misses;
+    u64 tlb_flushes;
+    u64 tlb_address_space_reuses;
+    u64 idle_cycles_skipped;
   };
 
   CPU(const String& identifier, float frequency, BackendType backend_type,
@@ -43,8 +53,8 @@ public:
   float GetFrequency() const { return m_frequency; }
   void SetFrequency(float frequency);
 
-  /// Returns the cycle period (amount of time for each tick).
-  float GetCyclePeriod() const { return m_cycle_period; }
+  /// Returns the cycle period (amount of time for each clock tick), in fixed-point simulation ticks.
+  SimulationTicks GetCyclePeriod() const { return m_cycle_period; }
 
   /// Updates the downcount, or how long the CPU can execute for before running events.
   void SetExecutionDowncount(SimulationTime time_downcount);
@@ -72,6 +82,9 @@ public:
   // Reads stats from CPU.
   virtual void GetExecutionStats(ExecutionStats* stats) const = 0;
 
+  // Logs the most expensive guest code blocks, for backends with a block profiler.
+  virtual void DumpBlockProfile(u32 count);
+
   // Backend to string.
   static const char* BackendTypeToString(BackendType type);
 
@@ -89,9 +102,11 @@ protected:
   // Number of cycles per second.
   float m_frequency;
 
-  // Time for each cycle.
-  float m_cycle_period = 0.0f;
-  float m_rcp_cycle_period = 0.0f;
+  // Time for each cycle, in fixed-point ticks.
+  SimulationTicks m_cycle_period = 0;
+
+  // Fraction of a nanosecond which has been executed but not yet added to the simulation time.
+  SimulationTicks m_partial_time = 0;
 
   // Currently-active backend type.
   BackendType m_backend_type;
@@ -0,0 +1,321 @@
+#include "pce/cpu_8086/cached_interpreter_backend.h"
+#include "YBaseLib/Log.h"
+#include "pce/cpu_8086/decoder.h"
+#include "pce/system.h"
+#include <algorithm>
+#include <cstring>
+Log_SetChannel(CPU_8086::CachedInterpreterBackend);
+
+namespace CPU_8086 {
+
+CachedInterpreterBackend::CachedInterpreterBackend(CPU* cpu)
+  : m_cpu(cpu), m_system(cpu->GetSystem()), m_bus(cpu->GetBus())
+{
+  m_physical_page_blocks = std::make_unique<PODArray<Block*>[]>(m_bus->GetMemoryPageCount());
+  m_bus->SetCodeInvalidationCallback(std::bind(&CachedInterpreterBackend::InvalidateBlocksWithPhysicalRange, this,
+                                               std::placeholders::_1, std::placeholders::_2));
+}
+
+CachedInterpreterBackend::~CachedInterpreterBackend()
+{
+  for (const auto& it : m_blocks)
+    delete it.second;
+
+  m_bus->ClearCodeInvalidationCallback();
+  m_bus->ClearPageCodeFlags();
+}
+
+void CachedInterpreterBackend::Execute()
+{
+  // Aborted instructions jump back to CPU::Execute, which calls us again. Clean up the block which was executing.
+  if (m_current_block)
+  {
+    if (m_current_block->destroy_pending)
+      delete m_current_block;
+    m_current_block = nullptr;
+  }
+
+  while (m_system->ShouldRunCPU())
+  {
+    // If we're halted, don't even bother looking up blocks.
+    if (m_cpu->m_halted)
+    {
+      m_cpu->m_pending_cycles += m_cpu->m_execution_downcount;
+      m_cpu->m_execution_downcount = 0;
+      m_cpu->CommitPendingCycles();
+      m_system->RunEvents();
+      continue;
+    }
+
+    while (m_cpu->m_execution_downcount > 0)
+    {
+      // Check for external interrupts.
+      if (m_cpu->HasExternalInterrupt())
+        m_cpu->DispatchExternalInterrupt();
+
+      Block* block = GetNextBlock();
+      if (!block)
+      {
+        // No block could be compiled for this address, fall back to the interpreter for one instruction.
+        m_cpu->ExecuteInstruction();
+        m_cpu->CommitPendingCycles();
+        continue;
+      }
+
+      m_current_block = block;
+      ExecuteBlock(block);
+      m_current_block = nullptr;
+      m_cpu->CommitPendingCycles();
+
+      // The cache may have been flushed by an instruction in the block.
+      if (block->destroy_pending)
+        delete block;
+    }
+
+    // Run events if needed.
+    m_system->RunEvents();
+  }
+}
+
+void CachedInterpreterBackend::FlushCodeCache()
+{
+  for (u32 i = 0; i < m_bus->GetMemoryPageCount(); i++)
+    m_physical_page_blocks[i].Clear();
+
+  // Prevent the current block from being destroyed while it is executing.
+  for (const auto& it : m_blocks)
+  {
+    if (it.second == m_current_block)
+      it.second->destroy_pending = true;
+    else
+      delete it.second;
+  }
+
+  m_blocks.clear();
+  m_bus->ClearPageCodeFlags();
+}
+
+bool CachedInterpreterBackend::IsExitBlockInstruction(const Instruction* instruction)
+{
+  switch (instruction->operation)
+  {
+    case Operation_JMP_Near:
+    case Operation_JMP_Far:
+    case Operation_LOOP:
+    case Operation_Jcc:
+    case Operation_JCXZ:
+    case Operation_CALL_Near:
+    case Operation_CALL_Far:
+    case Operation_RET_Near:
+    case Operation_RET_Far:
+    case Operation_INT:
+    case Operation_INTO:
+    case Operation_IRET:
+    case Operation_HLT:
+      return true;
+
+    // Interrupts and the trap flag are only checked between blocks, so changes to IF/TF should end the block.
+    case Operation_STI:
+    case Operation_POPF:
+      return true;
+
+    // Loading CS changes where the following instructions are fetched from.
+    case Operation_POP_Sreg:
+      return (instruction->operands[0].segreg == Segment_CS);
+
+    case Operation_MOV_Sreg:
+      return (instruction->operands[0].mode == OperandMode_ModRM_SegmentReg &&
+              (instruction->data.GetModRM_Reg() & 3) == Segment_CS);
+
+    default:
+      return false;
+  }
+}
+
+CachedInterpreterBackend::Block* CachedInterpreterBackend::GetNextBlock()
+{
+  // Single-stepping is left to the interpreter.
+  if (m_cpu->m_registers.FLAGS.TF)
+    return nullptr;
+
+  const PhysicalMemoryAddress address =
+    m_cpu->CalculateLinearAddress(Segment_CS, m_cpu->m_registers.IP) & m_bus->GetMemoryAddressMask();
+  auto iter = m_blocks.find(address);
+  if (iter != m_blocks.end())
+    return CanExecuteBlock(iter->second) ? iter->second : nullptr;
+
+  Block* block = new Block();
+  block->physical_address = address;
+  if (!CompileBlock(block))
+  {
+    Log_DebugPrintf("Failed to compile block %05X", address);
+    delete block;
+    return nullptr;
+  }
+
+  m_blocks.emplace(address, block);
+  AddBlockPhysicalMapping(block);
+  return block;
+}
+
+bool CachedInterpreterBackend::CompileBlock(Block* block)
+{
+  // Blocks are contiguous in physical memory, so they can't cross a page or wrap around the end of the segment.
+  const u32 page_offset = block->physical_address & Bus::MEMORY_PAGE_OFFSET_MASK;
+  const u32 max_length = std::min(Bus::MEMORY_PAGE_SIZE - page_offset, 0x10000u - ZeroExtend32(m_cpu->m_registers.IP));
+
+  PhysicalMemoryAddress fetch_address = block->physical_address;
+  auto fetchb = [this, &fetch_address](u8* val) {
+    *val = m_bus->ReadMemoryByte(fetch_address++);
+    return true;
+  };
+  auto fetchw = [this, &fetch_address](u16* val) {
+    const u8 lsb = m_bus->ReadMemoryByte(fetch_address++);
+    const u8 msb = m_bus->ReadMemoryByte(fetch_address++);
+    *val = ZeroExtend16(lsb) | (ZeroExtend16(msb) << 8);
+    return true;
+  };
+
+  while (block->entries.size() < MAX_BLOCK_INSTRUCTIONS)
+  {
+    Instruction instruction;
+    fetch_address = block->physical_address + block->code_length;
+    if (!Decoder::DecodeInstruction(&instruction, m_cpu->m_registers.IP + block->code_length, fetchb, fetchw) ||
+        (block->code_length + instruction.length) > max_length)
+    {
+      break;
+    }
+
+    CPU::InstructionHandler handler = CPU::GetInstructionHandler(&instruction);
+    if (!handler)
+    {
+      Log_WarningPrintf("No handler for instruction at %05X", block->physical_address + block->code_length);
+      break;
+    }
+
+    block->entries.push_back({handler, instruction.data, instruction.length});
+    block->code_length += instruction.length;
+    if (IsExitBlockInstruction(&instruction))
+      break;
+  }
+
+  if (block->entries.empty())
+    return false;
+
+  block->code_hash = m_bus->GetCodeHash(block->physical_address, block->code_length);
+  return true;
+}
+
+bool CachedInterpreterBackend::CanExecuteBlock(Block* block)
+{
+  // If the block is invalidated, we should check if the code changed.
+  if (block->invalidated)
+  {
+    if (m_bus->GetCodeHash(block->physical_address, block->code_length) != block->code_hash)
+    {
+      Log_DebugPrintf("Block %05X is invalidated - hash mismatch, recompiling", block->physical_address);
+      block->entries.clear();
+      block->code_length = 0;
+      if (!CompileBlock(block))
+      {
+        FlushBlock(block);
+        return false;
+      }
+    }
+
+    block->invalidated = false;
+    AddBlockPhysicalMapping(block);
+  }
+
+  // The same physical address can be reached through a CS:IP which wraps around within the block.
+  return (ZeroExtend32(m_cpu->m_registers.IP) + block->code_length) <= 0x10000u;
+}
+
+void CachedInterpreterBackend::ExecuteBlock(Block* block)
+{
+  m_cpu->m_execution_stats.code_cache_blocks_executed++;
+  for (const Block::Entry& entry : block->entries)
+  {
+    m_cpu->m_current_IP = m_cpu->m_registers.IP;
+    m_cpu->m_registers.IP += entry.length;
+    m_cpu->m_execution_stats.code_cache_instructions_executed++;
+    std::memcpy(&m_cpu->idata, &entry.data, sizeof(m_cpu->idata));
+    entry.handler(m_cpu);
+
+    // Self-modifying code - the remaining entries may be stale, so decode them again.
+    if (block->invalidated)
+      break;
+  }
+
+  // The prefetch queue was not consumed by the block, so its contents no longer follow IP.
+  m_cpu->FlushPrefetchQueue();
+}
+
+void CachedInterpreterBackend::FlushBlock(Block* block)
+{
+  m_blocks.erase(block->physical_address);
+  if (!block->invalidated)
+    RemoveBlockPhysicalMapping(block);
+
+  if (block == m_current_block)
+    block->destroy_pending = true;
+  else
+    delete block;
+}
+
+void CachedInterpreterBackend::InvalidateBlocksWithPhysicalRange(PhysicalMemoryAddress address, u32 size)
+{
+  PODArray<Block*>& block_list = m_physical_page_blocks[Bus::GetMemoryPageIndex(address)];
+  if (block_list.IsEmpty())
+    return;
+
+  // Find the blocks overlapping the modified range, and the code which remains in the page.
+  const PhysicalMemoryAddress page_address = address & Bus::MEMORY_PAGE_MASK;
+  const u32 start_offset = address & Bus::MEMORY_PAGE_OFFSET_MASK;
+  const u32 end_offset = start_offset + size;
+  PODArray<Block*> invalidated_blocks;
+  u64 remaining_code_bitmap = 0;
+  for (Block* block : block_list)
+  {
+    const u32 block_start_offset = block->physical_address & Bus::MEMORY_PAGE_OFFSET_MASK;
+    const u32 block_end_offset = block_start_offset + block->code_length;
+    if (block_start_offset < end_offset && start_offset < block_end_offset)
+      invalidated_blocks.Add(block);
+    else
+      remaining_code_bitmap |= Bus::GetCodeBitmapMask(block_start_offset, block->code_length);
+  }
+
+  // The write can hit a chunk shared by code and data without touching the code itself.
+  if (invalidated_blocks.IsEmpty())
+    return;
+
+  // Invalidated blocks are kept, so that they can be revalidated by hash if the code is written back unchanged.
+  for (Block* block : invalidated_blocks)
+  {
+    Log_DebugPrintf("Invalidating block %05X", block->physical_address);
+    block->invalidated = true;
+    RemoveBlockPhysicalMapping(block);
+  }
+
+  if (!block_list.IsEmpty())
+    m_bus->SetPageCodeBitmap(page_address, remaining_code_bitmap);
+
+  m_cpu->m_execution_stats.code_cache_blocks_invalidated += invalidated_blocks.GetSize();
+}
+
+void CachedInterpreterBackend::AddBlockPhysicalMapping(Block* block)
+{
+  const u32 page_offset = block->physical_address & Bus::MEMORY_PAGE_OFFSET_MASK;
+  m_physical_page_blocks[Bus::GetMemoryPageIndex(block->physical_address)].Add(block);
+  m_bus->MarkPageAsCode(block->physical_address, Bus::GetCodeBitmapMask(page_offset, block->code_length));
+}
+
+void CachedInterpreterBackend::RemoveBlockPhysicalMapping(Block* block)
+{
+  PODArray<Block*>& block_list = m_physical_page_blocks[Bus::GetMemoryPageIndex(block->physical_address)];
+  block_list.FastRemoveItem(block);
+  if (block_list.IsEmpty())
+    m_bus->UnmarkPageAsCode(block->physical_address);
+}
+
+} // namespace CPU_8086
@@ -0,0 +1,70 @@
+#pragma once
+#include "YBaseLib/PODArray.h"
+#include "pce/bus.h"
+#include "pce/cpu_8086/cpu.h"
+#include "pce/cpu_8086/instruction.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace CPU_8086 {
+
+/// Executes pre-decoded blocks of instructions, keyed by the physical address of CS:IP. Instructions are fetched and
+/// decoded once when the block is compiled, so the prefetch queue is bypassed entirely. Blocks never cross a page or
+/// an IP wraparound, and are invalidated through the bus code flags when the memory they were decoded from changes.
+class CachedInterpreterBackend
+{
+public:
+  CachedInterpreterBackend(CPU* cpu);
+  ~CachedInterpreterBackend();
+
+  size_t GetCodeBlockCount() const { return m_blocks.size(); }
+
+  void Execute();
+  void FlushCodeCache();
+
+private:
+  // Upper bound on instructions per block, so that interrupts are still checked regularly.
+  static constexpr u32 MAX_BLOCK_INSTRUCTIONS = 64;
+
+  struct Block
+  {
+    struct Entry
+    {
+      CPU::InstructionHandler handler;
+      InstructionData data;
+      u8 length;
+    };
+
+    PhysicalMemoryAddress physical_address;
+    u32 code_length = 0;
+    Bus::CodeHashType code_hash = 0;
+    bool invalidated = false;
+    bool destroy_pending = false;
+    std::vector<Entry> entries;
+  };
+
+  static bool IsExitBlockInstruction(const Instruction* instruction);
+
+  Block* GetNextBlock();
+  bool CompileBlock(Block* block);
+  bool CanExecuteBlock(Block* block);
+  void ExecuteBlock(Block* block);
+  void FlushBlock(Block* block);
+
+  void InvalidateBlocksWithPhysicalRange(PhysicalMemoryAddress address, u32 size);
+  void AddBlockPhysicalMapping(Block* block);
+  void RemoveBlockPhysicalMapping(Block* block);
+
+  CPU* m_cpu;
+  System* m_system;
+  Bus* m_bus;
+
+  std::unordered_map<PhysicalMemoryAddress, Block*> m_blocks;
+  std::unique_ptr<PODArray<Block*>[]> m_physical_page_blocks;
+
+  // Block being executed, which can't be destroyed until it returns.
+  Block* m_current_block = nullptr;
+};
+
+} // namespace CPU_8086
@@ -5,6 +5,7 @@
 #include "common/fastjmp.h"
 #include "common/state_wrapper.h"
 #include "pce/bus.h"
+#include "pce/cpu_8086/cached_interpreter_backend.h"
 #include "pce/cpu_8086/debugger_interface.h"
 #include "pce/cpu_8086/decoder.h"
 #include "pce/interrupt_controller.h"
@@ -43,6 +44,7 @@ bool CPU::Initialize(System* system, Bus* bus)
   }
 
   m_data_bus_is_8bit = (m_model == MODEL_8088 || m_model == MODEL_V20 || m_model == MODEL_80188);
+  CreateBackend();
   return true;
 }
 
@@ -110,6 +112,7 @@ bool CPU::DoState(StateWrapper& sw)
   {
     m_effective_address = 0;
     std::memset(&idata, 0, sizeof(idata));
+    FlushCodeCache();
   }
 
   return !sw.HasError();
@@ -153,18 +156,40 @@ void CPU::SignalNMI()
 
 bool CPU::SupportsBackend(BackendType mode)
 {
-  return (mode == BackendType::Interpreter);
+  return (mode == BackendType::Interpreter || mode == BackendType::CachedInterpreter);
 }
 
 void CPU::SetBackend(BackendType mode)
 {
-  Assert(mode == BackendType::Interpreter);
+  Assert(SupportsBackend(mode));
+  if (m_backend_type == mode)
+    return;
+
+  m_backend_type = mode;
+
+  // If we're initialized, switch backends now, otherwise wait until we have a system.
+  if (m_system)
+    CreateBackend();
+}
+
+void CPU::CreateBackend()
+{
+  m_code_cache_backend.reset();
+  if (m_backend_type == BackendType::CachedInterpreter)
+    m_code_cache_backend = std::make_unique<CachedInterpreterBackend>(this);
 }
 
 void CPU::Execute()
 {
   fastjmp_set(&m_jmp_buf);
 
+  // Aborted instructions jump back here, and re-enter the backend.
+  if (m_code_cache_backend)
+  {
+    m_code_cache_backend->Execute();
+    return;
+  }
+
   while (m_system->ShouldRunCPU())
   {
     // If we're halted, don't even bother calling into the backend.
@@ -192,22 +217,27 @@ void CPU::Execute()
   }
 }
 
-void CPU::FlushCodeCache() {}
+void CPU::FlushCodeCache()
+{
+  if (m_code_cache_backend)
+    m_code_cache_backend->FlushCodeCache();
+}
 
 void CPU::GetExecutionStats(ExecutionStats* stats) const
 {
   std::memcpy(stats, &m_execution_stats, sizeof(m_execution_stats));
+  stats->num_code_cache_blocks = m_code_cache_backend ? m_code_cache_backend->GetCodeBlockCount() : 0;
 }
 
 void CPU::CommitPendingCycles()
 {
-  // Convert to/from simulation time, keeping track of partial nanoseconds.
-  const SimulationTime simtime = static_cast<SimulationTime>(static_cast<float>(m_pending_cycles) * m_cycle_period);
-  const CycleCount cycles = static_cast<CycleCount>(static_cast<float>(simtime) * m_rcp_cycle_period);
-  m_system->AddSimulationTime(simtime);
-  m_execution_stats.cycles_executed += cycles;
-  m_execution_downcount -= cycles;
-  m_pending_cycles -= cycles;
+  // Convert to simulation time in fixed-point, carrying any partial nanosecond over to the next commit.
+  const SimulationTicks ticks = m_pending_cycles * m_cycle_period + m_partial_time;
+  m_system->AddSimulationTime(SimulationTicksToTime(ticks));
+  m_partial_time = ticks & SIMULATION_TICK_FRACTION_MASK;
+  m_execution_stats.cycles_executed += m_pending_cycles;
+  m_execution_downcount -= m_pending_cycles;
+  m_pending_cycles = 0;
 }
 
 void CPU::AbortCurrentInstruction()
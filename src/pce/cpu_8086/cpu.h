@@ -15,8 +15,10 @@ class InterruptController;
 namespace CPU_8086 {
 
 class Backend;
+class CachedInterpreterBackend;
 class DebuggerInterface;
 class Instructions;
+struct Instruction;
 
 class CPU : public ::CPU
 {
@@ -24,6 +26,7 @@ class CPU : public ::CPU
   DECLARE_OBJECT_NO_FACTORY(CPU);
   DECLARE_OBJECT_PROPERTY_MAP(CPU);
 
+  friend CachedInterpreterBackend;
   friend DebuggerInterface;
   friend Instructions;
 
@@ -197,9 +200,16 @@ protected:
   bool HasExternalInterrupt() const;
   void DispatchExternalInterrupt();
 
+  // Creates the code cache for the selected backend, if any.
+  void CreateBackend();
+
   // Instruction execution.
   void ExecuteInstruction();
 
+  // Returns the interpreter handler for a decoded instruction, or nullptr if there is none.
+  using InstructionHandler = void (*)(CPU*);
+  static InstructionHandler GetInstructionHandler(const Instruction* instruction);
+
   // Jump instructions
   void BranchTo(u16 new_IP);
   void BranchTo(u16 new_CS, u16 new_IP);
@@ -216,6 +226,9 @@ protected:
   InterruptController* m_interrupt_controller = nullptr;
   std::unique_ptr<DebuggerInterface> m_debugger_interface;
 
+  // Decoded block cache, only present when the cached interpreter backend is selected.
+  std::unique_ptr<CachedInterpreterBackend> m_code_cache_backend;
+
   // CPU model that determines behavior.
   Model m_model = MODEL_8086;
   bool m_data_bus_is_8bit = false;
@@ -3,8 +3,10 @@
 #include "YBaseLib/String.h"
 #include "pce/bus.h"
 #include "pce/cpu_8086/cpu.h"
+#include "pce/cpu_8086/instruction.h"
 #include "pce/interrupt_controller.h"
 #include "pce/system.h"
+#include <map>
 
 #ifdef Y_COMPILER_MSVC
 #include <intrin.h>
@@ -2702,6 +2704,46 @@ public:
   }
 
   static inline void DispatchInstruction(CPU* cpu);
+
+  /// Instruction handler key - used to get a pointer to an opcode handler
+  union HandlerFunctionKey
+  {
+    u64 bits;
+    struct
+    {
+      u16 operation;
+      struct
+      {
+        u16 size : 3;
+        u16 mode : 5;
+        u16 data : 5;
+        u16 pad : 3;
+      } operands[3];
+    };
+
+    static constexpr u64 Build(Operation operation, OperandSize opsize_1 = OperandSize_8,
+                               OperandMode opmode_1 = OperandMode_None, u32 opdata_1 = 0,
+                               OperandSize opsize_2 = OperandSize_8, OperandMode opmode_2 = OperandMode_None,
+                               u32 opdata_2 = 0, OperandSize opsize_3 = OperandSize_8,
+                               OperandMode opmode_3 = OperandMode_None, u32 opdata_3 = 0)
+    {
+      HandlerFunctionKey k = {};
+      k.operation = static_cast<u16>(operation);
+      k.operands[0].size = static_cast<u16>(opsize_1);
+      k.operands[0].mode = static_cast<u16>(opmode_1);
+      k.operands[0].data = static_cast<u16>(opdata_1);
+      k.operands[1].size = static_cast<u16>(opsize_2);
+      k.operands[1].mode = static_cast<u16>(opmode_2);
+      k.operands[1].data = static_cast<u16>(opdata_2);
+      k.operands[2].size = static_cast<u16>(opsize_3);
+      k.operands[2].mode = static_cast<u16>(opmode_3);
+      k.operands[2].data = static_cast<u16>(opdata_3);
+      return k.bits;
+    }
+  };
+  static_assert(sizeof(HandlerFunctionKey) == 8, "InstructionHandlerKey is qword-sized");
+  using HandlerFunctionMap = std::map<u64, CPU::InstructionHandler>;
+  static HandlerFunctionMap s_handler_functions;
 };
 
 void CPU::ExecuteInstruction()
@@ -2745,6 +2787,17 @@ void CPU::ExecuteInstruction()
   }
 }
 
+CPU::InstructionHandler CPU::GetInstructionHandler(const Instruction* instruction)
+{
+  const u64 key = Instructions::HandlerFunctionKey::Build(
+    instruction->operation, instruction->operands[0].size, instruction->operands[0].mode, instruction->operands[0].data,
+    instruction->operands[1].size, instruction->operands[1].mode, instruction->operands[1].data,
+    instruction->operands[2].size, instruction->operands[2].mode, instruction->operands[2].data);
+
+  auto iter = Instructions::s_handler_functions.find(key);
+  return (iter != Instructions::s_handler_functions.end()) ? iter->second : nullptr;
+}
+
 #include "instructions_dispatch.inl"
 
 } // namespace CPU_8086
@@ -1416,5 +1416,326 @@ void CPU_8086::Instructions::DispatchInstruction(CPU* cpu)
     return;
   }
 }
+CPU_8086::Instructions::HandlerFunctionMap CPU_8086::Instructions::s_handler_functions = {
+  { HandlerFunctionKey::Build(Operation_ADD, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_ADD<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_ADD, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_ADD<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_ADD, OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_ADD<OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_ADD, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_ADD<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_ADD, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADD<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_ADD, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADD<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_PUSH_Sreg, OperandSize_16, OperandMode_SegmentRegister, Segment_ES), &CPU_8086::Instructions::Execute_Operation_PUSH_Sreg<OperandSize_16, OperandMode_SegmentRegister, Segment_ES>},
+  { HandlerFunctionKey::Build(Operation_POP_Sreg, OperandSize_16, OperandMode_SegmentRegister, Segment_ES), &CPU_8086::Instructions::Execute_Operation_POP_Sreg<OperandSize_16, OperandMode_SegmentRegister, Segment_ES>},
+  { HandlerFunctionKey::Build(Operation_OR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_OR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_OR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_OR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_OR, OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_OR<OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_OR, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_OR<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_OR, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_OR<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_OR, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_OR<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_PUSH_Sreg, OperandSize_16, OperandMode_SegmentRegister, Segment_CS), &CPU_8086::Instructions::Execute_Operation_PUSH_Sreg<OperandSize_16, OperandMode_SegmentRegister, Segment_CS>},
+  { HandlerFunctionKey::Build(Operation_POP_Sreg, OperandSize_16, OperandMode_SegmentRegister, Segment_CS), &CPU_8086::Instructions::Execute_Operation_POP_Sreg<OperandSize_16, OperandMode_SegmentRegister, Segment_CS>},
+  { HandlerFunctionKey::Build(Operation_ADC, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_ADC<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_ADC, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_ADC<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_ADC, OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_ADC<OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_ADC, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_ADC<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_ADC, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADC<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_ADC, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADC<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_PUSH_Sreg, OperandSize_16, OperandMode_SegmentRegister, Segment_SS), &CPU_8086::Instructions::Execute_Operation_PUSH_Sreg<OperandSize_16, OperandMode_SegmentRegister, Segment_SS>},
+  { HandlerFunctionKey::Build(Operation_POP_Sreg, OperandSize_16, OperandMode_SegmentRegister, Segment_SS), &CPU_8086::Instructions::Execute_Operation_POP_Sreg<OperandSize_16, OperandMode_SegmentRegister, Segment_SS>},
+  { HandlerFunctionKey::Build(Operation_SBB, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_SBB<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_SBB, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_SBB<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_SBB, OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_SBB<OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_SBB, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_SBB<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_SBB, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SBB<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SBB, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SBB<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_PUSH_Sreg, OperandSize_16, OperandMode_SegmentRegister, Segment_DS), &CPU_8086::Instructions::Execute_Operation_PUSH_Sreg<OperandSize_16, OperandMode_SegmentRegister, Segment_DS>},
+  { HandlerFunctionKey::Build(Operation_POP_Sreg, OperandSize_16, OperandMode_SegmentRegister, Segment_DS), &CPU_8086::Instructions::Execute_Operation_POP_Sreg<OperandSize_16, OperandMode_SegmentRegister, Segment_DS>},
+  { HandlerFunctionKey::Build(Operation_AND, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_AND<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_AND, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_AND<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_AND, OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_AND<OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_AND, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_AND<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_AND, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_AND<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_AND, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_AND<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_DAA), &CPU_8086::Instructions::Execute_Operation_DAA},
+  { HandlerFunctionKey::Build(Operation_SUB, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_SUB<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_SUB, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_SUB<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_SUB, OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_SUB<OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_SUB, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_SUB<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_SUB, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SUB<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SUB, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SUB<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_DAS), &CPU_8086::Instructions::Execute_Operation_DAS},
+  { HandlerFunctionKey::Build(Operation_XOR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_XOR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_XOR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_XOR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_XOR, OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_XOR<OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_XOR, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_XOR<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_XOR, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_XOR<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_XOR, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_XOR<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_AAA), &CPU_8086::Instructions::Execute_Operation_AAA},
+  { HandlerFunctionKey::Build(Operation_CMP, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_CMP<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_CMP, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_CMP<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_CMP, OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_CMP<OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_CMP, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_CMP<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_CMP, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_CMP<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_CMP, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_CMP<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_AAS), &CPU_8086::Instructions::Execute_Operation_AAS},
+  { HandlerFunctionKey::Build(Operation_INC, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_INC<OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_INC, OperandSize_16, OperandMode_Register, Reg16_CX), &CPU_8086::Instructions::Execute_Operation_INC<OperandSize_16, OperandMode_Register, Reg16_CX>},
+  { HandlerFunctionKey::Build(Operation_INC, OperandSize_16, OperandMode_Register, Reg16_DX), &CPU_8086::Instructions::Execute_Operation_INC<OperandSize_16, OperandMode_Register, Reg16_DX>},
+  { HandlerFunctionKey::Build(Operation_INC, OperandSize_16, OperandMode_Register, Reg16_BX), &CPU_8086::Instructions::Execute_Operation_INC<OperandSize_16, OperandMode_Register, Reg16_BX>},
+  { HandlerFunctionKey::Build(Operation_INC, OperandSize_16, OperandMode_Register, Reg16_SP), &CPU_8086::Instructions::Execute_Operation_INC<OperandSize_16, OperandMode_Register, Reg16_SP>},
+  { HandlerFunctionKey::Build(Operation_INC, OperandSize_16, OperandMode_Register, Reg16_BP), &CPU_8086::Instructions::Execute_Operation_INC<OperandSize_16, OperandMode_Register, Reg16_BP>},
+  { HandlerFunctionKey::Build(Operation_INC, OperandSize_16, OperandMode_Register, Reg16_SI), &CPU_8086::Instructions::Execute_Operation_INC<OperandSize_16, OperandMode_Register, Reg16_SI>},
+  { HandlerFunctionKey::Build(Operation_INC, OperandSize_16, OperandMode_Register, Reg16_DI), &CPU_8086::Instructions::Execute_Operation_INC<OperandSize_16, OperandMode_Register, Reg16_DI>},
+  { HandlerFunctionKey::Build(Operation_DEC, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_DEC<OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_DEC, OperandSize_16, OperandMode_Register, Reg16_CX), &CPU_8086::Instructions::Execute_Operation_DEC<OperandSize_16, OperandMode_Register, Reg16_CX>},
+  { HandlerFunctionKey::Build(Operation_DEC, OperandSize_16, OperandMode_Register, Reg16_DX), &CPU_8086::Instructions::Execute_Operation_DEC<OperandSize_16, OperandMode_Register, Reg16_DX>},
+  { HandlerFunctionKey::Build(Operation_DEC, OperandSize_16, OperandMode_Register, Reg16_BX), &CPU_8086::Instructions::Execute_Operation_DEC<OperandSize_16, OperandMode_Register, Reg16_BX>},
+  { HandlerFunctionKey::Build(Operation_DEC, OperandSize_16, OperandMode_Register, Reg16_SP), &CPU_8086::Instructions::Execute_Operation_DEC<OperandSize_16, OperandMode_Register, Reg16_SP>},
+  { HandlerFunctionKey::Build(Operation_DEC, OperandSize_16, OperandMode_Register, Reg16_BP), &CPU_8086::Instructions::Execute_Operation_DEC<OperandSize_16, OperandMode_Register, Reg16_BP>},
+  { HandlerFunctionKey::Build(Operation_DEC, OperandSize_16, OperandMode_Register, Reg16_SI), &CPU_8086::Instructions::Execute_Operation_DEC<OperandSize_16, OperandMode_Register, Reg16_SI>},
+  { HandlerFunctionKey::Build(Operation_DEC, OperandSize_16, OperandMode_Register, Reg16_DI), &CPU_8086::Instructions::Execute_Operation_DEC<OperandSize_16, OperandMode_Register, Reg16_DI>},
+  { HandlerFunctionKey::Build(Operation_PUSH, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_PUSH<OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_PUSH, OperandSize_16, OperandMode_Register, Reg16_CX), &CPU_8086::Instructions::Execute_Operation_PUSH<OperandSize_16, OperandMode_Register, Reg16_CX>},
+  { HandlerFunctionKey::Build(Operation_PUSH, OperandSize_16, OperandMode_Register, Reg16_DX), &CPU_8086::Instructions::Execute_Operation_PUSH<OperandSize_16, OperandMode_Register, Reg16_DX>},
+  { HandlerFunctionKey::Build(Operation_PUSH, OperandSize_16, OperandMode_Register, Reg16_BX), &CPU_8086::Instructions::Execute_Operation_PUSH<OperandSize_16, OperandMode_Register, Reg16_BX>},
+  { HandlerFunctionKey::Build(Operation_PUSH, OperandSize_16, OperandMode_Register, Reg16_SP), &CPU_8086::Instructions::Execute_Operation_PUSH<OperandSize_16, OperandMode_Register, Reg16_SP>},
+  { HandlerFunctionKey::Build(Operation_PUSH, OperandSize_16, OperandMode_Register, Reg16_BP), &CPU_8086::Instructions::Execute_Operation_PUSH<OperandSize_16, OperandMode_Register, Reg16_BP>},
+  { HandlerFunctionKey::Build(Operation_PUSH, OperandSize_16, OperandMode_Register, Reg16_SI), &CPU_8086::Instructions::Execute_Operation_PUSH<OperandSize_16, OperandMode_Register, Reg16_SI>},
+  { HandlerFunctionKey::Build(Operation_PUSH, OperandSize_16, OperandMode_Register, Reg16_DI), &CPU_8086::Instructions::Execute_Operation_PUSH<OperandSize_16, OperandMode_Register, Reg16_DI>},
+  { HandlerFunctionKey::Build(Operation_POP, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_POP<OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_POP, OperandSize_16, OperandMode_Register, Reg16_CX), &CPU_8086::Instructions::Execute_Operation_POP<OperandSize_16, OperandMode_Register, Reg16_CX>},
+  { HandlerFunctionKey::Build(Operation_POP, OperandSize_16, OperandMode_Register, Reg16_DX), &CPU_8086::Instructions::Execute_Operation_POP<OperandSize_16, OperandMode_Register, Reg16_DX>},
+  { HandlerFunctionKey::Build(Operation_POP, OperandSize_16, OperandMode_Register, Reg16_BX), &CPU_8086::Instructions::Execute_Operation_POP<OperandSize_16, OperandMode_Register, Reg16_BX>},
+  { HandlerFunctionKey::Build(Operation_POP, OperandSize_16, OperandMode_Register, Reg16_SP), &CPU_8086::Instructions::Execute_Operation_POP<OperandSize_16, OperandMode_Register, Reg16_SP>},
+  { HandlerFunctionKey::Build(Operation_POP, OperandSize_16, OperandMode_Register, Reg16_BP), &CPU_8086::Instructions::Execute_Operation_POP<OperandSize_16, OperandMode_Register, Reg16_BP>},
+  { HandlerFunctionKey::Build(Operation_POP, OperandSize_16, OperandMode_Register, Reg16_SI), &CPU_8086::Instructions::Execute_Operation_POP<OperandSize_16, OperandMode_Register, Reg16_SI>},
+  { HandlerFunctionKey::Build(Operation_POP, OperandSize_16, OperandMode_Register, Reg16_DI), &CPU_8086::Instructions::Execute_Operation_POP<OperandSize_16, OperandMode_Register, Reg16_DI>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Overflow, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Overflow, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_NotOverflow, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_NotOverflow, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Below, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Below, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_AboveOrEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_AboveOrEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Equal, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Equal, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_NotEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_NotEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_BelowOrEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_BelowOrEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Above, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Above, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Sign, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Sign, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_NotSign, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_NotSign, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Parity, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Parity, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_NotParity, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_NotParity, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Less, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Less, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_GreaterOrEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_GreaterOrEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_LessOrEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_LessOrEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Greater, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Greater, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Overflow, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Overflow, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_NotOverflow, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_NotOverflow, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Below, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Below, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_AboveOrEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_AboveOrEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Equal, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Equal, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_NotEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_NotEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_BelowOrEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_BelowOrEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Above, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Above, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Sign, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Sign, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_NotSign, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_NotSign, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Parity, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Parity, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_NotParity, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_NotParity, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Less, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Less, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_GreaterOrEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_GreaterOrEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_LessOrEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_LessOrEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Greater, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_Greater, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_ADD, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADD<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_OR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_OR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_ADC, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADC<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SBB, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SBB<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_AND, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_AND<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SUB, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SUB<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_XOR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_XOR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_CMP, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_CMP<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_ADD, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADD<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_OR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_OR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_ADC, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADC<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SBB, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SBB<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_AND, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_AND<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SUB, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SUB<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_XOR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_XOR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_CMP, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_CMP<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_ADD, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADD<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_OR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_OR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_ADC, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADC<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SBB, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SBB<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_AND, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_AND<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SUB, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SUB<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_XOR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_XOR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_CMP, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_CMP<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_ADD, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADD<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_OR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_OR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_ADC, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_ADC<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SBB, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SBB<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_AND, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_AND<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SUB, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_SUB<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_XOR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_XOR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_CMP, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_CMP<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_TEST, OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_TEST<OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_TEST, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_TEST<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_XCHG, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_XCHG<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_XCHG, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_XCHG<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_Reg, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_ModRM_Reg, 0, OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV_Sreg, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_SegmentReg, 0), &CPU_8086::Instructions::Execute_Operation_MOV_Sreg<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_ModRM_SegmentReg, 0>},
+  { HandlerFunctionKey::Build(Operation_LEA, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_Count, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_LEA<OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_Count, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV_Sreg, OperandSize_16, OperandMode_ModRM_SegmentReg, 0, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_MOV_Sreg<OperandSize_16, OperandMode_ModRM_SegmentReg, 0, OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_POP, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_POP<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_NOP), &CPU_8086::Instructions::Execute_Operation_NOP},
+  { HandlerFunctionKey::Build(Operation_XCHG, OperandSize_16, OperandMode_Register, Reg16_CX, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_XCHG<OperandSize_16, OperandMode_Register, Reg16_CX, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_XCHG, OperandSize_16, OperandMode_Register, Reg16_DX, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_XCHG<OperandSize_16, OperandMode_Register, Reg16_DX, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_XCHG, OperandSize_16, OperandMode_Register, Reg16_BX, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_XCHG<OperandSize_16, OperandMode_Register, Reg16_BX, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_XCHG, OperandSize_16, OperandMode_Register, Reg16_SP, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_XCHG<OperandSize_16, OperandMode_Register, Reg16_SP, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_XCHG, OperandSize_16, OperandMode_Register, Reg16_BP, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_XCHG<OperandSize_16, OperandMode_Register, Reg16_BP, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_XCHG, OperandSize_16, OperandMode_Register, Reg16_SI, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_XCHG<OperandSize_16, OperandMode_Register, Reg16_SI, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_XCHG, OperandSize_16, OperandMode_Register, Reg16_DI, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_XCHG<OperandSize_16, OperandMode_Register, Reg16_DI, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_CBW), &CPU_8086::Instructions::Execute_Operation_CBW},
+  { HandlerFunctionKey::Build(Operation_CWD), &CPU_8086::Instructions::Execute_Operation_CWD},
+  { HandlerFunctionKey::Build(Operation_CALL_Far, OperandSize_Count, OperandMode_FarAddress, 0), &CPU_8086::Instructions::Execute_Operation_CALL_Far<OperandSize_Count, OperandMode_FarAddress, 0>},
+  { HandlerFunctionKey::Build(Operation_WAIT), &CPU_8086::Instructions::Execute_Operation_WAIT},
+  { HandlerFunctionKey::Build(Operation_PUSHF), &CPU_8086::Instructions::Execute_Operation_PUSHF},
+  { HandlerFunctionKey::Build(Operation_POPF), &CPU_8086::Instructions::Execute_Operation_POPF},
+  { HandlerFunctionKey::Build(Operation_SAHF), &CPU_8086::Instructions::Execute_Operation_SAHF},
+  { HandlerFunctionKey::Build(Operation_LAHF), &CPU_8086::Instructions::Execute_Operation_LAHF},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Memory, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Memory, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Memory, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Memory, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_Memory, 0, OperandSize_8, OperandMode_Register, Reg8_AL), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_Memory, 0, OperandSize_8, OperandMode_Register, Reg8_AL>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_Memory, 0, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_Memory, 0, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_MOVS, OperandSize_8, OperandMode_RegisterIndirect, Reg16_DI, OperandSize_8, OperandMode_RegisterIndirect, Reg16_SI), &CPU_8086::Instructions::Execute_Operation_MOVS<OperandSize_8, OperandMode_RegisterIndirect, Reg16_DI, OperandSize_8, OperandMode_RegisterIndirect, Reg16_SI>},
+  { HandlerFunctionKey::Build(Operation_MOVS, OperandSize_16, OperandMode_RegisterIndirect, Reg16_DI, OperandSize_16, OperandMode_RegisterIndirect, Reg16_SI), &CPU_8086::Instructions::Execute_Operation_MOVS<OperandSize_16, OperandMode_RegisterIndirect, Reg16_DI, OperandSize_16, OperandMode_RegisterIndirect, Reg16_SI>},
+  { HandlerFunctionKey::Build(Operation_CMPS, OperandSize_8, OperandMode_RegisterIndirect, Reg16_SI, OperandSize_8, OperandMode_RegisterIndirect, Reg16_DI), &CPU_8086::Instructions::Execute_Operation_CMPS<OperandSize_8, OperandMode_RegisterIndirect, Reg16_SI, OperandSize_8, OperandMode_RegisterIndirect, Reg16_DI>},
+  { HandlerFunctionKey::Build(Operation_CMPS, OperandSize_16, OperandMode_RegisterIndirect, Reg16_SI, OperandSize_16, OperandMode_RegisterIndirect, Reg16_DI), &CPU_8086::Instructions::Execute_Operation_CMPS<OperandSize_16, OperandMode_RegisterIndirect, Reg16_SI, OperandSize_16, OperandMode_RegisterIndirect, Reg16_DI>},
+  { HandlerFunctionKey::Build(Operation_TEST, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_TEST<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_TEST, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_TEST<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_STOS, OperandSize_8, OperandMode_RegisterIndirect, Reg16_DI, OperandSize_8, OperandMode_Register, Reg8_AL), &CPU_8086::Instructions::Execute_Operation_STOS<OperandSize_8, OperandMode_RegisterIndirect, Reg16_DI, OperandSize_8, OperandMode_Register, Reg8_AL>},
+  { HandlerFunctionKey::Build(Operation_STOS, OperandSize_16, OperandMode_RegisterIndirect, Reg16_DI, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_STOS<OperandSize_16, OperandMode_RegisterIndirect, Reg16_DI, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_LODS, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_RegisterIndirect, Reg16_SI), &CPU_8086::Instructions::Execute_Operation_LODS<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_RegisterIndirect, Reg16_SI>},
+  { HandlerFunctionKey::Build(Operation_LODS, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_RegisterIndirect, Reg16_SI), &CPU_8086::Instructions::Execute_Operation_LODS<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_RegisterIndirect, Reg16_SI>},
+  { HandlerFunctionKey::Build(Operation_SCAS, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_RegisterIndirect, Reg16_SI), &CPU_8086::Instructions::Execute_Operation_SCAS<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_RegisterIndirect, Reg16_SI>},
+  { HandlerFunctionKey::Build(Operation_SCAS, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_RegisterIndirect, Reg16_SI), &CPU_8086::Instructions::Execute_Operation_SCAS<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_RegisterIndirect, Reg16_SI>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_Register, Reg8_CL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_Register, Reg8_CL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_Register, Reg8_DL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_Register, Reg8_DL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_Register, Reg8_BL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_Register, Reg8_BL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_Register, Reg8_AH, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_Register, Reg8_AH, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_Register, Reg8_CH, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_Register, Reg8_CH, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_Register, Reg8_DH, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_Register, Reg8_DH, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_Register, Reg8_BH, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_Register, Reg8_BH, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_Register, Reg16_CX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_Register, Reg16_CX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_Register, Reg16_DX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_Register, Reg16_DX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_Register, Reg16_BX, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_Register, Reg16_BX, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_Register, Reg16_SP, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_Register, Reg16_SP, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_Register, Reg16_BP, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_Register, Reg16_BP, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_Register, Reg16_SI, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_Register, Reg16_SI, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_Register, Reg16_DI, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_Register, Reg16_DI, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_RET_Near, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_RET_Near<OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_RET_Near), &CPU_8086::Instructions::Execute_Operation_RET_Near},
+  { HandlerFunctionKey::Build(Operation_RET_Near, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_RET_Near<OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_RET_Near), &CPU_8086::Instructions::Execute_Operation_RET_Near},
+  { HandlerFunctionKey::Build(Operation_LXS, OperandSize_16, OperandMode_SegmentRegister, Segment_ES, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_Count, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_LXS<OperandSize_16, OperandMode_SegmentRegister, Segment_ES, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_Count, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_LXS, OperandSize_16, OperandMode_SegmentRegister, Segment_DS, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_Count, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_LXS<OperandSize_16, OperandMode_SegmentRegister, Segment_DS, OperandSize_16, OperandMode_ModRM_Reg, 0, OperandSize_Count, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_MOV, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_MOV<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_RET_Far, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_RET_Far<OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_RET_Far), &CPU_8086::Instructions::Execute_Operation_RET_Far},
+  { HandlerFunctionKey::Build(Operation_RET_Far, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_RET_Far<OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_RET_Far), &CPU_8086::Instructions::Execute_Operation_RET_Far},
+  { HandlerFunctionKey::Build(Operation_INT, OperandSize_8, OperandMode_Constant, 3), &CPU_8086::Instructions::Execute_Operation_INT<OperandSize_8, OperandMode_Constant, 3>},
+  { HandlerFunctionKey::Build(Operation_INT, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_INT<OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_INTO), &CPU_8086::Instructions::Execute_Operation_INTO},
+  { HandlerFunctionKey::Build(Operation_IRET), &CPU_8086::Instructions::Execute_Operation_IRET},
+  { HandlerFunctionKey::Build(Operation_ROL, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_ROL<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_ROR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_ROR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_RCL, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_RCL<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_RCR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_RCR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_SHL, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_SHL<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_SHR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_SHR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_SAR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_SAR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_ROL, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_ROL<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_ROR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_ROR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_RCL, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_RCL<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_RCR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_RCR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_SHL, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_SHL<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_SHR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_SHR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_SAR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1), &CPU_8086::Instructions::Execute_Operation_SAR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Constant, 1>},
+  { HandlerFunctionKey::Build(Operation_ROL, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_ROL<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_ROR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_ROR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_RCL, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_RCL<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_RCR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_RCR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_SHL, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_SHL<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_SHR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_SHR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_SAR, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_SAR<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_ROL, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_ROL<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_ROR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_ROR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_RCL, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_RCL<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_RCR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_RCR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_SHL, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_SHL<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_SHR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_SHR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_SAR, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL), &CPU_8086::Instructions::Execute_Operation_SAR<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Register, Reg8_CL>},
+  { HandlerFunctionKey::Build(Operation_AAM, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_AAM<OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_AAD, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_AAD<OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_SALC), &CPU_8086::Instructions::Execute_Operation_SALC},
+  { HandlerFunctionKey::Build(Operation_XLAT), &CPU_8086::Instructions::Execute_Operation_XLAT},
+  { HandlerFunctionKey::Build(Operation_Escape, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_Escape<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_Escape, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_Escape<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_Escape, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_Escape<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_Escape, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_Escape<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_Escape, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_Escape<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_Escape, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_Escape<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_Escape, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_Escape<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_Escape, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_Escape<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_LOOP, OperandSize_8, OperandMode_JumpCondition, JumpCondition_NotEqual, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_LOOP<JumpCondition_NotEqual, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_LOOP, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Equal, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_LOOP<JumpCondition_Equal, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_LOOP, OperandSize_8, OperandMode_JumpCondition, JumpCondition_Always, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_LOOP<JumpCondition_Always, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_Jcc, OperandSize_8, OperandMode_JumpCondition, JumpCondition_CXZero, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_Jcc<JumpCondition_CXZero, OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_IN, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_IN<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_IN, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_IN<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_OUT, OperandSize_8, OperandMode_Immediate, 0, OperandSize_8, OperandMode_Register, Reg8_AL), &CPU_8086::Instructions::Execute_Operation_OUT<OperandSize_8, OperandMode_Immediate, 0, OperandSize_8, OperandMode_Register, Reg8_AL>},
+  { HandlerFunctionKey::Build(Operation_OUT, OperandSize_8, OperandMode_Immediate, 0, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_OUT<OperandSize_8, OperandMode_Immediate, 0, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_CALL_Near, OperandSize_16, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_CALL_Near<OperandSize_16, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_JMP_Near, OperandSize_16, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_JMP_Near<OperandSize_16, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_JMP_Far, OperandSize_Count, OperandMode_FarAddress, 0), &CPU_8086::Instructions::Execute_Operation_JMP_Far<OperandSize_Count, OperandMode_FarAddress, 0>},
+  { HandlerFunctionKey::Build(Operation_JMP_Near, OperandSize_8, OperandMode_Relative, 0), &CPU_8086::Instructions::Execute_Operation_JMP_Near<OperandSize_8, OperandMode_Relative, 0>},
+  { HandlerFunctionKey::Build(Operation_IN, OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_16, OperandMode_Register, Reg16_DX), &CPU_8086::Instructions::Execute_Operation_IN<OperandSize_8, OperandMode_Register, Reg8_AL, OperandSize_16, OperandMode_Register, Reg16_DX>},
+  { HandlerFunctionKey::Build(Operation_IN, OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Register, Reg16_DX), &CPU_8086::Instructions::Execute_Operation_IN<OperandSize_16, OperandMode_Register, Reg16_AX, OperandSize_16, OperandMode_Register, Reg16_DX>},
+  { HandlerFunctionKey::Build(Operation_OUT, OperandSize_16, OperandMode_Register, Reg16_DX, OperandSize_8, OperandMode_Register, Reg8_AL), &CPU_8086::Instructions::Execute_Operation_OUT<OperandSize_16, OperandMode_Register, Reg16_DX, OperandSize_8, OperandMode_Register, Reg8_AL>},
+  { HandlerFunctionKey::Build(Operation_OUT, OperandSize_16, OperandMode_Register, Reg16_DX, OperandSize_16, OperandMode_Register, Reg16_AX), &CPU_8086::Instructions::Execute_Operation_OUT<OperandSize_16, OperandMode_Register, Reg16_DX, OperandSize_16, OperandMode_Register, Reg16_AX>},
+  { HandlerFunctionKey::Build(Operation_HLT), &CPU_8086::Instructions::Execute_Operation_HLT},
+  { HandlerFunctionKey::Build(Operation_CMC), &CPU_8086::Instructions::Execute_Operation_CMC},
+  { HandlerFunctionKey::Build(Operation_TEST, OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_TEST<OperandSize_8, OperandMode_ModRM_RM, 0, OperandSize_8, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_NOT, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_NOT<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_NEG, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_NEG<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_MUL, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_MUL<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_IMUL, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_IMUL<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_DIV, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_DIV<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_IDIV, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_IDIV<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_TEST, OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0), &CPU_8086::Instructions::Execute_Operation_TEST<OperandSize_16, OperandMode_ModRM_RM, 0, OperandSize_16, OperandMode_Immediate, 0>},
+  { HandlerFunctionKey::Build(Operation_NOT, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_NOT<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_NEG, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_NEG<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_MUL, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_MUL<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_IMUL, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_IMUL<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_DIV, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_DIV<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_IDIV, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_IDIV<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_CLC), &CPU_8086::Instructions::Execute_Operation_CLC},
+  { HandlerFunctionKey::Build(Operation_STC), &CPU_8086::Instructions::Execute_Operation_STC},
+  { HandlerFunctionKey::Build(Operation_CLI), &CPU_8086::Instructions::Execute_Operation_CLI},
+  { HandlerFunctionKey::Build(Operation_STI), &CPU_8086::Instructions::Execute_Operation_STI},
+  { HandlerFunctionKey::Build(Operation_CLD), &CPU_8086::Instructions::Execute_Operation_CLD},
+  { HandlerFunctionKey::Build(Operation_STD), &CPU_8086::Instructions::Execute_Operation_STD},
+  { HandlerFunctionKey::Build(Operation_INC, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_INC<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_DEC, OperandSize_8, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_DEC<OperandSize_8, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_INC, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_INC<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_DEC, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_DEC<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_CALL_Near, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_CALL_Near<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_CALL_Far, OperandSize_Count, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_CALL_Far<OperandSize_Count, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_JMP_Near, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_JMP_Near<OperandSize_16, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_JMP_Far, OperandSize_Count, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_JMP_Far<OperandSize_Count, OperandMode_ModRM_RM, 0>},
+  { HandlerFunctionKey::Build(Operation_PUSH, OperandSize_16, OperandMode_ModRM_RM, 0), &CPU_8086::Instructions::Execute_Operation_PUSH<OperandSize_16, OperandMode_ModRM_RM, 0>},
+};
 
 // clang-format on
@@ -12,7 +12,11 @@ public:
   virtual void AbortCurrentInstruction() = 0;
 
   virtual size_t GetCodeBlockCount() const = 0;
+  virtual size_t GetCodeCacheSize() const = 0;
   virtual void FlushCodeCache() = 0;
+
+  /// Logs the top count blocks from the block profiler. Only the code cache backends support profiling.
+  virtual void DumpBlockProfile(u32 count) {}
 };
 
 } // namespace CPU_X86
\ No newline at end of file
@@ -58,8 +58,10 @@ void CachedInterpreterBackend::Execute()
       }
 
       // Execute the block.
+      BeginIdleLoopCheck(m_current_block);
       ExecuteBlock();
       m_cpu->CommitPendingCycles();
+      EndIdleLoopCheck(m_current_block);
 
       // Fix up delayed block destroying.
       Block* previous_block = m_current_block;
@@ -166,7 +168,16 @@ bool CachedInterpreterBackend::CompileBlock(BlockBase* block)
       return false;
     }
 
-    cblock->entries.push_back({handler, instruction.data, static_cast<u8>(instruction.length)});
+    cblock->entries.push_back({handler, nullptr, instruction.data, static_cast<u8>(instruction.length)});
+  }
+
+  // Replace common instruction pairs with superinstructions.
+  for (size_t i = 0; (i + 1) < cblock->entries.size(); i++)
+  {
+    auto fused_handler =
+      Interpreter::GetFusedHandlerForInstructions(&cblock->instructions[i], &cblock->instructions[i + 1]);
+    if (fused_handler)
+      cblock->entries[i++].fused_handler = fused_handler;
   }
 
   return true;
@@ -198,7 +209,9 @@ void CachedInterpreterBackend::ExecuteBlock()
   // m_cpu->PrintCurrentStateAndInstruction(m_cpu->m_registers.EIP);
   m_cpu->m_execution_stats.code_cache_blocks_executed++;
   m_cpu->m_execution_stats.code_cache_instructions_executed += m_current_block->entries.size();
-  for (const Block::Entry& instruction : m_current_block->entries)
+  const u64 start_cycles = m_cpu->ReadTSC();
+  const Block::Entry* entries_end = m_current_block->entries.data() + m_current_block->entries.size();
+  for (const Block::Entry* instruction = m_current_block->entries.data(); instruction != entries_end; instruction++)
   {
 #if 0
     if (TRACE_EXECUTION && m_cpu->m_registers.EIP != TRACE_EXECUTION_LAST_EIP)
@@ -210,11 +223,29 @@ void CachedInterpreterBackend::ExecuteBlock()
 
     m_cpu->m_current_EIP = m_cpu->m_registers.EIP;
     m_cpu->m_current_ESP = m_cpu->m_registers.ESP;
-    m_cpu->m_registers.EIP = (m_cpu->m_registers.EIP + instruction.length) & m_cpu->m_EIP_mask;
-    std::memcpy(&m_cpu->idata, &instruction.data, sizeof(m_cpu->idata));
-    instruction.handler(m_cpu);
+    m_cpu->m_registers.EIP = (m_cpu->m_registers.EIP + instruction->length) & m_cpu->m_EIP_mask;
+    std::memcpy(&m_cpu->idata, &instruction->data, sizeof(m_cpu->idata));
+    if (instruction->fused_handler)
+    {
+      const Block::Entry* next_instruction = instruction + 1;
+      instruction->fused_handler(m_cpu, &next_instruction->data, next_instruction->length);
+      instruction = next_instruction;
+      continue;
+    }
+
+    instruction->handler(m_cpu);
     // Interpreter::ExecuteInstruction(m_cpu);
   }
+
+  // Blocks are compared against their starting register state for idle loops, so write back pending flags.
+  m_cpu->MaterializeLazyFlags();
+
+  // Cycles are measured rather than taken from the block, to include string instructions and I/O stalls.
+  if (m_current_block->profile)
+  {
+    m_current_block->profile->execution_count++;
+    m_current_block->profile->cycles += m_cpu->ReadTSC() - start_cycles;
+  }
 }
 
 } // namespace CPU_X86
\ No newline at end of file
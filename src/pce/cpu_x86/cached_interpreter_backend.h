@@ -26,6 +26,10 @@ protected:
     struct Entry
     {
       void (*handler)(CPU*);
+
+      // Superinstruction covering this entry and the next, which is skipped.
+      void (*fused_handler)(CPU*, const InstructionData*, u32);
+
       InstructionData data;
       u8 length;
     };
@@ -1,13 +1,20 @@
 #include "pce/cpu_x86/code_cache_backend.h"
+#include "YBaseLib/AutoReleasePtr.h"
+#include "YBaseLib/BinaryReader.h"
+#include "YBaseLib/BinaryWriter.h"
+#include "YBaseLib/FileSystem.h"
 #include "YBaseLib/Log.h"
 #include "pce/bus.h"
 #include "pce/cpu_x86/debugger_interface.h"
 #include "pce/cpu_x86/decoder.h"
 #include "pce/cpu_x86/interpreter.h"
 #include "pce/system.h"
+#include <algorithm>
 #include <array>
+#include <cinttypes>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 Log_SetChannel(CPU_X86::CodeCacheBackend);
 
 namespace CPU_X86 {
@@ -17,38 +24,86 @@ static_assert(CPU::PAGE_SIZE == Bus::MEMORY_PAGE_SIZE, "CPU page size matches bu
 extern bool TRACE_EXECUTION;
 extern u32 TRACE_EXECUTION_LAST_EIP;
 
-CodeCacheBackend::CodeCacheBackend(CPU* cpu) : m_cpu(cpu), m_system(cpu->GetSystem()), m_bus(cpu->GetBus())
+CodeCacheBackend::CodeCacheBackend(CPU* cpu)
+  : m_cpu(cpu), m_system(cpu->GetSystem()), m_bus(cpu->GetBus()), m_blocks(m_bus->GetMemoryPageCount())
 {
   m_physical_page_blocks = std::make_unique<BlockArray[]>(m_bus->GetMemoryPageCount());
   m_bus->SetCodeInvalidationCallback(
-    std::bind(&CodeCacheBackend::InvalidateBlocksWithPhysicalPage, this, std::placeholders::_1));
+    std::bind(&CodeCacheBackend::InvalidateBlocksWithPhysicalRange, this, std::placeholders::_1, std::placeholders::_2));
+
+  if (m_cpu->m_persistent_code_cache)
+  {
+    m_persistent_code_cache_enabled = true;
+    m_persistent_code_cache_filename = m_system->GetMiscDataFilename(".codecache");
+    LoadPersistentCodeCache();
+  }
+
+  m_block_profiling = m_cpu->m_block_profiler;
+  m_idle_loop_skipping = m_cpu->m_idle_loop_skipping;
 }
 
 CodeCacheBackend::~CodeCacheBackend()
 {
+  if (m_persistent_code_cache_enabled)
+    SavePersistentCodeCache();
+
   m_bus->ClearCodeInvalidationCallback();
   m_bus->ClearPageCodeFlags();
 }
 
-void CodeCacheBackend::InvalidateBlocksWithPhysicalPage(PhysicalMemoryAddress physical_page_address)
+void CodeCacheBackend::InvalidateBlocksWithPhysicalRange(PhysicalMemoryAddress address, u32 size)
 {
-  PODArray<BlockBase*>& block_list = m_physical_page_blocks[Bus::GetMemoryPageIndex(physical_page_address)];
+  PODArray<BlockBase*>& block_list = m_physical_page_blocks[Bus::GetMemoryPageIndex(address)];
   if (block_list.IsEmpty())
     return;
 
-  // We unmark all pages as code, and invalidate the blocks.
-  // When the blocks are next executed, they will be re-marked as code.
-  m_bus->UnmarkPageAsCode(physical_page_address);
+  // Find the blocks overlapping the modified range, and the code which remains in the page.
+  const PhysicalMemoryAddress page_address = address & CPU::PAGE_MASK;
+  const u32 start_offset = address & CPU::PAGE_OFFSET_MASK;
+  const u32 end_offset = start_offset + size;
+  PODArray<BlockBase*> invalidated_blocks;
+  u64 remaining_code_bitmap = 0;
+  for (BlockBase* block : block_list)
+  {
+    u32 block_start_offset, block_end_offset;
+    GetBlockRangeInPage(block, page_address, &block_start_offset, &block_end_offset);
+    if (block_start_offset < end_offset && start_offset < block_end_offset)
+      invalidated_blocks.Add(block);
+    else
+      remaining_code_bitmap |= Bus::GetCodeBitmapMask(block_start_offset, block_end_offset - block_start_offset);
+  }
 
-  // Move the list out, so we don't disturb it while iterating.
-  PODArray<BlockBase*> temp_block_list;
-  temp_block_list.Swap(block_list);
+  // The write can hit a chunk shared by code and data without touching the code itself.
+  if (invalidated_blocks.IsEmpty())
+    return;
 
-  for (BlockBase* block : temp_block_list)
+  // Invalidating removes the blocks from the page list, and unmarks the page when the last one is removed.
+  // When the blocks are next executed, they will be re-marked as code.
+  for (BlockBase* block : invalidated_blocks)
     InvalidateBlock(block);
 
-  temp_block_list.Swap(block_list);
-  block_list.Clear();
+  if (!block_list.IsEmpty())
+    m_bus->SetPageCodeBitmap(page_address, remaining_code_bitmap);
+
+  m_cpu->m_execution_stats.code_cache_blocks_invalidated += invalidated_blocks.GetSize();
+}
+
+void CodeCacheBackend::GetBlockRangeInPage(const BlockBase* block, PhysicalMemoryAddress page_address,
+                                           u32* start_offset, u32* end_offset)
+{
+  const u32 block_offset = block->key.eip_physical_address & CPU::PAGE_OFFSET_MASK;
+  const u32 size_in_first_page = std::min(block->code_length, CPU::PAGE_SIZE - block_offset);
+  if (block->GetPhysicalPageAddress() == page_address)
+  {
+    *start_offset = block_offset;
+    *end_offset = block_offset + size_in_first_page;
+  }
+  else
+  {
+    DebugAssert(block->CrossesPage() && block->GetNextPhysicalPageAddress() == page_address);
+    *start_offset = 0;
+    *end_offset = block->code_length - size_in_first_page;
+  }
 }
 
 Bus::CodeHashType CodeCacheBackend::GetBlockCodeHash(BlockBase* block)
@@ -92,6 +147,9 @@ bool CodeCacheBackend::GetBlockKeyForCurrentState(BlockKey* key)
   key->cs_granularity = 0; // FIXME
   key->ss_size = BoolToUInt32(m_cpu->m_stack_address_size == AddressSize_32);
   key->v8086_mode = m_cpu->InVirtual8086Mode();
+  key->flat_segments = BoolToUInt32(m_cpu->m_segment_cache[Segment_ES].flat &&
+                                    m_cpu->m_segment_cache[Segment_SS].flat &&
+                                    m_cpu->m_segment_cache[Segment_DS].flat);
   key->pad = 0;
   return true;
 }
@@ -115,6 +173,7 @@ bool CodeCacheBackend::CanExecuteBlock(BlockBase* block)
       ResetBlock(block);
       if (CompileBlock(block))
       {
+        ProfileBlockCompile(block);
         block->flags &= ~BlockFlags::Invalidated;
         AddBlockPhysicalMappings(block);
         return true;
@@ -155,17 +214,9 @@ BlockBase* CodeCacheBackend::GetNextBlock()
   }
 
   // Block lookup.
-  BlockBase* block;
-  auto iter = m_blocks.find(key);
-  if (iter != m_blocks.end())
+  BlockBase* block = m_blocks.Lookup(key);
+  if (block)
   {
-    block = iter->second;
-    if (!block)
-    {
-      // This block failed compilation previously, leave it.
-      return nullptr;
-    }
-
     // If CanExecuteBlock returns false, it means the block is incompatible with the current execution state.
     // In this case, fall back to the interpreter.
     if (!CanExecuteBlock(block))
@@ -178,6 +229,8 @@ BlockBase* CodeCacheBackend::GetNextBlock()
   // Block doesn't exist, so compile it.
   Log_DebugPrintf("Attempting to compile block %08X", key.eip_physical_address);
   block = AllocateBlock(key);
+  if (m_block_profiling)
+    block->profile = &m_block_profiles[key];
   if (!CompileBlock(block))
   {
     Log_WarningPrintf("Failed to compile block %08X", key.eip_physical_address);
@@ -185,6 +238,8 @@ BlockBase* CodeCacheBackend::GetNextBlock()
     return nullptr;
   }
 
+  ProfileBlockCompile(block);
+
   // Insert into tree.
   InsertBlock(block);
   return block;
@@ -205,14 +260,12 @@ void CodeCacheBackend::FlushBlock(BlockBase* block, bool defer_destroy /* = fals
 {
   Log_DebugPrintf("Flushing block %08X", block->key.eip_physical_address);
 
-  auto iter = m_blocks.find(block->key);
-  if (iter == m_blocks.end())
+  if (!m_blocks.Remove(block))
   {
     Panic("Flushing untracked block");
     return;
   }
 
-  m_blocks.erase(iter);
   UnlinkBlockBase(block);
 
   // This lookup may fail, if the block has been invalidated.
@@ -230,20 +283,26 @@ void CodeCacheBackend::InvalidateBlock(BlockBase* block)
   Log_DebugPrintf("Invalidating block %08X", block->key.eip_physical_address);
   block->flags |= BlockFlags::Invalidated;
   RemoveBlockPhysicalMappings(block);
+  if (block->profile)
+    block->profile->invalidation_count++;
 }
 
 size_t CodeCacheBackend::GetCodeBlockCount() const
 {
-  return m_blocks.size();
+  return m_blocks.GetBlockCount();
+}
+
+size_t CodeCacheBackend::GetCodeCacheSize() const
+{
+  return 0;
 }
 
 void CodeCacheBackend::FlushCodeCache()
 {
   for (u32 i = 0; i < m_bus->GetMemoryPageCount(); i++)
     m_physical_page_blocks[i].Clear();
-  for (auto& iter : m_blocks)
-    DestroyBlock(iter.second);
-  m_blocks.clear();
+  m_blocks.EnumerateBlocks([this](BlockBase* block) { DestroyBlock(block); });
+  m_blocks.Clear();
   m_bus->ClearPageCodeFlags();
 }
 
@@ -251,7 +310,10 @@ void CodeCacheBackend::AddBlockPhysicalMapping(PhysicalMemoryAddress address, Bl
 {
   const u32 page_index = Bus::GetMemoryPageIndex(address);
   m_physical_page_blocks[page_index].Add(block);
-  m_bus->MarkPageAsCode(address);
+
+  u32 start_offset, end_offset;
+  GetBlockRangeInPage(block, address, &start_offset, &end_offset);
+  m_bus->MarkPageAsCode(address, Bus::GetCodeBitmapMask(start_offset, end_offset - start_offset));
 }
 
 void CodeCacheBackend::AddBlockPhysicalMappings(BlockBase* block)
@@ -282,6 +344,12 @@ bool CodeCacheBackend::CompileBlockBase(BlockBase* block)
   static constexpr u32 BUFFER_SIZE = 64;
   DebugAssert(block != nullptr);
 
+  if (m_persistent_code_cache_enabled && LoadBlockFromPersistentCache(block))
+  {
+    DetectIdleLoop(block);
+    return true;
+  }
+
   struct FetchCallback
   {
     void FillBuffer()
@@ -435,6 +503,9 @@ bool CodeCacheBackend::CompileBlockBase(BlockBase* block)
     block->code_length += instruction->length;
     next_EIP = (next_EIP + instruction->length) & m_cpu->m_EIP_mask;
 
+    if (LoadsKeyedSegment(instruction))
+      block->flags |= BlockFlags::LoadsSegments;
+
     if (IsExitBlockInstruction(instruction))
     {
       if (IsLinkableExitInstruction(instruction))
@@ -485,6 +556,10 @@ bool CodeCacheBackend::CompileBlockBase(BlockBase* block)
 
   // Hash the code block to check invalidation.
   block->code_hash = GetBlockCodeHash(block);
+  if (m_persistent_code_cache_enabled)
+    AddPersistentBlock(block);
+
+  DetectIdleLoop(block);
 
   // Log_ErrorPrintf("Block %08X - %u inst, %u length", block->key.eip_physical_address,
   // unsigned(block->instructions.size()), block->code_length);
@@ -494,7 +569,7 @@ bool CodeCacheBackend::CompileBlockBase(BlockBase* block)
 
 void CodeCacheBackend::InsertBlock(BlockBase* block)
 {
-  m_blocks.emplace(block->key, block);
+  m_blocks.Insert(block);
   AddBlockPhysicalMappings(block);
 }
 
@@ -540,6 +615,9 @@ void CodeCacheBackend::InterpretUncachedBlock()
     return true;
   };
 
+  if (m_block_profiling)
+    ProfileFallback();
+
   // The prefetch queue is an unknown state, and likely not in sync with our execution.
   m_cpu->FlushPrefetchQueue();
 
@@ -580,7 +658,413 @@ void CodeCacheBackend::InterpretUncachedBlock()
       break;
   }
 
+  m_cpu->MaterializeLazyFlags();
+  m_cpu->CommitPendingCycles();
+}
+
+bool CodeCacheBackend::IsIdleLoopBlock(const BlockBase* block)
+{
+  static constexpr size_t MAX_IDLE_LOOP_INSTRUCTIONS = 8;
+  if (block->instructions.empty() || block->instructions.size() > MAX_IDLE_LOOP_INSTRUCTIONS ||
+      block->CrossesPage())
+  {
+    return false;
+  }
+
+  // The block has to end with a branch back to its first instruction.
+  const Instruction& branch = block->instructions.back();
+  const size_t target_operand = (branch.operation == Operation_Jcc) ? 1 : 0;
+  if ((branch.operation != Operation_Jcc && branch.operation != Operation_JMP_Near) ||
+      branch.operands[target_operand].mode != OperandMode_Relative)
+  {
+    return false;
+  }
+
+  const u32 eip_mask = block->Is32BitCode() ? UINT32_C(0xFFFFFFFF) : UINT32_C(0xFFFF);
+  const u32 target_mask = (branch.GetOperandSize() == OperandSize_16) ? UINT32_C(0xFFFF) : UINT32_C(0xFFFFFFFF);
+  const u32 target_eip = (((branch.address + branch.length) & eip_mask) + branch.data.disp32) & target_mask;
+  if (target_eip != block->instructions.front().address)
+    return false;
+
+  // Anything else can only read memory, IO ports, or write registers. Memory reads are assumed to be from RAM, or
+  // MMIO which doesn't change between events. IO ports are checked against the port number when the loop is found.
+  for (size_t i = 0; i < block->instructions.size() - 1; i++)
+  {
+    const Instruction& instruction = block->instructions[i];
+    switch (instruction.operation)
+    {
+      case Operation_NOP:
+      case Operation_CMP:
+      case Operation_TEST:
+      case Operation_IN:
+        break;
+
+      case Operation_MOV:
+      case Operation_MOVZX:
+      case Operation_MOVSX:
+      case Operation_AND:
+      case Operation_OR:
+      case Operation_XOR:
+      case Operation_ADD:
+      case Operation_SUB:
+      {
+        if (!instruction.IsRegisterOperand(0))
+          return false;
+      }
+      break;
+
+      default:
+        return false;
+    }
+  }
+
+  return true;
+}
+
+void CodeCacheBackend::DetectIdleLoop(BlockBase* block)
+{
+  if (m_idle_loop_skipping && IsIdleLoopBlock(block))
+  {
+    Log_DebugPrintf("Block %08X is an idle loop candidate", block->key.eip_physical_address);
+    block->flags |= BlockFlags::IdleLoop;
+  }
+}
+
+void CodeCacheBackend::BeginIdleLoopCheck(const BlockBase* block)
+{
+  if (block->IsIdleLoop())
+    std::memcpy(m_idle_loop_registers.data(), m_cpu->m_registers.reg32, sizeof(m_idle_loop_registers));
+}
+
+void CodeCacheBackend::EndIdleLoopCheck(const BlockBase* block)
+{
+  // EIP is part of the saved registers, so this also checks that the loop branched back to itself.
+  if (!block->IsIdleLoop() || m_cpu->m_execution_downcount <= 0 || m_cpu->HasExternalInterrupt() ||
+      std::memcmp(m_idle_loop_registers.data(), m_cpu->m_registers.reg32, sizeof(m_idle_loop_registers)) != 0)
+  {
+    return;
+  }
+
+  for (const Instruction& instruction : block->instructions)
+  {
+    if (instruction.operation != Operation_IN)
+      continue;
+
+    const u16 port = (instruction.operands[1].mode == OperandMode_Immediate) ? ZeroExtend16(instruction.data.imm8) :
+                                                                              m_cpu->m_registers.DX;
+    const u16 size = (instruction.operands[0].size == OperandSize_8) ?
+                       1 :
+                       ((instruction.GetOperandSize() == OperandSize_16) ? 2 : 4);
+    for (u16 i = 0; i < size; i++)
+    {
+      if (!m_bus->IsIOPortReadIdle(static_cast<u16>(port + i)))
+        return;
+    }
+  }
+
+  // Nothing the loop reads can change until the next event runs, so skip ahead to it, the same as when halted.
+  const CycleCount cycles = m_cpu->m_execution_downcount;
+  m_cpu->m_execution_stats.idle_cycles_skipped += static_cast<u64>(cycles);
+  m_cpu->m_pending_cycles += cycles;
   m_cpu->CommitPendingCycles();
 }
 
+void CodeCacheBackend::ProfileBlockCompile(BlockBase* block)
+{
+  BlockProfile* profile = block->profile;
+  if (!profile)
+    return;
+
+  profile->compile_count++;
+  profile->instructions.clear();
+  profile->instructions.reserve(block->instructions.size());
+  for (const Instruction& instruction : block->instructions)
+    profile->instructions.push_back(instruction);
+  profile->cs = m_cpu->m_registers.CS;
+  profile->eip = block->instructions.front().address;
+}
+
+void CodeCacheBackend::ProfileFallback()
+{
+  BlockKey key;
+  if (!GetBlockKeyForCurrentState(&key))
+  {
+    m_unkeyed_fallback_count++;
+    return;
+  }
+
+  BlockProfile& profile = m_block_profiles[key];
+  profile.fallback_count++;
+  profile.cs = m_cpu->m_registers.CS;
+  profile.eip = m_cpu->m_registers.EIP;
+}
+
+void CodeCacheBackend::DumpBlockProfile(u32 count)
+{
+  if (!m_block_profiling)
+  {
+    Log_WarningPrintf("Block profiler is not enabled, set the BlockProfiler CPU property to use it.");
+    return;
+  }
+
+  using ProfileEntry = std::pair<BlockKey, const BlockProfile*>;
+  std::vector<ProfileEntry> entries;
+  entries.reserve(m_block_profiles.size());
+  u64 total_cycles = 0;
+  u64 total_executions = 0;
+  u64 total_invalidations = 0;
+  u64 total_fallbacks = m_unkeyed_fallback_count;
+  for (const auto& it : m_block_profiles)
+  {
+    entries.emplace_back(it.first, &it.second);
+    total_cycles += it.second.cycles;
+    total_executions += it.second.execution_count;
+    total_invalidations += it.second.invalidation_count;
+    total_fallbacks += it.second.fallback_count;
+  }
+
+  Log_InfoPrintf("Block profile: %zu blocks, %" PRIu64 " executions, %" PRIu64 " cycles, %" PRIu64
+                 " invalidations, %" PRIu64 " interpreter fallbacks (%" PRIu64 " without a block key)",
+                 entries.size(), total_executions, total_cycles, total_invalidations, total_fallbacks,
+                 m_unkeyed_fallback_count);
+
+  auto LogEntries = [&entries, count](const char* title, u64 BlockProfile::*field, bool disassemble) {
+    const size_t num_entries = std::min(entries.size(), static_cast<size_t>(count));
+    std::partial_sort(entries.begin(), entries.begin() + num_entries, entries.end(),
+                      [field](const ProfileEntry& lhs, const ProfileEntry& rhs) {
+                        return (lhs.second->*field > rhs.second->*field);
+                      });
+
+    Log_InfoPrintf("Top %zu blocks by %s:", num_entries, title);
+    for (size_t i = 0; i < num_entries; i++)
+    {
+      const BlockKey& key = entries[i].first;
+      const BlockProfile* profile = entries[i].second;
+      if (profile->*field == 0)
+        break;
+
+      Log_InfoPrintf("  %08X %04X:%08X %s: %" PRIu64 " executions, %" PRIu64 " cycles, %" PRIu64
+                     " compiles, %" PRIu64 " invalidations, %" PRIu64 " fallbacks",
+                     key.eip_physical_address, ZeroExtend32(profile->cs), profile->eip,
+                     key.IsV8086Code() ? "v86" : (key.Is32BitCode() ? "32" : "16"), profile->execution_count,
+                     profile->cycles, profile->compile_count, profile->invalidation_count, profile->fallback_count);
+
+      if (!disassemble)
+        continue;
+
+      SmallString disassembly;
+      for (const Instruction& instruction : profile->instructions)
+      {
+        Decoder::DisassembleToString(&instruction, &disassembly);
+        Log_InfoPrintf("    %08X  %s", instruction.address, disassembly.GetCharArray());
+      }
+    }
+  };
+
+  // Compute-bound code shows up by cycles, self-modifying code by invalidations, and code the backends can't
+  // handle by fallbacks.
+  LogEntries("cycles", &BlockProfile::cycles, true);
+  LogEntries("invalidations", &BlockProfile::invalidation_count, false);
+  LogEntries("interpreter fallbacks", &BlockProfile::fallback_count, false);
+}
+
+// Bump when the Instruction structure or decoder output changes.
+static constexpr u32 PERSISTENT_CODE_CACHE_MAGIC = 0x43434550; // PECC
+static constexpr u32 PERSISTENT_CODE_CACHE_VERSION = 3;
+
+// Bounds on the number of cached blocks. A key can have several variants with different code, e.g. when a program is
+// loaded at the same address as a previous one, only the most recent ones are kept.
+static constexpr u32 MAX_PERSISTENT_BLOCKS = 131072;
+static constexpr u32 MAX_PERSISTENT_BLOCKS_PER_KEY = 4;
+
+void CodeCacheBackend::LoadPersistentCodeCache()
+{
+  if (!FileSystem::FileExists(m_persistent_code_cache_filename))
+    return;
+
+  AutoReleasePtr<ByteStream> stream =
+    FileSystem::OpenFile(m_persistent_code_cache_filename, BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
+  if (!stream)
+    return;
+
+  BinaryReader reader(stream);
+  if (reader.ReadUInt32() != PERSISTENT_CODE_CACHE_MAGIC || reader.ReadUInt32() != PERSISTENT_CODE_CACHE_VERSION ||
+      reader.ReadUInt32() != sizeof(Instruction) || reader.ReadUInt32() != static_cast<u32>(m_cpu->m_model))
+  {
+    Log_WarningPrintf("Code cache '%s' is incompatible, ignoring", m_persistent_code_cache_filename.GetCharArray());
+    return;
+  }
+
+  const u32 num_blocks = std::min(reader.ReadUInt32(), MAX_PERSISTENT_BLOCKS);
+  for (u32 i = 0; i < num_blocks; i++)
+  {
+    BlockKey key;
+    PersistentBlock pblock;
+    key.qword = reader.ReadUInt64();
+    pblock.code_hash = reader.ReadUInt64();
+    pblock.total_cycles = reader.ReadInt64();
+    pblock.eip = reader.ReadUInt32();
+    pblock.code_length = reader.ReadUInt32();
+    pblock.next_page_physical_address = reader.ReadUInt32();
+    pblock.flags = static_cast<BlockFlags>(reader.ReadUInt32());
+    pblock.sequence = reader.ReadUInt64();
+
+    const u32 num_instructions = reader.ReadUInt32();
+    if (reader.GetErrorState() || num_instructions == 0 || num_instructions > pblock.code_length)
+      break;
+
+    pblock.instructions.resize(num_instructions);
+    if (!reader.SafeReadBytes(pblock.instructions.data(), num_instructions * sizeof(Instruction)))
+      break;
+
+    if (m_persistent_blocks.count(key) >= MAX_PERSISTENT_BLOCKS_PER_KEY)
+      continue;
+
+    m_next_persistent_block_sequence = std::max(m_next_persistent_block_sequence, pblock.sequence + 1);
+    m_persistent_blocks.emplace(key, std::move(pblock));
+  }
+
+  if (reader.GetErrorState())
+  {
+    Log_WarningPrintf("Code cache '%s' is truncated", m_persistent_code_cache_filename.GetCharArray());
+    m_persistent_blocks.clear();
+    m_next_persistent_block_sequence = 0;
+    return;
+  }
+
+  Log_InfoPrintf("Loaded %u blocks from code cache '%s'", static_cast<u32>(m_persistent_blocks.size()),
+                 m_persistent_code_cache_filename.GetCharArray());
+}
+
+void CodeCacheBackend::SavePersistentCodeCache()
+{
+  AutoReleasePtr<ByteStream> stream = FileSystem::OpenFile(
+    m_persistent_code_cache_filename,
+    BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_WRITE | BYTESTREAM_OPEN_TRUNCATE | BYTESTREAM_OPEN_STREAMED);
+  if (!stream)
+  {
+    Log_WarningPrintf("Failed to open '%s'", m_persistent_code_cache_filename.GetCharArray());
+    return;
+  }
+
+  BinaryWriter writer(stream);
+  writer.WriteUInt32(PERSISTENT_CODE_CACHE_MAGIC);
+  writer.WriteUInt32(PERSISTENT_CODE_CACHE_VERSION);
+  writer.WriteUInt32(sizeof(Instruction));
+  writer.WriteUInt32(static_cast<u32>(m_cpu->m_model));
+  writer.WriteUInt32(static_cast<u32>(m_persistent_blocks.size()));
+  for (const auto& it : m_persistent_blocks)
+  {
+    const PersistentBlock& pblock = it.second;
+    writer.WriteUInt64(it.first.qword);
+    writer.WriteUInt64(pblock.code_hash);
+    writer.WriteInt64(pblock.total_cycles);
+    writer.WriteUInt32(pblock.eip);
+    writer.WriteUInt32(pblock.code_length);
+    writer.WriteUInt32(pblock.next_page_physical_address);
+    writer.WriteUInt32(static_cast<u32>(pblock.flags));
+    writer.WriteUInt64(pblock.sequence);
+    writer.WriteUInt32(static_cast<u32>(pblock.instructions.size()));
+    writer.WriteBytes(pblock.instructions.data(), static_cast<u32>(pblock.instructions.size() * sizeof(Instruction)));
+  }
+
+  if (writer.InErrorState())
+  {
+    Log_WarningPrintf("Failed to write code cache '%s'", m_persistent_code_cache_filename.GetCharArray());
+    return;
+  }
+
+  Log_InfoPrintf("Saved %u blocks to code cache '%s'", static_cast<u32>(m_persistent_blocks.size()),
+                 m_persistent_code_cache_filename.GetCharArray());
+}
+
+void CodeCacheBackend::AddPersistentBlock(const BlockBase* block)
+{
+  // The same code can be decoded again after a flush.
+  auto range = m_persistent_blocks.equal_range(block->key);
+  auto oldest = range.first;
+  u32 key_count = 0;
+  for (auto it = range.first; it != range.second; ++it, key_count++)
+  {
+    if (it->second.code_hash == block->code_hash && it->second.eip == block->instructions.front().address)
+      return;
+    if (it->second.sequence < oldest->second.sequence)
+      oldest = it;
+  }
+
+  // Replace the oldest variant of this key when it is full, and stop growing once the cache is full.
+  if (key_count >= MAX_PERSISTENT_BLOCKS_PER_KEY)
+    m_persistent_blocks.erase(oldest);
+  else if (m_persistent_blocks.size() >= MAX_PERSISTENT_BLOCKS)
+    return;
+
+  PersistentBlock pblock;
+  pblock.instructions.reserve(block->instructions.size());
+  for (const Instruction& instruction : block->instructions)
+    pblock.instructions.push_back(instruction);
+  pblock.total_cycles = block->total_cycles;
+  pblock.code_hash = block->code_hash;
+  pblock.eip = block->instructions.front().address;
+  pblock.code_length = block->code_length;
+  pblock.next_page_physical_address = block->next_page_physical_address;
+  pblock.flags = block->flags & (BlockFlags::Linkable | BlockFlags::CrossesPage | BlockFlags::LoadsSegments);
+  pblock.sequence = m_next_persistent_block_sequence++;
+  m_persistent_blocks.emplace(block->key, std::move(pblock));
+}
+
+bool CodeCacheBackend::LoadBlockFromPersistentCache(BlockBase* block)
+{
+  const u32 EIP = m_cpu->m_registers.EIP;
+  const CPU::SegmentCache& segcache = m_cpu->m_segment_cache[Segment_CS];
+
+  auto range = m_persistent_blocks.equal_range(block->key);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    // Instructions store the virtual address, so the EIP has to match, and the whole block must be within the limit.
+    const PersistentBlock& pblock = it->second;
+    if (pblock.eip != EIP || EIP < segcache.limit_low ||
+        (static_cast<u64>(EIP) + pblock.code_length) > static_cast<u64>(segcache.limit_high))
+    {
+      continue;
+    }
+
+    // The second page has to be mapped to the same physical page.
+    if ((pblock.flags & BlockFlags::CrossesPage) != BlockFlags::None)
+    {
+      const LinearMemoryAddress eip_linear_address = m_cpu->CalculateLinearAddress(Segment_CS, EIP);
+      PhysicalMemoryAddress next_page_physical_address;
+      if (!m_cpu->TranslateLinearAddress(
+            &next_page_physical_address, ((eip_linear_address + CPU::PAGE_SIZE) & CPU::PAGE_MASK),
+            AddAccessTypeToFlags(AccessType::Execute, AccessFlags::Normal | AccessFlags::NoPageFaults)) ||
+          ((next_page_physical_address & m_bus->GetMemoryAddressMask()) & CPU::PAGE_MASK) !=
+            pblock.next_page_physical_address ||
+          !m_bus->IsCachablePage(pblock.next_page_physical_address))
+      {
+        continue;
+      }
+    }
+
+    block->code_length = pblock.code_length;
+    block->next_page_physical_address = pblock.next_page_physical_address;
+    block->flags = pblock.flags;
+    if (GetBlockCodeHash(block) != pblock.code_hash)
+    {
+      block->code_length = 0;
+      block->next_page_physical_address = 0;
+      block->flags = BlockFlags::None;
+      continue;
+    }
+
+    block->instructions.reserve(pblock.instructions.size());
+    for (const Instruction& instruction : pblock.instructions)
+      block->instructions.push_back(instruction);
+    block->total_cycles = pblock.total_cycles;
+    block->code_hash = pblock.code_hash;
+    Log_DebugPrintf("Block %08X loaded from code cache", block->key.eip_physical_address);
+    return true;
+  }
+
+  return false;
+}
+
 } // namespace CPU_X86
@@ -5,6 +5,8 @@
 #include "pce/cpu_x86/instruction.h"
 #include "pce/cpu_x86/code_cache_types.h"
 #include "YBaseLib/PODArray.h"
+#include "YBaseLib/String.h"
+#include <array>
 #include <unordered_map>
 
 namespace CPU_X86 {
@@ -16,7 +18,9 @@ public:
   ~CodeCacheBackend();
 
   virtual size_t GetCodeBlockCount() const override;
+  virtual size_t GetCodeCacheSize() const override;
   virtual void FlushCodeCache() override;
+  virtual void DumpBlockProfile(u32 count) override;
 
 protected:
   /// Allocates storage for a block.
@@ -44,10 +48,14 @@ protected:
   void InsertBlock(BlockBase* block);
 
   /// Invalidates a single block of code, ensuring the code is re-hashed next execution.
-  void InvalidateBlock(BlockBase* block);
+  virtual void InvalidateBlock(BlockBase* block);
 
-  /// Invalidates any code blocks with a matching physical page.
-  void InvalidateBlocksWithPhysicalPage(PhysicalMemoryAddress physical_page_address);
+  /// Invalidates any code blocks overlapping the specified physical memory range. The range must be within a page.
+  void InvalidateBlocksWithPhysicalRange(PhysicalMemoryAddress address, u32 size);
+
+  /// Returns the range of page offsets covered by a block in the specified physical page.
+  static void GetBlockRangeInPage(const BlockBase* block, PhysicalMemoryAddress page_address, u32* start_offset,
+                                  u32* end_offset);
 
   /// Removes the physical page -> block mapping for block.
   void AddBlockPhysicalMapping(PhysicalMemoryAddress address, BlockBase* block);
@@ -67,22 +75,65 @@ protected:
   bool CanExecuteBlock(BlockBase* block);
 
   /// Link block from to to.
-  void LinkBlockBase(BlockBase* from, BlockBase* to);
+  virtual void LinkBlockBase(BlockBase* from, BlockBase* to);
 
   /// Unlink all blocks which point to this block, and any that this block links to.
-  void UnlinkBlockBase(BlockBase* block);
+  virtual void UnlinkBlockBase(BlockBase* block);
 
   /// Runs the interpreter until the emulated CPU branches.
   void InterpretUncachedBlock();
 
+  /// Idle loop detection. A block which only reads memory or IO ports the devices marked as idle, and branches back to
+  /// itself with no change to the registers, will spin until an event changes what it reads. The cycles until then
+  /// are skipped.
+  static bool IsIdleLoopBlock(const BlockBase* block);
+  void DetectIdleLoop(BlockBase* block);
+  void BeginIdleLoopCheck(const BlockBase* block);
+  void EndIdleLoopCheck(const BlockBase* block);
+
+  /// Block profiler. Records a successful compile of a block, or falling back to the interpreter at the current state.
+  void ProfileBlockCompile(BlockBase* block);
+  void ProfileFallback();
+
+  /// Persistent code cache. Blocks are stored by key and code hash, and reused if the guest code is unchanged.
+  void LoadPersistentCodeCache();
+  void SavePersistentCodeCache();
+  void AddPersistentBlock(const BlockBase* block);
+  bool LoadBlockFromPersistentCache(BlockBase* block);
+
   CPU* m_cpu;
   System* m_system;
   Bus* m_bus;
 
-  std::unordered_map<BlockKey, BlockBase*, BlockKeyHash> m_blocks;
+  BlockMap m_blocks;
 
   using BlockArray = PODArray<BlockBase*>;
   std::unique_ptr<BlockArray[]> m_physical_page_blocks;
   bool m_branched = false;
+
+  struct PersistentBlock
+  {
+    std::vector<Instruction> instructions;
+    CycleCount total_cycles;
+    Bus::CodeHashType code_hash;
+    VirtualMemoryAddress eip;
+    u32 code_length;
+    u32 next_page_physical_address;
+    BlockFlags flags;
+    u64 sequence; // order of insertion, the lowest variant of a key is evicted first
+  };
+  std::unordered_multimap<BlockKey, PersistentBlock, BlockKeyHash> m_persistent_blocks;
+  u64 m_next_persistent_block_sequence = 0;
+  String m_persistent_code_cache_filename;
+  bool m_persistent_code_cache_enabled = false;
+
+  // Profiles are never removed, so blocks can hold pointers to them.
+  std::unordered_map<BlockKey, BlockProfile, BlockKeyHash> m_block_profiles;
+  u64 m_unkeyed_fallback_count = 0;
+  bool m_block_profiling = false;
+
+  // General purpose registers, EIP and EFLAGS when an idle loop candidate was entered.
+  std::array<u32, Reg32_EFLAGS + 1> m_idle_loop_registers = {};
+  bool m_idle_loop_skipping = false;
 };
 } // namespace CPU_X86
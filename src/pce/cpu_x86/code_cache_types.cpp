@@ -1,10 +1,135 @@
 #include "pce/cpu_x86/code_cache_types.h"
+#include "pce/cpu_x86/decoder.h"
+#include <cstring>
 #include <optional>
 
 namespace CPU_X86 {
 
 BlockBase::BlockBase(const BlockKey key_) : key(key_) {}
 
+BlockMap::BlockMap(u32 num_pages) : m_page_tables(num_pages) {}
+
+BlockMap::~BlockMap() = default;
+
+BlockMap::PageTable::PageTable(u32 capacity_) : entries(std::make_unique<Entry[]>(capacity_)), capacity(capacity_)
+{
+  std::memset(entries.get(), 0, sizeof(Entry) * capacity);
+}
+
+BlockBase* BlockMap::Lookup(const BlockKey key)
+{
+  Entry& recent = m_recent_cache[GetRecentCacheIndex(key)];
+  if (recent.key == key.qword && recent.block)
+    return recent.block;
+
+  const PageTable* table = m_page_tables[Bus::GetMemoryPageIndex(key.eip_physical_address)].get();
+  if (!table)
+    return nullptr;
+
+  const u32 mask = table->capacity - 1;
+  for (u32 i = GetPageTableIndex(key, table->capacity);; i = (i + 1) & mask)
+  {
+    const Entry& entry = table->entries[i];
+    if (!entry.block)
+      return nullptr;
+
+    if (entry.key == key.qword)
+    {
+      recent = entry;
+      return entry.block;
+    }
+  }
+}
+
+void BlockMap::Insert(BlockBase* block)
+{
+  std::unique_ptr<PageTable>& table = m_page_tables[Bus::GetMemoryPageIndex(block->key.eip_physical_address)];
+  if (!table)
+  {
+    table = std::make_unique<PageTable>(INITIAL_PAGE_TABLE_SIZE);
+  }
+  else if ((table->count + 1) * 2 > table->capacity)
+  {
+    // Keep the load factor at or below 50%, so probe sequences stay short.
+    auto new_table = std::make_unique<PageTable>(table->capacity * 2);
+    for (u32 i = 0; i < table->capacity; i++)
+    {
+      if (table->entries[i].block)
+        InsertIntoPageTable(new_table.get(), table->entries[i]);
+    }
+    table = std::move(new_table);
+  }
+
+  InsertIntoPageTable(table.get(), Entry{block->key.qword, block});
+  m_block_count++;
+}
+
+void BlockMap::InsertIntoPageTable(PageTable* table, const Entry& entry)
+{
+  BlockKey key;
+  key.qword = entry.key;
+
+  const u32 mask = table->capacity - 1;
+  u32 i = GetPageTableIndex(key, table->capacity);
+  while (table->entries[i].block)
+  {
+    DebugAssert(table->entries[i].key != entry.key);
+    i = (i + 1) & mask;
+  }
+
+  table->entries[i] = entry;
+  table->count++;
+}
+
+bool BlockMap::Remove(const BlockBase* block)
+{
+  Entry& recent = m_recent_cache[GetRecentCacheIndex(block->key)];
+  if (recent.block == block)
+    recent = {};
+
+  PageTable* table = m_page_tables[Bus::GetMemoryPageIndex(block->key.eip_physical_address)].get();
+  if (!table)
+    return false;
+
+  const u32 mask = table->capacity - 1;
+  u32 i = GetPageTableIndex(block->key, table->capacity);
+  for (;; i = (i + 1) & mask)
+  {
+    if (!table->entries[i].block)
+      return false;
+    if (table->entries[i].block == block)
+      break;
+  }
+
+  // Shift back any entries in the same probe sequence, so lookups don't stop early at the hole.
+  table->entries[i] = {};
+  for (u32 j = (i + 1) & mask; table->entries[j].block; j = (j + 1) & mask)
+  {
+    BlockKey key;
+    key.qword = table->entries[j].key;
+    const u32 home = GetPageTableIndex(key, table->capacity);
+    const bool home_in_range = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+    if (home_in_range)
+      continue;
+
+    table->entries[i] = table->entries[j];
+    table->entries[j] = {};
+    i = j;
+  }
+
+  table->count--;
+  m_block_count--;
+  return true;
+}
+
+void BlockMap::Clear()
+{
+  for (std::unique_ptr<PageTable>& table : m_page_tables)
+    table.reset();
+  m_recent_cache.fill({});
+  m_block_count = 0;
+}
+
 bool IsExitBlockInstruction(const Instruction* instruction)
 {
   switch (instruction->operation)
@@ -88,6 +213,32 @@ bool IsLinkableExitInstruction(const Instruction* instruction)
   return false;
 }
 
+bool LoadsKeyedSegment(const Instruction* instruction)
+{
+  Segment segment;
+  switch (instruction->operation)
+  {
+    case Operation_MOV_Sreg:
+    {
+      if (instruction->operands[0].mode != OperandMode_ModRM_SegmentReg)
+        return false;
+
+      segment = static_cast<Segment>(instruction->data.GetModRM_Reg());
+    }
+    break;
+
+    case Operation_POP_Sreg:
+    case Operation_LXS:
+      segment = instruction->operands[0].segreg;
+      break;
+
+    default:
+      return false;
+  }
+
+  return (segment == Segment_ES || segment == Segment_SS || segment == Segment_DS);
+}
+
 bool CanInstructionFault(const Instruction* instruction)
 {
   switch (instruction->operation)
@@ -101,6 +252,8 @@ bool CanInstructionFault(const Instruction* instruction)
     case Operation_STC:
     case Operation_STD:
     case Operation_LEA:
+    case Operation_CBW:
+    case Operation_CWD:
       return false;
 
     case Operation_ADD:
@@ -113,6 +266,15 @@ bool CanInstructionFault(const Instruction* instruction)
     case Operation_CMP:
     case Operation_TEST:
     case Operation_MOV:
+    case Operation_MOVZX:
+    case Operation_MOVSX:
+    case Operation_XCHG:
+    case Operation_BT:
+    case Operation_BTS:
+    case Operation_BTR:
+    case Operation_BTC:
+    case Operation_BSF:
+    case Operation_BSR:
     {
       for (u32 i = 0; i < 2; i++)
       {
@@ -132,11 +294,245 @@ bool CanInstructionFault(const Instruction* instruction)
       return (!instruction->IsRegisterOperand(0) && instruction->operands[0].mode != OperandMode_Immediate);
     }
 
+    case Operation_SETcc:
+    {
+      // Operand 0 is the condition.
+      return !instruction->IsRegisterOperand(1);
+    }
+
     default:
       return true;
   }
 }
 
+void GetInstructionFlagUsage(const Instruction* instruction, u32* read_flags, u32* written_flags)
+{
+  constexpr u32 arithmetic_flags = Flag_CF | Flag_PF | Flag_AF | Flag_ZF | Flag_SF | Flag_OF;
+  switch (instruction->operation)
+  {
+    case Operation_ADD:
+    case Operation_SUB:
+    case Operation_CMP:
+    case Operation_AND:
+    case Operation_OR:
+    case Operation_XOR:
+    case Operation_TEST:
+    case Operation_NEG:
+      *read_flags = 0;
+      *written_flags = arithmetic_flags;
+      break;
+
+    case Operation_ADC:
+    case Operation_SBB:
+      *read_flags = Flag_CF;
+      *written_flags = arithmetic_flags;
+      break;
+
+    case Operation_INC:
+    case Operation_DEC:
+      *read_flags = 0;
+      *written_flags = arithmetic_flags & ~Flag_CF;
+      break;
+
+    case Operation_CLC:
+    case Operation_STC:
+      *read_flags = 0;
+      *written_flags = Flag_CF;
+      break;
+
+    case Operation_CMC:
+      *read_flags = Flag_CF;
+      *written_flags = Flag_CF;
+      break;
+
+    case Operation_NOP:
+    case Operation_MOV:
+    case Operation_MOVZX:
+    case Operation_MOVSX:
+    case Operation_LEA:
+    case Operation_XCHG:
+    case Operation_CBW:
+    case Operation_CWD:
+    case Operation_PUSH:
+    case Operation_POP:
+    case Operation_JMP_Near:
+    case Operation_CALL_Near:
+    case Operation_RET_Near:
+      *read_flags = 0;
+      *written_flags = 0;
+      break;
+
+    default:
+      *read_flags = arithmetic_flags;
+      *written_flags = 0;
+      break;
+  }
+}
+
+static std::optional<u8> GetOperandRegister32Index(const Instruction& instruction, u32 index)
+{
+  const auto reg = GetOperandRegister(instruction, index);
+  if (!reg)
+    return std::nullopt;
+
+  // AH/CH/DH/BH are the upper bytes of EAX/ECX/EDX/EBX.
+  return (instruction.operands[index].size == OperandSize_8) ? static_cast<u8>(*reg & 3) : *reg;
+}
+
+bool GetInstructionRegisterUsage(const Instruction* instruction, u8* read_registers, u8* written_registers,
+                                 u8* overwritten_registers)
+{
+  bool known = false;
+  bool overwrites_destination = false;
+  bool writes_destination = true;
+  bool writes_source = false;
+  switch (instruction->operation)
+  {
+    case Operation_MOV:
+    case Operation_MOVZX:
+    case Operation_MOVSX:
+    case Operation_LEA:
+      known = true;
+      overwrites_destination = true;
+      break;
+
+    case Operation_ADD:
+    case Operation_ADC:
+    case Operation_SUB:
+    case Operation_SBB:
+    case Operation_AND:
+    case Operation_OR:
+    case Operation_XOR:
+    case Operation_INC:
+    case Operation_DEC:
+    case Operation_NOT:
+    case Operation_NEG:
+    case Operation_SHL:
+    case Operation_SHR:
+    case Operation_SAR:
+    case Operation_BTS:
+    case Operation_BTR:
+    case Operation_BTC:
+    case Operation_BSF:
+    case Operation_BSR:
+      known = true;
+      break;
+
+    case Operation_XCHG:
+    case Operation_SETcc: // Operand 0 is the condition.
+      known = true;
+      writes_source = true;
+      break;
+
+    case Operation_CMP:
+    case Operation_TEST:
+    case Operation_BT:
+    case Operation_NOP:
+    case Operation_CLC:
+    case Operation_STC:
+    case Operation_CMC:
+    case Operation_Jcc:
+    case Operation_JMP_Near:
+      known = true;
+      writes_destination = false;
+      break;
+
+    default:
+      break;
+  }
+
+  // Segment/control register moves and the like are left to the conservative path.
+  for (u32 i = 0; i < countof(instruction->operands) && known; i++)
+  {
+    switch (instruction->operands[i].mode)
+    {
+      case OperandMode_None:
+      case OperandMode_Constant:
+      case OperandMode_Register:
+      case OperandMode_Immediate:
+      case OperandMode_Relative:
+      case OperandMode_Memory:
+      case OperandMode_ModRM_Reg:
+      case OperandMode_ModRM_RM:
+      case OperandMode_JumpCondition:
+        break;
+
+      default:
+        known = false;
+        break;
+    }
+  }
+  if (!known)
+  {
+    *read_registers = 0xFF;
+    *written_registers = 0xFF;
+    *overwritten_registers = 0;
+    return false;
+  }
+
+  u8 read = 0;
+  u8 written = 0;
+  u8 overwritten = 0;
+  for (u32 i = 0; i < countof(instruction->operands); i++)
+  {
+    read |= GetOperandAddressRegisters(*instruction, i);
+
+    const auto reg = GetOperandRegister32Index(*instruction, i);
+    if (!reg)
+      continue;
+
+    const u8 mask = static_cast<u8>(1u << *reg);
+    if (i == 0 && overwrites_destination && instruction->operands[i].size == OperandSize_32)
+    {
+      overwritten |= mask;
+      written |= mask;
+      continue;
+    }
+
+    // Partial writes merge with the old value, so count as a read.
+    read |= mask;
+
+    if ((i == 0 && writes_destination) || (i == 1 && writes_source))
+      written |= mask;
+  }
+
+  *read_registers = read;
+  *written_registers = written;
+  *overwritten_registers = overwritten;
+  return true;
+}
+
+u8 GetOperandAddressRegisters(const Instruction& instruction, u32 index)
+{
+  if (instruction.operands[index].mode != OperandMode_ModRM_RM || instruction.ModRM_RM_IsReg())
+    return 0;
+
+  const Decoder::ModRMAddress* modrm = Decoder::DecodeModRMAddress(instruction.GetAddressSize(), instruction.data.modrm);
+  switch (modrm->addressing_mode)
+  {
+    case ModRMAddressingMode::Indirect:
+    case ModRMAddressingMode::Indexed:
+      return static_cast<u8>(1u << modrm->base_register);
+
+    case ModRMAddressingMode::BasedIndexed:
+    case ModRMAddressingMode::BasedIndexedDisplacement:
+      return static_cast<u8>((1u << modrm->base_register) | (1u << modrm->index_register));
+
+    case ModRMAddressingMode::SIB:
+    {
+      u8 mask = 0;
+      if (instruction.HasSIBBase())
+        mask |= static_cast<u8>(1u << instruction.GetSIBBaseRegister());
+      if (instruction.HasSIBIndex())
+        mask |= static_cast<u8>(1u << instruction.GetSIBIndexRegister());
+      return mask;
+    }
+
+    default:
+      return 0;
+  }
+}
+
 std::optional<u8> GetOperandRegister(const Instruction& instruction, u32 index)
 {
   const Instruction::Operand& operand = instruction.operands[index];
@@ -2,6 +2,8 @@
 #include "pce/bus.h"
 #include "pce/cpu_x86/cpu_x86.h"
 #include "pce/cpu_x86/instruction.h"
+#include <array>
+#include <memory>
 #include <optional>
 #include <unordered_map>
 
@@ -18,7 +20,8 @@ struct BlockKey
       u32 cs_granularity : 1;
       u32 ss_size : 1;
       u32 v8086_mode : 1;
-      u32 pad : 28;
+      u32 flat_segments : 1; // ES, SS and DS are all flat.
+      u32 pad : 27;
     };
 
     u64 qword;
@@ -63,9 +66,27 @@ enum class BlockFlags : u32
   BackgroundCompiling = (1 << 4), // Only used by recompiler backends.
   Invalidated = (1 << 5),
   DestroyPending = (1 << 6),
+  LoadsSegments = (1 << 7), // Exit key can differ from the entry key, see LoadsKeyedSegment().
+  IdleLoop = (1 << 8),      // Candidate for idle loop skipping, see CodeCacheBackend::IsIdleLoopBlock().
 };
 IMPLEMENT_ENUM_CLASS_BITWISE_OPERATORS(BlockFlags);
 
+/// Execution statistics for a block, when the block profiler is enabled. Kept by key, so they survive the block
+/// being flushed or recompiled. The counters are updated by generated code in the recompiler.
+struct BlockProfile
+{
+  u64 execution_count = 0;
+  u64 cycles = 0;
+  u64 compile_count = 0;
+  u64 invalidation_count = 0;
+  u64 fallback_count = 0;
+
+  // Code from the last compile, for disassembly in the report.
+  std::vector<Instruction> instructions;
+  u16 cs = 0;
+  VirtualMemoryAddress eip = 0;
+};
+
 struct BlockBase
 {
   BlockBase(const BlockKey key_);
@@ -79,6 +100,7 @@ struct BlockBase
   u32 code_length = 0;
   u32 next_page_physical_address = 0;
   BlockFlags flags = BlockFlags::None;
+  BlockProfile* profile = nullptr;
 
   PhysicalMemoryAddress GetPhysicalAddress() const { return key.eip_physical_address; }
   PhysicalMemoryAddress GetPhysicalPageAddress() const { return (key.eip_physical_address & CPU::PAGE_MASK); }
@@ -93,6 +115,11 @@ struct BlockBase
   // Returns true if a block crosses a virtual memory page.
   bool CrossesPage() const { return (flags & BlockFlags::CrossesPage) != BlockFlags::None; }
 
+  // Returns true if the block can change the segments which are part of the key.
+  bool LoadsSegments() const { return (flags & BlockFlags::LoadsSegments) != BlockFlags::None; }
+
+  bool IsIdleLoop() const { return (flags & BlockFlags::IdleLoop) != BlockFlags::None; }
+
   bool IsDestroyPending() const { return (flags & BlockFlags::DestroyPending) != BlockFlags::None; }
 
   bool Is16BitCode() const { return key.Is16BitCode(); }
@@ -100,9 +127,102 @@ struct BlockBase
   bool IsV8086Code() const { return key.IsV8086Code(); }
 };
 
+/// Maps block keys to blocks. Blocks are found through the physical page they start in, which holds a small
+/// open-addressed table keyed by the page offset and mode bits. A direct-mapped cache of recent lookups sits in front.
+class BlockMap
+{
+public:
+  BlockMap(u32 num_pages);
+  ~BlockMap();
+
+  size_t GetBlockCount() const { return m_block_count; }
+
+  /// Returns the block with the specified key, or nullptr.
+  BlockBase* Lookup(const BlockKey key);
+
+  /// Inserts a block. A block with the same key must not already be present.
+  void Insert(BlockBase* block);
+
+  /// Removes a block. Returns false if the block was not present.
+  bool Remove(const BlockBase* block);
+
+  /// Removes all blocks.
+  void Clear();
+
+  template<typename T>
+  void EnumerateBlocks(T callback) const
+  {
+    for (const std::unique_ptr<PageTable>& table : m_page_tables)
+    {
+      if (!table)
+        continue;
+
+      for (u32 i = 0; i < table->capacity; i++)
+      {
+        if (table->entries[i].block)
+          callback(table->entries[i].block);
+      }
+    }
+  }
+
+private:
+  static constexpr u32 RECENT_CACHE_SIZE = 256;
+  static constexpr u32 INITIAL_PAGE_TABLE_SIZE = 8;
+
+  struct Entry
+  {
+    u64 key;
+    BlockBase* block;
+  };
+
+  struct PageTable
+  {
+    PageTable(u32 capacity_);
+
+    std::unique_ptr<Entry[]> entries;
+    u32 capacity;
+    u32 count = 0;
+  };
+
+  static u32 GetRecentCacheIndex(const BlockKey key)
+  {
+    const u32 bits = key.eip_physical_address ^ (key.eip_physical_address >> 12) ^ static_cast<u32>(key.qword >> 32);
+    return bits & (RECENT_CACHE_SIZE - 1);
+  }
+
+  static u32 GetPageTableIndex(const BlockKey key, u32 capacity)
+  {
+    // Page offset and mode bits.
+    const u32 bits = (key.eip_physical_address & CPU::PAGE_OFFSET_MASK) | (static_cast<u32>(key.qword >> 32) << 12);
+    return ((bits * 0x9E3779B1u) >> 16) & (capacity - 1);
+  }
+
+  static void InsertIntoPageTable(PageTable* table, const Entry& entry);
+
+  std::vector<std::unique_ptr<PageTable>> m_page_tables;
+  std::array<Entry, RECENT_CACHE_SIZE> m_recent_cache = {};
+  size_t m_block_count = 0;
+};
+
 bool IsExitBlockInstruction(const Instruction* instruction);
+
+/// Returns true if the instruction can load ES, SS or DS without exiting the block, changing flat_segments.
+bool LoadsKeyedSegment(const Instruction* instruction);
 bool IsLinkableExitInstruction(const Instruction* instruction);
 bool CanInstructionFault(const Instruction* instruction);
+
+/// Returns the arithmetic flags (CF/PF/AF/ZF/SF/OF) read and overwritten by an instruction. Instructions which aren't
+/// known are assumed to read all flags and not write any.
+void GetInstructionFlagUsage(const Instruction* instruction, u32* read_flags, u32* written_flags);
+
+/// Returns the general-purpose registers used by an instruction, as masks of Reg32 indices. Sub-registers map to the
+/// register containing them. overwritten_registers only includes registers where all 32 bits are replaced without
+/// being read. Returns false for instructions which aren't known, which are assumed to read and write all registers.
+bool GetInstructionRegisterUsage(const Instruction* instruction, u8* read_registers, u8* written_registers,
+                                 u8* overwritten_registers);
+
+/// Returns the mask of Reg32 indices used to compute the address of a memory operand.
+u8 GetOperandAddressRegisters(const Instruction& instruction, u32 index);
 bool OperandIsESP(const Instruction& instruction, u32 index);
 
 std::optional<u8> GetOperandRegister(const Instruction& instruction, u32 index);
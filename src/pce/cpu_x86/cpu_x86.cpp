@@ -18,6 +18,14 @@ Log_SetChannel(CPU_X86::CPU);
 namespace CPU_X86 {
 DEFINE_NAMED_OBJECT_TYPE_INFO(CPU, "CPU_X86");
 BEGIN_OBJECT_PROPERTY_MAP(CPU)
+PROPERTY_TABLE_MEMBER_BOOL("PersistentCodeCache", 0, offsetof(CPU, m_persistent_code_cache), nullptr, 0)
+PROPERTY_TABLE_MEMBER_BOOL("RecompilerBlockOptimization", 0, offsetof(CPU, m_recompiler_block_optimization), nullptr,
+                           0)
+PROPERTY_TABLE_MEMBER_BOOL("FastX87", 0, offsetof(CPU, m_fast_x87), nullptr, 0)
+PROPERTY_TABLE_MEMBER_BOOL("RecompilerFastmem", 0, offsetof(CPU, m_recompiler_fastmem), nullptr, 0)
+PROPERTY_TABLE_MEMBER_UINT("RecompilerPerfMap", 0, offsetof(CPU, m_recompiler_perf_map), nullptr, 0)
+PROPERTY_TABLE_MEMBER_BOOL("BlockProfiler", 0, offsetof(CPU, m_block_profiler), nullptr, 0)
+PROPERTY_TABLE_MEMBER_BOOL("IdleLoopSkipping", 0, offsetof(CPU, m_idle_loop_skipping), nullptr, 0)
 END_OBJECT_PROPERTY_MAP()
 
 // Used by backends to enable tracing feature.
@@ -56,7 +64,16 @@ CPU::CPU(const String& identifier, Model model, float frequency,
 {
 }
 
-CPU::~CPU() {}
+CPU::~CPU()
+{
+#ifdef ENABLE_TLB_EMULATION
+  if (m_bus)
+  {
+    m_bus->ClearPageMappingChangeCallback();
+    m_bus->ClearWriteWatchCallback();
+  }
+#endif
+}
 
 const char* CPU::GetModelString() const
 {
@@ -81,7 +98,11 @@ bool CPU::Initialize(System* system, Bus* bus)
     m_cycle_group_timings[i] = Truncate16(g_cycle_group_timings[i][m_model]);
 
 #ifdef ENABLE_TLB_EMULATION
+  // TLB entries hold host pointers, which have to follow the bus page mapping.
   InvalidateAllTLBEntries(true);
+  m_bus->SetPageMappingChangeCallback(
+    [this](PhysicalMemoryAddress page_address, const byte* ram_ptr) { UpdateTLBHostPointers(page_address, ram_ptr); });
+  m_bus->SetWriteWatchCallback([this](PhysicalMemoryAddress address, u32) { OnPagingStructureWrite(address); });
 #endif
 
   // Backend is created on reset.
@@ -98,6 +119,7 @@ void CPU::Reset()
   Y_memzero(&m_registers, sizeof(m_registers));
   Y_memzero(&m_fpu_registers, sizeof(m_fpu_registers));
   Y_memzero(&m_msr_registers, sizeof(m_msr_registers));
+  m_lazy_flags_operation = LazyFlagsOperation::None;
 
   // IOPL NT, reserved are 1 on 8086
   m_registers.EFLAGS.bits = 0;
@@ -150,6 +172,8 @@ void CPU::Reset()
   // CS is F000 but the base is FFFF0000
   m_registers.CS = 0xF000;
   m_segment_cache[Segment_CS].base_address = 0xFFFF0000u;
+  for (u32 i = 0; i < Segment_Count; i++)
+    UpdateSegmentFlatFlag(&m_segment_cache[i]);
   m_registers.EIP = 0xFFF0;
 
   // Protected mode off, FPU not present, cache disabled.
@@ -178,6 +202,7 @@ void CPU::Reset()
   m_fpu_registers.SW.bits = 0x0000;
   m_fpu_registers.TW.bits = 0x5555;
 
+  ClearPagingStructureWatches();
   InvalidateAllTLBEntries(true);
   FlushPrefetchQueue();
 
@@ -202,6 +227,12 @@ bool CPU::DoState(StateWrapper& sw)
     return false;
   }
 
+  // Pending flags aren't part of the state, they are written to EFLAGS before saving.
+  if (sw.IsReading())
+    m_lazy_flags_operation = LazyFlagsOperation::None;
+  else
+    MaterializeLazyFlags();
+
   sw.Do(&m_tsc_cycles);
   sw.Do(&m_current_EIP);
   sw.Do(&m_current_ESP);
@@ -231,6 +262,11 @@ bool CPU::DoState(StateWrapper& sw)
   sw.DoPOD(&m_tss_location);
 
   sw.DoPODArray(m_segment_cache, Segment_Count);
+  if (sw.IsReading())
+  {
+    for (u32 i = 0; i < Segment_Count; i++)
+      UpdateSegmentFlatFlag(&m_segment_cache[i]);
+  }
 
   sw.DoArray(m_msr_registers.raw_regs, countof(m_msr_registers.raw_regs));
 
@@ -247,12 +283,42 @@ bool CPU::DoState(StateWrapper& sw)
   sw.Do(&tlb_entry_count);
   if (tlb_entry_count != Truncate32(TLB_ENTRY_COUNT))
     return false;
+  if (sw.IsReading())
+    ClearPagingStructureWatches();
+  u32 highest_tag = 0;
   for (u32 user_supervisor = 0; user_supervisor < 2; user_supervisor++)
   {
     for (u32 write_read = 0; write_read < 3; write_read++)
-      sw.DoPODArray(m_tlb_entries[user_supervisor][write_read], TLB_ENTRY_COUNT);
+    {
+      // Host pointers aren't saved, they're recreated from the physical address when loading.
+      for (TLBEntry& entry : m_tlb_entries[user_supervisor][write_read])
+      {
+        sw.Do(&entry.linear_address);
+        sw.Do(&entry.physical_address);
+        if (sw.IsReading())
+        {
+          SetTLBEntryPhysicalAddress(entry, entry.physical_address);
+          if ((entry.linear_address & PAGE_OFFSET_MASK) != TLB_INVALID_TAG)
+            highest_tag = std::max(highest_tag, entry.linear_address & PAGE_OFFSET_MASK);
+        }
+      }
+    }
   }
   sw.Do(&m_tlb_counter_bits);
+  if (sw.IsReading())
+  {
+    // Only the current address space's tag is saved, entries with other tags are left unreachable. Its paging
+    // structures aren't watched after loading, so it can't be kept when switching away.
+    for (TLBAddressSpace& address_space : m_tlb_address_spaces)
+      address_space.tag = TLB_INVALID_TAG;
+    m_tlb_next_tag = std::max(highest_tag, m_tlb_counter_bits) + 1;
+    m_tlb_current_address_space = 0;
+    m_tlb_address_spaces[0] = {m_registers.CR3 & PAGE_MASK, m_tlb_counter_bits, ++m_tlb_address_space_counter, true};
+    if ((m_tlb_next_tag + 1) > TLB_INVALID_TAG)
+      InvalidateAllTLBEntries(true);
+    else
+      m_tlb_global_bits = m_tlb_next_tag++;
+  }
 #endif
 
 #ifdef ENABLE_PREFETCH_EMULATION
@@ -316,7 +382,7 @@ void CPU::SignalNMI()
 bool CPU::SupportsBackend(CPU::BackendType mode)
 {
   return (mode == CPU::BackendType::Interpreter || mode == CPU::BackendType::CachedInterpreter ||
-          mode == CPU::BackendType::Recompiler);
+          mode == CPU::BackendType::Recompiler || mode == CPU::BackendType::TieredRecompiler);
 }
 
 void CPU::SetBackend(CPU::BackendType mode)
@@ -327,6 +393,9 @@ void CPU::SetBackend(CPU::BackendType mode)
 
   m_backend_type = mode;
 
+  // Not all backends evaluate pending flags.
+  MaterializeLazyFlags();
+
   // If we're initialized, switch backends now, otherwise wait until we have a system.
   if (m_system)
   {
@@ -345,11 +414,17 @@ void CPU::FlushCodeCache()
   m_backend->FlushCodeCache();
 }
 
+void CPU::DumpBlockProfile(u32 count)
+{
+  m_backend->DumpBlockProfile(count);
+}
+
 void CPU::GetExecutionStats(ExecutionStats* stats) const
 {
   std::memcpy(stats, &m_execution_stats, sizeof(*stats));
   stats->cycles_executed = m_tsc_cycles + m_pending_cycles;
   stats->num_code_cache_blocks = m_backend->GetCodeBlockCount();
+  stats->code_cache_size = m_backend->GetCodeCacheSize();
 }
 
 void CPU::CreateBackend()
@@ -366,7 +441,11 @@ void CPU::CreateBackend()
 
 #if defined(Y_CPU_X64)
     case BackendType::Recompiler:
-      m_backend = std::make_unique<Recompiler::Backend>(this);
+      m_backend = std::make_unique<Recompiler::Backend>(this, false);
+      break;
+
+    case BackendType::TieredRecompiler:
+      m_backend = std::make_unique<Recompiler::Backend>(this, true);
       break;
 #endif
 
@@ -671,6 +750,9 @@ void CPU::TemporaryStack::SwitchTo()
 
 void CPU::SetFlags(u32 value)
 {
+  // Arithmetic flags from a pending operation would overwrite the new value.
+  MaterializeLazyFlags();
+
   // Don't clear/set all flags, only those allowed
   u32 MASK =
     Flag_IOPL | Flag_NT | Flag_CF | Flag_PF | Flag_AF | Flag_ZF | Flag_SF | Flag_TF | Flag_IF | Flag_DF | Flag_OF;
@@ -742,10 +824,11 @@ void CPU::LoadSpecialRegister(Reg32 reg, u32 value)
       if ((value & CR0Bit_NW) != (m_registers.CR0 & CR0Bit_NW))
         Log_ErrorPrintf("CPU cache is now %s", ((value & CR0Bit_NW) != 0) ? "write-back" : "write-through");
 
-      // We must flush the TLB when WP changes, because it changes the cached access masks.
+      // We must flush the TLB when WP changes, because it changes the cached access masks. Identity-mapped entries are
+      // created while paging is disabled, so the TLB must also be flushed when PG changes in either direction.
       u32 new_value = (m_registers.CR0 & ~CHANGE_MASK) | value;
       if (((m_registers.CR0 & CR0Bit_WP) != (new_value & CR0Bit_WP)) ||
-          (!(m_registers.CR0 & CR0Bit_PG) && (new_value & CR0Bit_PG)))
+          ((m_registers.CR0 & CR0Bit_PG) != (new_value & CR0Bit_PG)))
       {
         InvalidateAllTLBEntries();
       }
@@ -771,7 +854,7 @@ void CPU::LoadSpecialRegister(Reg32 reg, u32 value)
         Log_DebugPrintf("CR3 <- 0x%08X", value);
 
       m_registers.CR3 = value;
-      InvalidateAllTLBEntries();
+      SwitchTLBAddressSpace();
       FlushPrefetchQueue();
     }
     break;
@@ -782,7 +865,11 @@ void CPU::LoadSpecialRegister(Reg32 reg, u32 value)
       if (m_registers.CR4.bits != value)
         Log_DebugPrintf("CR4 <- 0x%08X", value);
 
+      // Changing PGE flushes all translations, including global pages.
+      const bool flush_tlb = ((m_registers.CR4.bits ^ value) & CR4Bit_PGE) != 0;
       m_registers.CR4.bits = value;
+      if (flush_tlb)
+        InvalidateAllTLBEntries();
     }
     break;
 
@@ -907,6 +994,11 @@ bool CPU::LookupPageTable(PhysicalMemoryAddress* out_physical_address, LinearMem
   // Updating of accessed/dirty bits is only done with access checks are enabled (=> normal usage)
   if (!HasAccessFlagBit(flags, AccessFlags::NoTLBUpdate))
   {
+#ifdef ENABLE_TLB_EMULATION
+    // Accessed/dirty bits don't change translations, so these writes don't need to discard any address spaces.
+    m_updating_paging_structures = true;
+#endif
+
     // Update accessed bits on directory and table entries
     if (!directory_entry.accessed)
     {
@@ -927,12 +1019,21 @@ bool CPU::LookupPageTable(PhysicalMemoryAddress* out_physical_address, LinearMem
     }
 
 #ifdef ENABLE_TLB_EMULATION
+    m_updating_paging_structures = false;
+
+    // Watching the structures drops the host pointers of TLB entries for their pages, which may include the page
+    // being translated, so this has to happen before the entry is filled.
+    WatchPagingStructure(dir_entry_address);
+    WatchPagingStructure(table_entry_address);
+    m_execution_stats.tlb_misses++;
+
     const size_t tlb_index = GetTLBEntryIndex(linear_address);
     const u8 tlb_user_bit = BoolToUInt8(user_mode);
     const u8 tlb_type = static_cast<u8>(GetAccessTypeFromFlags(flags));
+    const bool global = table_entry.global && (m_registers.CR4.bits & CR4Bit_PGE) != 0;
     TLBEntry& tlb_entry = m_tlb_entries[tlb_user_bit][tlb_type][tlb_index];
-    tlb_entry.linear_address = (linear_address & PAGE_MASK) | m_tlb_counter_bits;
-    tlb_entry.physical_address = page_base_address;
+    tlb_entry.linear_address = (linear_address & PAGE_MASK) | (global ? m_tlb_global_bits : m_tlb_counter_bits);
+    SetTLBEntryPhysicalAddress(tlb_entry, page_base_address);
 #endif
   }
 
@@ -960,17 +1061,16 @@ void CPU::RaisePageFault(LinearMemoryAddress linear_address, AccessFlags flags,
 
 u8 CPU::ReadMemoryByte(CPU* cpu, LinearMemoryAddress address)
 {
-  cpu->TranslateLinearAddress(&address, address, AddAccessTypeToFlags(AccessType::Read, AccessFlags::Normal));
-
-  u8* ram_page_ptr = cpu->m_bus->GetRAMPagePointer(address);
-  if (ram_page_ptr)
+  PhysicalMemoryAddress physical_address;
+  const byte* host_ptr = cpu->TranslateLinearAddressToHostPointer<AccessType::Read>(&physical_address, address);
+  if (host_ptr)
   {
     u8 value;
-    std::memcpy(&value, &ram_page_ptr[address & Bus::MEMORY_PAGE_OFFSET_MASK], sizeof(value));
+    std::memcpy(&value, host_ptr, sizeof(value));
     return value;
   }
 
-  return cpu->m_bus->ReadMemoryByte(address);
+  return cpu->m_bus->ReadMemoryByte(physical_address);
 }
 
 u16 CPU::ReadMemoryWord(CPU* cpu, LinearMemoryAddress address)
@@ -995,17 +1095,16 @@ u16 CPU::ReadMemoryWord(CPU* cpu, LinearMemoryAddress address)
     }
   }
 
-  cpu->TranslateLinearAddress(&address, address, AddAccessTypeToFlags(AccessType::Read, AccessFlags::Normal));
-
-  u8* ram_page_ptr = cpu->m_bus->GetRAMPagePointer(address);
-  if (ram_page_ptr)
+  PhysicalMemoryAddress physical_address;
+  const byte* host_ptr = cpu->TranslateLinearAddressToHostPointer<AccessType::Read>(&physical_address, address);
+  if (host_ptr)
   {
     u16 value;
-    std::memcpy(&value, &ram_page_ptr[address & Bus::MEMORY_PAGE_OFFSET_MASK], sizeof(value));
+    std::memcpy(&value, host_ptr, sizeof(value));
     return value;
   }
 
-  return cpu->m_bus->ReadMemoryWord(address);
+  return cpu->m_bus->ReadMemoryWord(physical_address);
 }
 
 u32 CPU::ReadMemoryDWord(CPU* cpu, LinearMemoryAddress address)
@@ -1030,31 +1129,29 @@ u32 CPU::ReadMemoryDWord(CPU* cpu, LinearMemoryAddress address)
     }
   }
 
-  cpu->TranslateLinearAddress(&address, address, AddAccessTypeToFlags(AccessType::Read, AccessFlags::Normal));
-
-  u8* ram_page_ptr = cpu->m_bus->GetRAMPagePointer(address);
-  if (ram_page_ptr)
+  PhysicalMemoryAddress physical_address;
+  const byte* host_ptr = cpu->TranslateLinearAddressToHostPointer<AccessType::Read>(&physical_address, address);
+  if (host_ptr)
   {
     u32 value;
-    std::memcpy(&value, &ram_page_ptr[address & Bus::MEMORY_PAGE_OFFSET_MASK], sizeof(value));
+    std::memcpy(&value, host_ptr, sizeof(value));
     return value;
   }
 
-  return cpu->m_bus->ReadMemoryDWord(address);
+  return cpu->m_bus->ReadMemoryDWord(physical_address);
 }
 
 void CPU::WriteMemoryByte(CPU* cpu, LinearMemoryAddress address, u8 value)
 {
-  cpu->TranslateLinearAddress(&address, address, AddAccessTypeToFlags(AccessType::Write, AccessFlags::Normal));
-
-  u8* ram_page_ptr = cpu->m_bus->GetRAMPagePointer(address);
-  if (ram_page_ptr)
+  PhysicalMemoryAddress physical_address;
+  byte* host_ptr = cpu->TranslateLinearAddressToHostPointer<AccessType::Write>(&physical_address, address);
+  if (host_ptr)
   {
-    std::memcpy(&ram_page_ptr[address & Bus::MEMORY_PAGE_OFFSET_MASK], &value, sizeof(value));
+    std::memcpy(host_ptr, &value, sizeof(value));
     return;
   }
 
-  cpu->m_bus->WriteMemoryByte(address, value);
+  cpu->m_bus->WriteMemoryByte(physical_address, value);
 }
 
 void CPU::WriteMemoryWord(CPU* cpu, LinearMemoryAddress address, u16 value)
@@ -1079,16 +1176,15 @@ void CPU::WriteMemoryWord(CPU* cpu, LinearMemoryAddress address, u16 value)
     }
   }
 
-  cpu->TranslateLinearAddress(&address, address, AddAccessTypeToFlags(AccessType::Write, AccessFlags::Normal));
-
-  u8* ram_page_ptr = cpu->m_bus->GetRAMPagePointer(address);
-  if (ram_page_ptr)
+  PhysicalMemoryAddress physical_address;
+  byte* host_ptr = cpu->TranslateLinearAddressToHostPointer<AccessType::Write>(&physical_address, address);
+  if (host_ptr)
   {
-    std::memcpy(&ram_page_ptr[address & Bus::MEMORY_PAGE_OFFSET_MASK], &value, sizeof(value));
+    std::memcpy(host_ptr, &value, sizeof(value));
     return;
   }
 
-  cpu->m_bus->WriteMemoryWord(address, value);
+  cpu->m_bus->WriteMemoryWord(physical_address, value);
 }
 
 void CPU::WriteMemoryDWord(CPU* cpu, LinearMemoryAddress address, u32 value)
@@ -1113,16 +1209,15 @@ void CPU::WriteMemoryDWord(CPU* cpu, LinearMemoryAddress address, u32 value)
     }
   }
 
-  cpu->TranslateLinearAddress(&address, address, AddAccessTypeToFlags(AccessType::Write, AccessFlags::Normal));
-
-  u8* ram_page_ptr = cpu->m_bus->GetRAMPagePointer(address);
-  if (ram_page_ptr)
+  PhysicalMemoryAddress physical_address;
+  byte* host_ptr = cpu->TranslateLinearAddressToHostPointer<AccessType::Write>(&physical_address, address);
+  if (host_ptr)
   {
-    std::memcpy(&ram_page_ptr[address & Bus::MEMORY_PAGE_OFFSET_MASK], &value, sizeof(value));
+    std::memcpy(host_ptr, &value, sizeof(value));
     return;
   }
 
-  cpu->m_bus->WriteMemoryDWord(address, value);
+  cpu->m_bus->WriteMemoryDWord(physical_address, value);
 }
 
 u8 CPU::ReadSegmentMemoryByte(Segment segment, VirtualMemoryAddress address)
@@ -1271,6 +1366,8 @@ bool CPU::SafeWriteMemoryDWord(VirtualMemoryAddress address, u32 value, AccessFl
 
 void CPU::PrintCurrentStateAndInstruction(u32 EIP, const char* prefix_message /* = nullptr */)
 {
+  MaterializeLazyFlags();
+
   if (prefix_message)
   {
     std::fprintf(stdout, "%s at EIP = %04X:%08Xh (0x%08X)\n", prefix_message, m_registers.CS, EIP,
@@ -1536,6 +1633,15 @@ void CPU::LoadInterruptDescriptorTable(LinearMemoryAddress table_base_address, u
   Log_DebugPrintf("Load IDT: Base 0x%08X limit 0x%04X", table_base_address, table_limit);
 }
 
+void CPU::UpdateSegmentFlatFlag(SegmentCache* segment_cache)
+{
+  // Expand-down segments can't cover the whole address space, so only the limits need checking.
+  const AccessTypeMask read_write = AccessTypeMask::Read | AccessTypeMask::Write;
+  segment_cache->flat = (segment_cache->base_address == 0 && segment_cache->limit_low == 0 &&
+                         segment_cache->limit_high == 0xFFFFFFFFu &&
+                         (segment_cache->access_mask & read_write) == read_write);
+}
+
 void CPU::LoadSegmentRegister(Segment segment, u16 value)
 {
   static const char* segment_names[Segment_Count] = {"ES", "CS", "SS", "DS", "FS", "GS"};
@@ -1599,6 +1705,7 @@ void CPU::LoadSegmentRegister(Segment segment, u16 value)
       m_stack_address_size = AddressSize_16;
     }
 
+    UpdateSegmentFlatFlag(segment_cache);
     return;
   }
 
@@ -1619,6 +1726,7 @@ void CPU::LoadSegmentRegister(Segment segment, u16 value)
     segment_cache->access.bits = 0;
     segment_cache->access.dpl = 0;
     segment_cache->access_mask = AccessTypeMask::None;
+    segment_cache->flat = false;
     m_registers.segment_selectors[segment] = value;
     Log_TracePrintf("Loaded null selector for %s", segment_names[segment]);
     return;
@@ -1698,6 +1806,7 @@ void CPU::LoadSegmentRegister(Segment segment, u16 value)
     if (descriptor.memory.access.data_writable)
       segment_cache->access_mask |= AccessTypeMask::Write;
   }
+  UpdateSegmentFlatFlag(segment_cache);
 
   Log_TracePrintf("Load segment register %s = %04X: %s index %u base 0x%08X limit 0x%08X->0x%08X",
                   segment_names[segment], ZeroExtend32(value), selector.ti ? "LDT" : "GDT", u32(selector.index),
@@ -1989,6 +2098,7 @@ void CPU::BranchFromException(u32 new_EIP)
 void CPU::AbortCurrentInstruction()
 {
   FlushPrefetchQueue();
+  MaterializeLazyFlags();
 
   Log_TracePrintf("Aborting instruction at %04X:%08X", ZeroExtend32(m_registers.CS), m_registers.EIP);
   m_backend->AbortCurrentInstruction();
@@ -2757,6 +2867,9 @@ void CPU::InterruptReturn(OperandSize operand_size)
 void CPU::SetupInterruptCall(u32 interrupt, bool software_interrupt, bool push_error_code, u32 error_code,
                              u32 return_EIP)
 {
+  // FLAGS is pushed to the stack.
+  MaterializeLazyFlags();
+
   if (InRealMode())
     SetupRealModeInterruptCall(interrupt, return_EIP);
   else
@@ -3140,6 +3253,9 @@ void CPU::SwitchToTask(u16 new_task, bool nested_task, bool from_iret, bool push
   Log_DevPrintf("Switching from task %02X to task %02X%s", ZeroExtend32(m_registers.TR), ZeroExtend32(new_task),
                 nested_task ? " (nested)" : "");
 
+  // EFLAGS is saved to the outgoing TSS.
+  MaterializeLazyFlags();
+
   // Read the current task descriptor. This should never fail.
   SEGMENT_SELECTOR_VALUE current_task_selector = {m_registers.TR};
   DESCRIPTOR_ENTRY current_task_descriptor;
@@ -4123,33 +4239,258 @@ void CPU::DumpStack()
 void CPU::InvalidateAllTLBEntries(bool force_clear /* = false */)
 {
 #ifdef ENABLE_TLB_EMULATION
-  m_tlb_counter_bits++;
-  Log_DebugPrintf("Invaliding TLB entries, counter=0x%03X", m_tlb_counter_bits);
-  if (m_tlb_counter_bits == 0xFFF || force_clear)
+  // Inactive address spaces are discarded, and the current address space and global pages get new tags.
+  if (force_clear || (m_tlb_next_tag + 2) > TLB_INVALID_TAG)
   {
     std::memset(m_tlb_entries, 0xFF, sizeof(m_tlb_entries));
-    m_tlb_counter_bits = 0;
+    ResetTLBRAMPageLinks();
+    m_tlb_next_tag = 0;
+  }
+
+  for (TLBAddressSpace& address_space : m_tlb_address_spaces)
+    address_space.tag = TLB_INVALID_TAG;
+  ReleasePagingStructureWatches(u8((1u << TLB_ADDRESS_SPACE_COUNT) - 1));
+
+  m_tlb_global_bits = m_tlb_next_tag++;
+  m_tlb_counter_bits = m_tlb_next_tag++;
+  m_tlb_current_address_space = 0;
+  m_tlb_address_spaces[0] = {m_registers.CR3 & PAGE_MASK, m_tlb_counter_bits, ++m_tlb_address_space_counter, false};
+  m_execution_stats.tlb_flushes++;
+  Log_DebugPrintf("Invaliding TLB entries, tag=0x%03X", m_tlb_counter_bits);
+#endif
+}
+
+void CPU::UpdateTLBHostPointers(PhysicalMemoryAddress page_address, const byte* ram_ptr)
+{
+#ifdef ENABLE_TLB_EMULATION
+  TLBEntry* entries = &m_tlb_entries[0][0][0];
+  if (page_address == Bus::ALL_PAGES_CHANGED)
+  {
+    // The RAM backing the pages can change too, so the chains are rebuilt.
+    for (u32 i = 0; i < countof(m_tlb_ram_page_links); i++)
+      SetTLBEntryPhysicalAddress(entries[i], entries[i].physical_address);
+    return;
+  }
+
+  // Pages without RAM never have a host pointer, and their RAM can only change along with all pages.
+  if (!ram_ptr)
+    return;
+
+  for (u32 i = m_tlb_ram_page_buckets[GetTLBRAMPageBucket(ram_ptr)]; i != TLB_NO_LINK; i = m_tlb_ram_page_links[i].next)
+  {
+    if (m_tlb_ram_page_links[i].ram_ptr != ram_ptr)
+      continue;
+
+    // Entries for mirrors of the page share its RAM, so they have to go through the bus too.
+    TLBEntry& entry = entries[i];
+    if ((entry.physical_address & m_bus->GetMemoryAddressMask()) == page_address)
+      entry.host_pointer = m_bus->GetRAMPagePointer(entry.physical_address);
+    else
+      entry.host_pointer = nullptr;
   }
 #endif
 }
 
+#ifdef ENABLE_TLB_EMULATION
+void CPU::SetTLBEntryPhysicalAddress(TLBEntry& entry, PhysicalMemoryAddress physical_address)
+{
+  entry.physical_address = physical_address;
+  entry.host_pointer = m_bus->GetRAMPagePointer(physical_address);
+  LinkTLBEntryRAMPage(static_cast<u32>(&entry - &m_tlb_entries[0][0][0]), m_bus->GetRAMPageBacking(physical_address));
+}
+
+void CPU::LinkTLBEntryRAMPage(u32 entry_number, const byte* ram_ptr)
+{
+  TLBRAMPageLink& link = m_tlb_ram_page_links[entry_number];
+  if (link.ram_ptr == ram_ptr)
+    return;
+
+  if (link.ram_ptr)
+  {
+    if (link.prev != TLB_NO_LINK)
+      m_tlb_ram_page_links[link.prev].next = link.next;
+    else
+      m_tlb_ram_page_buckets[GetTLBRAMPageBucket(link.ram_ptr)] = link.next;
+    if (link.next != TLB_NO_LINK)
+      m_tlb_ram_page_links[link.next].prev = link.prev;
+  }
+
+  link.ram_ptr = ram_ptr;
+  link.prev = TLB_NO_LINK;
+  link.next = TLB_NO_LINK;
+  if (ram_ptr)
+  {
+    u32& head = m_tlb_ram_page_buckets[GetTLBRAMPageBucket(ram_ptr)];
+    link.next = head;
+    if (head != TLB_NO_LINK)
+      m_tlb_ram_page_links[head].prev = entry_number;
+    head = entry_number;
+  }
+}
+
+void CPU::ResetTLBRAMPageLinks()
+{
+  for (TLBRAMPageLink& link : m_tlb_ram_page_links)
+    link = {nullptr, TLB_NO_LINK, TLB_NO_LINK};
+  std::fill(std::begin(m_tlb_ram_page_buckets), std::end(m_tlb_ram_page_buckets), TLB_NO_LINK);
+}
+#endif
+
 void CPU::InvalidateTLBEntry(u32 linear_address)
 {
 #ifdef ENABLE_TLB_EMULATION
-  const u32 compare_linear_address = (linear_address & PAGE_MASK) | m_tlb_counter_bits;
   const u32 index = GetTLBEntryIndex(linear_address);
   for (u32 user_supervisor = 0; user_supervisor < 2; user_supervisor++)
   {
     for (u32 write_read = 0; write_read < 3; write_read++)
     {
       TLBEntry& entry = m_tlb_entries[user_supervisor][write_read][index];
-      if (entry.linear_address == compare_linear_address)
+      if (IsTLBEntryValid(entry, linear_address))
         entry.linear_address = 0xFFFFFFFF;
     }
   }
 #endif
 }
 
+void CPU::SwitchTLBAddressSpace()
+{
+#ifdef ENABLE_TLB_EMULATION
+  const PhysicalMemoryAddress page_directory_address = m_registers.CR3 & PAGE_MASK;
+  TLBAddressSpace& current_address_space = m_tlb_address_spaces[m_tlb_current_address_space];
+  if (current_address_space.discard_on_switch)
+  {
+    current_address_space.tag = TLB_INVALID_TAG;
+    ReleasePagingStructureWatches(u8(1) << m_tlb_current_address_space);
+  }
+
+  // Switching back to a recently used address space keeps its translations.
+  for (u32 i = 0; i < TLB_ADDRESS_SPACE_COUNT; i++)
+  {
+    TLBAddressSpace& address_space = m_tlb_address_spaces[i];
+    if (i != m_tlb_current_address_space && address_space.tag != TLB_INVALID_TAG &&
+        address_space.page_directory_address == page_directory_address)
+    {
+      address_space.last_used = ++m_tlb_address_space_counter;
+      m_tlb_current_address_space = i;
+      m_tlb_counter_bits = address_space.tag;
+      m_execution_stats.tlb_address_space_reuses++;
+      return;
+    }
+  }
+
+  // Otherwise it gets a new tag, replacing an unused or the least recently used address space. Reloading the current
+  // page directory flushes its translations, so it replaces itself.
+  u32 replace_index = m_tlb_current_address_space;
+  if (current_address_space.tag != TLB_INVALID_TAG &&
+      current_address_space.page_directory_address != page_directory_address)
+  {
+    for (u32 i = 0; i < TLB_ADDRESS_SPACE_COUNT; i++)
+    {
+      const TLBAddressSpace& address_space = m_tlb_address_spaces[i];
+      if (address_space.tag == TLB_INVALID_TAG)
+      {
+        replace_index = i;
+        break;
+      }
+
+      if (address_space.last_used < m_tlb_address_spaces[replace_index].last_used)
+        replace_index = i;
+    }
+  }
+
+  // Flushing everything also sets up the current address space.
+  if ((m_tlb_next_tag + 1) > TLB_INVALID_TAG)
+  {
+    InvalidateAllTLBEntries();
+    return;
+  }
+
+  ReleasePagingStructureWatches(u8(1) << replace_index);
+  m_tlb_current_address_space = replace_index;
+  m_tlb_counter_bits = m_tlb_next_tag++;
+  m_tlb_address_spaces[replace_index] = {page_directory_address, m_tlb_counter_bits, ++m_tlb_address_space_counter,
+                                         false};
+  m_execution_stats.tlb_flushes++;
+#endif
+}
+
+void CPU::WatchPagingStructure(PhysicalMemoryAddress address)
+{
+#ifdef ENABLE_TLB_EMULATION
+  const u32 page_number = (address & m_bus->GetMemoryAddressMask()) >> PAGE_SHIFT;
+  auto iter = m_tlb_paging_structure_owners.find(page_number);
+  if (iter == m_tlb_paging_structure_owners.end())
+  {
+    // Only drops the host pointers of TLB entries for this page, translations are kept.
+    m_bus->WatchPageWrites(address);
+    iter = m_tlb_paging_structure_owners.emplace(page_number, u8(0)).first;
+  }
+
+  iter->second |= u8(1) << m_tlb_current_address_space;
+#endif
+}
+
+void CPU::OnPagingStructureWrite(PhysicalMemoryAddress address)
+{
+#ifdef ENABLE_TLB_EMULATION
+  if (m_updating_paging_structures)
+    return;
+
+  auto iter = m_tlb_paging_structure_owners.find(address >> PAGE_SHIFT);
+  if (iter == m_tlb_paging_structure_owners.end())
+    return;
+
+  // The current address space may keep stale translations until INVLPG or a CR3 load, so it's only discarded when
+  // switching away from it. Inactive address spaces would have been flushed by the CR3 load, so discard them now.
+  u8 discarded_mask = 0;
+  for (u32 i = 0; i < TLB_ADDRESS_SPACE_COUNT; i++)
+  {
+    if (!(iter->second & (u8(1) << i)))
+      continue;
+
+    if (i == m_tlb_current_address_space)
+    {
+      m_tlb_address_spaces[i].discard_on_switch = true;
+    }
+    else
+    {
+      m_tlb_address_spaces[i].tag = TLB_INVALID_TAG;
+      discarded_mask |= u8(1) << i;
+    }
+  }
+
+  if (discarded_mask != 0)
+    ReleasePagingStructureWatches(discarded_mask);
+#endif
+}
+
+void CPU::ClearPagingStructureWatches()
+{
+#ifdef ENABLE_TLB_EMULATION
+  m_tlb_paging_structure_owners.clear();
+  m_bus->ClearPageWriteWatches();
+#endif
+}
+
+void CPU::ReleasePagingStructureWatches(u8 address_space_mask)
+{
+#ifdef ENABLE_TLB_EMULATION
+  for (auto iter = m_tlb_paging_structure_owners.begin(); iter != m_tlb_paging_structure_owners.end();)
+  {
+    iter->second &= ~address_space_mask;
+    if (iter->second != 0)
+    {
+      ++iter;
+      continue;
+    }
+
+    // Unwatching restores the RAM pointer and fastmem mapping for the page.
+    m_bus->UnwatchPageWrites(iter->first << PAGE_SHIFT);
+    iter = m_tlb_paging_structure_owners.erase(iter);
+  }
+#endif
+}
+
 void CPU::FlushPrefetchQueue()
 {
 #ifdef ENABLE_PREFETCH_EMULATION
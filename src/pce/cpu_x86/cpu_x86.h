@@ -1,4 +1,5 @@
 #pragma once
+#include "../bus.h"
 #include "../cpu.h"
 #include "../system.h"
 #include "YBaseLib/Assert.h"
@@ -6,6 +7,7 @@
 #include "types.h"
 #include <functional>
 #include <memory>
+#include <unordered_map>
 
 // Enable TLB emulation?
 #define ENABLE_TLB_EMULATION 1
@@ -50,6 +52,7 @@ public:
   static constexpr u32 PAGE_MASK = ~PAGE_OFFSET_MASK;
   static constexpr u32 PAGE_SHIFT = 12;
   static constexpr size_t TLB_ENTRY_COUNT = 8192;
+  static constexpr u32 TLB_ADDRESS_SPACE_COUNT = 4;
 
 #pragma pack(push, 1)
   // Needed because the 8-bit register indices are all low bits -> all high bits
@@ -254,7 +257,8 @@ public:
     VirtualMemoryAddress limit_high;
     SEGMENT_DESCRIPTOR_ACCESS_BITS access;
     AccessTypeMask access_mask;
-    u8 pad[2];
+    bool flat; // Base of zero, limit of 4GiB, readable and writable. Only wrapping past 4GiB needs checking.
+    u8 pad;
   };
 
   struct TSSCache
@@ -303,6 +307,14 @@ public:
   const Registers* GetRegisters() const { return &m_registers; }
   Registers* GetRegisters() { return &m_registers; }
 
+  // Writes the arithmetic flags of the last lazily-evaluated ALU operation to EFLAGS. Anything outside of the
+  // interpreter handlers which reads CF/PF/AF/ZF/SF/OF, or writes some but not all of them, must call this first.
+  void MaterializeLazyFlags()
+  {
+    if (m_lazy_flags_operation != LazyFlagsOperation::None)
+      EvaluateLazyFlags();
+  }
+
   AddressSize GetCurrentAddressingSize() const { return m_current_address_size; }
   OperandSize GetCurrentOperandSize() const { return m_current_operand_size; }
   AddressSize GetStackAddressSize() const { return m_stack_address_size; }
@@ -331,19 +343,20 @@ public:
   // Cycle tracking when executing.
   void AddCycle() { m_pending_cycles++; }
   void AddCycles(CYCLE_GROUP group) { m_pending_cycles += GetCycles(group); }
+  void AddCycles(CYCLE_GROUP group, CycleCount count) { m_pending_cycles += GetCycles(group) * count; }
   void AddCyclesPMode(CYCLE_GROUP group) { m_pending_cycles += GetCyclesPMode(group); }
   void AddCyclesRM(CYCLE_GROUP group, bool rm_reg) { m_pending_cycles += GetCyclesRM(group, rm_reg); }
 
   void CommitPendingCycles()
   {
-    // Convert to/from simulation time, keeping track of partial nanoseconds.
-    const SimulationTime simtime = static_cast<SimulationTime>(static_cast<float>(m_pending_cycles) * m_cycle_period);
-    const CycleCount cycles = static_cast<CycleCount>(static_cast<float>(simtime) * m_rcp_cycle_period);
-    m_system->AddSimulationTime(simtime);
-    m_execution_stats.cycles_executed += cycles;
-    m_execution_downcount -= cycles;
-    m_pending_cycles -= cycles;
-    m_tsc_cycles += cycles;
+    // Convert to simulation time in fixed-point, carrying any partial nanosecond over to the next commit.
+    const SimulationTicks ticks = m_pending_cycles * m_cycle_period + m_partial_time;
+    m_system->AddSimulationTime(SimulationTicksToTime(ticks));
+    m_partial_time = ticks & SIMULATION_TICK_FRACTION_MASK;
+    m_execution_stats.cycles_executed += m_pending_cycles;
+    m_execution_downcount -= m_pending_cycles;
+    m_tsc_cycles += m_pending_cycles;
+    m_pending_cycles = 0;
   }
 
   u64 ReadTSC() const { return static_cast<u64>(m_tsc_cycles + m_pending_cycles); }
@@ -373,9 +386,10 @@ public:
     const u8 tlb_user_bit = BoolToUInt8(InUserMode() && !HasAccessFlagBit(flags, AccessFlags::UseSupervisorPrivileges));
     const u8 tlb_type = static_cast<u8>(GetAccessTypeFromFlags(flags));
     TLBEntry& tlb_entry = m_tlb_entries[tlb_user_bit][tlb_type][tlb_index];
-    if (tlb_entry.linear_address == ((linear_address & PAGE_MASK) | m_tlb_counter_bits))
+    if (IsTLBEntryValid(tlb_entry, linear_address))
     {
       // TLB hit!
+      m_execution_stats.tlb_hits++;
       *out_physical_address = tlb_entry.physical_address + (linear_address & PAGE_OFFSET_MASK);
       return true;
     }
@@ -384,6 +398,42 @@ public:
     return LookupPageTable(out_physical_address, linear_address, flags);
   }
 
+  // Translates a linear address for a normal data access, returning a host pointer if the page is plain RAM. Otherwise,
+  // returns null, and the access has to go through the bus using the physical address.
+  template<AccessType type>
+  byte* TranslateLinearAddressToHostPointer(PhysicalMemoryAddress* out_physical_address,
+                                            LinearMemoryAddress linear_address)
+  {
+#ifdef ENABLE_TLB_EMULATION
+    // TLB hits carry the host pointer, so no page lookup is needed.
+    TLBEntry& tlb_entry = m_tlb_entries[m_tlb_user_bit][static_cast<u8>(type)][GetTLBEntryIndex(linear_address)];
+    if (IsTLBEntryValid(tlb_entry, linear_address))
+    {
+      m_execution_stats.tlb_hits++;
+      if (tlb_entry.host_pointer)
+        return tlb_entry.host_pointer + (linear_address & PAGE_OFFSET_MASK);
+
+      *out_physical_address = tlb_entry.physical_address + (linear_address & PAGE_OFFSET_MASK);
+      return nullptr;
+    }
+
+    if ((m_registers.CR0 & CR0Bit_PG) == 0)
+    {
+      // Identity-mapped entries are created when paging is disabled, so the host pointer is cached too.
+      m_execution_stats.tlb_misses++;
+      tlb_entry.linear_address = (linear_address & PAGE_MASK) | m_tlb_counter_bits;
+      SetTLBEntryPhysicalAddress(tlb_entry, linear_address & PAGE_MASK);
+      *out_physical_address = linear_address;
+      return tlb_entry.host_pointer ? (tlb_entry.host_pointer + (linear_address & PAGE_OFFSET_MASK)) : nullptr;
+    }
+#endif
+
+    TranslateLinearAddress(out_physical_address, linear_address, AddAccessTypeToFlags(type, AccessFlags::Normal));
+
+    byte* ram_page_ptr = m_bus->GetRAMPagePointer(*out_physical_address);
+    return ram_page_ptr ? (ram_page_ptr + (*out_physical_address & Bus::MEMORY_PAGE_OFFSET_MASK)) : nullptr;
+  }
+
   // Checks if a given offset is valid into the specified segment.
   template<u32 size, AccessType access>
   bool CheckSegmentAccess(Segment segment, VirtualMemoryAddress offset, bool raise_gp_fault)
@@ -395,7 +445,10 @@ public:
     // Non-CS segments should be data or code+readable
     // SS segments should be data+writable
     // Everything else should be code or writable
-    // TODO: Add a flag for 4G segments so we can skip the limit check.
+
+    // Flat data segments don't need the access or limit checks, only for accesses which wrap around.
+    if (access != AccessType::Execute && segcache->flat && offset <= (0xFFFFFFFFu - (size - 1)))
+      return true;
 
     // First we check if we have read/write/execute access.
     // Then check against the segment limit (can be expand up or down, but calculated at load time).
@@ -467,6 +520,7 @@ public:
   // Code cache flushing - for recompiler backends
   void FlushCodeCache() override;
   void GetExecutionStats(ExecutionStats* stats) const override;
+  void DumpBlockProfile(u32 count) override;
 
 protected:
   // Actually creates the backend.
@@ -521,6 +575,17 @@ protected:
 
   // Sets flags from a value, masking away bits that can't be changed
   void SetFlags(u32 value);
+
+  // Records an ALU operation instead of computing its arithmetic flags. Replaces any pending operation, since each
+  // lazy operation writes all of CF/PF/AF/ZF/SF/OF.
+  void SetLazyFlags(LazyFlagsOperation operation, u32 lhs, u32 rhs, u32 result)
+  {
+    m_lazy_flags_operation = operation;
+    m_lazy_flags_lhs = lhs;
+    m_lazy_flags_rhs = rhs;
+    m_lazy_flags_result = result;
+  }
+  void EvaluateLazyFlags();
   void UpdateAlignmentCheckMask();
   void SetCPL(u8 cpl);
   void Halt();
@@ -549,6 +614,7 @@ protected:
 
   // Loads the visible portion of a segment register, updating the cached information
   void LoadSegmentRegister(Segment segment, u16 value);
+  static void UpdateSegmentFlatFlag(SegmentCache* segment_cache);
   void LoadLocalDescriptorTable(u16 value);
   void LoadTaskSegment(u16 value);
 
@@ -642,6 +708,20 @@ protected:
   void InvalidateAllTLBEntries(bool force_clear = false);
   void InvalidateTLBEntry(u32 linear_address);
 
+  // Refreshes the host pointers of TLB entries after the bus page mapping changes. Translations are kept.
+  void UpdateTLBHostPointers(PhysicalMemoryAddress page_address, const byte* ram_ptr);
+
+  // Switches to the address space for the page directory in CR3, reusing its tag if it was recently active.
+  void SwitchTLBAddressSpace();
+
+  // Tracks writes to paging structures, so that address spaces which were modified while inactive are discarded.
+  void WatchPagingStructure(PhysicalMemoryAddress address);
+  void OnPagingStructureWrite(PhysicalMemoryAddress address);
+  void ClearPagingStructureWatches();
+
+  // Removes discarded or replaced address spaces as owners of the paging structures, unwatching pages with no owners.
+  void ReleasePagingStructureWatches(u8 address_space_mask);
+
   // Prefetch queue emulation
   void FlushPrefetchQueue();
   bool FillPrefetchQueue();
@@ -652,6 +732,12 @@ protected:
   Registers m_registers = {};
   FPURegisters m_fpu_registers = {};
 
+  // Last ALU operation executed by the interpreter, whose arithmetic flags haven't been written to EFLAGS yet.
+  LazyFlagsOperation m_lazy_flags_operation = LazyFlagsOperation::None;
+  u32 m_lazy_flags_lhs = 0;
+  u32 m_lazy_flags_rhs = 0;
+  u32 m_lazy_flags_result = 0;
+
   // Current execution state.
   VirtualMemoryAddress m_effective_address = 0;
   InstructionData idata = {};
@@ -683,6 +769,29 @@ protected:
   std::unique_ptr<Backend> m_backend;
   std::unique_ptr<DebuggerInterface> m_debugger_interface;
 
+  // Save decoded blocks next to the system ini, so they can be reused on the next boot.
+  bool m_persistent_code_cache = false;
+
+  // Run the analysis/optimization pass over blocks before recompiling them. Disable to compare performance.
+  bool m_recompiler_block_optimization = true;
+
+  // Use host doubles for x87 arithmetic and loads/stores when the result matches softfloat. The precision exception
+  // flag isn't set for these operations, so this is off by default.
+  bool m_fast_x87 = false;
+
+  // Write symbols for recompiled blocks for Linux perf. 0 - disabled, 1 - /tmp/perf-<pid>.map, 2 - jitdump.
+  u32 m_recompiler_perf_map = 0;
+
+  // Access guest RAM from recompiled code through a 4GiB host view of physical memory. This reserves the address range
+  // and installs a SIGSEGV handler, so it is off by default.
+  bool m_recompiler_fastmem = false;
+
+  // Record execution counts, cycles, invalidations and interpreter fallbacks for each code cache block.
+  bool m_block_profiler = false;
+
+  // Skip to the next event when a code cache block is found to be spinning in an idle/polling loop.
+  bool m_idle_loop_skipping = true;
+
   // Locations of descriptor tables
   DescriptorTablePointer m_idt_location;
   DescriptorTablePointer m_gdt_location;
@@ -726,21 +835,81 @@ protected:
   ExecutionStats m_execution_stats = {};
 
 #ifdef ENABLE_TLB_EMULATION
-  // We use the lower 12 bits to represent a "counter" which is incremented each
-  // time the TLB is flushed. This way, we don't need to wipe out the array every
-  // flush, instead only when the counter wraps around. We still have 12 bits free
+  // We use the lower 12 bits to represent a "tag", a new one of which is allocated
+  // each time the TLB is flushed. This way, we don't need to wipe out the array every
+  // flush, instead only when the tags run out. We still have 12 bits free
   // in the physical adress if we need to store anything else.
+  static constexpr u32 TLB_INVALID_TAG = 0xFFF;
   struct TLBEntry
   {
     // Invalid TLB entries will be set to 0xFFFFFFFF, which has the lower-most
     // bits set, so it will never be confused for a real entry.
     LinearMemoryAddress linear_address;
     PhysicalMemoryAddress physical_address;
+
+    // Host pointer to the start of the physical page if it is plain RAM, otherwise null, meaning the access has to
+    // go through the bus (MMIO, ROM, or pages containing code). Refreshed when the bus page mapping changes.
+    byte* host_pointer;
+  };
+
+  // Checks whether the entry translates the linear address in the current address space.
+  bool IsTLBEntryValid(const TLBEntry& entry, LinearMemoryAddress linear_address) const
+  {
+    // Global pages have their own tag, which isn't changed by address space switches.
+    const LinearMemoryAddress page_address = linear_address & PAGE_MASK;
+    return (entry.linear_address == (page_address | m_tlb_counter_bits) ||
+            entry.linear_address == (page_address | m_tlb_global_bits));
+  }
+
+  // Recently used address spaces, identified by their page directory. Each has its own tag, so that translations
+  // survive switching CR3 back to it. The paging structures walked for an address space are write-watched, and the
+  // address space is discarded if they are modified while it is inactive, as a CR3 load would have flushed it.
+  struct TLBAddressSpace
+  {
+    PhysicalMemoryAddress page_directory_address;
+    u32 tag;
+    u64 last_used;
+
+    // Set when the paging structures were modified while active, or aren't watched. Discarded on switching away.
+    bool discard_on_switch;
   };
 
+  // Entries are chained by the RAM backing their physical page, so that a mapping change for a single page only visits
+  // the entries which can refer to it, including those for mirrors of the page.
+  static constexpr u32 TLB_RAM_PAGE_BUCKET_COUNT = 8192;
+  static constexpr u32 TLB_NO_LINK = 0xFFFFFFFF;
+  struct TLBRAMPageLink
+  {
+    const byte* ram_ptr; // null if not chained
+    u32 prev;
+    u32 next;
+  };
+
+  // Sets the physical page of an entry, updating its host pointer and chain.
+  void SetTLBEntryPhysicalAddress(TLBEntry& entry, PhysicalMemoryAddress physical_address);
+  void LinkTLBEntryRAMPage(u32 entry_number, const byte* ram_ptr);
+  void ResetTLBRAMPageLinks();
+  static u32 GetTLBRAMPageBucket(const byte* ram_ptr)
+  {
+    return static_cast<u32>(reinterpret_cast<uintptr_t>(ram_ptr) >> PAGE_SHIFT) % TLB_RAM_PAGE_BUCKET_COUNT;
+  }
+
   // Indexed by [user_supervisor][write_read]
   TLBEntry m_tlb_entries[2][3][TLB_ENTRY_COUNT] = {};
+  TLBRAMPageLink m_tlb_ram_page_links[2 * 3 * TLB_ENTRY_COUNT] = {};
+  u32 m_tlb_ram_page_buckets[TLB_RAM_PAGE_BUCKET_COUNT] = {};
   u32 m_tlb_counter_bits = 0;
+  u32 m_tlb_global_bits = 0;
+  u32 m_tlb_next_tag = 0;
+
+  TLBAddressSpace m_tlb_address_spaces[TLB_ADDRESS_SPACE_COUNT] = {};
+  u32 m_tlb_current_address_space = 0;
+  u64 m_tlb_address_space_counter = 0;
+
+  // Physical page number -> bitmask of address spaces which have walked the page. Bits are removed when an address
+  // space is discarded or its slot is reused, and the page is no longer watched once it has no owners.
+  std::unordered_map<u32, u8> m_tlb_paging_structure_owners;
+  bool m_updating_paging_structures = false;
 #endif
 
 #ifdef ENABLE_PREFETCH_EMULATION
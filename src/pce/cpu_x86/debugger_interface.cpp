@@ -46,6 +46,9 @@ const char* DebuggerInterface::GetRegisterName(u32 index) const
 
 DebuggerInterface::RegisterValue DebuggerInterface::GetRegisterValue(u32 index) const
 {
+  // EFLAGS may have arithmetic flags pending from the last instruction.
+  m_cpu->MaterializeLazyFlags();
+
   RegisterValue value = {};
   if (index < Reg32_Count)
     value.val_dword = m_cpu->GetRegisters()->reg32[index];
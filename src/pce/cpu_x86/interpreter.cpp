@@ -33,14 +33,36 @@ void Interpreter::ExecuteInstruction(CPU* cpu)
     cpu->RaiseDebugException();
 }
 
-Interpreter::HandlerFunction Interpreter::GetInterpreterHandlerForInstruction(const Instruction* instruction)
+u64 Interpreter::GetHandlerKeyForInstruction(const Instruction* instruction)
 {
-  const u64 key = HandlerFunctionKey::Build(
-    instruction->operation, instruction->operands[0].size, instruction->operands[0].mode, instruction->operands[0].data,
-    instruction->operands[1].size, instruction->operands[1].mode, instruction->operands[1].data,
-    instruction->operands[2].size, instruction->operands[2].mode, instruction->operands[2].data);
+  // Decoded instructions use the handlers for the form of their ModRM r/m operand.
+  u32 operand_data[countof(instruction->operands)];
+  for (u32 i = 0; i < countof(instruction->operands); i++)
+  {
+    const Instruction::Operand& operand = instruction->operands[i];
+    if (operand.mode == OperandMode_ModRM_RM)
+      operand_data[i] = instruction->data.ModRM_RM_IsReg() ? ModRMForm_Register : ModRMForm_Memory;
+    else
+      operand_data[i] = operand.data;
+  }
+
+  return HandlerFunctionKey::Build(instruction->operation, instruction->operands[0].size,
+                                   instruction->operands[0].mode, operand_data[0], instruction->operands[1].size,
+                                   instruction->operands[1].mode, operand_data[1], instruction->operands[2].size,
+                                   instruction->operands[2].mode, operand_data[2]);
+}
 
-  auto iter = s_handler_functions.find(key);
+Interpreter::HandlerFunction Interpreter::GetInterpreterHandlerForInstruction(const Instruction* instruction)
+{
+  auto iter = s_handler_functions.find(GetHandlerKeyForInstruction(instruction));
   return (iter != s_handler_functions.end()) ? iter->second : nullptr;
 }
+
+Interpreter::FusedHandlerFunction Interpreter::GetFusedHandlerForInstructions(const Instruction* first,
+                                                                             const Instruction* second)
+{
+  auto iter = s_fused_handler_functions.find(
+    std::make_pair(GetHandlerKeyForInstruction(first), GetHandlerKeyForInstruction(second)));
+  return (iter != s_fused_handler_functions.end()) ? iter->second : nullptr;
+}
 } // namespace CPU_X86
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "decoder.h"
 
 #include <map>
+#include <utility>
 #include <softfloat.h>
 #include <softfloatx80.h>
 
@@ -17,6 +18,21 @@ public:
   using HandlerFunction = void (*)(CPU*);
   static HandlerFunction GetInterpreterHandlerForInstruction(const Instruction* instruction);
 
+  // Retrieves a superinstruction which executes the instruction in idata, followed by the next instruction.
+  // The caller sets up idata/EIP for the first instruction, the handler does the same for the second.
+  using FusedHandlerFunction = void (*)(CPU*, const InstructionData* next_data, u32 next_length);
+  static FusedHandlerFunction GetFusedHandlerForInstructions(const Instruction* first, const Instruction* second);
+
+  // ADD/SUB/CMP/AND/OR/XOR/TEST handlers leave their arithmetic flags pending in the CPU, all other handlers
+  // evaluate them first. Backends which run native code between handlers must evaluate them afterwards.
+  static constexpr bool IsLazyFlagsOperation(Operation operation)
+  {
+    return (operation == Operation_ADD || operation == Operation_SUB || operation == Operation_CMP ||
+            operation == Operation_AND || operation == Operation_OR || operation == Operation_XOR ||
+            operation == Operation_TEST);
+  }
+  static void MaterializeLazyFlags(CPU* cpu);
+
   static void RaiseInvalidOpcode(CPU* cpu);
 
 private:
@@ -28,9 +44,17 @@ private:
 
   static inline void Dispatch(CPU* cpu);
 
+  template<HandlerFunction first, HandlerFunction second>
+  static void Execute_Fused(CPU* cpu, const InstructionData* next_data, u32 next_length);
+
+  template<HandlerFunction handler>
+  static void Execute_WithFlags(CPU* cpu);
+
   // Calculate the effective address for memory operands
-  template<OperandMode op_mode>
+  template<OperandMode op_mode, u32 op_constant>
   static void CalculateEffectiveAddress(CPU* cpu);
+  template<u32 constant>
+  static inline bool IsRegisterModRMOperand(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
   static VirtualMemoryAddress CalculateJumpTarget(CPU* cpu);
 
@@ -189,8 +213,13 @@ private:
   static inline void Execute_Operation_IRET(CPU* cpu);
 
   // String operations
+  template<AccessType access>
+  static inline byte* GetStringHostPointer(CPU* cpu, Segment segment, VirtualMemoryAddress offset, u32 element_size,
+                                           u32* count, bool* not_ram);
+  template<Operation operation, typename T>
+  static inline u32 Execute_REP_Bulk(CPU* cpu, bool* not_ram);
   template<Operation operation, bool check_equal, typename callback>
-  static inline void Execute_REP(CPU* cpu, callback cb);
+  static inline void Execute_REP(CPU* cpu, OperandSize data_size, callback cb);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
            u32 src_constant>
   static inline void Execute_Operation_MOVS(CPU* cpu);
@@ -384,6 +413,22 @@ private:
   static inline void WriteFloatRegister(CPU* cpu, u8 relative_index, const floatx80& value, bool update_tag = true);
   static inline void UpdateFloatTagRegister(CPU* cpu, u8 index);
   static inline float_status_t GetFloatStatus(CPU* cpu);
+
+  // Fast x87 mode, runs arithmetic on host doubles when the result is the same as softfloat's.
+  enum class HostFloatOperation : u8
+  {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    SquareRoot
+  };
+  static inline bool FloatX80ToHostDouble(const floatx80& value, u32 precision_bits, double* out_value);
+  static inline bool HostDoubleToFloatX80(double value, floatx80* out_value);
+  static inline bool IsHostFloatNormalOrZero(float value);
+  static inline bool IsHostDoubleInSingleRange(double value);
+  static inline bool TryHostFloatArithmetic(CPU* cpu, HostFloatOperation operation, const floatx80& lhs,
+                                            const floatx80& rhs, floatx80* result);
   static inline void RaiseFloatExceptions(CPU* cpu, const float_status_t& fs);
   static inline void SetStatusWordFromCompare(CPU* cpu, const float_status_t& fs, int res);
   static inline void ClearC1(CPU* cpu);
@@ -572,7 +617,10 @@ private:
     }
   };
   static_assert(sizeof(HandlerFunctionKey) == 8, "InstructionHandlerKey is qword-sized");
+  static u64 GetHandlerKeyForInstruction(const Instruction* instruction);
   using HandlerFunctionMap = std::map<u64, HandlerFunction>;
   static HandlerFunctionMap s_handler_functions;
+  using FusedHandlerFunctionMap = std::map<std::pair<u64, u64>, FusedHandlerFunction>;
+  static FusedHandlerFunctionMap s_fused_handler_functions;
 };
 } // namespace CPU_X86
\ No newline at end of file
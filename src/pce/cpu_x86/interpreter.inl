@@ -5,6 +5,7 @@
 #include "pce/cpu_x86/interpreter.h"
 #include "pce/interrupt_controller.h"
 #include "pce/system.h"
+#include <cstring>
 
 #ifdef Y_COMPILER_MSVC
 #include <intrin.h>
@@ -21,11 +22,37 @@ void Interpreter::RaiseInvalidOpcode(CPU* cpu)
   cpu->RaiseException(Interrupt_InvalidOpcode);
 }
 
+void Interpreter::MaterializeLazyFlags(CPU* cpu)
+{
+  cpu->MaterializeLazyFlags();
+}
+
 void Interpreter::FetchModRM(CPU* cpu)
 {
   cpu->idata.modrm = cpu->FetchInstructionByte();
 }
 
+template<Interpreter::HandlerFunction first, Interpreter::HandlerFunction second>
+void Interpreter::Execute_Fused(CPU* cpu, const InstructionData* next_data, u32 next_length)
+{
+  first(cpu);
+
+  // The first instruction can't branch, so the second instruction follows it. Exceptions in the second
+  // instruction need the current EIP/ESP, the same as when executing it on its own.
+  cpu->m_current_EIP = cpu->m_registers.EIP;
+  cpu->m_current_ESP = cpu->m_registers.ESP;
+  cpu->m_registers.EIP = (cpu->m_registers.EIP + next_length) & cpu->m_EIP_mask;
+  std::memcpy(&cpu->idata, next_data, sizeof(cpu->idata));
+  second(cpu);
+}
+
+template<Interpreter::HandlerFunction handler>
+void Interpreter::Execute_WithFlags(CPU* cpu)
+{
+  cpu->MaterializeLazyFlags();
+  handler(cpu);
+}
+
 template<OperandSize op_size, OperandMode op_mode, u32 op_constant>
 void Interpreter::FetchImmediate(CPU* cpu)
 {
@@ -149,13 +176,31 @@ void Interpreter::FetchImmediate(CPU* cpu)
   }
 }
 
-template<OperandMode op_mode>
+template<u32 constant>
+bool Interpreter::IsRegisterModRMOperand(CPU* cpu)
+{
+  if constexpr (constant == ModRMForm_Register)
+    return true;
+  else if constexpr (constant == ModRMForm_Memory)
+    return false;
+  else
+    return cpu->idata.modrm_rm_register;
+}
+
+template<OperandMode op_mode, u32 op_constant>
 void Interpreter::CalculateEffectiveAddress(CPU* cpu)
 {
   switch (op_mode)
   {
     case OperandMode_ModRM_RM:
     {
+      // Register operands are indexed by the r/m field, in both address sizes.
+      if constexpr (op_constant == ModRMForm_Register)
+      {
+        cpu->m_effective_address = cpu->idata.modrm & 7;
+        return;
+      }
+
       // NOTE: The uint16() cast here is needed otherwise the result is an int rather than uint16.
       u8 index = ((cpu->idata.modrm >> 6) << 3) | (cpu->idata.modrm & 7);
       if (cpu->idata.address_size == AddressSize_16)
@@ -423,7 +468,7 @@ u8 Interpreter::ReadByteOperand(CPU* cpu)
       return cpu->ReadSegmentMemoryByte(cpu->idata.segment, cpu->idata.disp32);
     case OperandMode_ModRM_RM:
     {
-      if (cpu->idata.modrm_rm_register)
+      if (IsRegisterModRMOperand<constant>(cpu))
         return cpu->m_registers.reg8[cpu->m_effective_address];
       else
         return cpu->ReadSegmentMemoryByte(cpu->idata.segment, cpu->m_effective_address);
@@ -453,7 +498,7 @@ u16 Interpreter::ReadWordOperand(CPU* cpu)
       return cpu->ReadSegmentMemoryWord(cpu->idata.segment, cpu->idata.disp32);
     case OperandMode_ModRM_RM:
     {
-      if (cpu->idata.modrm_rm_register)
+      if (IsRegisterModRMOperand<constant>(cpu))
         return cpu->m_registers.reg16[cpu->m_effective_address];
       else
         return cpu->ReadSegmentMemoryWord(cpu->idata.segment, cpu->m_effective_address);
@@ -484,7 +529,7 @@ u32 Interpreter::ReadDWordOperand(CPU* cpu)
       return cpu->ReadSegmentMemoryDWord(cpu->idata.segment, cpu->idata.disp32);
     case OperandMode_ModRM_RM:
     {
-      if (cpu->idata.modrm_rm_register)
+      if (IsRegisterModRMOperand<constant>(cpu))
         return cpu->m_registers.reg32[cpu->m_effective_address];
       else
         return cpu->ReadSegmentMemoryDWord(cpu->idata.segment, cpu->m_effective_address);
@@ -533,7 +578,7 @@ u16 Interpreter::ReadSignExtendedWordOperand(CPU* cpu)
           value = cpu->m_registers.reg8[cpu->idata.GetModRM_Reg()];
           break;
         case OperandMode_ModRM_RM:
-          if (cpu->idata.modrm_rm_register)
+          if (IsRegisterModRMOperand<constant>(cpu))
             value = cpu->m_registers.reg8[cpu->m_effective_address];
           else
             value = cpu->ReadSegmentMemoryByte(cpu->idata.segment, cpu->m_effective_address);
@@ -579,7 +624,7 @@ u32 Interpreter::ReadSignExtendedDWordOperand(CPU* cpu)
           value = cpu->m_registers.reg8[cpu->idata.GetModRM_Reg()];
           break;
         case OperandMode_ModRM_RM:
-          if (cpu->idata.modrm_rm_register)
+          if (IsRegisterModRMOperand<constant>(cpu))
             value = cpu->m_registers.reg8[cpu->m_effective_address];
           else
             value = cpu->ReadSegmentMemoryByte(cpu->idata.segment, cpu->m_effective_address);
@@ -611,7 +656,7 @@ u32 Interpreter::ReadSignExtendedDWordOperand(CPU* cpu)
           value = cpu->m_registers.reg16[cpu->idata.GetModRM_Reg()];
           break;
         case OperandMode_ModRM_RM:
-          if (cpu->idata.modrm_rm_register)
+          if (IsRegisterModRMOperand<constant>(cpu))
             value = cpu->m_registers.reg16[cpu->m_effective_address];
           else
             value = cpu->ReadSegmentMemoryWord(cpu->idata.segment, cpu->m_effective_address);
@@ -660,7 +705,7 @@ u16 Interpreter::ReadZeroExtendedWordOperand(CPU* cpu)
           value = cpu->m_registers.reg8[cpu->idata.GetModRM_Reg()];
           break;
         case OperandMode_ModRM_RM:
-          if (cpu->idata.modrm_rm_register)
+          if (IsRegisterModRMOperand<constant>(cpu))
             value = cpu->m_registers.reg8[cpu->m_effective_address];
           else
             value = cpu->ReadSegmentMemoryByte(cpu->idata.segment, cpu->m_effective_address);
@@ -709,7 +754,7 @@ u32 Interpreter::ReadZeroExtendedDWordOperand(CPU* cpu)
           value = cpu->m_registers.reg8[cpu->idata.GetModRM_Reg()];
           break;
         case OperandMode_ModRM_RM:
-          if (cpu->idata.modrm_rm_register)
+          if (IsRegisterModRMOperand<constant>(cpu))
             value = cpu->m_registers.reg8[cpu->m_effective_address];
           else
             value = cpu->ReadSegmentMemoryByte(cpu->idata.segment, cpu->m_effective_address);
@@ -744,7 +789,7 @@ u32 Interpreter::ReadZeroExtendedDWordOperand(CPU* cpu)
           value = cpu->m_registers.reg16[cpu->idata.GetModRM_Reg()];
           break;
         case OperandMode_ModRM_RM:
-          if (cpu->idata.modrm_rm_register)
+          if (IsRegisterModRMOperand<constant>(cpu))
             value = cpu->m_registers.reg16[cpu->m_effective_address];
           else
             value = cpu->ReadSegmentMemoryWord(cpu->idata.segment, cpu->m_effective_address);
@@ -777,7 +822,7 @@ void Interpreter::WriteByteOperand(CPU* cpu, u8 value)
 
     case OperandMode_ModRM_RM:
     {
-      if (cpu->idata.modrm_rm_register)
+      if (IsRegisterModRMOperand<constant>(cpu))
         cpu->m_registers.reg8[cpu->m_effective_address] = value;
       else
         cpu->WriteSegmentMemoryByte(cpu->idata.segment, cpu->m_effective_address, value);
@@ -808,7 +853,7 @@ void Interpreter::WriteWordOperand(CPU* cpu, u16 value)
 
     case OperandMode_ModRM_RM:
     {
-      if (cpu->idata.modrm_rm_register)
+      if (IsRegisterModRMOperand<constant>(cpu))
         cpu->m_registers.reg16[cpu->m_effective_address] = value;
       else
         cpu->WriteSegmentMemoryWord(cpu->idata.segment, cpu->m_effective_address, value);
@@ -840,7 +885,7 @@ void Interpreter::WriteDWordOperand(CPU* cpu, u32 value)
 
     case OperandMode_ModRM_RM:
     {
-      if (cpu->idata.modrm_rm_register)
+      if (IsRegisterModRMOperand<constant>(cpu))
         cpu->m_registers.reg32[cpu->m_effective_address] = value;
       else
         cpu->WriteSegmentMemoryDWord(cpu->idata.segment, cpu->m_effective_address, value);
@@ -1315,43 +1360,40 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_ADD(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
     const u8 lhs = ReadByteOperand<dst_mode, dst_constant>(cpu);
     const u8 rhs = ReadByteOperand<src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u8 new_value = ALUOp_Add8(&eflags, lhs, rhs);
+    const u8 new_value = static_cast<u8>(lhs + rhs);
     WriteByteOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    cpu->SetLazyFlags(LazyFlagsOperation::Add8, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
     const u16 lhs = ReadWordOperand<dst_mode, dst_constant>(cpu);
     const u16 rhs = ReadSignExtendedWordOperand<src_size, src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u16 new_value = ALUOp_Add16(&eflags, lhs, rhs);
+    const u16 new_value = static_cast<u16>(lhs + rhs);
     WriteWordOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    cpu->SetLazyFlags(LazyFlagsOperation::Add16, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
     const u32 lhs = ReadDWordOperand<dst_mode, dst_constant>(cpu);
     const u32 rhs = ReadSignExtendedDWordOperand<src_size, src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u32 new_value = ALUOp_Add32(&eflags, lhs, rhs);
+    const u32 new_value = lhs + rhs;
     WriteDWordOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    cpu->SetLazyFlags(LazyFlagsOperation::Add32, lhs, rhs, new_value);
   }
 
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
     cpu->AddCycles(CYCLES_ALU_REG_IMM);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, IsRegisterModRMOperand<dst_constant>(cpu));
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 }
@@ -1361,8 +1403,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_ADC(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
@@ -1395,9 +1437,9 @@ void Interpreter::Execute_Operation_ADC(CPU* cpu)
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
     cpu->AddCycles(CYCLES_ALU_REG_IMM);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, IsRegisterModRMOperand<dst_constant>(cpu));
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 }
@@ -1407,43 +1449,40 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_SUB(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
     const u8 lhs = ReadByteOperand<dst_mode, dst_constant>(cpu);
     const u8 rhs = ReadByteOperand<src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u8 new_value = ALUOp_Sub8(&eflags, lhs, rhs);
+    const u8 new_value = static_cast<u8>(lhs - rhs);
     WriteByteOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    cpu->SetLazyFlags(LazyFlagsOperation::Sub8, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
     const u16 lhs = ReadWordOperand<dst_mode, dst_constant>(cpu);
     const u16 rhs = ReadSignExtendedWordOperand<src_size, src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u16 new_value = ALUOp_Sub16(&eflags, lhs, rhs);
+    const u16 new_value = static_cast<u16>(lhs - rhs);
     WriteWordOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    cpu->SetLazyFlags(LazyFlagsOperation::Sub16, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
     const u32 lhs = ReadDWordOperand<dst_mode, dst_constant>(cpu);
     const u32 rhs = ReadSignExtendedDWordOperand<src_size, src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u32 new_value = ALUOp_Sub32(&eflags, lhs, rhs);
+    const u32 new_value = lhs - rhs;
     WriteDWordOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    cpu->SetLazyFlags(LazyFlagsOperation::Sub32, lhs, rhs, new_value);
   }
 
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
     cpu->AddCycles(CYCLES_ALU_REG_IMM);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, IsRegisterModRMOperand<dst_constant>(cpu));
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 }
@@ -1453,8 +1492,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_SBB(CPU* cpu)
 {
   OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
@@ -1487,9 +1526,9 @@ void Interpreter::Execute_Operation_SBB(CPU* cpu)
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
     cpu->AddCycles(CYCLES_ALU_REG_IMM);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, IsRegisterModRMOperand<dst_constant>(cpu));
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 }
@@ -1499,35 +1538,35 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_CMP(CPU* cpu)
 {
   OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   // Implemented as subtract but discarding the result
   if (actual_size == OperandSize_8)
   {
     const u8 lhs = ReadByteOperand<dst_mode, dst_constant>(cpu);
     const u8 rhs = ReadByteOperand<src_mode, src_constant>(cpu);
-    ALUOp_Sub8(&cpu->m_registers.EFLAGS.bits, lhs, rhs);
+    cpu->SetLazyFlags(LazyFlagsOperation::Sub8, lhs, rhs, static_cast<u8>(lhs - rhs));
   }
   else if (actual_size == OperandSize_16)
   {
     const u16 lhs = ReadWordOperand<dst_mode, dst_constant>(cpu);
     const u16 rhs = ReadSignExtendedWordOperand<src_size, src_mode, src_constant>(cpu);
-    ALUOp_Sub16(&cpu->m_registers.EFLAGS.bits, lhs, rhs);
+    cpu->SetLazyFlags(LazyFlagsOperation::Sub16, lhs, rhs, static_cast<u16>(lhs - rhs));
   }
   else if (actual_size == OperandSize_32)
   {
     const u32 lhs = ReadDWordOperand<dst_mode, dst_constant>(cpu);
     const u32 rhs = ReadSignExtendedDWordOperand<src_size, src_mode, src_constant>(cpu);
-    ALUOp_Sub32(&cpu->m_registers.EFLAGS.bits, lhs, rhs);
+    cpu->SetLazyFlags(LazyFlagsOperation::Sub32, lhs, rhs, lhs - rhs);
   }
 
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
     cpu->AddCycles(CYCLES_CMP_REG_IMM);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_CMP_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_CMP_RM_MEM_REG, IsRegisterModRMOperand<dst_constant>(cpu));
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_CMP_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_CMP_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 }
@@ -1543,13 +1582,54 @@ ALWAYS_INLINE constexpr u32 EFLAGS_BitwiseOps(u32 old_eflags, ValueType new_valu
          ZeroFlag(new_value);                                                          // ZF
 }
 
+// Defined here to share the flag computations with the ALU handlers.
+void CPU::EvaluateLazyFlags()
+{
+  u32 eflags = m_registers.EFLAGS.bits;
+  switch (m_lazy_flags_operation)
+  {
+    case LazyFlagsOperation::Add8:
+      ALUOp_Add8(&eflags, Truncate8(m_lazy_flags_lhs), Truncate8(m_lazy_flags_rhs));
+      break;
+    case LazyFlagsOperation::Add16:
+      ALUOp_Add16(&eflags, Truncate16(m_lazy_flags_lhs), Truncate16(m_lazy_flags_rhs));
+      break;
+    case LazyFlagsOperation::Add32:
+      ALUOp_Add32(&eflags, m_lazy_flags_lhs, m_lazy_flags_rhs);
+      break;
+    case LazyFlagsOperation::Sub8:
+      ALUOp_Sub8(&eflags, Truncate8(m_lazy_flags_lhs), Truncate8(m_lazy_flags_rhs));
+      break;
+    case LazyFlagsOperation::Sub16:
+      ALUOp_Sub16(&eflags, Truncate16(m_lazy_flags_lhs), Truncate16(m_lazy_flags_rhs));
+      break;
+    case LazyFlagsOperation::Sub32:
+      ALUOp_Sub32(&eflags, m_lazy_flags_lhs, m_lazy_flags_rhs);
+      break;
+    case LazyFlagsOperation::Logic8:
+      eflags = EFLAGS_BitwiseOps(eflags, Truncate8(m_lazy_flags_result));
+      break;
+    case LazyFlagsOperation::Logic16:
+      eflags = EFLAGS_BitwiseOps(eflags, Truncate16(m_lazy_flags_result));
+      break;
+    case LazyFlagsOperation::Logic32:
+      eflags = EFLAGS_BitwiseOps(eflags, m_lazy_flags_result);
+      break;
+    default:
+      break;
+  }
+
+  m_registers.EFLAGS.bits = eflags;
+  m_lazy_flags_operation = LazyFlagsOperation::None;
+}
+
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
          u32 src_constant>
 void Interpreter::Execute_Operation_AND(CPU* cpu)
 {
   OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
@@ -1558,7 +1638,7 @@ void Interpreter::Execute_Operation_AND(CPU* cpu)
     u8 new_value = lhs & rhs;
     WriteByteOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic8, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
@@ -1567,7 +1647,7 @@ void Interpreter::Execute_Operation_AND(CPU* cpu)
     u16 new_value = lhs & rhs;
     WriteWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic16, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
@@ -1576,7 +1656,7 @@ void Interpreter::Execute_Operation_AND(CPU* cpu)
     u32 new_value = lhs & rhs;
     WriteDWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic32, lhs, rhs, new_value);
   }
   else
   {
@@ -1587,9 +1667,9 @@ void Interpreter::Execute_Operation_AND(CPU* cpu)
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
     cpu->AddCycles(CYCLES_ALU_REG_IMM);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, IsRegisterModRMOperand<dst_constant>(cpu));
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 }
@@ -1599,8 +1679,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_OR(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
@@ -1609,7 +1689,7 @@ void Interpreter::Execute_Operation_OR(CPU* cpu)
     u8 new_value = lhs | rhs;
     WriteByteOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic8, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
@@ -1618,7 +1698,7 @@ void Interpreter::Execute_Operation_OR(CPU* cpu)
     u16 new_value = lhs | rhs;
     WriteWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic16, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
@@ -1627,7 +1707,7 @@ void Interpreter::Execute_Operation_OR(CPU* cpu)
     u32 new_value = lhs | rhs;
     WriteDWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic32, lhs, rhs, new_value);
   }
   else
   {
@@ -1638,9 +1718,9 @@ void Interpreter::Execute_Operation_OR(CPU* cpu)
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
     cpu->AddCycles(CYCLES_ALU_REG_IMM);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, IsRegisterModRMOperand<dst_constant>(cpu));
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 }
@@ -1650,8 +1730,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_XOR(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
@@ -1660,7 +1740,7 @@ void Interpreter::Execute_Operation_XOR(CPU* cpu)
     u8 new_value = lhs ^ rhs;
     WriteByteOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic8, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
@@ -1669,7 +1749,7 @@ void Interpreter::Execute_Operation_XOR(CPU* cpu)
     u16 new_value = lhs ^ rhs;
     WriteWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic16, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
@@ -1678,7 +1758,7 @@ void Interpreter::Execute_Operation_XOR(CPU* cpu)
     u32 new_value = lhs ^ rhs;
     WriteDWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic32, lhs, rhs, new_value);
   }
   else
   {
@@ -1689,9 +1769,9 @@ void Interpreter::Execute_Operation_XOR(CPU* cpu)
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
     cpu->AddCycles(CYCLES_ALU_REG_IMM);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, IsRegisterModRMOperand<dst_constant>(cpu));
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_ALU_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 }
@@ -1701,8 +1781,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_TEST(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
@@ -1710,7 +1790,7 @@ void Interpreter::Execute_Operation_TEST(CPU* cpu)
     u8 rhs = ReadByteOperand<src_mode, src_constant>(cpu);
     u8 new_value = lhs & rhs;
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic8, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
@@ -1718,7 +1798,7 @@ void Interpreter::Execute_Operation_TEST(CPU* cpu)
     u16 rhs = ReadWordOperand<src_mode, src_constant>(cpu);
     u16 new_value = lhs & rhs;
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic16, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
@@ -1726,7 +1806,7 @@ void Interpreter::Execute_Operation_TEST(CPU* cpu)
     u32 rhs = ReadDWordOperand<src_mode, src_constant>(cpu);
     u32 new_value = lhs & rhs;
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    cpu->SetLazyFlags(LazyFlagsOperation::Logic32, lhs, rhs, new_value);
   }
   else
   {
@@ -1734,12 +1814,12 @@ void Interpreter::Execute_Operation_TEST(CPU* cpu)
     return;
   }
 
-  if constexpr (src_mode == OperandMode_Immediate)
-    cpu->AddCyclesRM(CYCLES_TEST_RM_MEM_REG, (dst_mode == OperandMode_ModRM_RM) ? cpu->idata.ModRM_RM_IsReg() : false);
+  if constexpr (src_mode == OperandMode_Immediate && dst_mode != OperandMode_ModRM_RM)
+    cpu->AddCyclesRM(CYCLES_TEST_RM_MEM_REG, false);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_TEST_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_TEST_RM_MEM_REG, IsRegisterModRMOperand<dst_constant>(cpu));
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_TEST_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_TEST_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 }
@@ -1750,8 +1830,8 @@ void Interpreter::Execute_Operation_MOV(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
   static_assert(dst_size == src_size, "dst_size == src_size");
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   // Invalid with the LOCK prefix.
   // TODO: a more general solution.
@@ -1768,9 +1848,9 @@ void Interpreter::Execute_Operation_MOV(CPU* cpu)
   else if constexpr (dst_mode == OperandMode_Memory && src_mode == OperandMode_Register)
     cpu->AddCycles(CYCLES_MOV_RM_MEM_REG);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_MOV_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_MOV_RM_MEM_REG, IsRegisterModRMOperand<dst_constant>(cpu));
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_MOV_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_MOV_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 
@@ -1796,11 +1876,11 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_MOVZX(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if constexpr (dst_mode == OperandMode_ModRM_Reg && src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_MOVZX_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_MOVZX_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 
@@ -1821,11 +1901,11 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_MOVSX(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if constexpr (dst_mode == OperandMode_ModRM_Reg && src_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_MOVSX_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_MOVSX_REG_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 
@@ -1846,8 +1926,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_MOV_Sreg(CPU* cpu)
 {
   static_assert(dst_size == OperandSize_16 && src_size == OperandSize_16, "Segment registers are 16-bits");
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   const u8 segreg = cpu->idata.GetModRM_Reg();
 
@@ -1858,7 +1938,7 @@ void Interpreter::Execute_Operation_MOV_Sreg(CPU* cpu)
   if constexpr (dst_mode == OperandMode_ModRM_SegmentReg)
   {
     // Loading segment register.
-    cpu->AddCyclesPMode(cpu->idata.ModRM_RM_IsReg() ? CYCLES_MOV_SREG_RM_REG : CYCLES_MOV_SREG_RM_MEM);
+    cpu->AddCyclesPMode(IsRegisterModRMOperand<src_constant>(cpu) ? CYCLES_MOV_SREG_RM_REG : CYCLES_MOV_SREG_RM_MEM);
 
     // The MOV instruction cannot be used to load the CS register. Attempting to do so results in an invalid opcode
     // exception (#UD).
@@ -1874,7 +1954,7 @@ void Interpreter::Execute_Operation_MOV_Sreg(CPU* cpu)
   else
   {
     // Storing segment register.
-    cpu->AddCyclesRM(CYCLES_MOV_RM_MEM_SREG, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_MOV_RM_MEM_SREG, IsRegisterModRMOperand<dst_constant>(cpu));
     if (segreg >= Segment_Count)
     {
       cpu->RaiseException(Interrupt_InvalidOpcode);
@@ -1885,7 +1965,7 @@ void Interpreter::Execute_Operation_MOV_Sreg(CPU* cpu)
     u16 value = cpu->m_registers.segment_selectors[segreg];
     if constexpr (dst_mode == OperandMode_ModRM_RM)
     {
-      if (cpu->idata.operand_size == OperandSize_32 && cpu->idata.modrm_rm_register)
+      if (cpu->idata.operand_size == OperandSize_32 && IsRegisterModRMOperand<dst_constant>(cpu))
         WriteDWordOperand<dst_mode, dst_constant>(cpu, ZeroExtend32(value));
       else
         WriteWordOperand<dst_mode, dst_constant>(cpu, value);
@@ -1903,9 +1983,12 @@ void Interpreter::Execute_Operation_XCHG(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
   static_assert(dst_size == src_size, "source and destination operands are of same size");
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
-  cpu->AddCyclesRM(CYCLES_XCHG_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
+  if constexpr (dst_mode == OperandMode_ModRM_RM)
+    cpu->AddCyclesRM(CYCLES_XCHG_REG_RM_MEM, IsRegisterModRMOperand<dst_constant>(cpu));
+  else
+    cpu->AddCyclesRM(CYCLES_XCHG_REG_RM_MEM, true);
 
   // In memory version, memory is op0, register is op1. Memory must be written first.
   if (actual_size == OperandSize_8)
@@ -1940,9 +2023,9 @@ void Interpreter::Execute_Operation_SHL(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
   static_assert(count_size == OperandSize_8, "count is a byte-sized operand");
-  CalculateEffectiveAddress<val_mode>(cpu);
-  CalculateEffectiveAddress<count_mode>(cpu);
-  cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
+  CalculateEffectiveAddress<count_mode, count_constant>(cpu);
+  cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, IsRegisterModRMOperand<val_constant>(cpu));
 
   // Shift amounts will always be uint8
   // The 8086 does not mask the shift count. However, all other IA-32 processors
@@ -2022,9 +2105,9 @@ void Interpreter::Execute_Operation_SHR(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
   static_assert(count_size == OperandSize_8, "count is a byte-sized operand");
-  CalculateEffectiveAddress<val_mode>(cpu);
-  CalculateEffectiveAddress<count_mode>(cpu);
-  cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
+  CalculateEffectiveAddress<count_mode, count_constant>(cpu);
+  cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, IsRegisterModRMOperand<val_constant>(cpu));
 
   // Shift amounts will always be uint8
   // The 8086 does not mask the shift count. However, all other IA-32 processors
@@ -2095,11 +2178,11 @@ void Interpreter::Execute_Operation_SAR(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
   static_assert(count_size == OperandSize_8, "count is a byte-sized operand");
-  CalculateEffectiveAddress<val_mode>(cpu);
-  CalculateEffectiveAddress<count_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
+  CalculateEffectiveAddress<count_mode, count_constant>(cpu);
 
   // Cycles have to come first due to the early-out below.
-  cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_ALU_RM_MEM_REG, IsRegisterModRMOperand<val_constant>(cpu));
 
   // Shift amounts will always be uint8
   // The 8086 does not mask the shift count. However, all other IA-32 processors
@@ -2164,11 +2247,11 @@ void Interpreter::Execute_Operation_RCL(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
   static_assert(count_size == OperandSize_8, "count is a byte-sized operand");
-  CalculateEffectiveAddress<val_mode>(cpu);
-  CalculateEffectiveAddress<count_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
+  CalculateEffectiveAddress<count_mode, count_constant>(cpu);
 
   // Cycles have to come first due to the early-out below.
-  cpu->AddCyclesRM(CYCLES_RCL_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_RCL_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
 
   // The processor restricts the count to a number between 0 and 31 by masking all the bits in the count operand except
   // the 5 least-significant bits.
@@ -2233,11 +2316,11 @@ void Interpreter::Execute_Operation_RCR(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
   static_assert(count_size == OperandSize_8, "count is a byte-sized operand");
-  CalculateEffectiveAddress<val_mode>(cpu);
-  CalculateEffectiveAddress<count_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
+  CalculateEffectiveAddress<count_mode, count_constant>(cpu);
 
   // Cycles have to come first due to the early-out below.
-  cpu->AddCyclesRM(CYCLES_RCL_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_RCL_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
 
   // The processor restricts the count to a number between 0 and 31 by masking all the bits in the count operand except
   // the 5 least-significant bits.
@@ -2306,11 +2389,11 @@ void Interpreter::Execute_Operation_ROL(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
   static_assert(count_size == OperandSize_8, "count is a byte-sized operand");
-  CalculateEffectiveAddress<val_mode>(cpu);
-  CalculateEffectiveAddress<count_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
+  CalculateEffectiveAddress<count_mode, count_constant>(cpu);
 
   // Cycles have to come first due to the early-out below.
-  cpu->AddCyclesRM(CYCLES_ROL_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_ROL_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
 
   // Hopefully this will compile down to a native ROL instruction
   if (actual_size == OperandSize_8)
@@ -2377,11 +2460,11 @@ void Interpreter::Execute_Operation_ROR(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
   static_assert(count_size == OperandSize_8, "count is a byte-sized operand");
-  CalculateEffectiveAddress<val_mode>(cpu);
-  CalculateEffectiveAddress<count_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
+  CalculateEffectiveAddress<count_mode, count_constant>(cpu);
 
   // Cycles have to come first due to the early-out below.
-  cpu->AddCyclesRM(CYCLES_ROL_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_ROL_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
 
   // Hopefully this will compile down to a native ROR instruction
   if (actual_size == OperandSize_8)
@@ -2448,8 +2531,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_IN(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if constexpr (src_mode == OperandMode_Immediate)
     cpu->AddCyclesPMode(CYCLES_IN_IMM);
@@ -2505,8 +2588,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_OUT(CPU* cpu)
 {
   const OperandSize actual_size = (src_size == OperandSize_Count) ? cpu->idata.operand_size : src_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if constexpr (dst_mode == OperandMode_Immediate)
     cpu->AddCyclesPMode(CYCLES_OUT_IMM);
@@ -2561,12 +2644,12 @@ template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
 void Interpreter::Execute_Operation_INC(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
-  CalculateEffectiveAddress<val_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
 
   if constexpr (val_mode == OperandMode_Register)
     cpu->AddCycles(CYCLES_INC_RM_REG);
   else if constexpr (val_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_INC_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_INC_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
   else
     static_assert(dependent_int_false<val_mode>::value, "unknown mode");
 
@@ -2620,12 +2703,12 @@ template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
 void Interpreter::Execute_Operation_DEC(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
-  CalculateEffectiveAddress<val_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
 
   if constexpr (val_mode == OperandMode_Register)
     cpu->AddCycles(CYCLES_INC_RM_REG);
   else if constexpr (val_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_INC_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_INC_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
   else
     static_assert(dependent_int_false<val_mode>::value, "unknown mode");
 
@@ -2682,12 +2765,12 @@ template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
 void Interpreter::Execute_Operation_NOT(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
-  CalculateEffectiveAddress<val_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
 
   if constexpr (val_mode == OperandMode_Register)
     cpu->AddCycles(CYCLES_NEG_RM_REG);
   else if constexpr (val_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_NEG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_NEG_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
   else
     static_assert(dependent_int_false<val_mode>::value, "unknown mode");
 
@@ -2715,12 +2798,12 @@ template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
 void Interpreter::Execute_Operation_NEG(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
-  CalculateEffectiveAddress<val_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
 
   if constexpr (val_mode == OperandMode_Register)
     cpu->AddCycles(CYCLES_NEG_RM_REG);
   else if constexpr (val_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_NEG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_NEG_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
   else
     static_assert(dependent_int_false<val_mode>::value, "unknown mode");
 
@@ -2780,7 +2863,7 @@ template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
 void Interpreter::Execute_Operation_MUL(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
-  CalculateEffectiveAddress<val_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
 
   // The OF and CF flags are set to 0 if the upper half of the result is 0;
   // otherwise, they are set to 1. The SF, ZF, AF, and PF flags are undefined.
@@ -2802,7 +2885,7 @@ void Interpreter::Execute_Operation_MUL(CPU* cpu)
       ZeroFlag(al) |                                                                        // ZF
       ParityFlag(al);                                                                       // PF
 
-    cpu->AddCyclesRM(CYCLES_MUL_8_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_MUL_8_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
   }
   else if (actual_size == OperandSize_16)
   {
@@ -2823,7 +2906,7 @@ void Interpreter::Execute_Operation_MUL(CPU* cpu)
       ZeroFlag(ax) |                                                                        // ZF
       ParityFlag(ax);                                                                       // PF
 
-    cpu->AddCyclesRM(CYCLES_MUL_16_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_MUL_16_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
   }
   else if (actual_size == OperandSize_32)
   {
@@ -2844,7 +2927,7 @@ void Interpreter::Execute_Operation_MUL(CPU* cpu)
       ZeroFlag(eax) |                                                                       // ZF
       ParityFlag(eax);                                                                      // PF
 
-    cpu->AddCyclesRM(CYCLES_MUL_32_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_MUL_32_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
   }
 }
 
@@ -2852,9 +2935,9 @@ template<OperandSize op1_size, OperandMode op1_mode, u32 op1_constant, OperandSi
          u32 op2_constant, OperandSize op3_size, OperandMode op3_mode, u32 op3_constant>
 void Interpreter::Execute_Operation_IMUL(CPU* cpu)
 {
-  CalculateEffectiveAddress<op1_mode>(cpu);
-  CalculateEffectiveAddress<op2_mode>(cpu);
-  CalculateEffectiveAddress<op3_mode>(cpu);
+  CalculateEffectiveAddress<op1_mode, op1_constant>(cpu);
+  CalculateEffectiveAddress<op2_mode, op2_constant>(cpu);
+  CalculateEffectiveAddress<op3_mode, op3_constant>(cpu);
 
   const OperandSize actual_size = (op1_size == OperandSize_Count) ? cpu->idata.operand_size : op1_size;
   if (actual_size == OperandSize_8)
@@ -2880,7 +2963,7 @@ void Interpreter::Execute_Operation_IMUL(CPU* cpu)
       ZeroFlag(truncated_result) |                                                          // ZF
       ParityFlag(truncated_result);                                                         // PF
 
-    cpu->AddCyclesRM(CYCLES_IMUL_8_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_IMUL_8_RM_MEM, IsRegisterModRMOperand<op1_constant>(cpu));
   }
   else if (actual_size == OperandSize_16)
   {
@@ -2896,7 +2979,7 @@ void Interpreter::Execute_Operation_IMUL(CPU* cpu)
       result = u32(s32(lhs) * s32(rhs));
       truncated_result = Truncate16(result);
 
-      cpu->AddCyclesRM(CYCLES_IMUL_16_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+      cpu->AddCyclesRM(CYCLES_IMUL_16_REG_RM_MEM, IsRegisterModRMOperand<op2_constant>(cpu));
       WriteWordOperand<op1_mode, op1_constant>(cpu, truncated_result);
     }
     else if constexpr (op2_mode != OperandMode_None)
@@ -2907,7 +2990,7 @@ void Interpreter::Execute_Operation_IMUL(CPU* cpu)
       result = u32(s32(lhs) * s32(rhs));
       truncated_result = Truncate16(result);
 
-      cpu->AddCyclesRM(CYCLES_IMUL_16_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+      cpu->AddCyclesRM(CYCLES_IMUL_16_RM_MEM, IsRegisterModRMOperand<op2_constant>(cpu));
       WriteWordOperand<op1_mode, op1_constant>(cpu, truncated_result);
     }
     else
@@ -2918,7 +3001,7 @@ void Interpreter::Execute_Operation_IMUL(CPU* cpu)
       result = u32(s32(lhs) * s32(rhs));
       truncated_result = Truncate16(result);
 
-      cpu->AddCyclesRM(CYCLES_IMUL_16_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+      cpu->AddCyclesRM(CYCLES_IMUL_16_RM_MEM, IsRegisterModRMOperand<op1_constant>(cpu));
       cpu->m_registers.DX = Truncate16(result >> 16);
       cpu->m_registers.AX = truncated_result;
     }
@@ -2947,7 +3030,7 @@ void Interpreter::Execute_Operation_IMUL(CPU* cpu)
       result = u64(s64(lhs) * s64(rhs));
       truncated_result = Truncate32(result);
 
-      cpu->AddCyclesRM(CYCLES_IMUL_32_REG_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+      cpu->AddCyclesRM(CYCLES_IMUL_32_REG_RM_MEM, IsRegisterModRMOperand<op2_constant>(cpu));
       WriteDWordOperand<op1_mode, op1_constant>(cpu, truncated_result);
     }
     else if constexpr (op2_mode != OperandMode_None)
@@ -2958,7 +3041,7 @@ void Interpreter::Execute_Operation_IMUL(CPU* cpu)
       result = u64(s64(lhs) * s64(rhs));
       truncated_result = Truncate32(result);
 
-      cpu->AddCyclesRM(CYCLES_IMUL_32_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+      cpu->AddCyclesRM(CYCLES_IMUL_32_RM_MEM, IsRegisterModRMOperand<op2_constant>(cpu));
       WriteDWordOperand<op1_mode, op1_constant>(cpu, truncated_result);
     }
     else
@@ -2969,7 +3052,7 @@ void Interpreter::Execute_Operation_IMUL(CPU* cpu)
       result = u64(s64(lhs) * s64(rhs));
       truncated_result = Truncate32(result);
 
-      cpu->AddCyclesRM(CYCLES_IMUL_32_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+      cpu->AddCyclesRM(CYCLES_IMUL_32_RM_MEM, IsRegisterModRMOperand<op1_constant>(cpu));
       cpu->m_registers.EDX = Truncate32(u64(result) >> 32);
       cpu->m_registers.EAX = truncated_result;
     }
@@ -2990,11 +3073,11 @@ template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
 void Interpreter::Execute_Operation_DIV(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
-  CalculateEffectiveAddress<val_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
-    cpu->AddCyclesRM(CYCLES_DIV_8_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_DIV_8_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
 
     // Eight-bit divides use AX as a source
     u8 divisor = ReadByteOperand<val_mode, val_constant>(cpu);
@@ -3018,7 +3101,7 @@ void Interpreter::Execute_Operation_DIV(CPU* cpu)
   }
   else if (actual_size == OperandSize_16)
   {
-    cpu->AddCyclesRM(CYCLES_DIV_16_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_DIV_16_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
 
     // 16-bit divides use DX:AX as a source
     u16 divisor = ReadWordOperand<val_mode, val_constant>(cpu);
@@ -3042,7 +3125,7 @@ void Interpreter::Execute_Operation_DIV(CPU* cpu)
   }
   else if (actual_size == OperandSize_32)
   {
-    cpu->AddCyclesRM(CYCLES_DIV_32_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_DIV_32_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
 
     // 32-bit divides use EDX:EAX as a source
     u32 divisor = ReadDWordOperand<val_mode, val_constant>(cpu);
@@ -3075,11 +3158,11 @@ template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
 void Interpreter::Execute_Operation_IDIV(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
-  CalculateEffectiveAddress<val_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
-    cpu->AddCyclesRM(CYCLES_IDIV_8_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_IDIV_8_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
 
     // Eight-bit divides use AX as a source
     s8 divisor = s8(ReadByteOperand<val_mode, val_constant>(cpu));
@@ -3105,7 +3188,7 @@ void Interpreter::Execute_Operation_IDIV(CPU* cpu)
   }
   else if (actual_size == OperandSize_16)
   {
-    cpu->AddCyclesRM(CYCLES_IDIV_16_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_IDIV_16_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
 
     // 16-bit divides use DX:AX as a source
     s16 divisor = s16(ReadWordOperand<val_mode, val_constant>(cpu));
@@ -3131,7 +3214,7 @@ void Interpreter::Execute_Operation_IDIV(CPU* cpu)
   }
   else if (actual_size == OperandSize_32)
   {
-    cpu->AddCyclesRM(CYCLES_IDIV_32_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_IDIV_32_RM_MEM, IsRegisterModRMOperand<val_constant>(cpu));
 
     // 16-bit divides use DX:AX as a source
     s32 divisor = s32(ReadDWordOperand<val_mode, val_constant>(cpu));
@@ -3160,14 +3243,14 @@ void Interpreter::Execute_Operation_IDIV(CPU* cpu)
 template<OperandSize src_size, OperandMode src_mode, u32 src_constant>
 void Interpreter::Execute_Operation_PUSH(CPU* cpu)
 {
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   if constexpr (src_mode == OperandMode_Immediate)
     cpu->AddCycles(CYCLES_PUSH_IMM);
   else if constexpr (src_mode == OperandMode_Register)
     cpu->AddCycles(CYCLES_PUSH_REG);
   else if constexpr (src_mode == OperandMode_ModRM_RM)
-    cpu->AddCycles(cpu->idata.ModRM_RM_IsReg() ? CYCLES_PUSH_REG : CYCLES_PUSH_MEM);
+    cpu->AddCycles(IsRegisterModRMOperand<src_constant>(cpu) ? CYCLES_PUSH_REG : CYCLES_PUSH_MEM);
   else
     static_assert(dependent_int_false<src_mode>::value, "unknown mode");
 
@@ -3221,7 +3304,7 @@ void Interpreter::Execute_Operation_POP(CPU* cpu)
   if constexpr (dst_mode == OperandMode_Register)
     cpu->AddCycles(CYCLES_POP_REG);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCycles(cpu->idata.ModRM_RM_IsReg() ? CYCLES_POP_REG : CYCLES_POP_MEM);
+    cpu->AddCycles(IsRegisterModRMOperand<dst_constant>(cpu) ? CYCLES_POP_REG : CYCLES_POP_MEM);
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 
@@ -3230,13 +3313,13 @@ void Interpreter::Execute_Operation_POP(CPU* cpu)
   if (cpu->idata.operand_size == OperandSize_16)
   {
     u16 value = cpu->PopWord();
-    CalculateEffectiveAddress<dst_mode>(cpu);
+    CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
     WriteWordOperand<dst_mode, dst_constant>(cpu, value);
   }
   else
   {
     u32 value = cpu->PopDWord();
-    CalculateEffectiveAddress<dst_mode>(cpu);
+    CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
     WriteDWordOperand<dst_mode, dst_constant>(cpu, value);
   }
 }
@@ -3395,13 +3478,13 @@ void Interpreter::Execute_Operation_LXS(CPU* cpu)
   static_assert(ptr_mode == OperandMode_ModRM_RM, "reg_mode is Pointer");
 
   // #UD if the second argument is a register, not memory.
-  if (ptr_mode == OperandMode_ModRM_RM && cpu->idata.modrm_rm_register)
+  if (ptr_mode == OperandMode_ModRM_RM && IsRegisterModRMOperand<ptr_constant>(cpu))
   {
     cpu->RaiseException(Interrupt_InvalidOpcode);
     return;
   }
 
-  CalculateEffectiveAddress<ptr_mode>(cpu);
+  CalculateEffectiveAddress<ptr_mode, ptr_constant>(cpu);
   cpu->AddCyclesPMode(CYCLES_LxS);
 
   u16 segment_selector;
@@ -3424,8 +3507,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_LEA(CPU* cpu)
 {
   static_assert(src_mode == OperandMode_ModRM_RM, "Source operand is a pointer");
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
   cpu->AddCycles(CYCLES_LEA);
 
   // Calculate full address in instruction's address mode, truncate/extend to operand size.
@@ -3438,12 +3521,12 @@ void Interpreter::Execute_Operation_LEA(CPU* cpu)
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_JMP_Near(CPU* cpu)
 {
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   if constexpr (dst_mode == OperandMode_Relative)
     cpu->AddCycles(CYCLES_JMP_NEAR);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_JMP_NEAR_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_JMP_NEAR_RM_MEM, IsRegisterModRMOperand<dst_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 
@@ -3454,7 +3537,7 @@ void Interpreter::Execute_Operation_JMP_Near(CPU* cpu)
 template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_Jcc(CPU* cpu)
 {
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
   if (!TestJumpCondition<condition>(cpu))
   {
     cpu->AddCycles((condition == JumpCondition_CXZero) ? CYCLES_JCXZ_NOT_TAKEN : CYCLES_Jcc_NOT_TAKEN);
@@ -3469,7 +3552,7 @@ void Interpreter::Execute_Operation_Jcc(CPU* cpu)
 template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_LOOP(CPU* cpu)
 {
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   cpu->AddCycles((condition != JumpCondition_Always) ? CYCLES_LOOPZ : CYCLES_LOOP);
 
@@ -3490,12 +3573,12 @@ void Interpreter::Execute_Operation_LOOP(CPU* cpu)
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_CALL_Near(CPU* cpu)
 {
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   if constexpr (dst_mode == OperandMode_Relative)
     cpu->AddCycles(CYCLES_CALL_NEAR);
   else if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_CALL_NEAR_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_CALL_NEAR_RM_MEM, IsRegisterModRMOperand<dst_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 
@@ -3511,7 +3594,7 @@ void Interpreter::Execute_Operation_CALL_Near(CPU* cpu)
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_RET_Near(CPU* cpu)
 {
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
   cpu->AddCycles(CYCLES_RET_NEAR);
 
   u32 pop_count = 0;
@@ -3545,14 +3628,14 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_JMP_Far(CPU* cpu)
 {
   // #UD if the second argument is a register, not memory.
-  if (dst_mode == OperandMode_ModRM_RM && cpu->idata.modrm_rm_register)
+  if (dst_mode == OperandMode_ModRM_RM && IsRegisterModRMOperand<dst_constant>(cpu))
   {
     cpu->RaiseException(Interrupt_InvalidOpcode);
     return;
   }
 
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   if constexpr (dst_mode == OperandMode_FarAddress)
     cpu->AddCycles(CYCLES_JMP_FAR);
@@ -3572,14 +3655,14 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_CALL_Far(CPU* cpu)
 {
   // #UD if the second argument is a register, not memory.
-  if (dst_mode == OperandMode_ModRM_RM && cpu->idata.modrm_rm_register)
+  if (dst_mode == OperandMode_ModRM_RM && IsRegisterModRMOperand<dst_constant>(cpu))
   {
     cpu->RaiseException(Interrupt_InvalidOpcode);
     return;
   }
 
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   if constexpr (dst_mode == OperandMode_FarAddress)
     cpu->AddCycles(CYCLES_CALL_FAR);
@@ -3598,7 +3681,7 @@ void Interpreter::Execute_Operation_CALL_Far(CPU* cpu)
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_RET_Far(CPU* cpu)
 {
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   cpu->AddCycles(CYCLES_RET_FAR);
 
@@ -3979,7 +4062,7 @@ void Interpreter::Execute_Operation_AAS(CPU* cpu)
 template<OperandSize op_size, OperandMode op_mode, u32 op_constant>
 void Interpreter::Execute_Operation_AAM(CPU* cpu)
 {
-  CalculateEffectiveAddress<op_mode>(cpu);
+  CalculateEffectiveAddress<op_mode, op_constant>(cpu);
   cpu->AddCycles(CYCLES_AAM);
 
   const u8 operand = ReadByteOperand<op_mode, op_constant>(cpu);
@@ -4000,7 +4083,7 @@ void Interpreter::Execute_Operation_AAM(CPU* cpu)
 template<OperandSize op_size, OperandMode op_mode, u32 op_constant>
 void Interpreter::Execute_Operation_AAD(CPU* cpu)
 {
-  CalculateEffectiveAddress<op_mode>(cpu);
+  CalculateEffectiveAddress<op_mode, op_constant>(cpu);
   cpu->AddCycles(CYCLES_AAD);
 
   const u8 operand = ReadByteOperand<op_mode, op_constant>(cpu);
@@ -4066,7 +4149,7 @@ void Interpreter::Execute_Operation_DAS(CPU* cpu)
 template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
 void Interpreter::Execute_Operation_BSWAP(CPU* cpu)
 {
-  CalculateEffectiveAddress<val_mode>(cpu);
+  CalculateEffectiveAddress<val_mode, val_constant>(cpu);
   cpu->AddCycles(CYCLES_BSWAP);
 
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
@@ -4086,7 +4169,7 @@ void Interpreter::Execute_Operation_BSWAP(CPU* cpu)
 template<OperandSize addr_size, OperandMode addr_mode, u32 addr_constant>
 void Interpreter::Execute_Operation_INVLPG(CPU* cpu)
 {
-  CalculateEffectiveAddress<addr_mode>(cpu);
+  CalculateEffectiveAddress<addr_mode, addr_constant>(cpu);
   cpu->AddCycles(CYCLES_INVLPG);
 
   if (cpu->GetCPL() != 0)
@@ -4096,7 +4179,7 @@ void Interpreter::Execute_Operation_INVLPG(CPU* cpu)
   }
 
   // Get effective address of operand, this is the linear address to clear.
-  if (cpu->idata.ModRM_RM_IsReg() || cpu->idata.has_lock)
+  if (IsRegisterModRMOperand<addr_constant>(cpu) || cpu->idata.has_lock)
   {
     cpu->RaiseException(Interrupt_InvalidOpcode, 0);
     return;
@@ -4109,8 +4192,8 @@ template<OperandSize addr_size, OperandMode addr_mode, u32 addr_constant, Operan
          OperandMode table_mode, u32 table_constant>
 void Interpreter::Execute_Operation_BOUND(CPU* cpu)
 {
-  CalculateEffectiveAddress<addr_mode>(cpu);
-  CalculateEffectiveAddress<table_mode>(cpu);
+  CalculateEffectiveAddress<addr_mode, addr_constant>(cpu);
+  CalculateEffectiveAddress<table_mode, table_constant>(cpu);
 
   u32 address;
   u32 lower_bound;
@@ -4151,7 +4234,7 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_ARPL(CPU* cpu)
 {
   static_assert(src_size == OperandSize_16 && dst_size == OperandSize_16, "operand sizes are 16-bits");
-  cpu->AddCyclesRM(CYCLES_ARPL_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_ARPL_RM_MEM, IsRegisterModRMOperand<dst_constant>(cpu));
 
   if (cpu->InRealMode() || cpu->InVirtual8086Mode())
   {
@@ -4159,8 +4242,8 @@ void Interpreter::Execute_Operation_ARPL(CPU* cpu)
     return;
   }
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
   SEGMENT_SELECTOR_VALUE dst = {ReadWordOperand<dst_mode, dst_constant>(cpu)};
   SEGMENT_SELECTOR_VALUE src = {ReadWordOperand<src_mode, src_constant>(cpu)};
 
@@ -4186,7 +4269,7 @@ void Interpreter::Execute_Operation_VERx(CPU* cpu)
     return;
   }
 
-  CalculateEffectiveAddress<selector_mode>(cpu);
+  CalculateEffectiveAddress<selector_mode, selector_constant>(cpu);
 
   SEGMENT_SELECTOR_VALUE selector;
   selector.bits = ReadWordOperand<selector_mode, selector_constant>(cpu);
@@ -4230,14 +4313,14 @@ void Interpreter::Execute_Operation_VERx(CPU* cpu)
 template<OperandSize selector_size, OperandMode selector_mode, u32 selector_constant>
 void Interpreter::Execute_Operation_VERW(CPU* cpu)
 {
-  cpu->AddCyclesRM(CYCLES_VERR_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_VERR_RM_MEM, IsRegisterModRMOperand<selector_constant>(cpu));
   Execute_Operation_VERx<Operation_VERW, selector_size, selector_mode, selector_constant>(cpu);
 }
 
 template<OperandSize selector_size, OperandMode selector_mode, u32 selector_constant>
 void Interpreter::Execute_Operation_VERR(CPU* cpu)
 {
-  cpu->AddCyclesRM(CYCLES_VERW_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_VERW_RM_MEM, IsRegisterModRMOperand<selector_constant>(cpu));
   Execute_Operation_VERx<Operation_VERR, selector_size, selector_mode, selector_constant>(cpu);
 }
 
@@ -4246,9 +4329,9 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_LSL(CPU* cpu)
 {
   static_assert(selector_size == OperandSize_16, "selector size is 16-bits");
-  cpu->AddCyclesRM(CYCLES_LSL_RM_MEM, cpu->idata.ModRM_RM_IsReg());
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<selector_mode>(cpu);
+  cpu->AddCyclesRM(CYCLES_LSL_RM_MEM, IsRegisterModRMOperand<selector_constant>(cpu));
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<selector_mode, selector_constant>(cpu);
 
   if (cpu->InRealMode() || cpu->InVirtual8086Mode())
   {
@@ -4303,9 +4386,9 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_LAR(CPU* cpu)
 {
   static_assert(selector_size == OperandSize_16, "selector size is 16-bits");
-  cpu->AddCyclesRM(CYCLES_LAR_RM_MEM, cpu->idata.ModRM_RM_IsReg());
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<selector_mode>(cpu);
+  cpu->AddCyclesRM(CYCLES_LAR_RM_MEM, IsRegisterModRMOperand<selector_constant>(cpu));
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<selector_mode, selector_constant>(cpu);
 
   if (cpu->InRealMode() || cpu->InVirtual8086Mode())
   {
@@ -4366,7 +4449,7 @@ void Interpreter::Execute_Operation_LIDT(CPU* cpu)
     return;
   }
 
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
   const VirtualMemoryAddress base_address = cpu->m_effective_address;
   u32 table_limit = ZeroExtend32(cpu->ReadSegmentMemoryWord(cpu->idata.segment, base_address + 0));
   u32 table_base_address = cpu->ReadSegmentMemoryDWord(cpu->idata.segment, base_address + 2);
@@ -4388,7 +4471,7 @@ void Interpreter::Execute_Operation_LGDT(CPU* cpu)
     return;
   }
 
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
   const VirtualMemoryAddress base_address = cpu->m_effective_address;
   u32 table_limit = ZeroExtend32(cpu->ReadSegmentMemoryWord(cpu->idata.segment, base_address + 0));
   u32 table_base_address = cpu->ReadSegmentMemoryDWord(cpu->idata.segment, base_address + 2);
@@ -4403,7 +4486,7 @@ void Interpreter::Execute_Operation_LGDT(CPU* cpu)
 template<OperandSize src_size, OperandMode src_mode, u32 src_constant>
 void Interpreter::Execute_Operation_LLDT(CPU* cpu)
 {
-  cpu->AddCyclesRM(CYCLES_LLDT_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_LLDT_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   if (cpu->InRealMode() || cpu->InVirtual8086Mode())
   {
     cpu->RaiseException(Interrupt_InvalidOpcode);
@@ -4416,7 +4499,7 @@ void Interpreter::Execute_Operation_LLDT(CPU* cpu)
     return;
   }
 
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
   const u16 selector = ReadWordOperand<src_mode, src_constant>(cpu);
   cpu->LoadLocalDescriptorTable(selector);
 }
@@ -4424,7 +4507,7 @@ void Interpreter::Execute_Operation_LLDT(CPU* cpu)
 template<OperandSize src_size, OperandMode src_mode, u32 src_constant>
 void Interpreter::Execute_Operation_LTR(CPU* cpu)
 {
-  cpu->AddCyclesRM(CYCLES_LTR_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_LTR_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
   if (cpu->InRealMode() || cpu->InVirtual8086Mode())
   {
     cpu->RaiseException(Interrupt_InvalidOpcode);
@@ -4437,7 +4520,7 @@ void Interpreter::Execute_Operation_LTR(CPU* cpu)
     return;
   }
 
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
   const u16 selector = ReadWordOperand<src_mode, src_constant>(cpu);
   cpu->LoadTaskSegment(selector);
 }
@@ -4445,7 +4528,7 @@ void Interpreter::Execute_Operation_LTR(CPU* cpu)
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_SIDT(CPU* cpu)
 {
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
   cpu->AddCycles(CYCLES_SGDT);
 
   u32 idt_address = Truncate32(cpu->m_idt_location.base_address);
@@ -4464,7 +4547,7 @@ void Interpreter::Execute_Operation_SIDT(CPU* cpu)
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_SGDT(CPU* cpu)
 {
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
   cpu->AddCycles(CYCLES_SGDT);
 
   u32 gdt_address = Truncate32(cpu->m_gdt_location.base_address);
@@ -4475,7 +4558,7 @@ void Interpreter::Execute_Operation_SGDT(CPU* cpu)
     gdt_address = (gdt_address & 0xFFFFFF);
 
   // Write back to memory
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
   const VirtualMemoryAddress base_address = cpu->m_effective_address;
   cpu->WriteSegmentMemoryWord(cpu->idata.segment, base_address + 0, gdt_limit);
   cpu->WriteSegmentMemoryDWord(cpu->idata.segment, base_address + 2, gdt_address);
@@ -4484,7 +4567,7 @@ void Interpreter::Execute_Operation_SGDT(CPU* cpu)
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_SLDT(CPU* cpu)
 {
-  cpu->AddCyclesRM(CYCLES_SLDT_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_SLDT_RM_MEM, IsRegisterModRMOperand<dst_constant>(cpu));
 
   if (cpu->InRealMode() || cpu->InVirtual8086Mode())
   {
@@ -4492,14 +4575,14 @@ void Interpreter::Execute_Operation_SLDT(CPU* cpu)
     return;
   }
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
   WriteWordOperand<dst_mode, dst_constant>(cpu, cpu->m_registers.LDTR);
 }
 
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_STR(CPU* cpu)
 {
-  cpu->AddCyclesRM(CYCLES_STR_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_STR_RM_MEM, IsRegisterModRMOperand<dst_constant>(cpu));
 
   if (cpu->InRealMode() || cpu->InVirtual8086Mode())
   {
@@ -4507,14 +4590,14 @@ void Interpreter::Execute_Operation_STR(CPU* cpu)
     return;
   }
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
   WriteWordOperand<dst_mode, dst_constant>(cpu, cpu->m_registers.TR);
 }
 
 template<OperandSize src_size, OperandMode src_mode, u32 src_constant>
 void Interpreter::Execute_Operation_LMSW(CPU* cpu)
 {
-  cpu->AddCyclesRM(CYCLES_LMSW_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_LMSW_RM_MEM, IsRegisterModRMOperand<src_constant>(cpu));
 
   if (cpu->GetCPL() != 0)
   {
@@ -4523,7 +4606,7 @@ void Interpreter::Execute_Operation_LMSW(CPU* cpu)
   }
 
   // LMSW cannot clear the PE bit of CR0.
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
   const u16 value = ReadWordOperand<src_mode, src_constant>(cpu);
   cpu->LoadSpecialRegister(Reg32_CR0, (cpu->m_registers.CR0 & 0xFFFFFFF1) | ZeroExtend32(value & 0xF));
 }
@@ -4531,9 +4614,9 @@ void Interpreter::Execute_Operation_LMSW(CPU* cpu)
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_SMSW(CPU* cpu)
 {
-  cpu->AddCyclesRM(CYCLES_SMSW_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  cpu->AddCyclesRM(CYCLES_SMSW_RM_MEM, IsRegisterModRMOperand<dst_constant>(cpu));
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
   const u16 value = Truncate16(cpu->m_registers.CR0);
   WriteWordOperand<dst_mode, dst_constant>(cpu, value);
 }
@@ -4544,12 +4627,12 @@ void Interpreter::Execute_Operation_SHLD(CPU* cpu)
 {
   static_assert(dst_size == src_size && count_size == OperandSize_8, "args are correct size");
   if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_SHLD_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_SHLD_RM_MEM, IsRegisterModRMOperand<dst_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
   if (actual_size == OperandSize_16)
@@ -4599,10 +4682,10 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_SHRD(CPU* cpu)
 {
   static_assert(dst_size == src_size && count_size == OperandSize_8, "args are correct size");
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
   if constexpr (dst_mode == OperandMode_ModRM_RM)
-    cpu->AddCyclesRM(CYCLES_SHLD_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+    cpu->AddCyclesRM(CYCLES_SHLD_RM_MEM, IsRegisterModRMOperand<dst_constant>(cpu));
   else
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 
@@ -4654,13 +4737,13 @@ void Interpreter::Execute_Operation_XADD(CPU* cpu)
 {
   cpu->AddCycles(CYCLES_XADD);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   // Order is swapped when both src/dst are registers.
   // We have to write the destination first for the memory version though, in case it faults.
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  const bool swap_order = (dst_mode == OperandMode_ModRM_RM && cpu->idata.ModRM_RM_IsReg());
+  const bool swap_order = IsRegisterModRMOperand<dst_constant>(cpu);
 
   if (actual_size == OperandSize_8)
   {
@@ -4739,8 +4822,8 @@ void Interpreter::Execute_Operation_CMPXCHG(CPU* cpu)
 {
   cpu->AddCycles(CYCLES_CMPXCHG);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
   if (actual_size == OperandSize_8)
@@ -4819,10 +4902,10 @@ void Interpreter::Execute_Operation_CMPXCHG8B(CPU* cpu)
   static_assert(mem_size == OperandSize_64, "operands is 64-bit");
   cpu->AddCycles(CYCLES_CMPXCHG8B);
 
-  CalculateEffectiveAddress<mem_mode>(cpu);
+  CalculateEffectiveAddress<mem_mode, mem_constant>(cpu);
 
   // If r/m is is register, #UD.
-  if (cpu->idata.modrm_rm_register)
+  if (IsRegisterModRMOperand<mem_constant>(cpu))
   {
     cpu->RaiseException(Interrupt_InvalidOpcode);
     return;
@@ -4854,8 +4937,8 @@ void Interpreter::Execute_Operation_BSR(CPU* cpu)
   cpu->AddCycles(CYCLES_BSF_BASE);
   cpu->AddCycles(CYCLES_BSF_N);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
   if (actual_size == OperandSize_16)
@@ -4898,8 +4981,8 @@ void Interpreter::Execute_Operation_BSF(CPU* cpu)
   cpu->AddCycles(CYCLES_BSF_BASE);
   cpu->AddCycles(CYCLES_BSF_N);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
   if (actual_size == OperandSize_16)
@@ -4942,20 +5025,20 @@ void Interpreter::Execute_Operation_BTx(CPU* cpu)
   if constexpr (src_mode == OperandMode_Immediate)
   {
     cpu->AddCyclesRM((operation == Operation_BT) ? CYCLES_BT_RM_MEM_IMM : CYCLES_BTx_RM_MEM_IMM,
-                     cpu->idata.ModRM_RM_IsReg());
+                     IsRegisterModRMOperand<dst_constant>(cpu));
   }
   else
   {
     cpu->AddCyclesRM((operation == Operation_BT) ? CYCLES_BT_RM_MEM_REG : CYCLES_BTx_RM_MEM_REG,
-                     cpu->idata.ModRM_RM_IsReg());
+                     IsRegisterModRMOperand<dst_constant>(cpu));
   }
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   // When combined with a memory operand, these instructions can access more than 16/32 bits.
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
-  const bool is_register_operand = cpu->idata.modrm_rm_register;
+  const bool is_register_operand = IsRegisterModRMOperand<dst_constant>(cpu);
   if (actual_size == OperandSize_16)
   {
     u16 source = ReadZeroExtendedWordOperand<src_size, src_mode, src_constant>(cpu);
@@ -5098,8 +5181,222 @@ void Interpreter::Execute_Operation_BT(CPU* cpu)
   Execute_Operation_BTx<Operation_BT, dst_size, dst_mode, dst_constant, src_size, src_mode, src_constant>(cpu);
 }
 
+template<AccessType access>
+byte* Interpreter::GetStringHostPointer(CPU* cpu, Segment segment, VirtualMemoryAddress offset, u32 element_size,
+                                       u32* count, bool* not_ram)
+{
+  // The index register wraps around at the address size, so elements can't cross the end.
+  const u64 address_space_size =
+    (cpu->idata.address_size == AddressSize_16) ? UINT64_C(0x10000) : UINT64_C(0x100000000);
+  if ((static_cast<u64>(offset) + element_size) > address_space_size)
+    return nullptr;
+
+  // Elements which cross pages, or would raise an alignment check, go through the normal path.
+  const LinearMemoryAddress linear_address = cpu->CalculateLinearAddress(segment, offset);
+  const u32 page_offset = linear_address & CPU::PAGE_OFFSET_MASK;
+  if ((page_offset + element_size) > CPU::PAGE_SIZE ||
+      (cpu->m_alignment_check_enabled && (linear_address & (element_size - 1)) != 0))
+  {
+    return nullptr;
+  }
+
+  // Limit the run to the current page and the address size.
+  u32 max_count;
+  if (!cpu->m_registers.EFLAGS.DF)
+  {
+    max_count = std::min((CPU::PAGE_SIZE - page_offset) / element_size,
+                         static_cast<u32>((address_space_size - offset) / element_size));
+  }
+  else
+  {
+    max_count = std::min(page_offset / element_size, offset / element_size) + 1;
+  }
+  max_count = std::min(max_count, *count);
+
+  // The accessible part of a segment is contiguous, so checking both ends of the run is sufficient.
+  // Leave the exception to the normal path, so it is raised on the correct iteration.
+  const u32 run_size = max_count * element_size;
+  const VirtualMemoryAddress run_start =
+    (!cpu->m_registers.EFLAGS.DF) ? offset : (offset - (run_size - element_size));
+  if (!cpu->CheckSegmentAccess<sizeof(u8), access>(segment, run_start, false) ||
+      !cpu->CheckSegmentAccess<sizeof(u8), access>(segment, run_start + (run_size - 1), false))
+  {
+    return nullptr;
+  }
+
+  // Page faults for the first element can be raised here, as the normal path would raise the same fault.
+  // Only plain RAM pages have a pointer, pages containing code or MMIO are excluded.
+  PhysicalMemoryAddress physical_address;
+  byte* host_ptr = cpu->TranslateLinearAddressToHostPointer<access>(&physical_address, linear_address);
+  if (!host_ptr)
+  {
+    *not_ram = true;
+    return nullptr;
+  }
+
+  *count = max_count;
+  return host_ptr;
+}
+
+template<Operation operation, typename T>
+u32 Interpreter::Execute_REP_Bulk(CPU* cpu, bool* not_ram)
+{
+  constexpr bool uses_source =
+    (operation == Operation_MOVS || operation == Operation_LODS || operation == Operation_CMPS);
+  constexpr bool uses_destination = (operation != Operation_LODS);
+  const bool address_size_16 = (cpu->idata.address_size == AddressSize_16);
+  const bool reverse = (cpu->m_registers.EFLAGS.DF != 0);
+  const ptrdiff_t step = reverse ? -static_cast<ptrdiff_t>(sizeof(T)) : static_cast<ptrdiff_t>(sizeof(T));
+
+  // The caller has already checked that the count is non-zero.
+  u32 count = address_size_16 ? ZeroExtend32(cpu->m_registers.CX) : cpu->m_registers.ECX;
+  byte* src_ptr = nullptr;
+  byte* dst_ptr = nullptr;
+  if constexpr (uses_source)
+  {
+    const VirtualMemoryAddress src_address = address_size_16 ? ZeroExtend32(cpu->m_registers.SI) : cpu->m_registers.ESI;
+    src_ptr =
+      GetStringHostPointer<AccessType::Read>(cpu, cpu->idata.segment, src_address, sizeof(T), &count, not_ram);
+    if (!src_ptr)
+      return 0;
+  }
+  if constexpr (uses_destination)
+  {
+    const VirtualMemoryAddress dst_address = address_size_16 ? ZeroExtend32(cpu->m_registers.DI) : cpu->m_registers.EDI;
+    dst_ptr = GetStringHostPointer<(operation == Operation_MOVS || operation == Operation_STOS) ? AccessType::Write :
+                                                                                                  AccessType::Read>(
+      cpu, Segment_ES, dst_address, sizeof(T), &count, not_ram);
+    if (!dst_ptr)
+      return 0;
+  }
+
+  u32 executed = count;
+  if constexpr (operation == Operation_MOVS)
+  {
+    // Overlapping moves have to be done one element at a time, as the result depends on the order.
+    const size_t run_size = count * sizeof(T);
+    byte* src_start = reverse ? (src_ptr - (run_size - sizeof(T))) : src_ptr;
+    byte* dst_start = reverse ? (dst_ptr - (run_size - sizeof(T))) : dst_ptr;
+    if ((dst_start + run_size) <= src_start || (src_start + run_size) <= dst_start)
+    {
+      std::memcpy(dst_start, src_start, run_size);
+    }
+    else
+    {
+      for (u32 i = 0; i < count; i++)
+      {
+        T value;
+        std::memcpy(&value, src_ptr, sizeof(T));
+        std::memcpy(dst_ptr, &value, sizeof(T));
+        src_ptr += step;
+        dst_ptr += step;
+      }
+    }
+  }
+  else if constexpr (operation == Operation_STOS)
+  {
+    byte* dst_start = reverse ? (dst_ptr - (count - 1) * sizeof(T)) : dst_ptr;
+    if constexpr (sizeof(T) == sizeof(u8))
+    {
+      std::memset(dst_start, cpu->m_registers.AL, count);
+    }
+    else
+    {
+      const T value =
+        (sizeof(T) == sizeof(u16)) ? static_cast<T>(cpu->m_registers.AX) : static_cast<T>(cpu->m_registers.EAX);
+      for (u32 i = 0; i < count; i++)
+        std::memcpy(dst_start + i * sizeof(T), &value, sizeof(T));
+    }
+  }
+  else if constexpr (operation == Operation_LODS)
+  {
+    // Only the last element loaded is visible.
+    T value;
+    std::memcpy(&value, src_ptr + static_cast<ptrdiff_t>(count - 1) * step, sizeof(T));
+    if constexpr (sizeof(T) == sizeof(u8))
+      cpu->m_registers.AL = value;
+    else if constexpr (sizeof(T) == sizeof(u16))
+      cpu->m_registers.AX = value;
+    else
+      cpu->m_registers.EAX = value;
+  }
+  else if constexpr (operation == Operation_SCAS || operation == Operation_CMPS)
+  {
+    // Find the element which terminates the loop, REPE stops on the first difference, REPNE on the first match.
+    const bool stop_on_equal = cpu->idata.has_repne;
+    T lhs = 0;
+    T rhs = 0;
+    if constexpr (operation == Operation_SCAS)
+    {
+      if constexpr (sizeof(T) == sizeof(u8))
+        lhs = cpu->m_registers.AL;
+      else if constexpr (sizeof(T) == sizeof(u16))
+        lhs = cpu->m_registers.AX;
+      else
+        lhs = cpu->m_registers.EAX;
+    }
+
+    bool scanned = false;
+    if constexpr (operation == Operation_SCAS && sizeof(T) == sizeof(u8))
+    {
+      if (stop_on_equal && !reverse)
+      {
+        const byte* match = static_cast<const byte*>(std::memchr(dst_ptr, lhs, count));
+        executed = match ? static_cast<u32>(match - dst_ptr + 1) : count;
+        rhs = dst_ptr[executed - 1];
+        scanned = true;
+      }
+    }
+    if (!scanned)
+    {
+      for (executed = 1;; executed++)
+      {
+        if constexpr (operation == Operation_CMPS)
+        {
+          std::memcpy(&lhs, src_ptr, sizeof(T));
+          src_ptr += step;
+        }
+        std::memcpy(&rhs, dst_ptr, sizeof(T));
+        dst_ptr += step;
+        if ((lhs == rhs) == stop_on_equal || executed == count)
+          break;
+      }
+    }
+
+    // Flags are from the last comparison.
+    if constexpr (sizeof(T) == sizeof(u8))
+      ALUOp_Sub8(&cpu->m_registers.EFLAGS.bits, lhs, rhs);
+    else if constexpr (sizeof(T) == sizeof(u16))
+      ALUOp_Sub16(&cpu->m_registers.EFLAGS.bits, lhs, rhs);
+    else
+      ALUOp_Sub32(&cpu->m_registers.EFLAGS.bits, lhs, rhs);
+  }
+
+  // Update the index and count registers as if the iterations had been executed individually.
+  const u32 delta = executed * sizeof(T);
+  if (address_size_16)
+  {
+    const u16 delta16 = Truncate16(delta);
+    if constexpr (uses_source)
+      cpu->m_registers.SI = reverse ? (cpu->m_registers.SI - delta16) : (cpu->m_registers.SI + delta16);
+    if constexpr (uses_destination)
+      cpu->m_registers.DI = reverse ? (cpu->m_registers.DI - delta16) : (cpu->m_registers.DI + delta16);
+    cpu->m_registers.CX -= Truncate16(executed);
+  }
+  else
+  {
+    if constexpr (uses_source)
+      cpu->m_registers.ESI = reverse ? (cpu->m_registers.ESI - delta) : (cpu->m_registers.ESI + delta);
+    if constexpr (uses_destination)
+      cpu->m_registers.EDI = reverse ? (cpu->m_registers.EDI - delta) : (cpu->m_registers.EDI + delta);
+    cpu->m_registers.ECX -= executed;
+  }
+
+  return executed;
+}
+
 template<Operation operation, bool check_equal, typename callback>
-void Interpreter::Execute_REP(CPU* cpu, callback cb)
+void Interpreter::Execute_REP(CPU* cpu, OperandSize data_size, callback cb)
 {
   const bool has_rep = cpu->idata.has_rep;
   if constexpr (operation == Operation_CMPS)
@@ -5128,6 +5425,8 @@ void Interpreter::Execute_REP(CPU* cpu, callback cb)
     return;
   }
 
+  // Once an operand turns out not to be plain RAM, e.g. the VGA window, stop probing for host memory.
+  bool try_bulk = true;
   for (;;)
   {
     cpu->AddCycle();
@@ -5158,15 +5457,58 @@ void Interpreter::Execute_REP(CPU* cpu, callback cb)
         return;
     }
 
-    // Execute the actual instruction.
-    cb(cpu);
+    // Run as many iterations as possible directly on host memory, when the data is in RAM.
+    u32 bulk_iterations = 0;
+    if constexpr (operation == Operation_CMPS || operation == Operation_LODS || operation == Operation_MOVS ||
+                  operation == Operation_SCAS || operation == Operation_STOS)
+    {
+      bool not_ram = false;
+      if (!try_bulk)
+        bulk_iterations = 0;
+      else if (data_size == OperandSize_8)
+        bulk_iterations = Execute_REP_Bulk<operation, u8>(cpu, &not_ram);
+      else if (data_size == OperandSize_16)
+        bulk_iterations = Execute_REP_Bulk<operation, u16>(cpu, &not_ram);
+      else
+        bulk_iterations = Execute_REP_Bulk<operation, u32>(cpu, &not_ram);
+      if (not_ram)
+        try_bulk = false;
+    }
 
-    // Decrement the count register after the operation.
     bool branch = true;
-    if (cpu->idata.address_size == AddressSize_16)
-      branch = (--cpu->m_registers.CX != 0);
+    if (bulk_iterations > 0)
+    {
+      // The first iteration was charged above, charge the remainder the same way.
+      const CycleCount extra_iterations = static_cast<CycleCount>(bulk_iterations - 1);
+      cpu->m_pending_cycles += extra_iterations;
+      if constexpr (operation == Operation_CMPS)
+        cpu->AddCycles(CYCLES_REP_CMPS_N, extra_iterations);
+      else if constexpr (operation == Operation_LODS)
+        cpu->AddCycles(CYCLES_REP_LODS_N, extra_iterations);
+      else if constexpr (operation == Operation_MOVS)
+        cpu->AddCycles(CYCLES_REP_MOVS_N, extra_iterations);
+      else if constexpr (operation == Operation_SCAS)
+        cpu->AddCycles(CYCLES_REP_SCAS_N, extra_iterations);
+      else if constexpr (operation == Operation_STOS)
+        cpu->AddCycles(CYCLES_REP_STOS_N, extra_iterations);
+
+      // The count register has already been updated.
+      if (cpu->idata.address_size == AddressSize_16)
+        branch = (cpu->m_registers.CX != 0);
+      else
+        branch = (cpu->m_registers.ECX != 0);
+    }
     else
-      branch = (--cpu->m_registers.ECX != 0);
+    {
+      // Execute the actual instruction.
+      cb(cpu);
+
+      // Decrement the count register after the operation.
+      if (cpu->idata.address_size == AddressSize_16)
+        branch = (--cpu->m_registers.CX != 0);
+      else
+        branch = (--cpu->m_registers.ECX != 0);
+    }
 
     // Finally test the post-condition.
     if constexpr (check_equal)
@@ -5204,7 +5546,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_INS(CPU* cpu)
 {
   // TODO: Move the port number check out of the loop.
-  Execute_REP<Operation_INS, false>(cpu, [](CPU* cpu) {
+  const OperandSize operand_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
+  Execute_REP<Operation_INS, false>(cpu, operand_size, [](CPU* cpu) {
     const VirtualMemoryAddress dst_address =
       (cpu->idata.address_size == AddressSize_16) ? ZeroExtend32(cpu->m_registers.DI) : cpu->m_registers.EDI;
     const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -5280,7 +5623,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
          u32 src_constant>
 void Interpreter::Execute_Operation_OUTS(CPU* cpu)
 {
-  Execute_REP<Operation_OUTS, false>(cpu, [](CPU* cpu) {
+  const OperandSize operand_size = (src_size == OperandSize_Count) ? cpu->idata.operand_size : src_size;
+  Execute_REP<Operation_OUTS, false>(cpu, operand_size, [](CPU* cpu) {
     const Segment segment = cpu->idata.segment;
     const VirtualMemoryAddress src_address =
       (cpu->idata.address_size == AddressSize_16) ? ZeroExtend32(cpu->m_registers.SI) : cpu->m_registers.ESI;
@@ -5358,7 +5702,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_SCAS(CPU* cpu)
 {
   static_assert(src_size == dst_size, "operand sizes are the same");
-  Execute_REP<Operation_SCAS, true>(cpu, [](CPU* cpu) {
+  const OperandSize operand_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
+  Execute_REP<Operation_SCAS, true>(cpu, operand_size, [](CPU* cpu) {
     // The ES segment cannot be overridden with a segment override prefix.
     VirtualMemoryAddress dst_address =
       (cpu->idata.address_size == AddressSize_16) ? ZeroExtend32(cpu->m_registers.DI) : cpu->m_registers.EDI;
@@ -5413,7 +5758,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_LODS(CPU* cpu)
 {
   static_assert(src_size == dst_size, "operand sizes are the same");
-  Execute_REP<Operation_LODS, false>(cpu, [](CPU* cpu) {
+  const OperandSize operand_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
+  Execute_REP<Operation_LODS, false>(cpu, operand_size, [](CPU* cpu) {
     const Segment segment = cpu->idata.segment;
     const VirtualMemoryAddress src_address =
       (cpu->idata.address_size == AddressSize_16) ? ZeroExtend32(cpu->m_registers.SI) : cpu->m_registers.ESI;
@@ -5466,7 +5812,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_STOS(CPU* cpu)
 {
   static_assert(src_size == dst_size, "operand sizes are the same");
-  Execute_REP<Operation_STOS, false>(cpu, [](CPU* cpu) {
+  const OperandSize operand_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
+  Execute_REP<Operation_STOS, false>(cpu, operand_size, [](CPU* cpu) {
     const VirtualMemoryAddress dst_address =
       (cpu->idata.address_size == AddressSize_16) ? ZeroExtend32(cpu->m_registers.DI) : cpu->m_registers.EDI;
     const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -5518,7 +5865,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_CMPS(CPU* cpu)
 {
   static_assert(src_size == dst_size, "operand sizes are the same");
-  Execute_REP<Operation_CMPS, true>(cpu, [](CPU* cpu) {
+  const OperandSize operand_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
+  Execute_REP<Operation_CMPS, true>(cpu, operand_size, [](CPU* cpu) {
     // The DS segment may be overridden with a segment override prefix, but the ES segment cannot be overridden.
     Segment src_segment = cpu->idata.segment;
     VirtualMemoryAddress src_address =
@@ -5589,7 +5937,8 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_MOVS(CPU* cpu)
 {
   static_assert(src_size == dst_size, "operand sizes are the same");
-  Execute_REP<Operation_MOVS, false>(cpu, [](CPU* cpu) {
+  const OperandSize operand_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
+  Execute_REP<Operation_MOVS, false>(cpu, operand_size, [](CPU* cpu) {
     // The DS segment may be over-ridden with a segment override prefix, but the ES segment cannot be overridden.
     const Segment src_segment = cpu->idata.segment;
     const VirtualMemoryAddress src_address =
@@ -5659,8 +6008,8 @@ void Interpreter::Execute_Operation_CMOVcc(CPU* cpu)
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
   cpu->AddCycles(CYCLES_CMOV);
 
-  CalculateEffectiveAddress<src_mode>(cpu);
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   // NOTE: Memory access is performed even if the predicate does not hold.
   bool do_move = TestJumpCondition<condition>(cpu);
@@ -5681,8 +6030,8 @@ void Interpreter::Execute_Operation_CMOVcc(CPU* cpu)
 template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
 void Interpreter::Execute_Operation_SETcc(CPU* cpu)
 {
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  cpu->AddCyclesRM(CYCLES_SETcc_RM_MEM, cpu->idata.ModRM_RM_IsReg());
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  cpu->AddCyclesRM(CYCLES_SETcc_RM_MEM, IsRegisterModRMOperand<dst_constant>(cpu));
 
   bool flag = TestJumpCondition<condition>(cpu);
   WriteByteOperand<dst_mode, dst_constant>(cpu, BoolToUInt8(flag));
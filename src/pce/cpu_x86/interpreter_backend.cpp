@@ -1,14 +1,32 @@
 #include "interpreter_backend.h"
+#include "../bus.h"
+#include "decoder.h"
 #include "interpreter.h"
+#include <array>
+#include <functional>
 
 namespace CPU_X86 {
 
 extern bool TRACE_EXECUTION;
 extern u32 TRACE_EXECUTION_LAST_EIP;
 
-InterpreterBackend::InterpreterBackend(CPU* cpu) : m_cpu(cpu), m_system(cpu->GetSystem()), m_bus(cpu->GetBus()) {}
+InterpreterBackend::InterpreterBackend(CPU* cpu)
+  : m_cpu(cpu), m_system(cpu->GetSystem()), m_bus(cpu->GetBus()),
+    m_decode_cache(std::make_unique<DecodeCacheEntry[]>(DECODE_CACHE_SIZE)),
+    m_page_generations(std::make_unique<u32[]>(m_bus->GetMemoryPageCount()))
+{
+  for (u32 i = 0; i < DECODE_CACHE_SIZE; i++)
+    m_decode_cache[i].key = INVALID_DECODE_CACHE_KEY;
+
+  m_bus->SetCodeInvalidationCallback(std::bind(&InterpreterBackend::InvalidateDecodeCacheRange, this,
+                                               std::placeholders::_1, std::placeholders::_2));
+}
 
-InterpreterBackend::~InterpreterBackend() {}
+InterpreterBackend::~InterpreterBackend()
+{
+  m_bus->ClearCodeInvalidationCallback();
+  m_bus->ClearPageCodeFlags();
+}
 
 void InterpreterBackend::Execute()
 {
@@ -47,11 +65,14 @@ void InterpreterBackend::Execute()
         TRACE_EXECUTION_LAST_EIP = m_cpu->m_registers.EIP;
       }
 
-      Interpreter::ExecuteInstruction(m_cpu);
+      if (!ExecuteCachedInstruction())
+        Interpreter::ExecuteInstruction(m_cpu);
+
       m_cpu->CommitPendingCycles();
     }
 
     // Run events if needed.
+    m_cpu->MaterializeLazyFlags();
     m_system->RunEvents();
   }
 }
@@ -67,6 +88,140 @@ size_t InterpreterBackend::GetCodeBlockCount() const
   return 0;
 }
 
-void InterpreterBackend::FlushCodeCache() {}
+size_t InterpreterBackend::GetCodeCacheSize() const
+{
+  return 0;
+}
+
+void InterpreterBackend::FlushCodeCache()
+{
+  for (u32 i = 0; i < DECODE_CACHE_SIZE; i++)
+    m_decode_cache[i].key = INVALID_DECODE_CACHE_KEY;
+
+  m_bus->ClearPageCodeFlags();
+}
+
+bool InterpreterBackend::ExecuteCachedInstruction()
+{
+  const VirtualMemoryAddress EIP = m_cpu->m_registers.EIP;
+  const LinearMemoryAddress linear_address = m_cpu->CalculateLinearAddress(Segment_CS, EIP);
+  PhysicalMemoryAddress physical_address;
+  if (!m_cpu->CheckSegmentAccess<sizeof(u8), AccessType::Execute>(Segment_CS, EIP, false) ||
+      !m_cpu->TranslateLinearAddress(
+        &physical_address, linear_address,
+        AddAccessTypeToFlags(AccessType::Execute, AccessFlags::Normal | AccessFlags::NoPageFaults)))
+  {
+    // Let the interpreter raise the fault.
+    return false;
+  }
+
+  physical_address &= m_bus->GetMemoryAddressMask();
+  const u64 key = GetDecodeCacheKey(physical_address, m_cpu->m_current_address_size, m_cpu->m_current_operand_size);
+  DecodeCacheEntry* entry = &m_decode_cache[GetDecodeCacheIndex(physical_address)];
+  if ((entry->key != key || entry->generation != m_page_generations[physical_address >> CPU::PAGE_SHIFT]) &&
+      !DecodeInstructionIntoCache(entry, physical_address, key))
+  {
+    return false;
+  }
+
+  // The whole instruction has to be within the segment, without wrapping around EIP.
+  const u32 length = entry->length;
+  if ((ZeroExtend64(EIP) + length - 1) > ZeroExtend64(m_cpu->m_EIP_mask) ||
+      !m_cpu->CheckSegmentAccess<sizeof(u8), AccessType::Execute>(Segment_CS, EIP + length - 1, false))
+  {
+    return false;
+  }
+
+  m_cpu->m_trap_after_instruction = m_cpu->m_registers.EFLAGS.TF;
+  m_cpu->m_current_EIP = EIP;
+  m_cpu->m_current_ESP = m_cpu->m_registers.ESP;
+  m_cpu->m_execution_stats.instructions_interpreted++;
+
+#ifdef ENABLE_PREFETCH_EMULATION
+  // Keep the prefetch queue in step with EIP, as if the instruction had been fetched through it.
+  if ((m_cpu->m_prefetch_queue_size - m_cpu->m_prefetch_queue_position) >= length)
+    m_cpu->m_prefetch_queue_position += length;
+  else
+    m_cpu->FlushPrefetchQueue();
+#endif
+
+  // The entry can be invalidated by the instruction itself, so don't touch it after calling the handler.
+  auto handler = entry->handler;
+  m_cpu->m_registers.EIP = (EIP + length) & m_cpu->m_EIP_mask;
+  std::memcpy(&m_cpu->idata, &entry->data, sizeof(m_cpu->idata));
+  handler(m_cpu);
+
+  if (m_cpu->m_trap_after_instruction)
+    m_cpu->RaiseDebugException();
+
+  return true;
+}
+
+bool InterpreterBackend::DecodeInstructionIntoCache(DecodeCacheEntry* entry, PhysicalMemoryAddress physical_address,
+                                                    u64 key)
+{
+  // Only RAM and cachable MMIO can be tracked for modifications.
+  if (!m_bus->IsCachablePage(physical_address))
+    return false;
+
+  // Instructions which cross a page are left to the interpreter, so the cache only depends on one page.
+  static constexpr u32 MAX_INSTRUCTION_LENGTH = 15;
+  const u32 page_offset = physical_address & CPU::PAGE_OFFSET_MASK;
+  const u32 fetch_size = std::min(CPU::PAGE_SIZE - page_offset, MAX_INSTRUCTION_LENGTH);
+  std::array<u8, MAX_INSTRUCTION_LENGTH> buffer;
+  m_bus->ReadMemoryBlock(physical_address, fetch_size, buffer.data());
+
+  u32 buffer_pos = 0;
+  auto fetchb = [&](u8* val) {
+    if ((buffer_pos + sizeof(u8)) > fetch_size)
+      return false;
+    *val = buffer[buffer_pos];
+    buffer_pos += sizeof(u8);
+    return true;
+  };
+  auto fetchw = [&](u16* val) {
+    if ((buffer_pos + sizeof(u16)) > fetch_size)
+      return false;
+    std::memcpy(val, &buffer[buffer_pos], sizeof(u16));
+    buffer_pos += sizeof(u16);
+    return true;
+  };
+  auto fetchd = [&](u32* val) {
+    if ((buffer_pos + sizeof(u32)) > fetch_size)
+      return false;
+    std::memcpy(val, &buffer[buffer_pos], sizeof(u32));
+    buffer_pos += sizeof(u32);
+    return true;
+  };
+
+  Instruction instruction;
+  if (!Decoder::DecodeInstruction(&instruction, m_cpu->m_current_address_size, m_cpu->m_current_operand_size,
+                                  m_cpu->m_registers.EIP, fetchb, fetchw, fetchd))
+  {
+    return false;
+  }
+
+  auto handler = Interpreter::GetInterpreterHandlerForInstruction(&instruction);
+  if (!handler)
+    return false;
+
+  entry->key = key;
+  entry->generation = m_page_generations[physical_address >> CPU::PAGE_SHIFT];
+  entry->handler = handler;
+  std::memcpy(&entry->data, &instruction.data, sizeof(entry->data));
+  entry->length = static_cast<u8>(instruction.length);
+  m_bus->MarkPageAsCode(physical_address & CPU::PAGE_MASK, Bus::GetCodeBitmapMask(page_offset, instruction.length));
+  return true;
+}
+
+void InterpreterBackend::InvalidateDecodeCacheRange(PhysicalMemoryAddress address, u32 size)
+{
+  // Bumping the generation drops every instruction in the page, without touching the cache itself.
+  const PhysicalMemoryAddress page_address = address & m_bus->GetMemoryAddressMask() & CPU::PAGE_MASK;
+  m_page_generations[page_address >> CPU::PAGE_SHIFT]++;
+
+  // Unmarks the page, so writes to it are fast again until its code is decoded again.
+  m_bus->SetPageCodeBitmap(page_address, 0);
+}
 
 } // namespace CPU_X86
@@ -2,6 +2,7 @@
 #include "common/fastjmp.h"
 #include "pce/cpu_x86/backend.h"
 #include "pce/cpu_x86/cpu_x86.h"
+#include <memory>
 
 namespace CPU_X86 {
 class InterpreterBackend : public Backend
@@ -14,12 +15,51 @@ public:
   void AbortCurrentInstruction() override;
 
   size_t GetCodeBlockCount() const override;
+  size_t GetCodeCacheSize() const override;
   void FlushCodeCache() override;
 
 private:
+  // Decoded instructions, direct-mapped by physical address. Instructions which cross a page are not cached.
+  // Entries are only valid while their page's generation matches, so a page can be invalidated without a scan.
+  static constexpr u32 DECODE_CACHE_SIZE = 4096;
+  static constexpr u64 INVALID_DECODE_CACHE_KEY = ~UINT64_C(0);
+
+  struct DecodeCacheEntry
+  {
+    // Physical address in the upper bits, address and operand size in the lower two bits.
+    u64 key;
+    u32 generation;
+    void (*handler)(CPU*);
+    InstructionData data;
+    u8 length;
+  };
+
+  static u64 GetDecodeCacheKey(PhysicalMemoryAddress physical_address, AddressSize address_size,
+                               OperandSize operand_size)
+  {
+    return (ZeroExtend64(physical_address) << 2) | (BoolToUInt64(address_size == AddressSize_32) << 1) |
+           BoolToUInt64(operand_size == OperandSize_32);
+  }
+  static PhysicalMemoryAddress GetDecodeCacheKeyAddress(u64 key) { return Truncate32(key >> 2); }
+  static u32 GetDecodeCacheIndex(PhysicalMemoryAddress physical_address)
+  {
+    return (physical_address ^ (physical_address >> CPU::PAGE_SHIFT)) & (DECODE_CACHE_SIZE - 1);
+  }
+
+  /// Executes the instruction at EIP from the decode cache, decoding it first if needed.
+  /// Returns false if the instruction can't be cached, and should be executed by the interpreter instead.
+  bool ExecuteCachedInstruction();
+  bool DecodeInstructionIntoCache(DecodeCacheEntry* entry, PhysicalMemoryAddress physical_address, u64 key);
+
+  // Invoked by the bus when code in a page containing cached instructions is modified.
+  // Drops every instruction in the page, which is re-marked as code as it gets decoded again.
+  void InvalidateDecodeCacheRange(PhysicalMemoryAddress address, u32 size);
+
   CPU* m_cpu;
   System* m_system;
   Bus* m_bus;
+  std::unique_ptr<DecodeCacheEntry[]> m_decode_cache;
+  std::unique_ptr<u32[]> m_page_generations;
 #ifdef Y_COMPILER_MSVC
 #pragma warning(push)
 #pragma warning(disable : 4324)
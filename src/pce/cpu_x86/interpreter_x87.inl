@@ -5,6 +5,9 @@
 #include "pce/cpu_x86/interpreter.h"
 #include "pce/interrupt_controller.h"
 #include "pce/system.h"
+#include <cfloat>
+#include <cmath>
+#include <cstring>
 
 #ifdef Y_COMPILER_MSVC
 #include <intrin.h>
@@ -52,6 +55,17 @@ floatx80 Interpreter::ReadFloatOperand(CPU* cpu, float_status_t& fs)
     {
       // Convert single precision -> extended precision.
       u32 dword_val = cpu->ReadSegmentMemoryDWord(cpu->idata.segment, cpu->m_effective_address);
+      if (cpu->m_fast_x87)
+      {
+        float host_value;
+        floatx80 ret;
+        std::memcpy(&host_value, &dword_val, sizeof(host_value));
+
+        // Denormals are normal as doubles, but have to go through softfloat to raise the denormal exception.
+        if (IsHostFloatNormalOrZero(host_value) && HostDoubleToFloatX80(static_cast<double>(host_value), &ret))
+          return ret;
+      }
+
       return float32_to_floatx80(dword_val, fs);
     }
     else if constexpr (size == OperandSize_64)
@@ -61,6 +75,15 @@ floatx80 Interpreter::ReadFloatOperand(CPU* cpu, float_status_t& fs)
       u32 dword_val_high =
         cpu->ReadSegmentMemoryDWord(cpu->idata.segment, (cpu->m_effective_address + 4) & cpu->idata.GetAddressMask());
       float64 qword_val = (ZeroExtend64(dword_val_high) << 32) | ZeroExtend64(dword_val_low);
+      if (cpu->m_fast_x87)
+      {
+        double host_value;
+        floatx80 ret;
+        std::memcpy(&host_value, &qword_val, sizeof(host_value));
+        if (HostDoubleToFloatX80(host_value, &ret))
+          return ret;
+      }
+
       return float64_to_floatx80(qword_val, fs);
     }
     else if constexpr (size == OperandSize_80)
@@ -123,14 +146,31 @@ void Interpreter::WriteFloatOperand(CPU* cpu, float_status_t& fs, const floatx80
                   "size is 32, 64 or 80-bit");
     if constexpr (size == OperandSize_32)
     {
-      // Convert extended precision -> single precision.
-      u32 dword_val = floatx80_to_float32(value, fs);
+      // Convert extended precision -> single precision. Values which are exact in single precision need no rounding.
+      // Anything which would underflow or overflow goes through softfloat, which raises the exceptions.
+      u32 dword_val;
+      double host_value;
+      if (cpu->m_fast_x87 && (cpu->m_fpu_registers.CW.bits & 0x3F) == 0x3F &&
+          FloatX80ToHostDouble(value, 24, &host_value) && IsHostDoubleInSingleRange(host_value))
+      {
+        const float host_float_value = static_cast<float>(host_value);
+        std::memcpy(&dword_val, &host_float_value, sizeof(dword_val));
+      }
+      else
+      {
+        dword_val = floatx80_to_float32(value, fs);
+      }
       cpu->WriteSegmentMemoryDWord(cpu->idata.segment, cpu->m_effective_address, dword_val);
     }
     if constexpr (size == OperandSize_64)
     {
       // Convert extended precision -> double precision
-      u64 qword_val = floatx80_to_float64(value, fs);
+      u64 qword_val;
+      double host_value;
+      if (cpu->m_fast_x87 && FloatX80ToHostDouble(value, 53, &host_value))
+        std::memcpy(&qword_val, &host_value, sizeof(qword_val));
+      else
+        qword_val = floatx80_to_float64(value, fs);
       cpu->WriteSegmentMemoryDWord(cpu->idata.segment, cpu->m_effective_address, Truncate32(qword_val));
       cpu->WriteSegmentMemoryDWord(cpu->idata.segment, (cpu->m_effective_address + 4) & cpu->idata.GetAddressMask(),
                             Truncate32(qword_val >> 32));
@@ -233,6 +273,151 @@ float_status_t Interpreter::GetFloatStatus(CPU* cpu)
   return ret;
 }
 
+bool Interpreter::FloatX80ToHostDouble(const floatx80& value, u32 precision_bits, double* out_value)
+{
+  // Only zeros and normals which fit in the precision and exponent range convert exactly.
+  const u64 sign_bit = ZeroExtend64(value.exp & 0x8000) << 48;
+  const u32 exponent = ZeroExtend32(value.exp & 0x7FFF);
+  u64 bits;
+  if (exponent == 0)
+  {
+    if (value.fraction != 0)
+      return false;
+
+    bits = sign_bit;
+  }
+  else
+  {
+    const u64 low_bits_mask = (UINT64_C(1) << (64 - precision_bits)) - 1;
+    const s32 double_exponent = static_cast<s32>(exponent) - 16383 + 1023;
+    if (!(value.fraction >> 63) || (value.fraction & low_bits_mask) != 0 || double_exponent <= 0 ||
+        double_exponent >= 0x7FF)
+    {
+      return false;
+    }
+
+    bits = sign_bit | (static_cast<u64>(double_exponent) << 52) |
+           ((value.fraction >> 11) & ((UINT64_C(1) << 52) - 1));
+  }
+
+  std::memcpy(out_value, &bits, sizeof(bits));
+  return true;
+}
+
+bool Interpreter::HostDoubleToFloatX80(double value, floatx80* out_value)
+{
+  // Denormals, infinities and NaNs are left to softfloat.
+  u64 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const u16 sign = Truncate16(bits >> 63) << 15;
+  const u32 exponent = Truncate32(bits >> 52) & 0x7FF;
+  const u64 mantissa = bits & ((UINT64_C(1) << 52) - 1);
+  if (exponent == 0)
+  {
+    if (mantissa != 0)
+      return false;
+
+    out_value->exp = sign;
+    out_value->fraction = 0;
+    return true;
+  }
+  else if (exponent == 0x7FF)
+  {
+    return false;
+  }
+
+  out_value->exp = sign | Truncate16(exponent - 1023 + 16383);
+  out_value->fraction = (UINT64_C(1) << 63) | (mantissa << 11);
+  return true;
+}
+
+bool Interpreter::IsHostFloatNormalOrZero(float value)
+{
+  const int fp_class = std::fpclassify(value);
+  return (fp_class == FP_NORMAL || fp_class == FP_ZERO);
+}
+
+bool Interpreter::IsHostDoubleInSingleRange(double value)
+{
+  // Zero, or normal in single precision. NaNs fail both comparisons.
+  const double magnitude = std::fabs(value);
+  return (magnitude == 0.0 || (magnitude >= static_cast<double>(FLT_MIN) && magnitude <= static_cast<double>(FLT_MAX)));
+}
+
+bool Interpreter::TryHostFloatArithmetic(CPU* cpu, HostFloatOperation operation, const floatx80& lhs,
+                                         const floatx80& rhs, floatx80* result)
+{
+  // The host only rounds to nearest, and doesn't report exceptions. With 24 or 53-bit precision and exactly
+  // representable operands, the host double result rounds to the same value. The precision flag is not updated.
+  const FPUControlWord& cw = cpu->m_fpu_registers.CW;
+  if (!cpu->m_fast_x87 || (cw.bits & 0x3F) != 0x3F || cw.RC != FPURoundingControl_Nearest ||
+      (cw.PC != FPUPrecision_24 && cw.PC != FPUPrecision_53))
+  {
+    return false;
+  }
+
+  const u32 precision_bits = (cw.PC == FPUPrecision_24) ? 24 : 53;
+  double a, b;
+  if (!FloatX80ToHostDouble(lhs, precision_bits, &a) || !FloatX80ToHostDouble(rhs, precision_bits, &b))
+    return false;
+
+  double res;
+  switch (operation)
+  {
+    case HostFloatOperation::Add:
+      res = a + b;
+      break;
+
+    case HostFloatOperation::Subtract:
+      res = a - b;
+      break;
+
+    case HostFloatOperation::Multiply:
+      res = a * b;
+      break;
+
+    case HostFloatOperation::Divide:
+    {
+      if (b == 0.0)
+        return false;
+
+      res = a / b;
+    }
+    break;
+
+    case HostFloatOperation::SquareRoot:
+    {
+      if (a < 0.0)
+        return false;
+
+      res = std::sqrt(a);
+    }
+    break;
+
+    default:
+      return false;
+  }
+
+  // Range check before rounding, so differences below the single range aren't flushed to zero. Rounding to nearest
+  // can't take a value in range out of it, since FLT_MIN and FLT_MAX are representable.
+  if (precision_bits == 24)
+  {
+    if (!IsHostDoubleInSingleRange(res))
+      return false;
+
+    res = static_cast<double>(static_cast<float>(res));
+  }
+
+  // Results which underflowed to zero would still be normal with the extended exponent range.
+  if (res == 0.0 && a != 0.0 && (b != 0.0 || operation == HostFloatOperation::SquareRoot) &&
+      (operation != HostFloatOperation::Add && operation != HostFloatOperation::Subtract))
+  {
+    return false;
+  }
+
+  return HostDoubleToFloatX80(res, result);
+}
+
 void Interpreter::RaiseFloatExceptions(CPU* cpu, const float_status_t& fs)
 {
   // TODO: This can be optimized.
@@ -386,8 +571,8 @@ void Interpreter::Execute_Operation_FADD(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FADD);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 lhs = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -396,7 +581,9 @@ void Interpreter::Execute_Operation_FADD(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_add(lhs, rhs, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Add, lhs, rhs, &res))
+    res = floatx80_add(lhs, rhs, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -416,7 +603,7 @@ void Interpreter::Execute_Operation_FBLD(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FBLD);
 
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   u32 p1 = cpu->ReadSegmentMemoryDWord(cpu->idata.segment, cpu->m_effective_address);
   u32 p2 = cpu->ReadSegmentMemoryDWord(cpu->idata.segment, (cpu->m_effective_address + 4) & cpu->idata.GetAddressMask());
@@ -455,7 +642,7 @@ void Interpreter::Execute_Operation_FBSTP(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FBSTP);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   // The store can throw an exception, so we want to preserve the old FPU flags.
   u16 SW = cpu->m_fpu_registers.SW.bits;
@@ -559,8 +746,8 @@ void Interpreter::Execute_Operation_FCOM(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(quiet ? CYCLES_FUCOM : CYCLES_FCOM);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 lhs = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -636,8 +823,8 @@ void Interpreter::Execute_Operation_FDIV(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FDIV);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 dividend = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -645,7 +832,9 @@ void Interpreter::Execute_Operation_FDIV(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_div(dividend, divisor, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Divide, dividend, divisor, &res))
+    res = floatx80_div(dividend, divisor, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -666,8 +855,8 @@ void Interpreter::Execute_Operation_FDIVR(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FDIV);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 divisor = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -675,7 +864,9 @@ void Interpreter::Execute_Operation_FDIVR(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_div(dividend, divisor, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Divide, dividend, divisor, &res))
+    res = floatx80_div(dividend, divisor, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -707,8 +898,8 @@ void Interpreter::Execute_Operation_FIADD(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FIADD);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 lhs = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -716,7 +907,9 @@ void Interpreter::Execute_Operation_FIADD(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_add(lhs, rhs, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Add, lhs, rhs, &res))
+    res = floatx80_add(lhs, rhs, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -729,8 +922,8 @@ void Interpreter::Execute_Operation_FISUB(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FISUB);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 lhs = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -738,7 +931,9 @@ void Interpreter::Execute_Operation_FISUB(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_sub(lhs, rhs, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Subtract, lhs, rhs, &res))
+    res = floatx80_sub(lhs, rhs, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -751,8 +946,8 @@ void Interpreter::Execute_Operation_FISUBR(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FISUB);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 lhs = ReadIntegerOperandAsFloat<src_size, src_mode, src_constant>(cpu, fs);
@@ -760,7 +955,9 @@ void Interpreter::Execute_Operation_FISUBR(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_sub(lhs, rhs, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Subtract, lhs, rhs, &res))
+    res = floatx80_sub(lhs, rhs, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -773,8 +970,8 @@ void Interpreter::Execute_Operation_FIMUL(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FIMUL);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 lhs = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -782,7 +979,9 @@ void Interpreter::Execute_Operation_FIMUL(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_mul(lhs, rhs, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Multiply, lhs, rhs, &res))
+    res = floatx80_mul(lhs, rhs, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -795,8 +994,8 @@ void Interpreter::Execute_Operation_FIDIV(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FIDIV);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 dividend = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -804,7 +1003,9 @@ void Interpreter::Execute_Operation_FIDIV(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_div(dividend, divisor, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Divide, dividend, divisor, &res))
+    res = floatx80_div(dividend, divisor, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -817,8 +1018,8 @@ void Interpreter::Execute_Operation_FIDIVR(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FIDIV);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 divisor = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -826,7 +1027,9 @@ void Interpreter::Execute_Operation_FIDIVR(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_div(dividend, divisor, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Divide, dividend, divisor, &res))
+    res = floatx80_div(dividend, divisor, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -839,8 +1042,8 @@ void Interpreter::Execute_Operation_FICOM(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FICOM);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 lhs = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -871,7 +1074,7 @@ void Interpreter::Execute_Operation_FILD(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FILD);
 
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 value = ReadIntegerOperandAsFloat<src_size, src_mode, src_constant>(cpu, fs);
@@ -891,7 +1094,7 @@ void Interpreter::Execute_Operation_FIST(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FIST);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   ClearC1(cpu);
   CheckFloatStackUnderflow(cpu, 0);
@@ -942,7 +1145,7 @@ void Interpreter::Execute_Operation_FLD(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FLD);
 
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   ClearC1(cpu);
   CheckFloatStackOverflow(cpu);
@@ -974,7 +1177,7 @@ void Interpreter::Execute_Operation_FLDCW(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FLDCW);
 
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   u16 cw = ReadWordOperand<src_mode, src_constant>(cpu);
   cpu->m_fpu_registers.CW.bits = (cw & ~FPUControlWord::ReservedBits) | FPUControlWord::FixedBits;
@@ -1065,8 +1268,8 @@ void Interpreter::Execute_Operation_FMUL(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FMUL);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 lhs = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -1075,7 +1278,9 @@ void Interpreter::Execute_Operation_FMUL(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_mul(lhs, rhs, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Multiply, lhs, rhs, &res))
+    res = floatx80_mul(lhs, rhs, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -1095,7 +1300,7 @@ void Interpreter::Execute_Operation_FRSTOR(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FRSTOR);
 
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   cpu->LoadFPUState(cpu->idata.segment, cpu->m_effective_address, cpu->idata.GetAddressMask(), cpu->idata.Is32Bit(),
                     true);
@@ -1107,7 +1312,7 @@ void Interpreter::Execute_Operation_FNSAVE(CPU* cpu)
   StartX87Instruction(cpu, false);
   cpu->AddCycles(CYCLES_FNSAVE);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   cpu->StoreFPUState(cpu->idata.segment, cpu->m_effective_address, cpu->idata.GetAddressMask(), cpu->idata.Is32Bit(),
                      true);
@@ -1125,7 +1330,7 @@ void Interpreter::Execute_Operation_FLDENV(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FLDENV);
 
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   cpu->LoadFPUState(cpu->idata.segment, cpu->m_effective_address, cpu->idata.GetAddressMask(), cpu->idata.Is32Bit(),
                     false);
@@ -1137,7 +1342,7 @@ void Interpreter::Execute_Operation_FNSTENV(CPU* cpu)
   StartX87Instruction(cpu, false);
   cpu->AddCycles(CYCLES_FNSTENV);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   cpu->StoreFPUState(cpu->idata.segment, cpu->m_effective_address, cpu->idata.GetAddressMask(), cpu->idata.Is32Bit(),
                      false);
@@ -1159,7 +1364,7 @@ void Interpreter::Execute_Operation_FNSTCW(CPU* cpu)
   StartX87Instruction(cpu, false);
   cpu->AddCycles(CYCLES_FNSTCW);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
   WriteWordOperand<dst_mode, dst_constant>(cpu, cpu->m_fpu_registers.CW.bits);
 }
 
@@ -1170,7 +1375,7 @@ void Interpreter::Execute_Operation_FNSTSW(CPU* cpu)
   StartX87Instruction(cpu, false);
   cpu->AddCycles(CYCLES_FNSTSW);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
   WriteWordOperand<dst_mode, dst_constant>(cpu, cpu->m_fpu_registers.SW.bits);
 }
 
@@ -1279,7 +1484,9 @@ void Interpreter::Execute_Operation_FSQRT(CPU* cpu)
   // ST(0) <- SquareRoot(ST(0))
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 val = ReadFloatRegister(cpu, 0);
-  floatx80 res = floatx80_sqrt(val, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::SquareRoot, val, val, &res))
+    res = floatx80_sqrt(val, fs);
   RaiseFloatExceptions(cpu, fs);
   WriteFloatRegister(cpu, 0, res);
 }
@@ -1290,7 +1497,7 @@ void Interpreter::Execute_Operation_FST(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FST);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
 
   ClearC1(cpu);
   CheckFloatStackUnderflow(cpu, 0);
@@ -1315,8 +1522,8 @@ void Interpreter::Execute_Operation_FSUB(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FSUB);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 lhs = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -1325,7 +1532,9 @@ void Interpreter::Execute_Operation_FSUB(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_sub(lhs, rhs, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Subtract, lhs, rhs, &res))
+    res = floatx80_sub(lhs, rhs, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
@@ -1346,8 +1555,8 @@ void Interpreter::Execute_Operation_FSUBR(CPU* cpu)
   StartX87Instruction(cpu);
   cpu->AddCycles(CYCLES_FSUB);
 
-  CalculateEffectiveAddress<dst_mode>(cpu);
-  CalculateEffectiveAddress<src_mode>(cpu);
+  CalculateEffectiveAddress<dst_mode, dst_constant>(cpu);
+  CalculateEffectiveAddress<src_mode, src_constant>(cpu);
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 rhs = ReadFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs);
@@ -1356,7 +1565,9 @@ void Interpreter::Execute_Operation_FSUBR(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_sub(lhs, rhs, fs);
+  floatx80 res;
+  if (!TryHostFloatArithmetic(cpu, HostFloatOperation::Subtract, lhs, rhs, &res))
+    res = floatx80_sub(lhs, rhs, fs);
   RaiseFloatExceptions(cpu, fs);
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
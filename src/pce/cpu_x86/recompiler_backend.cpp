@@ -6,6 +6,11 @@
 #include "decoder.h"
 #include "interpreter.h"
 #include "recompiler_code_generator.h"
+#include <cstring>
+#ifdef ENABLE_FASTMEM
+#include <signal.h>
+#include <ucontext.h>
+#endif
 Log_SetChannel(CPU_X86::Recompiler);
 
 namespace CPU_X86 {
@@ -15,12 +20,90 @@ extern u32 TRACE_EXECUTION_LAST_EIP;
 
 namespace CPU_X86::Recompiler {
 
-Backend::Backend(CPU* cpu) : CodeCacheBackend(cpu), m_code_space(std::make_unique<JitCodeBuffer>())
+#ifdef ENABLE_FASTMEM
+static Backend* s_fastmem_backend = nullptr;
+static struct sigaction s_old_sigsegv_action;
+
+static void FastmemSignalHandler(int sig, siginfo_t* info, void* context)
 {
-  m_asm_functions = ASMFunctions::Generate(m_code_space.get());
+  ucontext_t* uc = static_cast<ucontext_t*>(context);
+  void* host_pc = reinterpret_cast<void*>(uc->uc_mcontext.gregs[REG_RIP]);
+  if (s_fastmem_backend && s_fastmem_backend->HandleFastmemFault(info->si_addr, &host_pc))
+  {
+    uc->uc_mcontext.gregs[REG_RIP] = reinterpret_cast<greg_t>(host_pc);
+    return;
+  }
+
+  // Not ours, pass it on. Returning with the default action restored re-raises the fault.
+  if (s_old_sigsegv_action.sa_flags & SA_SIGINFO)
+    s_old_sigsegv_action.sa_sigaction(sig, info, context);
+  else if (s_old_sigsegv_action.sa_handler != SIG_DFL && s_old_sigsegv_action.sa_handler != SIG_IGN)
+    s_old_sigsegv_action.sa_handler(sig);
+  else
+    sigaction(SIGSEGV, &s_old_sigsegv_action, nullptr);
 }
+#endif
+
+Backend::Backend(CPU* cpu, bool tiered)
+  : CodeCacheBackend(cpu), m_code_space(std::make_unique<JitCodeBuffer>()), m_tiered(tiered)
+{
+  if (m_tiered)
+  {
+    void* background_code_ptr = m_code_space->SplitTail(BackgroundCodeSpaceSize);
+    m_background_code_space = std::make_unique<JitCodeBuffer>(background_code_ptr, BackgroundCodeSpaceSize);
+    m_compile_thread = std::thread([this]() { CompileThreadRoutine(); });
+  }
+
+  if (m_cpu->m_recompiler_perf_map != 0)
+    m_perf_map.Open((m_cpu->m_recompiler_perf_map == 2) ? JitPerfMap::Format::JitDump : JitPerfMap::Format::PerfMap);
+
+  GenerateASMFunctions();
+  SetupCodeRegions();
+
+#ifdef ENABLE_FASTMEM
+  if (m_cpu->m_recompiler_fastmem && m_bus->EnableFastmem())
+  {
+    struct sigaction sa = {};
+    sa.sa_sigaction = FastmemSignalHandler;
+    sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGSEGV, &sa, &s_old_sigsegv_action) == 0)
+    {
+      s_fastmem_backend = this;
+      m_fastmem_handler_installed = true;
+    }
+    else
+    {
+      Log_ErrorPrintf("Failed to install fastmem fault handler, fastmem will not be used");
+      m_bus->DisableFastmem();
+    }
+  }
+#endif
+}
+
+Backend::~Backend()
+{
+  if (m_compile_thread.joinable())
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_compile_mutex);
+      m_compile_thread_shutdown = true;
+      m_compile_queue_cv.notify_one();
+    }
+    m_compile_thread.join();
+  }
 
-Backend::~Backend() {}
+  CodeGenerator::LogOperationCounts();
+
+#ifdef ENABLE_FASTMEM
+  if (m_fastmem_handler_installed)
+  {
+    sigaction(SIGSEGV, &s_old_sigsegv_action, nullptr);
+    s_fastmem_backend = nullptr;
+    m_bus->DisableFastmem();
+  }
+#endif
+}
 
 void Backend::Execute()
 {
@@ -42,13 +125,24 @@ void Backend::Execute()
 
     while (m_cpu->m_execution_downcount > 0)
     {
-      // Block flush pending?
+      // Install any code which finished compiling in the background.
+      if (m_has_completed_compiles.load(std::memory_order_acquire))
+        PublishBackgroundCompiles();
+
+      // Code region full? The worker in tiered mode uses a single region, so it has to be flushed completely.
       if (m_code_buffer_overflow)
       {
-        Log_ErrorPrint("Out of code space, flushing all blocks.");
         m_code_buffer_overflow = false;
         m_current_block = nullptr;
-        FlushCodeCache();
+        if (m_tiered)
+        {
+          Log_ErrorPrint("Out of code space, flushing all blocks.");
+          FlushCodeCache();
+        }
+        else
+        {
+          EvictNextCodeRegion();
+        }
       }
 
       // Check for external interrupts.
@@ -73,8 +167,10 @@ void Backend::Execute()
       }
 
       // Execute the block.
+      BeginIdleLoopCheck(m_current_block);
       ExecuteBlock();
       m_cpu->CommitPendingCycles();
+      EndIdleLoopCheck(m_current_block);
 
       // Fix up delayed block destroying.
       Block* previous_block = m_current_block;
@@ -90,39 +186,37 @@ void Backend::Execute()
       {
         if (GetBlockKeyForCurrentState(&key))
         {
-          // Block points to itself?
-          if (previous_block->key == key && CanExecuteBlock(previous_block))
+          // Try to find an already-linked block.
+          for (BlockBase* linked_block : previous_block->link_successors)
           {
-            // Execute self again.
-            m_current_block = previous_block;
-          }
-          else
-          {
-            // Try to find an already-linked block.
-            for (BlockBase* linked_block : previous_block->link_successors)
+            if (linked_block->key == key)
             {
-              if (linked_block->key == key)
+              // CanExecuteBlock can result in a block flush, so stop iterating here either way.
+              if (CanExecuteBlock(linked_block))
               {
-                if (!CanExecuteBlock(linked_block))
-                {
-                  // CanExecuteBlock can result in a block flush, so stop iterating here.
-                  break;
-                }
-
-                // Execute the
                 m_current_block = static_cast<Block*>(linked_block);
-                continue;
+
+                // In tiered mode, either block may have been compiled since they were linked.
+                if (m_tiered)
+                  LinkBlockCode(previous_block, m_current_block);
               }
+
+              break;
             }
+          }
 
-            // No acceptable blocks found in the successor list, try a new one.
-            if (!m_current_block)
-            {
-              // Link the previous block to this new block if we find a new block.
+          // No acceptable blocks found in the successor list, try a new one.
+          if (!m_current_block)
+          {
+            // Block points to itself?
+            if (previous_block->key == key)
+              m_current_block = CanExecuteBlock(previous_block) ? previous_block : nullptr;
+            else
               m_current_block = static_cast<Block*>(GetNextBlock());
-              if (m_current_block)
-                LinkBlockBase(previous_block, m_current_block);
-            }
+
+            // Link the previous block to this new block if we find a new block.
+            if (m_current_block)
+              LinkBlockBase(previous_block, m_current_block);
           }
         }
       }
@@ -151,15 +245,119 @@ void Backend::AbortCurrentInstruction()
 
 void Backend::FlushCodeCache()
 {
+  // The worker can't be writing to the code space while it's reset.
+  if (m_tiered)
+    CancelAllBackgroundCompiles();
+
   // Prevent the current block from being flushed.
   if (m_current_block)
     FlushBlock(m_current_block, true);
 
   CodeCacheBackend::FlushCodeCache();
   m_code_space->Reset();
+  if (m_background_code_space)
+    m_background_code_space->Reset();
 
   // recompile asm functions
+  GenerateASMFunctions();
+  SetupCodeRegions();
+}
+
+size_t Backend::GetCodeCacheSize() const
+{
+  if (m_tiered)
+    return m_background_code_space->GetUsedCodeSpace();
+
+  size_t size = 0;
+  for (const CodeRegion& region : m_code_regions)
+    size += region.code_space->GetUsedCodeSpace();
+  return size;
+}
+
+void Backend::GenerateASMFunctions()
+{
+  const size_t code_start = m_code_space->GetUsedCodeSpace();
+  const void* code_ptr = m_code_space->GetFreeCodePointer();
   m_asm_functions = ASMFunctions::Generate(m_code_space.get());
+  m_perf_map.RegisterCode(code_ptr, m_code_space->GetUsedCodeSpace() - code_start, "pce_asm_functions");
+}
+
+void Backend::AddBlockToPerfMap(const Block* block, u16 cs_selector)
+{
+  if (!m_perf_map.IsOpen())
+    return;
+
+  SmallString name;
+  name.Format("pce_block_%08X_%04X:%08X_%s", block->GetPhysicalAddress(), ZeroExtend32(cs_selector),
+              block->instructions.front().address,
+              block->key.IsV8086Code() ? "v86" : (block->key.Is32BitCode() ? "32" : "16"));
+  m_perf_map.RegisterCode(reinterpret_cast<const void*>(block->code_pointer), block->code_size, name);
+}
+
+void Backend::SetupCodeRegions()
+{
+  m_current_code_region = 0;
+  if (m_tiered)
+    return;
+
+  // Each region is a view of part of the main code space, so block links between regions stay within rel32 range.
+  u8* region_ptr = static_cast<u8*>(m_code_space->GetFreeCodePointer());
+  const size_t region_size = m_code_space->GetFreeCodeSpace() / CodeRegionCount;
+  for (CodeRegion& region : m_code_regions)
+  {
+    // Only a block pending destruction can be left after a flush.
+    for (Block* block : region.blocks)
+      block->code_region = CodeRegionCount;
+    region.blocks.clear();
+    region.code_space = std::make_unique<JitCodeBuffer>(region_ptr, region_size);
+    region_ptr += region_size;
+  }
+}
+
+void Backend::AddBlockToCodeRegion(Block* block, u32 region_index)
+{
+  CodeRegion& region = m_code_regions[region_index];
+  block->code_region = region_index;
+  block->code_region_index = static_cast<u32>(region.blocks.size());
+  region.blocks.push_back(block);
+}
+
+void Backend::RemoveBlockFromCodeRegion(Block* block)
+{
+  if (block->code_region == CodeRegionCount)
+    return;
+
+  // Swap with the last block in the region, so removal is constant time.
+  CodeRegion& region = m_code_regions[block->code_region];
+  DebugAssert(region.blocks[block->code_region_index] == block);
+  Block* last_block = region.blocks.back();
+  region.blocks[block->code_region_index] = last_block;
+  last_block->code_region_index = block->code_region_index;
+  region.blocks.pop_back();
+  block->code_region = CodeRegionCount;
+  block->code_region_index = 0;
+}
+
+void Backend::EvictNextCodeRegion()
+{
+  m_current_code_region = (m_current_code_region + 1) % CodeRegionCount;
+  CodeRegion& region = m_code_regions[m_current_code_region];
+  const u32 num_blocks = static_cast<u32>(region.blocks.size());
+  Log_DevPrintf("Code region full, evicting region %u (%u blocks)", m_current_code_region, num_blocks);
+
+  // Flushing unlinks the blocks and removes them from the region.
+  while (!region.blocks.empty())
+  {
+    Block* block = region.blocks.back();
+    if (block->IsDestroyPending())
+      DestroyBlock(block);
+    else
+      FlushBlock(block);
+  }
+
+  region.code_space->Reset();
+  m_cpu->m_execution_stats.code_cache_regions_evicted++;
+  m_cpu->m_execution_stats.code_cache_blocks_evicted += num_blocks;
 }
 
 BlockBase* Backend::AllocateBlock(const BlockKey key)
@@ -173,32 +371,54 @@ bool Backend::CompileBlock(BlockBase* block)
     return false;
 
   Block* cblock = static_cast<Block*>(block);
-  if (m_code_space->GetFreeCodeSpace() < (cblock->instructions.size() * MaximumBytesPerInstruction))
+  if (m_tiered)
+    return CompileInterpreterBlock(cblock);
+
+  // The region can't be evicted here, since the dispatcher may be holding pointers to blocks in it.
+  CodeRegion& region = m_code_regions[m_current_code_region];
+  if (region.code_space->GetFreeCodeSpace() < (cblock->instructions.size() * MaximumBytesPerInstruction))
   {
-    Log_WarningPrintf("Code space is possibly insufficient for block %08X (%zu instructions), flushing",
-                      cblock->GetPhysicalAddress(), cblock->instructions.size());
+    if (region.blocks.empty())
+    {
+      Log_WarningPrintf("Block %08X (%zu instructions) is too large for a code region", cblock->GetPhysicalAddress(),
+                        cblock->instructions.size());
+      return false;
+    }
+
+    Log_DevPrintf("Code region %u is possibly insufficient for block %08X (%zu instructions), evicting",
+                  m_current_code_region, cblock->GetPhysicalAddress(), cblock->instructions.size());
     m_code_buffer_overflow = true;
     return false;
   }
 
-  CodeGenerator::AlignCodeBuffer(m_code_space.get());
+  CodeGenerator::AlignCodeBuffer(region.code_space.get());
 
-  CodeGenerator codegen(m_cpu, m_code_space.get(), m_asm_functions);
-  if (!codegen.CompileBlock(block, &cblock->code_pointer, &cblock->code_size))
+  CodeGenerator codegen(m_cpu, region.code_space.get(), m_asm_functions, &m_current_block);
+  if (!codegen.CompileBlock(block, &cblock->code_pointer, &cblock->code_size, &cblock->link_slots,
+                            &cblock->fastmem_accesses))
   {
     Log_WarningPrintf("Failed to compile block at paddr %08X", block->key.eip_physical_address);
     return false;
   }
 
+  AddBlockToCodeRegion(cblock, m_current_code_region);
+  AddFastmemAccesses(cblock);
+  AddBlockToPerfMap(cblock, m_cpu->m_registers.CS);
   return true;
 }
 
 void Backend::ResetBlock(BlockBase* block)
 {
   Block* cblock = static_cast<Block*>(block);
+  CancelBackgroundCompile(cblock);
   CodeCacheBackend::ResetBlock(cblock);
+  RemoveBlockFromCodeRegion(cblock);
+  RemoveFastmemAccesses(cblock);
   cblock->code_pointer = nullptr;
   cblock->code_size = 0;
+  cblock->link_slots.clear();
+  cblock->interpreter_entries.clear();
+  cblock->execution_count = 0;
 }
 
 void Backend::FlushBlock(BlockBase* block, bool defer_destroy /* = false */)
@@ -212,15 +432,348 @@ void Backend::FlushBlock(BlockBase* block, bool defer_destroy /* = false */)
 
 void Backend::DestroyBlock(BlockBase* block)
 {
-  delete static_cast<Block*>(block);
+  Block* cblock = static_cast<Block*>(block);
+  CancelBackgroundCompile(cblock);
+  RemoveBlockFromCodeRegion(cblock);
+  RemoveFastmemAccesses(cblock);
+  delete cblock;
+}
+
+void Backend::InvalidateBlock(BlockBase* block)
+{
+  // Blocks jumping directly here have to go through the dispatcher again, so the code hash gets checked.
+  UnlinkBlockBase(block);
+  CodeCacheBackend::InvalidateBlock(block);
+}
+
+void Backend::LinkBlockBase(BlockBase* from, BlockBase* to)
+{
+  CodeCacheBackend::LinkBlockBase(from, to);
+  LinkBlockCode(static_cast<Block*>(from), static_cast<Block*>(to));
+}
+
+void Backend::LinkBlockCode(Block* from, Block* to)
+{
+  // Blocks which are still being interpreted can't be linked directly.
+  if (!from->code_pointer || !to->code_pointer)
+    return;
+
+  // Only link directly within the linear page the source block starts in. The dispatcher validated the mapping of
+  // this page when entering the source block, but a jump to any other page could end up in the wrong block if the
+  // page tables change. Blocks crossing pages need the second page checked, so they always go through the dispatcher.
+  const u32 target_eip = m_cpu->m_registers.EIP;
+  const LinearMemoryAddress from_linear_address =
+    m_cpu->CalculateLinearAddress(Segment_CS, from->instructions.front().address);
+  const LinearMemoryAddress to_linear_address = m_cpu->CalculateLinearAddress(Segment_CS, target_eip);
+  if (to->CrossesPage() || (from_linear_address & CPU::PAGE_MASK) != (to_linear_address & CPU::PAGE_MASK))
+    return;
+
+  // Idle loops have to return to the dispatcher each iteration, so they can be detected. This includes exits to other
+  // blocks, which could otherwise chain back into the loop within a single dispatch, after modifying state.
+  if (from->IsIdleLoop())
+    return;
+
+  // Blocks compiled for flat segments skip the segment checks, so the source block must always exit with flat segments.
+  if (to->key.flat_segments && from->LoadsSegments())
+    return;
+
+  for (BlockLinkSlot& slot : from->link_slots)
+  {
+    if (slot.target_eip == target_eip && !slot.linked_block)
+    {
+      Log_DebugPrintf("Direct linking block %08X to %08X", from->GetPhysicalAddress(), to->GetPhysicalAddress());
+      PatchLinkSlot(from, &slot, to);
+    }
+  }
+}
+
+void Backend::UnlinkBlockBase(BlockBase* block)
+{
+  // Restore the jumps in any blocks linked to this one, as well as the block's own exits.
+  for (BlockBase* predecessor : block->link_predecessors)
+  {
+    Block* predecessor_block = static_cast<Block*>(predecessor);
+    for (BlockLinkSlot& slot : predecessor_block->link_slots)
+    {
+      if (slot.linked_block == block)
+        PatchLinkSlot(predecessor_block, &slot, nullptr);
+    }
+  }
+
+  Block* cblock = static_cast<Block*>(block);
+  for (BlockLinkSlot& slot : cblock->link_slots)
+  {
+    if (slot.linked_block)
+      PatchLinkSlot(cblock, &slot, nullptr);
+  }
+
+  CodeCacheBackend::UnlinkBlockBase(block);
+}
+
+void Backend::PatchLinkSlot(Block* block, BlockLinkSlot* slot, Block* linked_block)
+{
+  // The block pointer is written to m_current_block before jumping, so the dispatcher and exception handling know
+  // which block was executing. A zero displacement falls through to the return.
+  u8* code = reinterpret_cast<u8*>(block->code_pointer);
+  const Block* next_block = linked_block ? linked_block : block;
+  s32 displacement = 0;
+  if (linked_block)
+  {
+    const u8* jump_end = code + slot->jump_offset + sizeof(displacement);
+    displacement = static_cast<s32>(reinterpret_cast<const u8*>(linked_block->code_pointer) - jump_end);
+  }
+
+  std::memcpy(code + slot->block_pointer_offset, &next_block, sizeof(next_block));
+  std::memcpy(code + slot->jump_offset, &displacement, sizeof(displacement));
+  slot->linked_block = linked_block;
+}
+
+void Backend::AddFastmemAccesses(Block* block)
+{
+  for (const FastmemAccess& access : block->fastmem_accesses)
+    m_fastmem_accesses.emplace(access.host_code_address, access);
+}
+
+void Backend::RemoveFastmemAccesses(Block* block)
+{
+  for (const FastmemAccess& access : block->fastmem_accesses)
+    m_fastmem_accesses.erase(access.host_code_address);
+  block->fastmem_accesses.clear();
+}
+
+bool Backend::HandleFastmemFault(void* fault_address, void** host_pc)
+{
+  if (!m_bus->IsFastmemAddress(fault_address))
+    return false;
+
+  auto iter = m_fastmem_accesses.find(*host_pc);
+  if (iter == m_fastmem_accesses.end())
+    return false;
+
+  // Replace the access with a jump to the slow path. The page is MMIO or contains code, so it's likely to be hit
+  // again, and the slow path handles both.
+  const FastmemAccess& access = iter->second;
+  u8* code = static_cast<u8*>(access.host_code_address);
+  const s32 displacement = static_cast<s32>(static_cast<const u8*>(access.slow_path_address) - (code + 5));
+  code[0] = 0xE9;
+  std::memcpy(code + 1, &displacement, sizeof(displacement));
+  std::memset(code + 5, 0x90, access.host_code_size - 5);
+
+  *host_pc = access.slow_path_address;
+  m_fastmem_accesses.erase(iter);
+  return true;
 }
 
 void Backend::ExecuteBlock()
 {
   // m_cpu->PrintCurrentStateAndInstruction(m_cpu->m_registers.EIP);
+  // Block stats are updated by the generated code, since linked blocks don't return here.
+  if (m_current_block->code_pointer)
+  {
+    m_current_block->code_pointer(m_cpu);
+    return;
+  }
+
+  // Tiered mode, block isn't compiled yet.
+  if (++m_current_block->execution_count == BackgroundCompileThreshold)
+    QueueBackgroundCompile(m_current_block);
+
+  InterpretBlock(m_current_block);
+}
+
+bool Backend::CompileInterpreterBlock(Block* block)
+{
+  block->interpreter_entries.reserve(block->instructions.size());
+  for (const Instruction& instruction : block->instructions)
+  {
+    auto handler = Interpreter::GetInterpreterHandlerForInstruction(&instruction);
+    if (!handler)
+    {
+      String disassembled;
+      Decoder::DisassembleToString(&instruction, &disassembled);
+      Log_ErrorPrintf("Failed to get handler for instruction '%s'", disassembled.GetCharArray());
+      return false;
+    }
+
+    block->interpreter_entries.push_back({handler, instruction.data, static_cast<u8>(instruction.length)});
+  }
+
+  return true;
+}
+
+void Backend::InterpretBlock(Block* block)
+{
   m_cpu->m_execution_stats.code_cache_blocks_executed++;
-  m_cpu->m_execution_stats.code_cache_instructions_executed += m_current_block->instructions.size();
-  m_current_block->code_pointer(m_cpu);
+  m_cpu->m_execution_stats.code_cache_instructions_executed += block->interpreter_entries.size();
+  const u64 start_cycles = m_cpu->ReadTSC();
+  for (const Block::InterpreterEntry& instruction : block->interpreter_entries)
+  {
+    m_cpu->m_current_EIP = m_cpu->m_registers.EIP;
+    m_cpu->m_current_ESP = m_cpu->m_registers.ESP;
+    m_cpu->m_registers.EIP = (m_cpu->m_registers.EIP + instruction.length) & m_cpu->m_EIP_mask;
+    std::memcpy(&m_cpu->idata, &instruction.data, sizeof(m_cpu->idata));
+    instruction.handler(m_cpu);
+  }
+
+  m_cpu->MaterializeLazyFlags();
+
+  if (block->profile)
+  {
+    block->profile->execution_count++;
+    block->profile->cycles += m_cpu->ReadTSC() - start_cycles;
+  }
+}
+
+void Backend::QueueBackgroundCompile(Block* block)
+{
+  if (block->IsBackgroundCompiling())
+    return;
+
+  // The worker compiles from a copy of the instructions, since the block can be reset while it's compiling.
+  auto job = std::make_unique<CompileJob>(block);
+  job->cs_selector = m_cpu->m_registers.CS;
+  job->snapshot.instructions.reserve(block->instructions.size());
+  for (const Instruction& instruction : block->instructions)
+    job->snapshot.instructions.push_back(instruction);
+  job->snapshot.total_cycles = block->total_cycles;
+  job->snapshot.code_length = block->code_length;
+  job->snapshot.next_page_physical_address = block->next_page_physical_address;
+  job->snapshot.flags = block->flags;
+  job->snapshot.profile = block->profile;
+
+  block->flags |= BlockFlags::BackgroundCompiling;
+  block->compile_job = job.get();
+
+  std::unique_lock<std::mutex> lock(m_compile_mutex);
+  m_compile_queue.push_back(std::move(job));
+  m_compile_queue_cv.notify_one();
+}
+
+void Backend::CancelBackgroundCompile(Block* block)
+{
+  if (!block->compile_job)
+    return;
+
+  // The job is either queued, being compiled, or waiting to be published. In any case, it'll be dropped. Queued jobs
+  // are dropped by the worker without compiling them.
+  std::unique_lock<std::mutex> lock(m_compile_mutex);
+  block->compile_job->cancelled = true;
+  block->compile_job->block = nullptr;
+  block->compile_job = nullptr;
+  block->flags &= ~BlockFlags::BackgroundCompiling;
+}
+
+void Backend::CancelAllBackgroundCompiles()
+{
+  std::unique_lock<std::mutex> lock(m_compile_mutex);
+  auto cancel_job = [](CompileJob* job) {
+    job->cancelled = true;
+    if (job->block)
+    {
+      job->block->compile_job = nullptr;
+      job->block->flags &= ~BlockFlags::BackgroundCompiling;
+      job->block = nullptr;
+    }
+  };
+
+  for (auto& job : m_compile_queue)
+    cancel_job(job.get());
+  for (auto& job : m_completed_compiles)
+    cancel_job(job.get());
+  if (m_active_compile)
+    cancel_job(m_active_compile);
+
+  m_compile_queue.clear();
+  m_completed_compiles.clear();
+  m_has_completed_compiles.store(false, std::memory_order_release);
+
+  // Wait for the in-progress compile to finish, it may still be writing to the code space.
+  m_compile_done_cv.wait(lock, [this]() { return m_active_compile == nullptr; });
+}
+
+void Backend::PublishBackgroundCompiles()
+{
+  std::vector<std::unique_ptr<CompileJob>> completed_compiles;
+  {
+    std::unique_lock<std::mutex> lock(m_compile_mutex);
+    completed_compiles.swap(m_completed_compiles);
+    m_has_completed_compiles.store(false, std::memory_order_release);
+  }
+
+  for (auto& job : completed_compiles)
+  {
+    if (job->out_of_space)
+      m_code_buffer_overflow = true;
+
+    Block* block = job->block;
+    if (job->cancelled || !block)
+      continue;
+
+    block->compile_job = nullptr;
+    block->flags &= ~BlockFlags::BackgroundCompiling;
+    if (!job->succeeded)
+    {
+      // Leave the block in the interpreter.
+      continue;
+    }
+
+    block->code_pointer = job->code_pointer;
+    block->code_size = job->code_size;
+    block->link_slots = std::move(job->link_slots);
+    block->fastmem_accesses = std::move(job->fastmem_accesses);
+
+    // The code was generated for the snapshot, so unlinked exits would store the snapshot as the current block.
+    for (BlockLinkSlot& slot : block->link_slots)
+      PatchLinkSlot(block, &slot, nullptr);
+
+    AddFastmemAccesses(block);
+    AddBlockToPerfMap(block, job->cs_selector);
+    Log_DebugPrintf("Published background compile of block %08X", block->GetPhysicalAddress());
+  }
+}
+
+void Backend::CompileThreadRoutine()
+{
+  std::unique_lock<std::mutex> lock(m_compile_mutex);
+  for (;;)
+  {
+    m_compile_queue_cv.wait(lock, [this]() { return m_compile_thread_shutdown || !m_compile_queue.empty(); });
+    if (m_compile_thread_shutdown)
+      break;
+
+    std::unique_ptr<CompileJob> job = std::move(m_compile_queue.front());
+    m_compile_queue.pop_front();
+    if (job->cancelled)
+      continue;
+
+    m_active_compile = job.get();
+    lock.unlock();
+
+    if (m_background_code_space->GetFreeCodeSpace() <
+        (job->snapshot.instructions.size() * MaximumBytesPerInstruction))
+    {
+      job->out_of_space = true;
+    }
+    else
+    {
+      CodeGenerator::AlignCodeBuffer(m_background_code_space.get());
+
+      CodeGenerator codegen(m_cpu, m_background_code_space.get(), m_asm_functions, &m_current_block);
+      job->succeeded = codegen.CompileBlock(&job->snapshot, &job->code_pointer, &job->code_size, &job->link_slots,
+                                            &job->fastmem_accesses);
+      if (!job->succeeded)
+        Log_WarningPrintf("Failed to compile block at paddr %08X", job->snapshot.key.eip_physical_address);
+    }
+
+    lock.lock();
+    m_active_compile = nullptr;
+    if (!job->cancelled)
+    {
+      m_completed_compiles.push_back(std::move(job));
+      m_has_completed_compiles.store(true, std::memory_order_release);
+    }
+    m_compile_done_cv.notify_all();
+  }
 }
 
 } // namespace CPU_X86::Recompiler
\ No newline at end of file
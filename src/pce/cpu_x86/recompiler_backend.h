@@ -1,32 +1,90 @@
 #pragma once
 #include "common/fastjmp.h"
 #include "common/jit_code_buffer.h"
+#include "common/jit_perf_map.h"
 #include "pce/cpu_x86/code_cache_backend.h"
 #include "pce/cpu_x86/cpu_x86.h"
 #include "pce/cpu_x86/recompiler_thunks.h"
 #include "pce/cpu_x86/recompiler_types.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace CPU_X86::Recompiler {
 
 class Backend : public CodeCacheBackend
 {
 public:
-  Backend(CPU* cpu);
+  /// In tiered mode, blocks are run through the interpreter until they have executed BackgroundCompileThreshold
+  /// times, after which they are compiled on a worker thread and switched to the native code once it is ready.
+  Backend(CPU* cpu, bool tiered);
   ~Backend();
 
   void Execute() override;
   void AbortCurrentInstruction() override;
+  size_t GetCodeCacheSize() const override;
   void FlushCodeCache() override;
 
+  /// Handles a fault from a fastmem access by patching it to use the slow path. Returns false if the fault did not
+  /// come from a fastmem access, otherwise updates host_pc to continue execution.
+  bool HandleFastmemFault(void* fault_address, void** host_pc);
+
 protected:
+  struct CompileJob;
+
   struct Block : public BlockBase
   {
     Block(const BlockKey key_) : BlockBase(key_) {}
 
     BlockFunctionType code_pointer = nullptr;
     size_t code_size = 0;
+    std::vector<BlockLinkSlot> link_slots;
+    std::vector<FastmemAccess> fastmem_accesses;
+
+    // Code region the block's code was written to, and its position in the region's block list.
+    u32 code_region = CodeRegionCount;
+    u32 code_region_index = 0;
+
+    // Tiered mode only. Blocks without code are executed with these handlers.
+    struct InterpreterEntry
+    {
+      void (*handler)(CPU*);
+      InstructionData data;
+      u8 length;
+    };
+    std::vector<InterpreterEntry> interpreter_entries;
+    CompileJob* compile_job = nullptr;
+    u32 execution_count = 0;
+
+    bool IsBackgroundCompiling() const { return (flags & BlockFlags::BackgroundCompiling) != BlockFlags::None; }
+  };
+
+  /// A block queued for compilation on the worker thread. The worker only accesses the snapshot and the results, the
+  /// block itself is only touched by the CPU thread when the results are published.
+  struct CompileJob
+  {
+    CompileJob(Block* block_) : block(block_), snapshot(block_->key) {}
+
+    Block* block;
+    BlockBase snapshot;
+    bool cancelled = false;
+    bool out_of_space = false;
+    bool succeeded = false;
+
+    BlockFunctionType code_pointer = nullptr;
+    size_t code_size = 0;
+    std::vector<BlockLinkSlot> link_slots;
+    std::vector<FastmemAccess> fastmem_accesses;
+
+    // Code segment when the compile was queued, for naming the block in the perf map.
+    u16 cs_selector = 0;
   };
 
   BlockBase* AllocateBlock(const BlockKey key) override;
@@ -34,9 +92,48 @@ protected:
   void ResetBlock(BlockBase* block) override;
   void FlushBlock(BlockBase* block, bool defer_destroy = false) override;
   void DestroyBlock(BlockBase* block) override;
+  void InvalidateBlock(BlockBase* block) override;
+  void LinkBlockBase(BlockBase* from, BlockBase* to) override;
+  void UnlinkBlockBase(BlockBase* block) override;
+
+  /// Patches from's exits to jump directly to to's code, if both blocks have been compiled.
+  void LinkBlockCode(Block* from, Block* to);
 
+  /// Points the link slot's jump at linked_block's code, or back to the dispatcher if null.
+  void PatchLinkSlot(Block* block, BlockLinkSlot* slot, Block* linked_block);
+
+  /// Adds/removes a block's fastmem accesses to the lookup used by the fault handler.
+  void AddFastmemAccesses(Block* block);
+  void RemoveFastmemAccesses(Block* block);
   void ExecuteBlock();
 
+  /// Divides the code space after the ASM functions into regions.
+  void SetupCodeRegions();
+
+  /// Adds/removes a block from the list of blocks with code in a region.
+  void AddBlockToCodeRegion(Block* block, u32 region_index);
+  void RemoveBlockFromCodeRegion(Block* block);
+
+  /// Moves to the next code region, flushing all blocks with code in it.
+  void EvictNextCodeRegion();
+
+  /// Tiered mode: runs a block which hasn't been compiled yet through the interpreter handlers.
+  bool CompileInterpreterBlock(Block* block);
+  void InterpretBlock(Block* block);
+
+  /// Generates the ASM functions at the start of the code space, and adds them to the perf map.
+  void GenerateASMFunctions();
+
+  /// Adds a symbol for a compiled block to the perf map, if enabled.
+  void AddBlockToPerfMap(const Block* block, u16 cs_selector);
+
+  /// Tiered mode: queues a block for compilation, cancels a queued compile, or installs finished compiles.
+  void QueueBackgroundCompile(Block* block);
+  void CancelBackgroundCompile(Block* block);
+  void CancelAllBackgroundCompiles();
+  void PublishBackgroundCompiles();
+  void CompileThreadRoutine();
+
   ASMFunctions m_asm_functions = {};
 
 #ifdef Y_COMPILER_MSVC
@@ -51,5 +148,34 @@ protected:
   Block* m_current_block = nullptr;
   std::unique_ptr<JitCodeBuffer> m_code_space;
   bool m_code_buffer_overflow = false;
+  bool m_tiered;
+
+  // Blocks are compiled into the current region, the regions are used as a ring.
+  struct CodeRegion
+  {
+    std::unique_ptr<JitCodeBuffer> code_space;
+    std::vector<Block*> blocks;
+  };
+  std::array<CodeRegion, CodeRegionCount> m_code_regions;
+  u32 m_current_code_region = 0;
+
+  // Tiered mode: the worker compiles into its own region of the code buffer, split off the end of m_code_space.
+  std::unique_ptr<JitCodeBuffer> m_background_code_space;
+  std::thread m_compile_thread;
+  std::mutex m_compile_mutex;
+  std::condition_variable m_compile_queue_cv;
+  std::condition_variable m_compile_done_cv;
+  std::deque<std::unique_ptr<CompileJob>> m_compile_queue;
+  std::vector<std::unique_ptr<CompileJob>> m_completed_compiles;
+  CompileJob* m_active_compile = nullptr;
+  std::atomic_bool m_has_completed_compiles{false};
+  bool m_compile_thread_shutdown = false;
+
+  // Fastmem accesses, indexed by host code address.
+  std::unordered_map<const void*, FastmemAccess> m_fastmem_accesses;
+  bool m_fastmem_handler_installed = false;
+
+  // Symbols for compiled code, for profiling with Linux perf.
+  JitPerfMap m_perf_map;
 };
 } // namespace CPU_X86::Recompiler
\ No newline at end of file
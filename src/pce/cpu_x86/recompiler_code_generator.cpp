@@ -8,6 +8,9 @@ Log_SetChannel(CPU_X86::Recompiler);
 
 namespace CPU_X86::Recompiler {
 
+static std::array<u64, Operation_Count> s_native_operation_instruction_counts;
+static std::array<u64, Operation_Count> s_fallback_operation_instruction_counts;
+
 // TODO:
 // Constant operands - don't move to a temporary register first
 // Only sync current_ESP at the start of the block, and on push/pop instructions
@@ -17,12 +20,13 @@ namespace CPU_X86::Recompiler {
 // Lazy flag calculation - store operands and opcode
 // TODO: Block leaking on invalidation
 // TODO: Remove physical references when block is destroyed
-// TODO: block linking
 // TODO: memcpy-like stuff from bus for validation
 // TODO: xor eax, eax -> invalidate and constant 0
 
-CodeGenerator::CodeGenerator(CPU* cpu, JitCodeBuffer* code_buffer, const ASMFunctions& asm_functions)
-  : m_cpu(cpu), m_code_buffer(code_buffer), m_asm_functions(asm_functions), m_register_cache(*this),
+CodeGenerator::CodeGenerator(CPU* cpu, JitCodeBuffer* code_buffer, const ASMFunctions& asm_functions,
+                             void* current_block_ptr)
+  : m_cpu(cpu), m_code_buffer(code_buffer), m_asm_functions(asm_functions), m_current_block_ptr(current_block_ptr),
+    m_register_cache(*this),
     m_emit(code_buffer->GetFreeCodeSpace(), code_buffer->GetFreeCodePointer())
 {
   InitHostRegs();
@@ -94,13 +98,18 @@ u32 CodeGenerator::CalculateSegmentRegisterOffset(Segment segment)
   return uint32(offsetof(CPU, m_registers.segment_selectors[0]) + (segment * sizeof(uint16)));
 }
 
-bool CodeGenerator::CompileBlock(const BlockBase* block, BlockFunctionType* out_function_ptr, size_t* out_code_size)
+bool CodeGenerator::CompileBlock(const BlockBase* block, BlockFunctionType* out_function_ptr, size_t* out_code_size,
+                                 std::vector<BlockLinkSlot>* out_link_slots,
+                                 std::vector<FastmemAccess>* out_fastmem_accesses)
 {
   // TODO: Align code buffer.
 
+  out_fastmem_accesses->clear();
+  m_fastmem_accesses = out_fastmem_accesses;
   m_block = block;
   m_block_start = block->instructions.data();
   m_block_end = block->instructions.data() + block->instructions.size();
+  AnalyzeBlock();
 
   EmitBeginBlock();
 
@@ -113,32 +122,490 @@ bool CodeGenerator::CompileBlock(const BlockBase* block, BlockFunctionType* out_
     Log_DebugPrintf("Compiling instruction '%08x: %s'", instruction->address, disasm.GetCharArray());
 #endif
 
+    m_current_instruction_info = &m_instruction_info[instruction - m_block_start];
+    m_live_flags = m_current_instruction_info->live_flags;
+    m_checked_access_types = m_current_instruction_info->checked_access_types;
+    m_limit_checked = m_current_instruction_info->limit_checked;
     if (!CompileInstruction(*instruction))
     {
+      m_current_instruction_info = nullptr;
+      m_live_flags = ALL_ARITHMETIC_FLAGS;
+      out_fastmem_accesses->clear();
+      m_fastmem_accesses = nullptr;
       m_block_end = nullptr;
       m_block_start = nullptr;
       m_block = nullptr;
       return false;
     }
 
+    DiscardDeadGuestRegisters(m_current_instruction_info->live_registers);
     instruction++;
   }
 
+  m_current_instruction_info = nullptr;
+
   // Re-sync instruction pointers.
   m_register_cache.FlushAllGuestRegisters(true);
   SyncInstructionPointer();
+
+  // Exits with constant targets can be linked directly to the next block.
+  out_link_slots->clear();
+  if (m_block->IsLinkable())
+  {
+    std::array<u32, 2> target_eips;
+    const u32 num_targets = GetConstantBranchTargets(*(m_block_end - 1), &target_eips);
+    if (num_targets > 0)
+      EmitBlockLinkSlots(target_eips.data(), num_targets, out_link_slots);
+  }
+
   EmitEndBlock();
 
   FinalizeBlock(out_function_ptr, out_code_size);
 
   DebugAssert(m_register_cache.GetUsedHostRegisters() == 0);
 
+  m_live_flags = ALL_ARITHMETIC_FLAGS;
+  m_fastmem_accesses = nullptr;
   m_block_end = nullptr;
   m_block_start = nullptr;
   m_block = nullptr;
   return true;
 }
 
+void CodeGenerator::AnalyzeBlock()
+{
+  const size_t num_instructions = static_cast<size_t>(m_block_end - m_block_start);
+  m_instruction_info.resize(num_instructions);
+
+  // The key says whether ES, SS and DS are flat on entry, which holds until the block loads one of them.
+  bool flat_segments = (m_block->key.flat_segments != 0);
+  for (size_t i = 0; i < num_instructions; i++)
+  {
+    InstructionInfo& info = m_instruction_info[i];
+    info.flat_segments = flat_segments;
+    flat_segments &= !LoadsKeyedSegment(&m_block_start[i]);
+
+    info.live_flags = ALL_ARITHMETIC_FLAGS;
+    info.constant_result = 0;
+    info.live_registers = 0xFF;
+    info.checked_access_types = 0;
+    info.limit_checked = false;
+    info.track_memory_checks = false;
+    info.has_constant_result = false;
+    info.sync_eip = true;
+  }
+
+  if (!m_cpu->m_recompiler_block_optimization)
+    return;
+
+  ComputeLiveness();
+  ComputeConstantResults();
+  ComputeMemoryChecks();
+}
+
+void CodeGenerator::ComputeLiveness()
+{
+  // Walk the block backwards, tracking which flags and registers are read before being overwritten. Everything is
+  // live at the end of the block, and at any instruction which can fault, since the exception handler sees the state.
+  u32 live_flags = ALL_ARITHMETIC_FLAGS;
+  u8 live_registers = 0xFF;
+  for (size_t i = m_instruction_info.size(); i > 0; i--)
+  {
+    const Instruction* instruction = &m_block_start[i - 1];
+    InstructionInfo& info = m_instruction_info[i - 1];
+    info.live_flags = live_flags;
+    info.live_registers = live_registers;
+
+    if (CanInstructionFault(instruction))
+    {
+      live_flags = ALL_ARITHMETIC_FLAGS;
+      live_registers = 0xFF;
+      continue;
+    }
+
+    u32 read_flags, written_flags;
+    GetInstructionFlagUsage(instruction, &read_flags, &written_flags);
+    live_flags = (live_flags & ~written_flags) | read_flags;
+
+    u8 read_registers, written_registers, overwritten_registers;
+    GetInstructionRegisterUsage(instruction, &read_registers, &written_registers, &overwritten_registers);
+    live_registers = (live_registers & ~overwritten_registers) | read_registers;
+  }
+}
+
+// Computes the value written to the destination register of a 32-bit MOV/LEA/ALU instruction, if it only depends on
+// immediates and registers which are known.
+static std::optional<u32> EvaluateConstantResult(const Instruction* instruction, u8 known_registers,
+                                                 const std::array<u32, Reg32_Count>& register_values)
+{
+  const auto dest = GetOperandRegister(*instruction, 0);
+  if (!dest || instruction->operands[0].size != OperandSize_32)
+    return std::nullopt;
+
+  auto GetKnownRegister = [&](u8 reg) -> std::optional<u32> {
+    if (!(known_registers & (1u << reg)))
+      return std::nullopt;
+    return register_values[reg];
+  };
+
+  auto GetSource = [&]() -> std::optional<u32> {
+    const Instruction::Operand& operand = instruction->operands[1];
+    if (operand.mode == OperandMode_Immediate)
+    {
+      // Byte immediates are sign-extended to the operand size.
+      if (operand.size == OperandSize_8)
+        return SignExtend32(instruction->data.imm8);
+      else if (operand.size == OperandSize_32)
+        return instruction->data.imm32;
+      else
+        return std::nullopt;
+    }
+
+    const auto reg = GetOperandRegister(*instruction, 1);
+    if (reg && operand.size == OperandSize_32)
+      return GetKnownRegister(*reg);
+
+    return std::nullopt;
+  };
+
+  switch (instruction->operation)
+  {
+    case Operation_MOV:
+      return GetSource();
+
+    case Operation_LEA:
+    {
+      if (!instruction->Is32BitAddressSize() || instruction->operands[1].mode != OperandMode_ModRM_RM)
+        return std::nullopt;
+
+      const Decoder::ModRMAddress* modrm = Decoder::DecodeModRMAddress(AddressSize_32, instruction->data.modrm);
+      u32 address = 0;
+      switch (modrm->addressing_mode)
+      {
+        case ModRMAddressingMode::Direct:
+          return instruction->data.disp32;
+
+        case ModRMAddressingMode::Indirect:
+        case ModRMAddressingMode::Indexed:
+        {
+          const auto base = GetKnownRegister(modrm->base_register);
+          if (!base)
+            return std::nullopt;
+
+          address = *base;
+          if (modrm->addressing_mode == ModRMAddressingMode::Indexed)
+            address += instruction->data.disp32;
+          return address;
+        }
+
+        case ModRMAddressingMode::SIB:
+        {
+          if (instruction->HasSIBBase())
+          {
+            const auto base = GetKnownRegister(instruction->GetSIBBaseRegister());
+            if (!base)
+              return std::nullopt;
+            address += *base;
+          }
+          if (instruction->HasSIBIndex())
+          {
+            const auto index = GetKnownRegister(instruction->GetSIBIndexRegister());
+            if (!index)
+              return std::nullopt;
+            address += *index << instruction->GetSIBScaling();
+          }
+          return address + instruction->data.disp32;
+        }
+
+        default:
+          return std::nullopt;
+      }
+    }
+
+    case Operation_XOR:
+    case Operation_SUB:
+    {
+      // xor reg, reg and sub reg, reg are zero regardless of the register's value.
+      if (OperandRegistersMatch(*instruction, 0, 1))
+        return 0;
+    }
+      [[fallthrough]];
+
+    case Operation_ADD:
+    case Operation_AND:
+    case Operation_OR:
+    {
+      const auto lhs = GetKnownRegister(*dest);
+      const auto rhs = GetSource();
+      if (!lhs || !rhs)
+        return std::nullopt;
+
+      switch (instruction->operation)
+      {
+        case Operation_ADD:
+          return *lhs + *rhs;
+        case Operation_SUB:
+          return *lhs - *rhs;
+        case Operation_AND:
+          return *lhs & *rhs;
+        case Operation_OR:
+          return *lhs | *rhs;
+        case Operation_XOR:
+        default:
+          return *lhs ^ *rhs;
+      }
+    }
+
+    case Operation_INC:
+    case Operation_DEC:
+    {
+      const auto value = GetKnownRegister(*dest);
+      if (!value)
+        return std::nullopt;
+
+      return (instruction->operation == Operation_INC) ? (*value + 1) : (*value - 1);
+    }
+
+    default:
+      return std::nullopt;
+  }
+}
+
+void CodeGenerator::ComputeConstantResults()
+{
+  // Track the registers which hold values known at compile time. Only full 32-bit writes of known values are tracked,
+  // anything else which writes a register makes it unknown.
+  std::array<u32, Reg32_Count> register_values{};
+  u8 known_registers = 0;
+  for (size_t i = 0; i < m_instruction_info.size(); i++)
+  {
+    const Instruction* instruction = &m_block_start[i];
+    InstructionInfo& info = m_instruction_info[i];
+
+    const std::optional<u32> result = EvaluateConstantResult(instruction, known_registers, register_values);
+
+    u8 read_registers, written_registers, overwritten_registers;
+    GetInstructionRegisterUsage(instruction, &read_registers, &written_registers, &overwritten_registers);
+    known_registers &= ~written_registers;
+    if (!result)
+      continue;
+
+    const u8 dest = *GetOperandRegister(*instruction, 0);
+    known_registers |= static_cast<u8>(1u << dest);
+    register_values[dest] = *result;
+
+    // The flags still have to be computed if they're read. MOVs with immediates are already constant in the register
+    // cache, so they don't need anything special.
+    u32 read_flags, written_flags;
+    GetInstructionFlagUsage(instruction, &read_flags, &written_flags);
+    if ((written_flags & info.live_flags) == 0 &&
+        !(instruction->operation == Operation_MOV && instruction->operands[1].mode == OperandMode_Immediate))
+    {
+      info.has_constant_result = true;
+      info.constant_result = *result;
+    }
+  }
+}
+
+// Returns true if the only memory accesses of the instruction are to a single memory operand, and they're always
+// done. The operand index and types of access are returned.
+static bool GetSimpleMemoryAccess(const Instruction* instruction, u32* operand_index, u8* access_types)
+{
+  constexpr u8 read = static_cast<u8>(AccessTypeMask::Read);
+  constexpr u8 read_write = static_cast<u8>(AccessTypeMask::ReadWrite);
+  u8 destination_access;
+  switch (instruction->operation)
+  {
+    case Operation_MOV:
+    case Operation_MOVZX:
+    case Operation_MOVSX:
+      destination_access = static_cast<u8>(AccessTypeMask::Write);
+      break;
+
+    case Operation_ADD:
+    case Operation_ADC:
+    case Operation_SUB:
+    case Operation_SBB:
+    case Operation_AND:
+    case Operation_OR:
+    case Operation_XOR:
+    case Operation_INC:
+    case Operation_DEC:
+    case Operation_NOT:
+    case Operation_NEG:
+      destination_access = read_write;
+      break;
+
+    case Operation_CMP:
+    case Operation_TEST:
+      destination_access = read;
+      break;
+
+    case Operation_XCHG:
+      destination_access = read_write;
+      break;
+
+    case Operation_SETcc:
+      // Operand 0 is the condition.
+      if (instruction->operands[1].mode != OperandMode_ModRM_RM || instruction->ModRM_RM_IsReg())
+        return false;
+      *operand_index = 1;
+      *access_types = static_cast<u8>(AccessTypeMask::Write);
+      return true;
+
+    default:
+      return false;
+  }
+
+  u32 num_memory_operands = 0;
+  for (u32 i = 0; i < 2; i++)
+  {
+    switch (instruction->operands[i].mode)
+    {
+      case OperandMode_None:
+      case OperandMode_Constant:
+      case OperandMode_Register:
+      case OperandMode_Immediate:
+      case OperandMode_ModRM_Reg:
+        break;
+
+      case OperandMode_Memory:
+      case OperandMode_ModRM_RM:
+      {
+        if (instruction->operands[i].mode == OperandMode_ModRM_RM && instruction->ModRM_RM_IsReg())
+          break;
+
+        num_memory_operands++;
+        *operand_index = i;
+        *access_types = (i == 0 || instruction->operation == Operation_XCHG) ? destination_access : read;
+      }
+      break;
+
+      default:
+        return false;
+    }
+  }
+
+  return (num_memory_operands == 1);
+}
+
+// Identifies the address expression of a memory operand, two operands with the same key and the same register
+// values have the same offset.
+static u64 GetMemoryOperandKey(const Instruction* instruction, u32 index)
+{
+  const u32 displacement =
+    instruction->Is32BitAddressSize() ? instruction->data.disp32 : ZeroExtend32(instruction->data.disp16);
+  u32 addressing = ZeroExtend32(static_cast<u8>(instruction->GetAddressSize()));
+  if (instruction->operands[index].mode == OperandMode_ModRM_RM)
+  {
+    addressing |= 0x100 | (ZeroExtend32(instruction->data.modrm & 0xC7) << 16);
+    if (instruction->HasSIB())
+      addressing |= ZeroExtend32(instruction->data.sib) << 24;
+  }
+
+  return (ZeroExtend64(addressing) << 32) | ZeroExtend64(displacement);
+}
+
+void CodeGenerator::ComputeMemoryChecks()
+{
+  // Once a memory access completes, the segment allowed that type of access, and the offset was within the limit.
+  // Later accesses through the same segment and address expression don't need the checks again, as long as the
+  // segment and the registers used in the address haven't changed. Unknown instructions may load segments.
+  struct CheckedAddress
+  {
+    u64 key;
+    Segment segment;
+    OperandSize size;
+    u8 address_registers;
+  };
+  static constexpr u32 MAX_CHECKED_ADDRESSES = 8;
+  std::array<CheckedAddress, MAX_CHECKED_ADDRESSES> checked_addresses;
+  u32 num_checked_addresses = 0;
+  std::array<u8, Segment_Count> checked_access_types{};
+
+  for (size_t i = 0; i < m_instruction_info.size(); i++)
+  {
+    const Instruction* instruction = &m_block_start[i];
+    InstructionInfo& info = m_instruction_info[i];
+
+    u32 operand_index;
+    u8 access_types;
+    const bool simple_access = GetSimpleMemoryAccess(instruction, &operand_index, &access_types);
+    const Segment segment = instruction->GetMemorySegment();
+    u64 key = 0;
+    if (simple_access)
+    {
+      // These can only fault in the memory access, which restarts from m_current_EIP, so EIP can be synced later.
+      info.track_memory_checks = true;
+      info.sync_eip = false;
+      info.checked_access_types = checked_access_types[segment];
+
+      key = GetMemoryOperandKey(instruction, operand_index);
+      for (u32 j = 0; j < num_checked_addresses; j++)
+      {
+        const CheckedAddress& ca = checked_addresses[j];
+        if (ca.key == key && ca.segment == segment && ca.size >= instruction->operands[operand_index].size)
+        {
+          info.limit_checked = true;
+          break;
+        }
+      }
+    }
+
+    u8 read_registers, written_registers, overwritten_registers;
+    if (!GetInstructionRegisterUsage(instruction, &read_registers, &written_registers, &overwritten_registers))
+    {
+      checked_access_types.fill(0);
+      num_checked_addresses = 0;
+      continue;
+    }
+
+    for (u32 j = 0; j < num_checked_addresses;)
+    {
+      if (checked_addresses[j].address_registers & written_registers)
+        checked_addresses[j] = checked_addresses[--num_checked_addresses];
+      else
+        j++;
+    }
+
+    if (!simple_access)
+      continue;
+
+    checked_access_types[segment] |= access_types;
+
+    const u8 address_registers = GetOperandAddressRegisters(*instruction, operand_index);
+    if (address_registers & written_registers)
+      continue;
+
+    // Replace the oldest address when full.
+    if (num_checked_addresses == MAX_CHECKED_ADDRESSES)
+    {
+      std::move(checked_addresses.begin() + 1, checked_addresses.end(), checked_addresses.begin());
+      num_checked_addresses--;
+    }
+    checked_addresses[num_checked_addresses++] = {key, segment, instruction->operands[operand_index].size,
+                                                  address_registers};
+  }
+}
+
+void CodeGenerator::DiscardDeadGuestRegisters(u8 live_registers)
+{
+  // Values of dead registers never need to be written back, since they're overwritten before anything reads them.
+  for (u8 reg = 0; reg < 8; reg++)
+  {
+    if (live_registers & (1u << reg))
+      continue;
+
+    m_register_cache.InvalidateGuestRegister(static_cast<Reg32>(reg));
+    m_register_cache.InvalidateGuestRegister(static_cast<Reg16>(reg));
+    if (reg < 4)
+    {
+      m_register_cache.InvalidateGuestRegister(static_cast<Reg8>(reg));
+      m_register_cache.InvalidateGuestRegister(static_cast<Reg8>(reg + 4));
+    }
+  }
+}
+
 bool CodeGenerator::CompileInstruction(const Instruction& instruction)
 {
   if (IsInvalidInstruction(instruction))
@@ -148,6 +615,9 @@ bool CodeGenerator::CompileInstruction(const Instruction& instruction)
     return true;
   }
 
+  // Anything which doesn't pass through Compile_Fallback is compiled natively.
+  const u64 fallback_count = s_fallback_operation_instruction_counts[instruction.operation];
+
   bool result;
   switch (instruction.operation)
   {
@@ -163,6 +633,23 @@ bool CodeGenerator::CompileInstruction(const Instruction& instruction)
       result = Compile_MOV(instruction);
       break;
 
+    case Operation_MOVZX:
+    case Operation_MOVSX:
+      result = Compile_MOVX(instruction);
+      break;
+
+    case Operation_XCHG:
+      result = Compile_XCHG(instruction);
+      break;
+
+    case Operation_CBW:
+      result = Compile_CBW(instruction);
+      break;
+
+    case Operation_CWD:
+      result = Compile_CWD(instruction);
+      break;
+
     case Operation_MOVS:
     case Operation_LODS:
     case Operation_STOS:
@@ -191,12 +678,46 @@ bool CodeGenerator::CompileInstruction(const Instruction& instruction)
       result = Compile_NOT(instruction);
       break;
 
+    case Operation_NEG:
+      result = Compile_NEG(instruction);
+      break;
+
     case Operation_ADD:
+    case Operation_ADC:
     case Operation_SUB:
+    case Operation_SBB:
     case Operation_CMP:
       result = Compile_AddSub(instruction);
       break;
 
+    case Operation_MUL:
+      result = Compile_MUL(instruction);
+      break;
+
+    case Operation_IMUL:
+      result = Compile_IMUL(instruction);
+      break;
+
+    case Operation_DIV:
+      result = Compile_DIV(instruction);
+      break;
+
+    case Operation_BT:
+    case Operation_BTS:
+    case Operation_BTR:
+    case Operation_BTC:
+      result = Compile_BTx(instruction);
+      break;
+
+    case Operation_BSF:
+    case Operation_BSR:
+      result = Compile_BSx(instruction);
+      break;
+
+    case Operation_SETcc:
+      result = Compile_SETcc(instruction);
+      break;
+
     case Operation_INC:
     case Operation_DEC:
       result = Compile_IncDec(instruction);
@@ -218,6 +739,10 @@ bool CodeGenerator::CompileInstruction(const Instruction& instruction)
       result = Compile_Jcc(instruction);
       break;
 
+    case Operation_LOOP:
+      result = Compile_LOOP(instruction);
+      break;
+
     case Operation_JMP_Near:
       result = Compile_JMP_Near(instruction);
       break;
@@ -230,6 +755,31 @@ bool CodeGenerator::CompileInstruction(const Instruction& instruction)
       result = Compile_RET_Near(instruction);
       break;
 
+    case Operation_FLD:
+    case Operation_FST:
+    case Operation_FSTP:
+    case Operation_FILD:
+    case Operation_FIST:
+    case Operation_FISTP:
+    case Operation_FXCH:
+    case Operation_FADD:
+    case Operation_FADDP:
+    case Operation_FSUB:
+    case Operation_FSUBP:
+    case Operation_FSUBR:
+    case Operation_FSUBRP:
+    case Operation_FMUL:
+    case Operation_FMULP:
+    case Operation_FDIV:
+    case Operation_FDIVP:
+    case Operation_FDIVR:
+    case Operation_FDIVRP:
+    case Operation_FCOM:
+    case Operation_FCOMP:
+    case Operation_FCOMPP:
+      result = Compile_X87(instruction);
+      break;
+
     default:
       result = Compile_Fallback(instruction);
       break;
@@ -239,9 +789,32 @@ bool CodeGenerator::CompileInstruction(const Instruction& instruction)
   for (Value& value : m_operand_memory_addresses)
     value.ReleaseAndClear();
 
+  if (result && s_fallback_operation_instruction_counts[instruction.operation] == fallback_count)
+    s_native_operation_instruction_counts[instruction.operation]++;
+
   return result;
 }
 
+void CodeGenerator::LogOperationCounts()
+{
+  u64 total_native = 0;
+  u64 total_fallback = 0;
+  for (u32 i = 0; i < Operation_Count; i++)
+  {
+    const u64 native_count = s_native_operation_instruction_counts[i];
+    const u64 fallback_count = s_fallback_operation_instruction_counts[i];
+    if (native_count == 0 && fallback_count == 0)
+      continue;
+
+    Log_InfoPrintf("%-12s %10" PRIu64 " native %10" PRIu64 " fallback",
+                   Decoder::GetOperationName(static_cast<Operation>(i)), native_count, fallback_count);
+    total_native += native_count;
+    total_fallback += fallback_count;
+  }
+
+  Log_InfoPrintf("Total: %" PRIu64 " native, %" PRIu64 " fallback", total_native, total_fallback);
+}
+
 Value CodeGenerator::ConvertValueSize(const Value& value, OperandSize size, bool sign_extend)
 {
   DebugAssert(value.size != size);
@@ -407,6 +980,14 @@ Value CodeGenerator::ShlValues(const Value& lhs, const Value& rhs)
 
 void CodeGenerator::UpdateEFLAGS(Value&& merge_value, u32 clear_flags_mask, u32 copy_flags_mask, u32 set_flags_mask)
 {
+  // Don't bother updating flags which are overwritten later in the block without being read.
+  const u32 dead_flags = ALL_ARITHMETIC_FLAGS & ~m_live_flags;
+  clear_flags_mask &= ~dead_flags;
+  copy_flags_mask &= ~dead_flags;
+  set_flags_mask &= ~dead_flags;
+  if ((clear_flags_mask | copy_flags_mask | set_flags_mask) == 0)
+    return;
+
   Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);
 
   const u32 bits_to_clear = clear_flags_mask | copy_flags_mask;
@@ -904,6 +1485,39 @@ Value CodeGenerator::CalculateJumpTarget(const Instruction& instruction, size_t
   }
 }
 
+u32 CodeGenerator::GetConstantBranchTargets(const Instruction& instruction, std::array<u32, 2>* target_eips) const
+{
+  const u32 eip_mask = m_block->Is32BitCode() ? UINT32_C(0xFFFFFFFF) : UINT32_C(0xFFFF);
+  const u32 target_mask = (instruction.GetOperandSize() == OperandSize_16) ? UINT32_C(0xFFFF) : UINT32_C(0xFFFFFFFF);
+  const u32 next_eip = (instruction.address + instruction.length) & eip_mask;
+
+  switch (instruction.operation)
+  {
+    case Operation_JMP_Near:
+    case Operation_CALL_Near:
+    {
+      if (instruction.operands[0].mode != OperandMode_Relative)
+        return 0;
+
+      (*target_eips)[0] = (next_eip + instruction.data.disp32) & target_mask;
+      return 1;
+    }
+
+    case Operation_Jcc:
+    case Operation_LOOP:
+    {
+      // Both the taken and not-taken paths are constant.
+      DebugAssert(instruction.operands[1].mode == OperandMode_Relative);
+      (*target_eips)[0] = (next_eip + instruction.data.disp32) & target_mask;
+      (*target_eips)[1] = next_eip;
+      return ((*target_eips)[0] != (*target_eips)[1]) ? 2 : 1;
+    }
+
+    default:
+      return 0;
+  }
+}
+
 bool CodeGenerator::IsConstantOperand(const Instruction* instruction, size_t index)
 {
   const Instruction::Operand* operand = &instruction->operands[index];
@@ -927,71 +1541,6 @@ uint32 CodeGenerator::GetConstantOperand(const Instruction* instruction, size_t
   }
 }
 
-void CodeGenerator::LoadSegmentMemory(Value* dest_value, OperandSize size, const Value& address, Segment segment)
-{
-  DebugAssert(address.size == OperandSize_32);
-  switch (size)
-  {
-    case OperandSize_8:
-      EmitFunctionCall(dest_value, m_asm_functions.read_memory_byte, Value::FromConstantU8(segment), address);
-      break;
-    case OperandSize_16:
-      EmitFunctionCall(dest_value, m_asm_functions.read_memory_word, Value::FromConstantU8(segment), address);
-      break;
-    case OperandSize_32:
-      EmitFunctionCall(dest_value, m_asm_functions.read_memory_dword, Value::FromConstantU8(segment), address);
-      break;
-    default:
-      break;
-  }
-}
-
-void CodeGenerator::StoreSegmentMemory(const Value& value, const Value& address, Segment segment)
-{
-  if (value.IsConstant())
-  {
-    if (address.IsConstant())
-    {
-      Log_DebugPrintf("Store constant value %08X to constant address %08X", Truncate32(value.constant_value),
-                      Truncate32(address.constant_value));
-    }
-    else
-    {
-      Log_DebugPrintf("Store constant value %08X to address in register %s", Truncate32(value.constant_value),
-                      GetHostRegName(address.host_reg));
-    }
-  }
-  else
-  {
-    if (address.IsConstant())
-    {
-      Log_DebugPrintf("Store register %s to constant address %08X", GetHostRegName(value.host_reg),
-                      Truncate32(address.constant_value));
-    }
-    else
-    {
-      Log_DebugPrintf("Store register %s to address in register %s", GetHostRegName(value.host_reg),
-                      GetHostRegName(address.host_reg));
-    }
-  }
-
-  DebugAssert(address.size == OperandSize_32);
-  switch (value.size)
-  {
-    case OperandSize_8:
-      EmitFunctionCall(nullptr, m_asm_functions.write_memory_byte, Value::FromConstantU8(segment), address, value);
-      break;
-    case OperandSize_16:
-      EmitFunctionCall(nullptr, m_asm_functions.write_memory_word, Value::FromConstantU8(segment), address, value);
-      break;
-    case OperandSize_32:
-      EmitFunctionCall(nullptr, m_asm_functions.write_memory_dword, Value::FromConstantU8(segment), address, value);
-      break;
-    default:
-      break;
-  }
-}
-
 void CodeGenerator::RaiseException(u32 exception, const Value& ec /*= Value::FromConstantU32(0)*/)
 {
   EmitFunctionCall(nullptr, &Thunks::RaiseException, m_register_cache.GetCPUPtr(), Value::FromConstantU32(exception),
@@ -1010,6 +1559,24 @@ void CodeGenerator::InstructionPrologue(const Instruction& instruction, CycleCou
     return;
   }
 
+  if (!m_current_instruction_info->sync_eip && !force_sync)
+  {
+    // Faults only need m_current_EIP, so the EIP update can be merged with the next sync.
+    if (m_delayed_current_eip_add > 0)
+    {
+      EmitAddCPUStructField(offsetof(CPU, m_current_EIP),
+                            m_block->Is32BitCode() ? Value::FromConstantU32(m_delayed_current_eip_add) :
+                                                     Value::FromConstantU16(Truncate16(m_delayed_current_eip_add)));
+    }
+
+    m_delayed_eip_add += instruction.length;
+    m_delayed_current_eip_add = instruction.length;
+    EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(m_delayed_cycles_add + cycles));
+    m_delayed_cycles_add = 0;
+    m_register_cache.FlushAllGuestRegisters(false);
+    return;
+  }
+
   // Update EIP to point to the next instruction.
   if (m_block->Is32BitCode())
   {
@@ -1061,7 +1628,7 @@ void CodeGenerator::SyncInstructionPointer()
 
   if (m_delayed_cycles_add > 0)
   {
-    EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(m_delayed_eip_add));
+    EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(m_delayed_cycles_add));
     m_delayed_cycles_add = 0;
   }
 }
@@ -1076,8 +1643,6 @@ void CodeGenerator::SyncCurrentESP()
   EmitStoreCPUStructField(offsetof(CPU, m_current_ESP), m_register_cache.ReadGuestRegister(Reg32_ESP, false));
 }
 
-static std::array<u64, Operation_Count> s_fallback_operation_instruction_counts;
-
 bool CodeGenerator::Compile_Fallback(const Instruction& instruction)
 {
   InstructionPrologue(instruction, 0, true);
@@ -1085,7 +1650,16 @@ bool CodeGenerator::Compile_Fallback(const Instruction& instruction)
 
   // flush and invalidate all guest registers, since the fallback could change any of them
   m_register_cache.FlushAllGuestRegisters(true);
+  EmitInterpreterCall(instruction);
+
+  // assume any instruction can manipulate esp
+  SyncCurrentESP();
+
+  return true;
+}
 
+void CodeGenerator::EmitInterpreterCall(const Instruction& instruction)
+{
   // set up the instruction data
   EmitStoreCPUStructField(offsetof(CPU, idata.bits64[0]), Value::FromConstantU64(instruction.data.bits64[0]));
   EmitStoreCPUStructField(offsetof(CPU, idata.bits64[1]), Value::FromConstantU64(instruction.data.bits64[1]));
@@ -1095,9 +1669,16 @@ bool CodeGenerator::Compile_Fallback(const Instruction& instruction)
   DebugAssert(handler);
   EmitFunctionCall(nullptr, handler, m_register_cache.GetCPUPtr());
 
-  // assume any instruction can manipulate esp
-  SyncCurrentESP();
+  // generated code reads EFLAGS directly, so it can't leave flags pending
+  if (Interpreter::IsLazyFlagsOperation(instruction.operation))
+    EmitFunctionCall(nullptr, &Interpreter::MaterializeLazyFlags, m_register_cache.GetCPUPtr());
+}
 
+bool CodeGenerator::Compile_ConstantResult(const Instruction& instruction, CycleCount cycles)
+{
+  // The analysis pass computed the result, and none of the flags written by the instruction are read.
+  InstructionPrologue(instruction, cycles);
+  WriteOperand(instruction, 0, Value::FromConstantU32(m_current_instruction_info->constant_result));
   return true;
 }
 
@@ -1109,6 +1690,9 @@ bool CodeGenerator::Compile_NOP(const Instruction& instruction)
 
 bool CodeGenerator::Compile_LEA(const Instruction& instruction)
 {
+  if (m_current_instruction_info->has_constant_result)
+    return Compile_ConstantResult(instruction, m_cpu->GetCycles(CYCLES_LEA));
+
   InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_LEA));
   CalculateEffectiveAddress(instruction);
 
@@ -1146,6 +1730,90 @@ bool CodeGenerator::Compile_MOV(const Instruction& instruction)
   return true;
 }
 
+bool CodeGenerator::Compile_MOVX(const Instruction& instruction)
+{
+  const bool sign_extend = (instruction.operation == Operation_MOVSX);
+  const CycleCount cycles =
+    m_cpu->GetCyclesRM(sign_extend ? CYCLES_MOVSX_REG_RM_MEM : CYCLES_MOVZX_REG_RM_MEM, instruction.ModRM_RM_IsReg());
+
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+  WriteOperand(instruction, 0, ReadOperand(instruction, 1, instruction.operands[0].size, sign_extend));
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_XCHG(const Instruction& instruction)
+{
+  DebugAssert(instruction.operands[0].size == instruction.operands[1].size);
+
+  InstructionPrologue(instruction, m_cpu->GetCyclesRM(CYCLES_XCHG_REG_RM_MEM, instruction.ModRM_RM_IsReg()));
+  CalculateEffectiveAddress(instruction);
+
+  // Both values have to be copied out before either is written, otherwise the first write can clobber the second.
+  const OperandSize size = instruction.operands[0].size;
+  Value value0 = ReadOperand(instruction, 0, size, false, false);
+  Value value1 = ReadOperand(instruction, 1, size, false, false);
+  Value temp0 = m_register_cache.AllocateScratch(size);
+  Value temp1 = m_register_cache.AllocateScratch(size);
+  EmitCopyValue(temp0.GetHostRegister(), value0);
+  EmitCopyValue(temp1.GetHostRegister(), value1);
+  value0.ReleaseAndClear();
+  value1.ReleaseAndClear();
+
+  WriteOperand(instruction, 0, std::move(temp1));
+  WriteOperand(instruction, 1, std::move(temp0));
+
+  if (OperandIsESP(instruction, 0) || OperandIsESP(instruction, 1))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_CBW(const Instruction& instruction)
+{
+  InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_CBW));
+
+  if (instruction.GetOperandSize() == OperandSize_16)
+  {
+    Value value = m_register_cache.ReadGuestRegister(Reg8_AL);
+    m_register_cache.WriteGuestRegister(Reg16_AX, ConvertValueSize(value, OperandSize_16, true));
+  }
+  else
+  {
+    Value value = m_register_cache.ReadGuestRegister(Reg16_AX);
+    m_register_cache.WriteGuestRegister(Reg32_EAX, ConvertValueSize(value, OperandSize_32, true));
+  }
+
+  return true;
+}
+
+bool CodeGenerator::Compile_CWD(const Instruction& instruction)
+{
+  InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_CWD));
+
+  // DX/EDX is filled with the sign bit of AX/EAX.
+  if (instruction.GetOperandSize() == OperandSize_16)
+  {
+    Value value = m_register_cache.AllocateScratch(OperandSize_16);
+    EmitCopyValue(value.GetHostRegister(), m_register_cache.ReadGuestRegister(Reg16_AX));
+    EmitSar(value.GetHostRegister(), OperandSize_16, Value::FromConstantU8(15));
+    m_register_cache.WriteGuestRegister(Reg16_DX, std::move(value));
+  }
+  else
+  {
+    Value value = m_register_cache.AllocateScratch(OperandSize_32);
+    EmitCopyValue(value.GetHostRegister(), m_register_cache.ReadGuestRegister(Reg32_EAX));
+    EmitSar(value.GetHostRegister(), OperandSize_32, Value::FromConstantU8(31));
+    m_register_cache.WriteGuestRegister(Reg32_EDX, std::move(value));
+  }
+
+  return true;
+}
+
 bool CodeGenerator::Compile_Bitwise(const Instruction& instruction)
 {
   const bool is_test = (instruction.operation == Operation_TEST);
@@ -1166,8 +1834,12 @@ bool CodeGenerator::Compile_Bitwise(const Instruction& instruction)
   else
     Panic("Unknown mode");
 
+  if (m_current_instruction_info->has_constant_result)
+  {
+    Compile_ConstantResult(instruction, cycles);
+  }
   // Special case for xor reg, reg.
-  if (instruction.operation == Operation_XOR && OperandRegistersMatch(instruction, 0, 1))
+  else if (instruction.operation == Operation_XOR && OperandRegistersMatch(instruction, 0, 1))
   {
     // Register contains zero, eflags has PF and ZF set.
     InstructionPrologue(instruction, cycles);
@@ -1181,7 +1853,6 @@ bool CodeGenerator::Compile_Bitwise(const Instruction& instruction)
   }
   else
   {
-    // TODO: constant folding here
     if (!Compile_Bitwise_Impl(instruction, cycles))
       return Compile_Fallback(instruction);
   }
@@ -1265,6 +1936,25 @@ bool CodeGenerator::Compile_NOT(const Instruction& instruction)
   return true;
 }
 
+bool CodeGenerator::Compile_NEG(const Instruction& instruction)
+{
+  CycleCount cycles = 0;
+  if (instruction.DestinationMode() == OperandMode_Register)
+    cycles = m_cpu->GetCycles(CYCLES_NEG_RM_REG);
+  else if (instruction.DestinationMode() == OperandMode_ModRM_RM)
+    cycles = m_cpu->GetCyclesRM(CYCLES_NEG_RM_MEM, instruction.ModRM_RM_IsReg());
+  else
+    Panic("Unknown mode");
+
+  if (!Compile_NEG_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
 bool CodeGenerator::Compile_AddSub(const Instruction& instruction)
 {
   const bool is_cmp = (instruction.operation == Operation_CMP);
@@ -1279,9 +1969,9 @@ bool CodeGenerator::Compile_AddSub(const Instruction& instruction)
   else
     Panic("Unknown mode");
 
-  // TODO: constant folding here
-
-  if (!Compile_AddSub_Impl(instruction, cycles))
+  if (m_current_instruction_info->has_constant_result)
+    Compile_ConstantResult(instruction, cycles);
+  else if (!Compile_AddSub_Impl(instruction, cycles))
     return Compile_Fallback(instruction);
 
   if (OperandIsESP(instruction, 0))
@@ -1300,7 +1990,122 @@ bool CodeGenerator::Compile_IncDec(const Instruction& instruction)
   else
     Panic("Unknown mode");
 
-  if (!Compile_IncDec_Impl(instruction, cycles))
+  if (m_current_instruction_info->has_constant_result)
+    Compile_ConstantResult(instruction, cycles);
+  else if (!Compile_IncDec_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_MUL(const Instruction& instruction)
+{
+  CycleCount cycles = 0;
+  switch (instruction.operands[0].size)
+  {
+    case OperandSize_8:
+      cycles = m_cpu->GetCyclesRM(CYCLES_MUL_8_RM_MEM, instruction.ModRM_RM_IsReg());
+      break;
+    case OperandSize_16:
+      cycles = m_cpu->GetCyclesRM(CYCLES_MUL_16_RM_MEM, instruction.ModRM_RM_IsReg());
+      break;
+    case OperandSize_32:
+      cycles = m_cpu->GetCyclesRM(CYCLES_MUL_32_RM_MEM, instruction.ModRM_RM_IsReg());
+      break;
+    default:
+      UnreachableCode();
+      break;
+  }
+
+  if (!Compile_MUL_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  return true;
+}
+
+bool CodeGenerator::Compile_IMUL(const Instruction& instruction)
+{
+  const bool is_three_operand = (instruction.operands[2].mode != OperandMode_None);
+
+  CycleCount cycles = 0;
+  switch (instruction.operands[0].size)
+  {
+    case OperandSize_8:
+      cycles = m_cpu->GetCyclesRM(CYCLES_IMUL_8_RM_MEM, instruction.ModRM_RM_IsReg());
+      break;
+    case OperandSize_16:
+      cycles = m_cpu->GetCyclesRM(is_three_operand ? CYCLES_IMUL_16_REG_RM_MEM : CYCLES_IMUL_16_RM_MEM,
+                                  instruction.ModRM_RM_IsReg());
+      break;
+    case OperandSize_32:
+      cycles = m_cpu->GetCyclesRM(is_three_operand ? CYCLES_IMUL_32_REG_RM_MEM : CYCLES_IMUL_32_RM_MEM,
+                                  instruction.ModRM_RM_IsReg());
+      break;
+    default:
+      UnreachableCode();
+      break;
+  }
+
+  // The one-operand form shares its register setup with MUL.
+  const bool result = (instruction.operands[1].mode == OperandMode_None) ? Compile_MUL_Impl(instruction, cycles) :
+                                                                           Compile_IMUL_Impl(instruction, cycles);
+  if (!result)
+    return Compile_Fallback(instruction);
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_DIV(const Instruction& instruction)
+{
+  CycleCount cycles = 0;
+  switch (instruction.operands[0].size)
+  {
+    case OperandSize_8:
+      cycles = m_cpu->GetCyclesRM(CYCLES_DIV_8_RM_MEM, instruction.ModRM_RM_IsReg());
+      break;
+    case OperandSize_16:
+      cycles = m_cpu->GetCyclesRM(CYCLES_DIV_16_RM_MEM, instruction.ModRM_RM_IsReg());
+      break;
+    case OperandSize_32:
+      cycles = m_cpu->GetCyclesRM(CYCLES_DIV_32_RM_MEM, instruction.ModRM_RM_IsReg());
+      break;
+    default:
+      UnreachableCode();
+      break;
+  }
+
+  if (!Compile_DIV_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  return true;
+}
+
+bool CodeGenerator::Compile_SETcc(const Instruction& instruction)
+{
+  const CycleCount cycles = m_cpu->GetCyclesRM(CYCLES_SETcc_RM_MEM, instruction.ModRM_RM_IsReg());
+  if (!Compile_SETcc_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  return true;
+}
+
+bool CodeGenerator::Compile_BTx(const Instruction& instruction)
+{
+  const bool is_bt = (instruction.operation == Operation_BT);
+
+  CycleCount cycles = 0;
+  if (instruction.SourceMode() == OperandMode_Immediate)
+    cycles = m_cpu->GetCyclesRM(is_bt ? CYCLES_BT_RM_MEM_IMM : CYCLES_BTx_RM_MEM_IMM, instruction.ModRM_RM_IsReg());
+  else
+    cycles = m_cpu->GetCyclesRM(is_bt ? CYCLES_BT_RM_MEM_REG : CYCLES_BTx_RM_MEM_REG, instruction.ModRM_RM_IsReg());
+
+  if (!Compile_BTx_Impl(instruction, cycles))
     return Compile_Fallback(instruction);
 
   if (OperandIsESP(instruction, 0))
@@ -1309,6 +2114,76 @@ bool CodeGenerator::Compile_IncDec(const Instruction& instruction)
   return true;
 }
 
+bool CodeGenerator::Compile_BSx(const Instruction& instruction)
+{
+  // Same cost as the interpreter, which does not scale with the bit index.
+  const CycleCount cycles = m_cpu->GetCycles(CYCLES_BSF_BASE) + m_cpu->GetCycles(CYCLES_BSF_N);
+  if (!Compile_BSx_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_X87(const Instruction& instruction)
+{
+  // The native path computes with host doubles, so it's only used when reduced precision is acceptable.
+  if (!m_cpu->m_fast_x87)
+    return Compile_Fallback(instruction);
+
+  CYCLE_GROUP cycle_group;
+  switch (instruction.operation)
+  {
+    case Operation_FLD:
+      cycle_group = CYCLES_FLD;
+      break;
+    case Operation_FST:
+    case Operation_FSTP:
+      cycle_group = CYCLES_FST;
+      break;
+    case Operation_FILD:
+      cycle_group = CYCLES_FILD;
+      break;
+    case Operation_FIST:
+    case Operation_FISTP:
+      cycle_group = CYCLES_FIST;
+      break;
+    case Operation_FXCH:
+      cycle_group = CYCLES_FXCH;
+      break;
+    case Operation_FADD:
+    case Operation_FADDP:
+      cycle_group = CYCLES_FADD;
+      break;
+    case Operation_FSUB:
+    case Operation_FSUBP:
+    case Operation_FSUBR:
+    case Operation_FSUBRP:
+      cycle_group = CYCLES_FSUB;
+      break;
+    case Operation_FMUL:
+    case Operation_FMULP:
+      cycle_group = CYCLES_FMUL;
+      break;
+    case Operation_FDIV:
+    case Operation_FDIVP:
+    case Operation_FDIVR:
+    case Operation_FDIVRP:
+      cycle_group = CYCLES_FDIV;
+      break;
+    default:
+      cycle_group = CYCLES_FCOM;
+      break;
+  }
+
+  if (!Compile_X87_Impl(instruction, m_cpu->GetCycles(cycle_group)))
+    return Compile_Fallback(instruction);
+
+  return true;
+}
+
 bool CodeGenerator::Compile_PUSH(const Instruction& instruction)
 {
   CycleCount cycles = 0;
@@ -1387,6 +2262,16 @@ bool CodeGenerator::Compile_Jcc(const Instruction& instruction)
   return Compile_Jcc_Impl(instruction, cycles, cycles_not_taken);
 }
 
+bool CodeGenerator::Compile_LOOP(const Instruction& instruction)
+{
+  const bool is_conditional = (instruction.operands[0].jump_condition != JumpCondition_Always);
+  const CycleCount cycles = m_cpu->GetCycles(is_conditional ? CYCLES_LOOPZ : CYCLES_LOOP);
+  if (!Compile_LOOP_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  return true;
+}
+
 bool CodeGenerator::Compile_JMP_Near(const Instruction& instruction)
 {
   CycleCount cycles = 0;
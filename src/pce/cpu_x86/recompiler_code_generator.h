@@ -2,6 +2,7 @@
 #include <array>
 #include <initializer_list>
 #include <utility>
+#include <vector>
 
 #include "common/jit_code_buffer.h"
 
@@ -28,7 +29,7 @@ namespace CPU_X86::Recompiler {
 class CodeGenerator
 {
 public:
-  CodeGenerator(CPU* cpu, JitCodeBuffer* code_buffer, const ASMFunctions& asm_functions);
+  CodeGenerator(CPU* cpu, JitCodeBuffer* code_buffer, const ASMFunctions& asm_functions, void* current_block_ptr);
   ~CodeGenerator();
 
   static u32 CalculateRegisterOffset(Reg8 reg);
@@ -38,15 +39,20 @@ public:
   static const char* GetHostRegName(HostReg reg, OperandSize size = HostPointerSize);
   static void AlignCodeBuffer(JitCodeBuffer* code_buffer);
 
+  /// Logs the number of instructions compiled natively and through the interpreter fallback, per operation.
+  static void LogOperationCounts();
+
   RegisterCache& GetRegisterCache() { return m_register_cache; }
   CodeEmitter& GetCodeEmitter() { return m_emit; }
 
-  bool CompileBlock(const BlockBase* block, BlockFunctionType* out_function_ptr, size_t* out_code_size);
+  bool CompileBlock(const BlockBase* block, BlockFunctionType* out_function_ptr, size_t* out_code_size,
+                    std::vector<BlockLinkSlot>* out_link_slots, std::vector<FastmemAccess>* out_fastmem_accesses);
 
   //////////////////////////////////////////////////////////////////////////
   // Helpers
   //////////////////////////////////////////////////////////////////////////
   bool IsConstantOperand(const Instruction* instruction, size_t index);
+  u32 GetConstantBranchTargets(const Instruction& instruction, std::array<u32, 2>* target_eips) const;
   u32 GetConstantOperand(const Instruction* instruction, size_t index, bool sign_extend);
 
   //////////////////////////////////////////////////////////////////////////
@@ -54,6 +60,7 @@ public:
   //////////////////////////////////////////////////////////////////////////
   void EmitBeginBlock();
   void EmitEndBlock();
+  void EmitBlockLinkSlots(const u32* target_eips, u32 num_targets, std::vector<BlockLinkSlot>* out_link_slots);
   void FinalizeBlock(BlockFunctionType* out_function_ptr, size_t* out_code_size);
 
   void EmitSignExtend(HostReg to_reg, OperandSize to_size, HostReg from_reg, OperandSize from_size);
@@ -61,6 +68,8 @@ public:
   void EmitCopyValue(HostReg to_reg, const Value& value);
   void EmitAdd(HostReg to_reg, const Value& value);
   void EmitSub(HostReg to_reg, const Value& value);
+  void EmitAdc(HostReg to_reg, const Value& value);
+  void EmitSbb(HostReg to_reg, const Value& value);
   void EmitCmp(HostReg to_reg, const Value& value);
   void EmitInc(HostReg to_reg, OperandSize size);
   void EmitDec(HostReg to_reg, OperandSize size);
@@ -72,6 +81,7 @@ public:
   void EmitXor(HostReg to_reg, const Value& value);
   void EmitTest(HostReg to_reg, const Value& value);
   void EmitNot(HostReg to_reg, OperandSize size);
+  void EmitNeg(HostReg to_reg, OperandSize size);
 
   void EmitLoadGuestRegister(HostReg host_reg, OperandSize guest_size, u8 guest_reg);
   void EmitStoreGuestRegister(OperandSize guest_size, u8 guest_reg, const Value& value);
@@ -167,7 +177,34 @@ private:
   Value WriteOperand(const Instruction& instruction, size_t index, Value&& value);
   void LoadSegmentMemory(Value* dest_value, OperandSize size, const Value& address, Segment segment);
   void StoreSegmentMemory(const Value& value, const Value& address, Segment segment);
+#if defined(Y_CPU_X64)
+  /// Emits the access type and limit checks against the segment cache at segcache_offset, for the offset in
+  /// offset_reg. Jumps to slow_path_label if either fails.
+  void EmitSegmentChecks(HostReg offset_reg, HostReg temp_reg, u32 access_size, u32 segcache_offset,
+                         AccessType access, Xbyak::Label& slow_path_label);
+  /// Emits the segment check, TLB probe and RAM page lookup for an access, leaving the host page pointer in
+  /// host_ptr_reg and the page offset in offset_reg. Jumps to slow_path_label if the access can't be done inline.
+  void EmitGuestMemoryFastPath(HostReg host_ptr_reg, HostReg offset_reg, HostReg temp_reg, OperandSize size,
+                               const Value& address, Segment segment, AccessType access,
+                               Xbyak::Label& slow_path_label);
+  /// Pads a fastmem access so it can be backpatched, and records its size. No-op if fastmem is not in use.
+  void EndFastmemAccess(FastmemAccess* access);
+  /// Converts the 80-bit register at address to a double in result. Jumps to slow_path_label unless the value is zero
+  /// or a normal number which is exact in double precision.
+  void EmitX87ExtendedToDouble(const Xbyak::Reg64& result, const Xbyak::RegExp& address, const Xbyak::Reg64& temp1,
+                               const Xbyak::Reg64& temp2, Xbyak::Label& slow_path_label);
+  /// Converts the double in value to an 80-bit fraction and sign/exponent, clobbering value. Jumps to slow_path_label
+  /// unless the value is zero or has a biased exponent within [min_exponent, max_exponent].
+  void EmitX87DoubleToExtended(const Xbyak::Reg64& fraction, const Xbyak::Reg64& exponent, const Xbyak::Reg64& value,
+                               u32 min_exponent, u32 max_exponent, Xbyak::Label& slow_path_label);
+  /// Jumps to slow_path_label unless the double in value is zero or has a biased exponent within
+  /// [min_exponent, max_exponent].
+  void EmitX87CheckDoubleRange(const Xbyak::Reg64& value, const Xbyak::Reg64& temp, u32 min_exponent,
+                               u32 max_exponent, Xbyak::Label& slow_path_label);
+#endif
   void RaiseException(u32 exception, const Value& ec = Value::FromConstantU32(0));
+  /// Runs the instruction through its interpreter handler. Guest registers must already be flushed.
+  void EmitInterpreterCall(const Instruction& instruction);
   void InstructionPrologue(const Instruction& instruction, CycleCount cycles, bool force_sync = false);
   void SyncInstructionPointer();
   void SyncCurrentEIP();
@@ -184,8 +221,19 @@ private:
   //////////////////////////////////////////////////////////////////////////
   // Instruction Code Generators
   //////////////////////////////////////////////////////////////////////////
+  /// Fills m_instruction_info for the block. Without block optimization, every instruction gets conservative info.
+  void AnalyzeBlock();
+  /// Finds the arithmetic flags and guest registers which are live after each instruction.
+  void ComputeLiveness();
+  /// Finds register results which can be computed at compile time, from MOV/LEA/ADD chains on constants.
+  void ComputeConstantResults();
+  /// Finds memory operands whose segment access and limit checks were already done by earlier instructions.
+  void ComputeMemoryChecks();
+  /// Drops cached guest registers which are overwritten before being read again.
+  void DiscardDeadGuestRegisters(u8 live_registers);
   bool CompileInstruction(const Instruction& instruction);
   bool Compile_Fallback(const Instruction& instruction);
+  bool Compile_ConstantResult(const Instruction& instruction, CycleCount cycles);
   bool Compile_NOP(const Instruction& instruction);
   bool Compile_LEA(const Instruction& instruction);
   bool Compile_MOV(const Instruction& instruction);
@@ -209,15 +257,63 @@ private:
   bool Compile_CALL_Near(const Instruction& instruction);
   bool Compile_RET_Near(const Instruction& instruction);
   bool Compile_String(const Instruction& instruction);
+  bool Compile_NEG(const Instruction& instruction);
+  bool Compile_NEG_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_MUL(const Instruction& instruction);
+  bool Compile_MUL_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_IMUL(const Instruction& instruction);
+  bool Compile_IMUL_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_DIV(const Instruction& instruction);
+  bool Compile_DIV_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_MOVX(const Instruction& instruction);
+  bool Compile_XCHG(const Instruction& instruction);
+  bool Compile_CBW(const Instruction& instruction);
+  bool Compile_CWD(const Instruction& instruction);
+  bool Compile_SETcc(const Instruction& instruction);
+  bool Compile_SETcc_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_LOOP(const Instruction& instruction);
+  bool Compile_LOOP_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_BTx(const Instruction& instruction);
+  bool Compile_BTx_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_BSx(const Instruction& instruction);
+  bool Compile_BSx_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_X87(const Instruction& instruction);
+  bool Compile_X87_Impl(const Instruction& instruction, CycleCount cycles);
 
   CPU* m_cpu;
   JitCodeBuffer* m_code_buffer;
   const ASMFunctions& m_asm_functions;
+  void* m_current_block_ptr;
   const BlockBase* m_block = nullptr;
   const Instruction* m_block_start = nullptr;
   const Instruction* m_block_end = nullptr;
   RegisterCache m_register_cache;
   CodeEmitter m_emit;
+  std::vector<FastmemAccess>* m_fastmem_accesses = nullptr;
+
+  // Results of the analysis pass, for each instruction in the block.
+  struct InstructionInfo
+  {
+    u32 live_flags;            // Arithmetic flags read after the instruction, before being overwritten.
+    u32 constant_result;       // Value of the destination register, when has_constant_result is set.
+    u8 live_registers;         // Guest registers (Reg32 mask) read after the instruction, before being overwritten.
+    u8 checked_access_types;   // AccessTypeMask of checks already done on the memory operand's segment.
+    bool limit_checked;        // The memory operand's offset was limit checked by an earlier instruction.
+    bool track_memory_checks;  // All memory accesses are to the memory operand, so checks carry between them.
+    bool has_constant_result;  // The destination register is known at compile time, and no written flags are live.
+    bool flat_segments;        // ES, SS and DS are flat when the instruction starts, see BlockKey::flat_segments.
+    bool sync_eip;             // EIP must be updated before the instruction can fault, not just m_current_EIP.
+  };
+  std::vector<InstructionInfo> m_instruction_info;
+  const InstructionInfo* m_current_instruction_info = nullptr;
+
+  // Arithmetic flags which are read after the current instruction, before being overwritten.
+  static constexpr u32 ALL_ARITHMETIC_FLAGS = Flag_CF | Flag_PF | Flag_AF | Flag_ZF | Flag_SF | Flag_OF;
+  u32 m_live_flags = ALL_ARITHMETIC_FLAGS;
+
+  // Segment checks which have been done for the current instruction's memory operand.
+  u8 m_checked_access_types = 0;
+  bool m_limit_checked = false;
 
   u32 m_delayed_eip_add = 0;
   u32 m_delayed_current_eip_add = 0;
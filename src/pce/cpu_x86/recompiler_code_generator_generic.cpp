@@ -9,6 +9,48 @@ void CodeGenerator::AlignCodeBuffer(JitCodeBuffer* code_buffer) {}
 
 #if !defined(Y_CPU_X64)
 
+void CodeGenerator::LoadSegmentMemory(Value* dest_value, OperandSize size, const Value& address, Segment segment)
+{
+  DebugAssert(address.size == OperandSize_32);
+  switch (size)
+  {
+    case OperandSize_8:
+      EmitFunctionCall(dest_value, m_asm_functions.read_memory_byte, Value::FromConstantU8(segment), address);
+      break;
+    case OperandSize_16:
+      EmitFunctionCall(dest_value, m_asm_functions.read_memory_word, Value::FromConstantU8(segment), address);
+      break;
+    case OperandSize_32:
+      EmitFunctionCall(dest_value, m_asm_functions.read_memory_dword, Value::FromConstantU8(segment), address);
+      break;
+    default:
+      break;
+  }
+}
+
+void CodeGenerator::StoreSegmentMemory(const Value& value, const Value& address, Segment segment)
+{
+  DebugAssert(address.size == OperandSize_32);
+  switch (value.size)
+  {
+    case OperandSize_8:
+      EmitFunctionCall(nullptr, m_asm_functions.write_memory_byte, Value::FromConstantU8(segment), address, value);
+      break;
+    case OperandSize_16:
+      EmitFunctionCall(nullptr, m_asm_functions.write_memory_word, Value::FromConstantU8(segment), address, value);
+      break;
+    case OperandSize_32:
+      EmitFunctionCall(nullptr, m_asm_functions.write_memory_dword, Value::FromConstantU8(segment), address, value);
+      break;
+    default:
+      break;
+  }
+}
+
+#endif
+
+#if !defined(Y_CPU_X64)
+
 bool CodeGenerator::Compile_Bitwise_Impl(const Instruction& instruction, CycleCount cycles)
 {
   CycleCount cycles = 0;
@@ -122,4 +164,53 @@ bool CodeGenerator::Compile_Jcc(const Instruction& instruction, CycleCount cycle
 
 #endif
 
+#if !defined(Y_CPU_X64)
+
+bool CodeGenerator::Compile_NEG_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_MUL_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_IMUL_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_DIV_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_SETcc_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_LOOP_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_BTx_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_BSx_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_X87_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+#endif
+
 } // namespace CPU_X86::Recompiler
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include "../bus.h"
 #include "interpreter.h"
 #include "recompiler_code_generator.h"
 #include "recompiler_thunks.h"
@@ -152,6 +153,21 @@ void CodeGenerator::EmitBeginBlock()
   // Copy {EIP,ESP} to m_current_{EIP,ESP}
   SyncCurrentEIP();
   SyncCurrentESP();
+
+  // Blocks can be entered without going through the dispatcher, so the stats have to be updated here.
+  EmitAddCPUStructField(offsetof(CPU, m_execution_stats.code_cache_blocks_executed), Value::FromConstantU64(1));
+  EmitAddCPUStructField(offsetof(CPU, m_execution_stats.code_cache_instructions_executed),
+                        Value::FromConstantU64(m_block->instructions.size()));
+
+  // Block profiler. Cycles are charged from the block's static count, exits part-way through aren't accounted for.
+  if (m_block->profile)
+  {
+    Value temp = m_register_cache.AllocateScratch(OperandSize_64);
+    m_emit.mov(GetHostReg64(temp), reinterpret_cast<size_t>(m_block->profile));
+    m_emit.inc(m_emit.qword[GetHostReg64(temp) + offsetof(BlockProfile, execution_count)]);
+    m_emit.add(m_emit.qword[GetHostReg64(temp) + offsetof(BlockProfile, cycles)],
+               static_cast<u32>(m_block->total_cycles));
+  }
 }
 
 void CodeGenerator::EmitEndBlock()
@@ -162,6 +178,59 @@ void CodeGenerator::EmitEndBlock()
   m_emit.ret();
 }
 
+void CodeGenerator::EmitBlockLinkSlots(const u32* target_eips, u32 num_targets,
+                                       std::vector<BlockLinkSlot>* out_link_slots)
+{
+  Xbyak::Label no_link_label;
+
+  // Return to the dispatcher if events are due.
+  m_emit.mov(m_emit.rax, m_emit.qword[GetCPUPtrReg() + offsetof(CPU, m_pending_cycles)]);
+  m_emit.cmp(m_emit.rax, m_emit.qword[GetCPUPtrReg() + offsetof(CPU, m_execution_downcount)]);
+  m_emit.jge(no_link_label);
+
+  // Same for a pending interrupt (IF set and IRQ line high), or the trap flag.
+  static_assert(Flag_IF == (1u << 9), "IF is bit 9");
+  m_emit.movzx(m_emit.eax, m_emit.byte[GetCPUPtrReg() + offsetof(CPU, m_irq_state)]);
+  m_emit.shl(m_emit.eax, 9);
+  m_emit.or_(m_emit.eax, Flag_TF);
+  m_emit.test(m_emit.dword[GetCPUPtrReg() + offsetof(CPU, m_registers.EFLAGS.bits)], m_emit.eax);
+  m_emit.jnz(no_link_label);
+
+  m_emit.mov(m_emit.eax, m_emit.dword[GetCPUPtrReg() + offsetof(CPU, m_registers.EIP)]);
+  for (u32 i = 0; i < num_targets; i++)
+  {
+    Xbyak::Label next_label;
+    m_emit.cmp(m_emit.eax, target_eips[i]);
+    m_emit.jne(next_label);
+
+    BlockLinkSlot slot = {};
+    slot.target_eip = target_eips[i];
+
+    // mov rcx, imm64 - the block which is executing after the jump, this block when unlinked.
+    // Encoded manually so the immediate is always 64-bit and can be patched.
+    m_emit.db(0x48);
+    m_emit.db(0xB9);
+    slot.block_pointer_offset = static_cast<u32>(m_emit.getSize());
+    m_emit.dq(reinterpret_cast<u64>(m_block));
+    m_emit.mov(m_emit.rax, reinterpret_cast<u64>(m_current_block_ptr));
+    m_emit.mov(m_emit.qword[m_emit.rax], m_emit.rcx);
+
+    // Restore the callee-saved registers and tail-call the linked block, which expects the CPU pointer in the first
+    // argument register. Unlinked jumps have a zero displacement, which falls through to the return.
+    m_emit.mov(GetHostReg64(RARG1), GetCPUPtrReg());
+    m_register_cache.PopCalleeSavedRegisters(false);
+    m_emit.db(0xE9);
+    slot.jump_offset = static_cast<u32>(m_emit.getSize());
+    m_emit.dd(0);
+    m_emit.ret();
+
+    out_link_slots->push_back(slot);
+    m_emit.L(next_label);
+  }
+
+  m_emit.L(no_link_label);
+}
+
 void CodeGenerator::FinalizeBlock(BlockFunctionType* out_function_ptr, size_t* out_code_size)
 {
   m_emit.ready();
@@ -406,6 +475,84 @@ void CodeGenerator::EmitSub(HostReg to_reg, const Value& value)
   }
 }
 
+void CodeGenerator::EmitAdc(HostReg to_reg, const Value& value)
+{
+  DebugAssert(value.IsConstant() || value.IsInHostRegister());
+
+  switch (value.size)
+  {
+    case OperandSize_8:
+    {
+      if (value.IsConstant())
+        m_emit.adc(GetHostReg8(to_reg), SignExtend32(Truncate8(value.constant_value)));
+      else
+        m_emit.adc(GetHostReg8(to_reg), GetHostReg8(value.host_reg));
+    }
+    break;
+
+    case OperandSize_16:
+    {
+      if (value.IsConstant())
+        m_emit.adc(GetHostReg16(to_reg), SignExtend32(Truncate16(value.constant_value)));
+      else
+        m_emit.adc(GetHostReg16(to_reg), GetHostReg16(value.host_reg));
+    }
+    break;
+
+    case OperandSize_32:
+    {
+      if (value.IsConstant())
+        m_emit.adc(GetHostReg32(to_reg), Truncate32(value.constant_value));
+      else
+        m_emit.adc(GetHostReg32(to_reg), GetHostReg32(value.host_reg));
+    }
+    break;
+
+    default:
+      UnreachableCode();
+      break;
+  }
+}
+
+void CodeGenerator::EmitSbb(HostReg to_reg, const Value& value)
+{
+  DebugAssert(value.IsConstant() || value.IsInHostRegister());
+
+  switch (value.size)
+  {
+    case OperandSize_8:
+    {
+      if (value.IsConstant())
+        m_emit.sbb(GetHostReg8(to_reg), SignExtend32(Truncate8(value.constant_value)));
+      else
+        m_emit.sbb(GetHostReg8(to_reg), GetHostReg8(value.host_reg));
+    }
+    break;
+
+    case OperandSize_16:
+    {
+      if (value.IsConstant())
+        m_emit.sbb(GetHostReg16(to_reg), SignExtend32(Truncate16(value.constant_value)));
+      else
+        m_emit.sbb(GetHostReg16(to_reg), GetHostReg16(value.host_reg));
+    }
+    break;
+
+    case OperandSize_32:
+    {
+      if (value.IsConstant())
+        m_emit.sbb(GetHostReg32(to_reg), Truncate32(value.constant_value));
+      else
+        m_emit.sbb(GetHostReg32(to_reg), GetHostReg32(value.host_reg));
+    }
+    break;
+
+    default:
+      UnreachableCode();
+      break;
+  }
+}
+
 void CodeGenerator::EmitCmp(HostReg to_reg, const Value& value)
 {
   DebugAssert(value.IsConstant() || value.IsInHostRegister());
@@ -918,6 +1065,31 @@ void CodeGenerator::EmitNot(HostReg to_reg, OperandSize size)
   }
 }
 
+void CodeGenerator::EmitNeg(HostReg to_reg, OperandSize size)
+{
+  switch (size)
+  {
+    case OperandSize_8:
+      m_emit.neg(GetHostReg8(to_reg));
+      break;
+
+    case OperandSize_16:
+      m_emit.neg(GetHostReg16(to_reg));
+      break;
+
+    case OperandSize_32:
+      m_emit.neg(GetHostReg32(to_reg));
+      break;
+
+    case OperandSize_64:
+      m_emit.neg(GetHostReg64(to_reg));
+      break;
+
+    default:
+      break;
+  }
+}
+
 u32 CodeGenerator::PrepareStackForCall()
 {
   // we assume that the stack is unaligned at this point
@@ -1117,6 +1289,11 @@ void CodeGenerator::ReadFlagsFromHost(Value* value)
 {
   // this is a 64-bit push/pop, we ignore the upper 32 bits
   DebugAssert(value->IsInHostRegister());
+
+  // UpdateEFLAGS() will discard the value if none of the flags are live.
+  if ((m_live_flags & ALL_ARITHMETIC_FLAGS) == 0)
+    return;
+
   m_emit.pushf();
   m_emit.pop(GetHostReg64(value->host_reg));
 }
@@ -1685,16 +1862,28 @@ bool CodeGenerator::Compile_AddSub_Impl(const Instruction& instruction, CycleCou
   Value lhs = ReadOperand(instruction, 0, size, false, true);
   Value rhs = ReadOperand(instruction, 1, size, true, false);
 
+  // ADC/SBB need the guest carry flag in the host flags, nothing can touch them between here and the operation.
+  if (instruction.operation == Operation_ADC || instruction.operation == Operation_SBB)
+    CopyGuestFlagsToHostFlags(Flag_CF);
+
   switch (instruction.operation)
   {
     case Operation_ADD:
       EmitAdd(lhs.GetHostRegister(), rhs);
       break;
 
+    case Operation_ADC:
+      EmitAdc(lhs.GetHostRegister(), rhs);
+      break;
+
     case Operation_SUB:
       EmitSub(lhs.GetHostRegister(), rhs);
       break;
 
+    case Operation_SBB:
+      EmitSbb(lhs.GetHostRegister(), rhs);
+      break;
+
     case Operation_CMP:
       EmitCmp(lhs.GetHostRegister(), rhs);
       break;
@@ -1735,138 +1924,69 @@ bool CodeGenerator::Compile_IncDec_Impl(const Instruction& instruction, CycleCou
   return true;
 }
 
-bool CodeGenerator::Compile_String(const Instruction& instruction)
+bool CodeGenerator::Compile_NEG_Impl(const Instruction& instruction, CycleCount cycles)
 {
-  const CycleCount cycles_base = m_cpu->GetCycles(instruction.IsRep() ? CYCLES_REP_MOVS_BASE : CYCLES_MOVS);
-  const CycleCount cycles_n = m_cpu->GetCycles(CYCLES_REP_MOVS_N) + 1;
-  const u32 data_size = GetOperandSizeInBytes(instruction.operands[0].size);
-  const OperandSize reg_address_size =
-    ((instruction.GetAddressSize() == AddressSize_32) ? OperandSize_32 : OperandSize_16);
-  const bool is_rep = instruction.IsRep();
-  const bool is_32bit = (instruction.GetAddressSize() == AddressSize_32);
-  const bool needs_eax = (instruction.operation == Operation_LODS || instruction.operation == Operation_STOS ||
-                          instruction.operation == Operation_SCAS);
-  const bool needs_esi = (instruction.operation == Operation_MOVS || instruction.operation == Operation_CMPS ||
-                          instruction.operation == Operation_LODS);
-  const bool needs_edi = (instruction.operation == Operation_MOVS || instruction.operation == Operation_CMPS ||
-                          instruction.operation == Operation_STOS || instruction.operation == Operation_SCAS);
-  const bool needs_lhs = (instruction.operation == Operation_MOVS || instruction.operation == Operation_CMPS);
-  const bool needs_rhs = (instruction.operation == Operation_CMPS);
-
-  InstructionPrologue(instruction, cycles_base, true);
-
-  // work out the increment (positive or negative)
-  Value increment = m_register_cache.AllocateScratch(reg_address_size);
-  {
-    Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);
-    Value increment_temp = m_register_cache.AllocateScratch(reg_address_size);
-    if (is_32bit)
-    {
-      EmitCopyValue(increment.GetHostRegister(), Value::FromConstantU32(data_size));
-      EmitCopyValue(increment_temp.GetHostRegister(), Value::FromConstantU32(u32(-s32(data_size))));
-      m_emit.test(GetHostReg32(eflags), Flag_DF);
-      m_emit.cmovnz(GetHostReg32(increment), GetHostReg32(increment_temp));
-    }
-    else
-    {
-      EmitCopyValue(increment.GetHostRegister(), Value::FromConstantU16(u16(data_size)));
-      EmitCopyValue(increment_temp.GetHostRegister(), Value::FromConstantU16(u16(-s16(data_size))));
-      m_emit.test(GetHostReg32(eflags), Flag_DF);
-      m_emit.cmovnz(GetHostReg16(increment), GetHostReg16(increment_temp));
-    }
-  }
-
-  // temporary for the value read, and zero-extended address (if in 16-bit mode)
-  Value lhs;
-  Value rhs;
-  Value address;
-  Value eax;
-  Value ecx;
-  Value esi;
-  Value edi;
-  if (!is_32bit)
-    address = m_register_cache.AllocateScratch(OperandSize_32);
-  if (needs_lhs)
-    lhs = m_register_cache.AllocateScratch(instruction.operands[0].size);
-  if (needs_rhs)
-    rhs = m_register_cache.AllocateScratch(instruction.operands[0].size);
-  if (needs_eax)
-    eax = m_register_cache.ReadGuestRegister(instruction.operands[0].size, Reg32_EAX, true, true);
-  if (needs_esi)
-    esi = m_register_cache.ReadGuestRegister(reg_address_size, Reg32_ESI, true, true);
-  if (needs_edi)
-    edi = m_register_cache.ReadGuestRegister(reg_address_size, Reg32_EDI, true, true);
-  if (is_rep)
-    ecx = m_register_cache.ReadGuestRegister(reg_address_size, Reg32_ECX, true, true);
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
 
-  // everything should be in the register cache still
-  Assert((!needs_eax || m_register_cache.IsGuestRegisterInHostReg(instruction.operands[0].size, Reg32_EAX)) &&
-         (!needs_esi || m_register_cache.IsGuestRegisterInHostReg(reg_address_size, Reg32_ESI)) &&
-         (!needs_edi || m_register_cache.IsGuestRegisterInHostReg(reg_address_size, Reg32_EDI)) &&
-         (!is_rep || m_register_cache.IsGuestRegisterInHostReg(reg_address_size, Reg32_ECX)));
+  Value val = ReadOperand(instruction, 0, instruction.operands[0].size, false, true);
+  EmitNeg(val.GetHostRegister(), val.size);
 
-  Xbyak::Label rep_label;
-  Xbyak::Label done_label;
-  if (is_rep)
-  {
-    m_emit.L(rep_label);
+  Value host_flags = ReadFlagsFromHost();
+  WriteOperand(instruction, 0, std::move(val));
 
-    // add n cycles
-    EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(cycles_n));
+  const u32 eflags_mask = Flag_OF | Flag_CF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF;
+  UpdateEFLAGS(std::move(host_flags), 0, eflags_mask, 0);
+  return true;
+}
 
-    // compare ecx against zero
-    EmitTest(ecx.GetHostRegister(), ecx);
-    m_emit.jz(done_label);
-  }
+bool CodeGenerator::Compile_MUL_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  constexpr auto rax = Xbyak::Operand::RAX;
+  constexpr auto rdx = Xbyak::Operand::RDX;
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
 
-  switch (instruction.operation)
+  // memory operands are read through a call, which would trash rax/rdx, so this has to come first
+  const OperandSize size = instruction.operands[0].size;
+  Value multiplier = ReadOperand(instruction, 0, size, false, true);
+
+  // 8-bit multiplies produce the whole result in ax, larger sizes use dx:ax/edx:eax
+  m_register_cache.EnsureHostRegFree(rax);
+  m_register_cache.EnsureHostRegFree(rdx);
+  Value result_low = m_register_cache.AllocateScratch((size == OperandSize_8) ? OperandSize_16 : size, rax);
+  Value result_high;
+  if (size != OperandSize_8)
+    result_high = m_register_cache.AllocateScratch(size, rdx);
+  EmitCopyValue(rax, m_register_cache.ReadGuestRegister(size, Reg32_EAX));
+
+  const bool is_signed = (instruction.operation == Operation_IMUL);
+  switch (size)
   {
-    case Operation_MOVS:
+    case OperandSize_8:
     {
-      // read from esi, write to es:edi
-      if (is_32bit)
-      {
-        LoadSegmentMemory(&lhs, lhs.size, esi, instruction.GetMemorySegment());
-        StoreSegmentMemory(lhs, edi, Segment_ES);
-      }
+      if (is_signed)
+        m_emit.imul(GetHostReg8(multiplier));
       else
-      {
-        EmitZeroExtend(address.GetHostRegister(), OperandSize_32, esi.GetHostRegister(), OperandSize_16);
-        LoadSegmentMemory(&lhs, lhs.size, address, instruction.GetMemorySegment());
-        EmitZeroExtend(address.GetHostRegister(), OperandSize_32, edi.GetHostRegister(), OperandSize_16);
-        StoreSegmentMemory(lhs, address, Segment_ES);
-      }
+        m_emit.mul(GetHostReg8(multiplier));
     }
     break;
 
-    case Operation_LODS:
+    case OperandSize_16:
     {
-      // read from esi, write to (e)ax
-      if (is_32bit)
-      {
-        LoadSegmentMemory(&eax, eax.size, esi, instruction.GetMemorySegment());
-      }
+      if (is_signed)
+        m_emit.imul(GetHostReg16(multiplier));
       else
-      {
-        EmitZeroExtend(address.GetHostRegister(), OperandSize_32, esi.GetHostRegister(), OperandSize_16);
-        LoadSegmentMemory(&eax, eax.size, address, instruction.GetMemorySegment());
-      }
-      eax = m_register_cache.WriteGuestRegister(eax.size, Reg32_EAX, std::move(eax));
+        m_emit.mul(GetHostReg16(multiplier));
     }
     break;
 
-    case Operation_STOS:
+    case OperandSize_32:
     {
-      // read from (e)ax, write to [es:edi]
-      if (is_32bit)
-      {
-        StoreSegmentMemory(eax, edi, Segment_ES);
-      }
+      if (is_signed)
+        m_emit.imul(GetHostReg32(multiplier));
       else
-      {
-        EmitZeroExtend(address.GetHostRegister(), OperandSize_32, edi.GetHostRegister(), OperandSize_16);
-        StoreSegmentMemory(eax, address, Segment_ES);
-      }
+        m_emit.mul(GetHostReg32(multiplier));
     }
     break;
 
@@ -1875,23 +1995,1240 @@ bool CodeGenerator::Compile_String(const Instruction& instruction)
       break;
   }
 
-  // increment edi/esi
-  if (needs_esi)
+  // CF/OF come from the multiply, SF/ZF/PF are computed from the low half of the result
+  Value host_flags = ReadFlagsFromHost();
+  switch (size)
   {
-    EmitAdd(esi.GetHostRegister(), increment);
-    esi = m_register_cache.WriteGuestRegister(reg_address_size, Reg32_ESI, std::move(esi));
+    case OperandSize_8:
+      m_emit.test(m_emit.al, m_emit.al);
+      break;
+    case OperandSize_16:
+      m_emit.test(m_emit.ax, m_emit.ax);
+      break;
+    case OperandSize_32:
+      m_emit.test(m_emit.eax, m_emit.eax);
+      break;
+    default:
+      break;
   }
-  if (needs_edi)
+  Value result_flags = ReadFlagsFromHost();
+
+  // move the results out of rax/rdx, they can't be bound to guest registers
+  Value low = m_register_cache.AllocateScratch(result_low.size);
+  EmitCopyValue(low.GetHostRegister(), result_low);
+  result_low.ReleaseAndClear();
+  if (size == OperandSize_8)
   {
-    EmitAdd(edi.GetHostRegister(), increment);
-    edi = m_register_cache.WriteGuestRegister(reg_address_size, Reg32_EDI, std::move(edi));
+    m_register_cache.WriteGuestRegister(Reg16_AX, std::move(low));
   }
-
-  if (is_rep)
+  else
   {
-    // reduce ecx
-    EmitDec(ecx.GetHostRegister(), ecx.size);
-    ecx = m_register_cache.WriteGuestRegister(reg_address_size, Reg32_ECX, std::move(ecx));
+    Value high = m_register_cache.AllocateScratch(size);
+    EmitCopyValue(high.GetHostRegister(), result_high);
+    result_high.ReleaseAndClear();
+    m_register_cache.WriteGuestRegister(size, Reg32_EAX, std::move(low));
+    m_register_cache.WriteGuestRegister(size, Reg32_EDX, std::move(high));
+  }
+
+  UpdateEFLAGS(std::move(host_flags), 0, Flag_CF | Flag_OF, 0);
+  UpdateEFLAGS(std::move(result_flags), 0, Flag_SF | Flag_ZF | Flag_PF, 0);
+  return true;
+}
+
+bool CodeGenerator::Compile_IMUL_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  const OperandSize size = instruction.operands[0].size;
+  Value result;
+  if (instruction.operands[2].mode != OperandMode_None)
+  {
+    // three-operand form, reg <- rm * imm
+    Value lhs = ReadOperand(instruction, 1, size, false, true);
+    Value rhs = ReadOperand(instruction, 2, size, true, false);
+    DebugAssert(rhs.IsConstant());
+    result = m_register_cache.AllocateScratch(size);
+    if (size == OperandSize_16)
+    {
+      m_emit.imul(GetHostReg16(result), GetHostReg16(lhs), static_cast<s16>(Truncate16(rhs.constant_value)));
+    }
+    else
+    {
+      m_emit.imul(GetHostReg32(result), GetHostReg32(lhs), static_cast<s32>(Truncate32(rhs.constant_value)));
+    }
+  }
+  else
+  {
+    // two-operand form, reg <- reg * rm
+    Value lhs = ReadOperand(instruction, 0, size, false, false);
+    Value rhs = ReadOperand(instruction, 1, size, false, true);
+    result = m_register_cache.AllocateScratch(size);
+    EmitCopyValue(result.GetHostRegister(), lhs);
+    if (size == OperandSize_16)
+      m_emit.imul(GetHostReg16(result), GetHostReg16(rhs));
+    else
+      m_emit.imul(GetHostReg32(result), GetHostReg32(rhs));
+  }
+
+  // CF/OF come from the multiply, SF/ZF/PF are computed from the truncated result
+  Value host_flags = ReadFlagsFromHost();
+  EmitTest(result.GetHostRegister(), result);
+  Value result_flags = ReadFlagsFromHost();
+
+  WriteOperand(instruction, 0, std::move(result));
+
+  UpdateEFLAGS(std::move(host_flags), 0, Flag_CF | Flag_OF, 0);
+  UpdateEFLAGS(std::move(result_flags), 0, Flag_SF | Flag_ZF | Flag_PF, 0);
+  return true;
+}
+
+bool CodeGenerator::Compile_DIV_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  constexpr auto rax = Xbyak::Operand::RAX;
+  constexpr auto rdx = Xbyak::Operand::RDX;
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  // memory operands are read through a call, which would trash rax/rdx, so this has to come first
+  const OperandSize size = instruction.operands[0].size;
+  Value divisor = ReadOperand(instruction, 0, size, false, true);
+
+  // 8-bit divides take the dividend from ax, larger sizes use dx:ax/edx:eax
+  m_register_cache.EnsureHostRegFree(rax);
+  m_register_cache.EnsureHostRegFree(rdx);
+  Value result_low = m_register_cache.AllocateScratch((size == OperandSize_8) ? OperandSize_16 : size, rax);
+  Value result_high;
+  Value check;
+  if (size != OperandSize_8)
+  {
+    result_high = m_register_cache.AllocateScratch(size, rdx);
+    EmitCopyValue(rax, m_register_cache.ReadGuestRegister(size, Reg32_EAX));
+    EmitCopyValue(rdx, m_register_cache.ReadGuestRegister(size, Reg32_EDX));
+  }
+  else
+  {
+    check = m_register_cache.AllocateScratch(OperandSize_32);
+    EmitCopyValue(rax, m_register_cache.ReadGuestRegister(Reg16_AX));
+  }
+
+  // A zero divisor or a quotient which doesn't fit are both caught by the upper half of the dividend not being
+  // below the divisor. For 8-bit, compare ax against the divisor shifted into the upper byte instead of using ah.
+  Xbyak::Label no_exception_label;
+  switch (size)
+  {
+    case OperandSize_8:
+      m_emit.movzx(GetHostReg32(check), GetHostReg8(divisor));
+      m_emit.shl(GetHostReg32(check), 8);
+      m_emit.cmp(m_emit.ax, GetHostReg16(check));
+      break;
+    case OperandSize_16:
+      m_emit.cmp(m_emit.dx, GetHostReg16(divisor));
+      break;
+    case OperandSize_32:
+      m_emit.cmp(m_emit.edx, GetHostReg32(divisor));
+      break;
+    default:
+      UnreachableCode();
+      break;
+  }
+  m_emit.jb(no_exception_label);
+
+  // RaiseException() does not return to the block.
+  RaiseException(Interrupt_DivideError);
+  m_emit.L(no_exception_label);
+
+  switch (size)
+  {
+    case OperandSize_8:
+      m_emit.div(GetHostReg8(divisor));
+      break;
+    case OperandSize_16:
+      m_emit.div(GetHostReg16(divisor));
+      break;
+    case OperandSize_32:
+      m_emit.div(GetHostReg32(divisor));
+      break;
+    default:
+      break;
+  }
+
+  // move the results out of rax/rdx, they can't be bound to guest registers
+  Value quotient = m_register_cache.AllocateScratch(result_low.size);
+  EmitCopyValue(quotient.GetHostRegister(), result_low);
+  result_low.ReleaseAndClear();
+  if (size == OperandSize_8)
+  {
+    // al = quotient, ah = remainder
+    m_register_cache.WriteGuestRegister(Reg16_AX, std::move(quotient));
+  }
+  else
+  {
+    Value remainder = m_register_cache.AllocateScratch(size);
+    EmitCopyValue(remainder.GetHostRegister(), result_high);
+    result_high.ReleaseAndClear();
+    m_register_cache.WriteGuestRegister(size, Reg32_EAX, std::move(quotient));
+    m_register_cache.WriteGuestRegister(size, Reg32_EDX, std::move(remainder));
+  }
+
+  return true;
+}
+
+bool CodeGenerator::Compile_SETcc_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  Value value = m_register_cache.AllocateScratch(OperandSize_8);
+  const Xbyak::Reg8 value_reg = GetHostReg8(value);
+
+  switch (instruction.operands[0].jump_condition)
+  {
+#define FLAG_SET(cc, flag)                                                                                             \
+  case (cc):                                                                                                           \
+  {                                                                                                                    \
+    Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);                                       \
+    m_emit.test(GetHostReg32(eflags), (flag));                                                                         \
+    m_emit.setnz(value_reg);                                                                                           \
+  }                                                                                                                    \
+  break;
+
+#define FLAG_NOT_SET(cc, flag)                                                                                         \
+  case (cc):                                                                                                           \
+  {                                                                                                                    \
+    Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);                                       \
+    m_emit.test(GetHostReg32(eflags), (flag));                                                                         \
+    m_emit.setz(value_reg);                                                                                            \
+  }                                                                                                                    \
+  break;
+
+    FLAG_SET(JumpCondition_Overflow, Flag_OF);
+    FLAG_NOT_SET(JumpCondition_NotOverflow, Flag_OF);
+    FLAG_SET(JumpCondition_Sign, Flag_SF);
+    FLAG_NOT_SET(JumpCondition_NotSign, Flag_SF);
+    FLAG_SET(JumpCondition_Equal, Flag_ZF);
+    FLAG_NOT_SET(JumpCondition_NotEqual, Flag_ZF);
+    FLAG_SET(JumpCondition_Below, Flag_CF);
+    FLAG_NOT_SET(JumpCondition_AboveOrEqual, Flag_CF);
+    FLAG_SET(JumpCondition_Parity, Flag_PF);
+    FLAG_NOT_SET(JumpCondition_NotParity, Flag_PF);
+
+#undef FLAG_SET
+#undef FLAG_NOT_SET
+
+    case JumpCondition_BelowOrEqual:
+      CopyGuestFlagsToHostFlags(Flag_CF | Flag_ZF);
+      m_emit.setbe(value_reg);
+      break;
+
+    case JumpCondition_Above:
+      CopyGuestFlagsToHostFlags(Flag_CF | Flag_ZF);
+      m_emit.seta(value_reg);
+      break;
+
+    case JumpCondition_Less:
+      CopyGuestFlagsToHostFlags(Flag_SF | Flag_OF);
+      m_emit.setl(value_reg);
+      break;
+
+    case JumpCondition_GreaterOrEqual:
+      CopyGuestFlagsToHostFlags(Flag_SF | Flag_OF);
+      m_emit.setge(value_reg);
+      break;
+
+    case JumpCondition_LessOrEqual:
+      CopyGuestFlagsToHostFlags(Flag_ZF | Flag_SF | Flag_OF);
+      m_emit.setle(value_reg);
+      break;
+
+    case JumpCondition_Greater:
+      CopyGuestFlagsToHostFlags(Flag_ZF | Flag_SF | Flag_OF);
+      m_emit.setg(value_reg);
+      break;
+
+    default:
+      Panic("Unhandled condition");
+      break;
+  }
+
+  WriteOperand(instruction, 1, std::move(value));
+  return true;
+}
+
+bool CodeGenerator::Compile_LOOP_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  InstructionPrologue(instruction, cycles, true);
+  CalculateEffectiveAddress(instruction);
+  Value target = CalculateJumpTarget(instruction, 1);
+
+  // read the flags before the first branch, so they're cached on both paths
+  const JumpCondition condition = instruction.operands[0].jump_condition;
+  Value eflags;
+  if (condition != JumpCondition_Always)
+    eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);
+
+  // the counter is cx or ecx depending on the address size, and the decrement doesn't affect the guest flags
+  const OperandSize count_size = instruction.Is32BitAddressSize() ? OperandSize_32 : OperandSize_16;
+  Value count = m_register_cache.ReadGuestRegister(count_size, Reg32_ECX, true, true);
+  EmitDec(count.GetHostRegister(), count_size);
+  count = m_register_cache.WriteGuestRegister(count_size, Reg32_ECX, std::move(count));
+
+  Xbyak::Label done_label;
+  EmitTest(count.GetHostRegister(), count);
+  m_emit.jz(done_label);
+  if (condition == JumpCondition_Equal)
+  {
+    m_emit.test(GetHostReg32(eflags), Flag_ZF);
+    m_emit.jz(done_label);
+  }
+  else if (condition == JumpCondition_NotEqual)
+  {
+    m_emit.test(GetHostReg32(eflags), Flag_ZF);
+    m_emit.jnz(done_label);
+  }
+
+  EmitFunctionCall(nullptr, static_cast<void (*)(CPU*, u32)>(&CPU::BranchTo), m_register_cache.GetCPUPtr(), target);
+  m_emit.L(done_label);
+  return true;
+}
+
+bool CodeGenerator::Compile_BTx_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  // With a memory destination, bit offsets past the operand size address memory relative to the effective address.
+  // Leave these to the interpreter, which is always the case for register offsets.
+  const OperandSize size = instruction.operands[0].size;
+  const u32 bit_mask = (size == OperandSize_16) ? 0x0F : 0x1F;
+  if (!instruction.ModRM_RM_IsReg() && (instruction.operands[1].mode != OperandMode_Immediate ||
+                                        (GetConstantOperand(&instruction, 1, false) & ~bit_mask) != 0))
+  {
+    return false;
+  }
+
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  Value value = ReadOperand(instruction, 0, size, false, true);
+  Value bit = ReadOperand(instruction, 1, size, false, false);
+  const Xbyak::Reg value_reg =
+    (size == OperandSize_16) ? Xbyak::Reg(GetHostReg16(value)) : Xbyak::Reg(GetHostReg32(value));
+
+#define EMIT_BTx(op)                                                                                                   \
+  if (bit.IsConstant())                                                                                                \
+    m_emit.op(value_reg, Truncate8(bit.constant_value & bit_mask));                                                    \
+  else if (size == OperandSize_16)                                                                                     \
+    m_emit.op(value_reg, GetHostReg16(bit));                                                                           \
+  else                                                                                                                 \
+    m_emit.op(value_reg, GetHostReg32(bit));
+
+  switch (instruction.operation)
+  {
+    case Operation_BT:
+      EMIT_BTx(bt);
+      break;
+    case Operation_BTS:
+      EMIT_BTx(bts);
+      break;
+    case Operation_BTR:
+      EMIT_BTx(btr);
+      break;
+    case Operation_BTC:
+      EMIT_BTx(btc);
+      break;
+    default:
+      UnreachableCode();
+      break;
+  }
+
+#undef EMIT_BTx
+
+  Value host_flags = ReadFlagsFromHost();
+  if (instruction.operation != Operation_BT)
+    WriteOperand(instruction, 0, std::move(value));
+
+  UpdateEFLAGS(std::move(host_flags), 0, Flag_CF, 0);
+  return true;
+}
+
+bool CodeGenerator::Compile_BSx_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  const OperandSize size = instruction.operands[0].size;
+  Value source = ReadOperand(instruction, 1, size, false, true);
+  Value dest = ReadOperand(instruction, 0, size, false, true);
+  Value result = m_register_cache.AllocateScratch(size);
+  Value host_flags = m_register_cache.AllocateScratch(OperandSize_32);
+
+  const bool is_bsf = (instruction.operation == Operation_BSF);
+  if (size == OperandSize_16)
+  {
+    if (is_bsf)
+      m_emit.bsf(GetHostReg16(result), GetHostReg16(source));
+    else
+      m_emit.bsr(GetHostReg16(result), GetHostReg16(source));
+  }
+  else
+  {
+    if (is_bsf)
+      m_emit.bsf(GetHostReg32(result), GetHostReg32(source));
+    else
+      m_emit.bsr(GetHostReg32(result), GetHostReg32(source));
+  }
+
+  // the destination is left unchanged when the source is zero
+  ReadFlagsFromHost(&host_flags);
+  if (size == OperandSize_16)
+    m_emit.cmovnz(GetHostReg16(dest), GetHostReg16(result));
+  else
+    m_emit.cmovnz(GetHostReg32(dest), GetHostReg32(result));
+
+  WriteOperand(instruction, 0, std::move(dest));
+  UpdateEFLAGS(std::move(host_flags), 0, Flag_ZF, 0);
+  return true;
+}
+
+// x87 values are converted to host doubles on the native path. Zeros and normals with no more than 53 significant bits
+// and an exponent in the double range convert exactly, everything else goes through the interpreter.
+static constexpr u32 X87_EXPONENT_BIAS_ADJUST = 16383 - 1023;
+static constexpr u32 X87_SINGLE_MIN_EXPONENT = 1023 - 126;
+static constexpr u32 X87_SINGLE_MAX_EXPONENT = 1023 + 127;
+static constexpr u32 X87_DOUBLE_MIN_EXPONENT = 1;
+static constexpr u32 X87_DOUBLE_MAX_EXPONENT = 0x7FE;
+
+void CodeGenerator::EmitX87ExtendedToDouble(const Xbyak::Reg64& result, const Xbyak::RegExp& address,
+                                            const Xbyak::Reg64& temp1, const Xbyak::Reg64& temp2,
+                                            Xbyak::Label& slow_path_label)
+{
+  Xbyak::Label zero_label, done_label;
+  m_emit.mov(result, m_emit.qword[address]);
+  m_emit.movzx(temp1.cvt32(), m_emit.word[address + 8]);
+  m_emit.mov(temp2.cvt32(), temp1.cvt32());
+  m_emit.and_(temp1.cvt32(), 0x8000);
+  m_emit.shl(temp1, 48);
+  m_emit.and_(temp2.cvt32(), 0x7FFF);
+  m_emit.jz(zero_label);
+
+  // the explicit integer bit must be set, and the fraction bits below double precision clear
+  m_emit.bt(result, 63);
+  m_emit.jnc(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.test(result, 0x7FF);
+  m_emit.jnz(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.sub(temp2.cvt32(), X87_EXPONENT_BIAS_ADJUST);
+  m_emit.jle(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.cmp(temp2.cvt32(), X87_DOUBLE_MAX_EXPONENT);
+  m_emit.ja(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.shl(result, 1);
+  m_emit.shr(result, 12);
+  m_emit.shl(temp2, 52);
+  m_emit.or_(result, temp2);
+  m_emit.or_(result, temp1);
+  m_emit.jmp(done_label);
+
+  // denormals and pseudo-denormals also have a zero exponent
+  m_emit.L(zero_label);
+  m_emit.test(result, result);
+  m_emit.jnz(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.mov(result, temp1);
+  m_emit.L(done_label);
+}
+
+void CodeGenerator::EmitX87DoubleToExtended(const Xbyak::Reg64& fraction, const Xbyak::Reg64& exponent,
+                                            const Xbyak::Reg64& value, u32 min_exponent, u32 max_exponent,
+                                            Xbyak::Label& slow_path_label)
+{
+  Xbyak::Label zero_label, sign_label;
+  m_emit.mov(fraction, value);
+  m_emit.shl(fraction, 1);
+  m_emit.jz(zero_label);
+
+  m_emit.mov(exponent, fraction);
+  m_emit.shr(exponent, 53);
+  m_emit.cmp(exponent.cvt32(), min_exponent);
+  m_emit.jb(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.cmp(exponent.cvt32(), max_exponent);
+  m_emit.ja(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.add(exponent.cvt32(), X87_EXPONENT_BIAS_ADJUST);
+  m_emit.shl(fraction, 10);
+  m_emit.bts(fraction, 63);
+  m_emit.jmp(sign_label);
+
+  m_emit.L(zero_label);
+  m_emit.xor_(exponent.cvt32(), exponent.cvt32());
+
+  m_emit.L(sign_label);
+  m_emit.shr(value, 63);
+  m_emit.shl(value.cvt32(), 15);
+  m_emit.or_(exponent.cvt32(), value.cvt32());
+}
+
+void CodeGenerator::EmitX87CheckDoubleRange(const Xbyak::Reg64& value, const Xbyak::Reg64& temp, u32 min_exponent,
+                                            u32 max_exponent, Xbyak::Label& slow_path_label)
+{
+  Xbyak::Label ok_label;
+  m_emit.mov(temp, value);
+  m_emit.shl(temp, 1);
+  m_emit.jz(ok_label);
+  m_emit.shr(temp, 53);
+  m_emit.cmp(temp.cvt32(), min_exponent);
+  m_emit.jb(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.cmp(temp.cvt32(), max_exponent);
+  m_emit.ja(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.L(ok_label);
+}
+
+bool CodeGenerator::Compile_X87_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  enum class X87Form : u8
+  {
+    Load,         // FLD
+    Store,        // FST, FSTP
+    LoadInteger,  // FILD
+    StoreInteger, // FIST, FISTP
+    Exchange,     // FXCH
+    Arithmetic,   // FADD, FSUB, FSUBR, FMUL, FDIV, FDIVR and the popping forms
+    Compare       // FCOM, FCOMP, FCOMPP
+  };
+
+  X87Form form;
+  u32 pop_count = 0;
+  switch (instruction.operation)
+  {
+    case Operation_FLD:
+      form = X87Form::Load;
+      break;
+    case Operation_FST:
+      form = X87Form::Store;
+      break;
+    case Operation_FSTP:
+      form = X87Form::Store;
+      pop_count = 1;
+      break;
+    case Operation_FILD:
+      form = X87Form::LoadInteger;
+      break;
+    case Operation_FIST:
+      form = X87Form::StoreInteger;
+      break;
+    case Operation_FISTP:
+      form = X87Form::StoreInteger;
+      pop_count = 1;
+      break;
+    case Operation_FXCH:
+      form = X87Form::Exchange;
+      break;
+    case Operation_FADD:
+    case Operation_FSUB:
+    case Operation_FSUBR:
+    case Operation_FMUL:
+    case Operation_FDIV:
+    case Operation_FDIVR:
+      form = X87Form::Arithmetic;
+      break;
+    case Operation_FADDP:
+    case Operation_FSUBP:
+    case Operation_FSUBRP:
+    case Operation_FMULP:
+    case Operation_FDIVP:
+    case Operation_FDIVRP:
+      form = X87Form::Arithmetic;
+      pop_count = 1;
+      break;
+    case Operation_FCOM:
+      form = X87Form::Compare;
+      break;
+    case Operation_FCOMP:
+      form = X87Form::Compare;
+      pop_count = 1;
+      break;
+    case Operation_FCOMPP:
+      form = X87Form::Compare;
+      pop_count = 2;
+      break;
+    default:
+      return Compile_Fallback(instruction);
+  }
+
+  // 80-bit and 64-bit integer memory operands are left to the interpreter.
+  const bool two_operands = (form == X87Form::Arithmetic || form == X87Form::Compare);
+  const bool integer_operand = (form == X87Form::LoadInteger || form == X87Form::StoreInteger);
+  const size_t value_index = two_operands ? 1 : 0;
+  const Instruction::Operand& value_operand = instruction.operands[value_index];
+  const bool memory_operand =
+    (value_operand.mode == OperandMode_Memory ||
+     (value_operand.mode == OperandMode_ModRM_RM && !instruction.ModRM_RM_IsReg()));
+  if (memory_operand)
+  {
+    if (form == X87Form::Exchange ||
+        (integer_operand ? (value_operand.size != OperandSize_16 && value_operand.size != OperandSize_32) :
+                           (value_operand.size != OperandSize_32 && value_operand.size != OperandSize_64)))
+    {
+      return Compile_Fallback(instruction);
+    }
+  }
+  else if (value_operand.mode != OperandMode_FPRegister || integer_operand ||
+           (two_operands && instruction.operands[0].mode != OperandMode_FPRegister))
+  {
+    return Compile_Fallback(instruction);
+  }
+
+  // The interpreter adds the cycles itself on the slow path.
+  InstructionPrologue(instruction, 0, true);
+  m_register_cache.FlushAllGuestRegisters(true);
+  CalculateEffectiveAddress(instruction);
+
+  static_assert(sizeof(float80) == 16, "FPU registers are 16 bytes apart");
+  const auto cpu = GetCPUPtrReg();
+  const u32 st_offset = static_cast<u32>(offsetof(CPU, m_fpu_registers.ST));
+  const u32 cw_offset = static_cast<u32>(offsetof(CPU, m_fpu_registers.CW));
+  const u32 sw_offset = static_cast<u32>(offsetof(CPU, m_fpu_registers.SW));
+  const u32 tw_offset = static_cast<u32>(offsetof(CPU, m_fpu_registers.TW));
+  const Value& address = m_operand_memory_addresses[value_index];
+  const Segment segment = instruction.GetMemorySegment();
+  const OperandSize memory_size = value_operand.size;
+  Xbyak::Label slow_path_label;
+  Xbyak::Label done_label;
+
+  // The second half of a 64-bit operand wraps around within 16-bit address space.
+  auto EmitHighDWordAddress = [&]() {
+    Value high_address = m_register_cache.AllocateScratch(OperandSize_32);
+    EmitCopyValue(high_address.host_reg, address);
+    m_emit.add(GetHostReg32(high_address), 4);
+    if (!instruction.Is32BitAddressSize())
+      m_emit.movzx(GetHostReg32(high_address), GetHostReg16(high_address.host_reg));
+    return high_address;
+  };
+
+  {
+    Value temp = m_register_cache.AllocateScratch(OperandSize_32);
+
+    // #NM, and unmasked exceptions pending from an earlier instruction, are raised by the interpreter.
+    m_emit.test(m_emit.dword[cpu + offsetof(CPU, m_registers.CR0)], static_cast<u32>(CR0Bit_EM | CR0Bit_TS));
+    m_emit.jnz(slow_path_label, CodeEmitter::T_NEAR);
+    m_emit.test(m_emit.byte[cpu + sw_offset], 0x80);
+    m_emit.jnz(slow_path_label, CodeEmitter::T_NEAR);
+
+    // Rounding matches the host with all exceptions masked and round to nearest. Arithmetic results are rounded to
+    // the precision control as well, which only works for 24 and 53-bit precision.
+    if (form == X87Form::Arithmetic)
+    {
+      Xbyak::Label precision_ok_label;
+      m_emit.movzx(GetHostReg32(temp), m_emit.word[cpu + cw_offset]);
+      m_emit.and_(GetHostReg32(temp), 0xF3F);
+      m_emit.cmp(GetHostReg32(temp), 0x23F);
+      m_emit.je(precision_ok_label);
+      m_emit.cmp(GetHostReg32(temp), 0x03F);
+      m_emit.jne(slow_path_label, CodeEmitter::T_NEAR);
+      m_emit.L(precision_ok_label);
+    }
+    else if ((form == X87Form::Store && memory_operand) || form == X87Form::StoreInteger)
+    {
+      m_emit.movzx(GetHostReg32(temp), m_emit.word[cpu + cw_offset]);
+      m_emit.and_(GetHostReg32(temp), 0xC3F);
+      m_emit.cmp(GetHostReg32(temp), 0x03F);
+      m_emit.jne(slow_path_label, CodeEmitter::T_NEAR);
+    }
+  }
+
+  // Memory source operands are read before anything else, since the read can call out of the block.
+  Value memory_value;
+  if (memory_operand && form != X87Form::Store && form != X87Form::StoreInteger)
+  {
+    const OperandSize load_size = (memory_size == OperandSize_16) ? OperandSize_16 : OperandSize_32;
+    memory_value = m_register_cache.AllocateScratch(load_size);
+    LoadSegmentMemory(&memory_value, load_size, address, segment);
+    if (memory_size == OperandSize_64)
+    {
+      Value high_address = EmitHighDWordAddress();
+      Value high = m_register_cache.AllocateScratch(OperandSize_32);
+      LoadSegmentMemory(&high, OperandSize_32, high_address, segment);
+      m_emit.shl(GetHostReg64(high.host_reg), 32);
+      m_emit.or_(GetHostReg64(memory_value.host_reg), GetHostReg64(high.host_reg));
+    }
+  }
+
+  // Values written to memory are converted in the first scope, and the stack is updated after the store.
+  Value store_value;
+  {
+    Value top = m_register_cache.AllocateScratch(OperandSize_32);
+    Value tw = m_register_cache.AllocateScratch(OperandSize_32);
+    Value temp1 = m_register_cache.AllocateScratch(OperandSize_64);
+    Value temp2 = m_register_cache.AllocateScratch(OperandSize_64);
+    Value temp3 = m_register_cache.AllocateScratch(OperandSize_64);
+    Value slot_a = m_register_cache.AllocateScratch(OperandSize_32);
+    Value slot_b;
+    const auto top32 = GetHostReg32(top);
+    const auto tw32 = GetHostReg32(tw);
+    const auto t1 = GetHostReg64(temp1.host_reg);
+    const auto t2 = GetHostReg64(temp2.host_reg);
+    const auto t3 = GetHostReg64(temp3.host_reg);
+    const auto mem = memory_value.IsValid() ? GetHostReg64(memory_value.host_reg) : Xbyak::Reg64();
+
+    // TOP is loaded once per instruction, and registers are addressed by their tag word bit index (slot * 2). The
+    // native path only reads registers tagged valid or zero, so the low tag bit is the zero flag.
+    m_emit.movzx(top32, m_emit.word[cpu + sw_offset]);
+    m_emit.shr(top32, 11);
+    m_emit.and_(top32, 7);
+    m_emit.movzx(tw32, m_emit.word[cpu + tw_offset]);
+
+    auto EmitLoadSlot = [&](const Value& slot, u32 relative_index) {
+      m_emit.lea(GetHostReg32(slot), m_emit.dword[GetHostReg64(top.host_reg) + (relative_index & 7)]);
+      m_emit.and_(GetHostReg32(slot), 7);
+      m_emit.add(GetHostReg32(slot), GetHostReg32(slot));
+    };
+    auto GetSlotAddress = [&](const Value& slot) { return cpu + GetHostReg64(slot.host_reg) * 8 + st_offset; };
+    auto EmitCheckReadable = [&](const Value& slot) {
+      m_emit.lea(t3.cvt32(), m_emit.dword[GetHostReg64(slot.host_reg) + 1]);
+      m_emit.bt(tw32, t3.cvt32());
+      m_emit.jc(slow_path_label, CodeEmitter::T_NEAR);
+    };
+    auto EmitCheckEmpty = [&](const Value& slot) {
+      m_emit.bt(tw32, GetHostReg32(slot));
+      m_emit.jnc(slow_path_label, CodeEmitter::T_NEAR);
+      m_emit.lea(t3.cvt32(), m_emit.dword[GetHostReg64(slot.host_reg) + 1]);
+      m_emit.bt(tw32, t3.cvt32());
+      m_emit.jnc(slow_path_label, CodeEmitter::T_NEAR);
+    };
+    auto EmitSetZeroTagFromCarry = [&](const Value& slot) {
+      Xbyak::Label set_label, tag_done_label;
+      m_emit.jc(set_label);
+      m_emit.btr(tw32, GetHostReg32(slot));
+      m_emit.jmp(tag_done_label);
+      m_emit.L(set_label);
+      m_emit.bts(tw32, GetHostReg32(slot));
+      m_emit.L(tag_done_label);
+    };
+    auto EmitWriteRegister = [&](const Value& slot, const Xbyak::Reg64& fraction, const Xbyak::Reg64& exponent,
+                                 bool raw_copy_of_slot_b) {
+      m_emit.mov(m_emit.qword[GetSlotAddress(slot)], fraction);
+      m_emit.mov(m_emit.word[GetSlotAddress(slot) + 8], exponent.cvt16());
+      m_emit.lea(t3.cvt32(), m_emit.dword[GetHostReg64(slot.host_reg) + 1]);
+      m_emit.btr(tw32, t3.cvt32());
+      if (raw_copy_of_slot_b)
+        m_emit.bt(tw32, GetHostReg32(slot_b));
+      else
+        m_emit.cmp(fraction, 1);
+      EmitSetZeroTagFromCarry(slot);
+    };
+    auto EmitReadSourceAsDouble = [&](const Xbyak::Xmm& dest) {
+      // register sources are in slot_b, memory sources in memory_value
+      if (!memory_operand)
+      {
+        EmitX87ExtendedToDouble(t1, GetSlotAddress(slot_b), t2, t3, slow_path_label);
+        m_emit.movq(dest, t1);
+      }
+      else if (memory_size == OperandSize_32)
+      {
+        m_emit.movd(dest, mem.cvt32());
+        m_emit.cvtss2sd(dest, dest);
+        m_emit.movq(t1, dest);
+        EmitX87CheckDoubleRange(t1, t2, X87_SINGLE_MIN_EXPONENT, X87_SINGLE_MAX_EXPONENT, slow_path_label);
+      }
+      else
+      {
+        EmitX87CheckDoubleRange(mem, t2, X87_DOUBLE_MIN_EXPONENT, X87_DOUBLE_MAX_EXPONENT, slow_path_label);
+        m_emit.movq(dest, mem);
+      }
+    };
+    auto EmitCommit = [&](s32 top_adjust, bool condition_codes_in_t1) {
+      EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(cycles));
+      for (u32 i = 0; i < pop_count; i++)
+      {
+        m_emit.lea(t2.cvt32(), m_emit.dword[GetHostReg64(top.host_reg) + i]);
+        m_emit.and_(t2.cvt32(), 7);
+        m_emit.add(t2.cvt32(), t2.cvt32());
+        m_emit.bts(tw32, t2.cvt32());
+        m_emit.inc(t2.cvt32());
+        m_emit.bts(tw32, t2.cvt32());
+      }
+      m_emit.mov(m_emit.word[cpu + tw_offset], tw32.cvt16());
+
+      // C1 is cleared, C0/C2/C3 are only written by compares
+      u32 clear_mask = 0x0200;
+      if (top_adjust != 0)
+        clear_mask |= 0x3800;
+      if (condition_codes_in_t1)
+        clear_mask |= 0x4500;
+      m_emit.movzx(t2.cvt32(), m_emit.word[cpu + sw_offset]);
+      m_emit.and_(t2.cvt32(), ~clear_mask);
+      if (top_adjust != 0)
+      {
+        m_emit.lea(t3.cvt32(), m_emit.dword[GetHostReg64(top.host_reg) + (top_adjust & 7)]);
+        m_emit.and_(t3.cvt32(), 7);
+        m_emit.shl(t3.cvt32(), 11);
+        m_emit.or_(t2.cvt32(), t3.cvt32());
+      }
+      if (condition_codes_in_t1)
+        m_emit.or_(t2.cvt32(), t1.cvt32());
+      m_emit.mov(m_emit.word[cpu + sw_offset], t2.cvt16());
+    };
+
+    switch (form)
+    {
+      case X87Form::Load:
+      case X87Form::LoadInteger:
+      {
+        // ST(-1) becomes ST(0), and must be empty
+        EmitLoadSlot(slot_a, 7);
+        EmitCheckEmpty(slot_a);
+        if (!memory_operand)
+        {
+          // register loads copy the value as-is
+          slot_b = m_register_cache.AllocateScratch(OperandSize_32);
+          EmitLoadSlot(slot_b, value_operand.data);
+          EmitCheckReadable(slot_b);
+          m_emit.mov(t1, m_emit.qword[GetSlotAddress(slot_b)]);
+          m_emit.movzx(t2.cvt32(), m_emit.word[GetSlotAddress(slot_b) + 8]);
+          EmitWriteRegister(slot_a, t1, t2, true);
+        }
+        else
+        {
+          u32 min_exponent = X87_DOUBLE_MIN_EXPONENT;
+          u32 max_exponent = X87_DOUBLE_MAX_EXPONENT;
+          if (form == X87Form::LoadInteger)
+          {
+            if (memory_size == OperandSize_16)
+              m_emit.movsx(t1.cvt32(), mem.cvt16());
+            else
+              m_emit.mov(t1.cvt32(), mem.cvt32());
+            m_emit.cvtsi2sd(m_emit.xmm0, t1.cvt32());
+            m_emit.movq(t1, m_emit.xmm0);
+          }
+          else if (memory_size == OperandSize_32)
+          {
+            m_emit.movd(m_emit.xmm0, mem.cvt32());
+            m_emit.cvtss2sd(m_emit.xmm0, m_emit.xmm0);
+            m_emit.movq(t1, m_emit.xmm0);
+            min_exponent = X87_SINGLE_MIN_EXPONENT;
+            max_exponent = X87_SINGLE_MAX_EXPONENT;
+          }
+          else
+          {
+            m_emit.mov(t1, mem);
+          }
+
+          EmitX87DoubleToExtended(t2, t3, t1, min_exponent, max_exponent, slow_path_label);
+          EmitWriteRegister(slot_a, t2, t3, false);
+        }
+
+        EmitCommit(-1, false);
+      }
+      break;
+
+      case X87Form::Store:
+      case X87Form::StoreInteger:
+      {
+        EmitLoadSlot(slot_a, 0);
+        EmitCheckReadable(slot_a);
+        if (!memory_operand)
+        {
+          // register stores copy the value as-is, the destination can be empty
+          slot_b = std::move(slot_a);
+          slot_a = m_register_cache.AllocateScratch(OperandSize_32);
+          EmitLoadSlot(slot_a, value_operand.data);
+          m_emit.mov(t1, m_emit.qword[GetSlotAddress(slot_b)]);
+          m_emit.movzx(t2.cvt32(), m_emit.word[GetSlotAddress(slot_b) + 8]);
+          EmitWriteRegister(slot_a, t1, t2, true);
+          EmitCommit(pop_count, false);
+          break;
+        }
+
+        EmitX87ExtendedToDouble(t1, GetSlotAddress(slot_a), t2, t3, slow_path_label);
+        if (form == X87Form::StoreInteger)
+        {
+          // cvtsd2si returns the integer indefinite value for anything out of range, which needs an exception
+          m_emit.movq(m_emit.xmm0, t1);
+          m_emit.cvtsd2si(t1.cvt32(), m_emit.xmm0);
+          if (memory_size == OperandSize_16)
+          {
+            m_emit.movsx(t2.cvt32(), t1.cvt16());
+            m_emit.cmp(t2.cvt32(), t1.cvt32());
+            m_emit.jne(slow_path_label, CodeEmitter::T_NEAR);
+          }
+          else
+          {
+            m_emit.cmp(t1.cvt32(), 0x80000000u);
+            m_emit.je(slow_path_label, CodeEmitter::T_NEAR);
+          }
+        }
+        else if (memory_size == OperandSize_32)
+        {
+          // rounding can still overflow at the top of the single range
+          EmitX87CheckDoubleRange(t1, t2, X87_SINGLE_MIN_EXPONENT, X87_SINGLE_MAX_EXPONENT, slow_path_label);
+          m_emit.movq(m_emit.xmm0, t1);
+          m_emit.cvtsd2ss(m_emit.xmm0, m_emit.xmm0);
+          m_emit.movd(t1.cvt32(), m_emit.xmm0);
+          m_emit.mov(t2.cvt32(), t1.cvt32());
+          m_emit.and_(t2.cvt32(), 0x7F800000);
+          m_emit.cmp(t2.cvt32(), 0x7F800000);
+          m_emit.je(slow_path_label, CodeEmitter::T_NEAR);
+        }
+
+        store_value = std::move(temp1);
+      }
+      break;
+
+      case X87Form::Exchange:
+      {
+        slot_b = m_register_cache.AllocateScratch(OperandSize_32);
+        EmitLoadSlot(slot_a, 0);
+        EmitLoadSlot(slot_b, value_operand.data);
+        EmitCheckReadable(slot_a);
+        EmitCheckReadable(slot_b);
+
+        m_emit.mov(t1, m_emit.qword[GetSlotAddress(slot_a)]);
+        m_emit.movzx(t2.cvt32(), m_emit.word[GetSlotAddress(slot_a) + 8]);
+        m_emit.mov(t3, m_emit.qword[GetSlotAddress(slot_b)]);
+        m_emit.mov(m_emit.qword[GetSlotAddress(slot_a)], t3);
+        m_emit.movzx(t3.cvt32(), m_emit.word[GetSlotAddress(slot_b) + 8]);
+        m_emit.mov(m_emit.word[GetSlotAddress(slot_a) + 8], t3.cvt16());
+        m_emit.mov(m_emit.qword[GetSlotAddress(slot_b)], t1);
+        m_emit.mov(m_emit.word[GetSlotAddress(slot_b) + 8], t2.cvt16());
+
+        // swap the zero bits, the high bits are both clear
+        m_emit.bt(tw32, GetHostReg32(slot_a));
+        m_emit.setc(t1.cvt8());
+        m_emit.bt(tw32, GetHostReg32(slot_b));
+        EmitSetZeroTagFromCarry(slot_a);
+        m_emit.bt(t1.cvt32(), 0);
+        EmitSetZeroTagFromCarry(slot_b);
+        EmitCommit(0, false);
+      }
+      break;
+
+      case X87Form::Arithmetic:
+      case X87Form::Compare:
+      {
+        EmitLoadSlot(slot_a, instruction.operands[0].data);
+        EmitCheckReadable(slot_a);
+        if (!memory_operand)
+        {
+          slot_b = m_register_cache.AllocateScratch(OperandSize_32);
+          EmitLoadSlot(slot_b, value_operand.data);
+          EmitCheckReadable(slot_b);
+        }
+
+        // xmm0 is the left-hand side and xmm1 the right-hand side, the reversed forms swap the operands
+        const bool reverse = (instruction.operation == Operation_FSUBR || instruction.operation == Operation_FSUBRP ||
+                              instruction.operation == Operation_FDIVR || instruction.operation == Operation_FDIVRP);
+        const Xbyak::Xmm& dest_xmm = reverse ? m_emit.xmm1 : m_emit.xmm0;
+        const Xbyak::Xmm& source_xmm = reverse ? m_emit.xmm0 : m_emit.xmm1;
+        EmitX87ExtendedToDouble(t1, GetSlotAddress(slot_a), t2, t3, slow_path_label);
+        m_emit.movq(dest_xmm, t1);
+        EmitReadSourceAsDouble(source_xmm);
+
+        if (form == X87Form::Compare)
+        {
+          // NaNs were excluded, so the result is never unordered and C2 stays clear
+          m_emit.ucomisd(m_emit.xmm0, m_emit.xmm1);
+          m_emit.setb(t1.cvt8());
+          m_emit.sete(t2.cvt8());
+          m_emit.movzx(t1.cvt32(), t1.cvt8());
+          m_emit.movzx(t2.cvt32(), t2.cvt8());
+          m_emit.shl(t1.cvt32(), 8);
+          m_emit.shl(t2.cvt32(), 14);
+          m_emit.or_(t1.cvt32(), t2.cvt32());
+          EmitCommit(pop_count, true);
+          break;
+        }
+
+        // With 24-bit precision, the double result is rounded again to single precision. That gives the same result
+        // for these operations as long as the operands are exact in single precision.
+        Xbyak::Label operands_ok_label;
+        m_emit.test(m_emit.byte[cpu + cw_offset + 1], 0x02);
+        m_emit.jnz(operands_ok_label);
+        for (const Xbyak::Xmm* operand : {&m_emit.xmm0, &m_emit.xmm1})
+        {
+          m_emit.cvtsd2ss(m_emit.xmm2, *operand);
+          m_emit.cvtss2sd(m_emit.xmm2, m_emit.xmm2);
+          m_emit.ucomisd(m_emit.xmm2, *operand);
+          m_emit.jne(slow_path_label, CodeEmitter::T_NEAR);
+        }
+        m_emit.L(operands_ok_label);
+
+        const bool is_multiply = (instruction.operation == Operation_FMUL || instruction.operation == Operation_FMULP);
+        const bool is_divide = (instruction.operation == Operation_FDIV || instruction.operation == Operation_FDIVP ||
+                                instruction.operation == Operation_FDIVR || instruction.operation == Operation_FDIVRP);
+        if (is_divide)
+        {
+          m_emit.xorpd(m_emit.xmm2, m_emit.xmm2);
+          m_emit.ucomisd(m_emit.xmm1, m_emit.xmm2);
+          m_emit.je(slow_path_label, CodeEmitter::T_NEAR);
+        }
+        if (is_multiply || is_divide)
+          m_emit.movapd(m_emit.xmm3, m_emit.xmm0);
+
+        switch (instruction.operation)
+        {
+          case Operation_FADD:
+          case Operation_FADDP:
+            m_emit.addsd(m_emit.xmm0, m_emit.xmm1);
+            break;
+          case Operation_FSUB:
+          case Operation_FSUBP:
+          case Operation_FSUBR:
+          case Operation_FSUBRP:
+            m_emit.subsd(m_emit.xmm0, m_emit.xmm1);
+            break;
+          case Operation_FMUL:
+          case Operation_FMULP:
+            m_emit.mulsd(m_emit.xmm0, m_emit.xmm1);
+            break;
+          default:
+            m_emit.divsd(m_emit.xmm0, m_emit.xmm1);
+            break;
+        }
+
+        // Results which underflowed to zero would still be normal with the extended exponent range.
+        if (is_multiply || is_divide)
+        {
+          Xbyak::Label result_ok_label;
+          m_emit.xorpd(m_emit.xmm2, m_emit.xmm2);
+          m_emit.ucomisd(m_emit.xmm0, m_emit.xmm2);
+          m_emit.jne(result_ok_label);
+          m_emit.ucomisd(m_emit.xmm3, m_emit.xmm2);
+          m_emit.je(result_ok_label);
+          if (is_multiply)
+          {
+            m_emit.ucomisd(m_emit.xmm1, m_emit.xmm2);
+            m_emit.je(result_ok_label);
+          }
+          m_emit.jmp(slow_path_label, CodeEmitter::T_NEAR);
+          m_emit.L(result_ok_label);
+        }
+
+        Xbyak::Label rounded_label;
+        m_emit.movq(t1, m_emit.xmm0);
+        m_emit.test(m_emit.byte[cpu + cw_offset + 1], 0x02);
+        m_emit.jnz(rounded_label);
+        EmitX87CheckDoubleRange(t1, t2, X87_SINGLE_MIN_EXPONENT, X87_SINGLE_MAX_EXPONENT, slow_path_label);
+        m_emit.cvtsd2ss(m_emit.xmm0, m_emit.xmm0);
+        m_emit.cvtss2sd(m_emit.xmm0, m_emit.xmm0);
+        m_emit.movq(t1, m_emit.xmm0);
+        m_emit.L(rounded_label);
+
+        EmitX87DoubleToExtended(t2, t3, t1, X87_DOUBLE_MIN_EXPONENT, X87_DOUBLE_MAX_EXPONENT, slow_path_label);
+        EmitWriteRegister(slot_a, t2, t3, false);
+        EmitCommit(pop_count, false);
+      }
+      break;
+    }
+  }
+
+  if (store_value.IsValid())
+  {
+    // The store can fault, so the stack isn't touched until it has completed.
+    if (memory_size == OperandSize_64)
+    {
+      Value high_address = EmitHighDWordAddress();
+      Value high = m_register_cache.AllocateScratch(OperandSize_64);
+      m_emit.mov(GetHostReg64(high), GetHostReg64(store_value));
+      m_emit.shr(GetHostReg64(high), 32);
+      StoreSegmentMemory(Value::FromHostReg(&m_register_cache, store_value.host_reg, OperandSize_32), address, segment);
+      StoreSegmentMemory(Value::FromHostReg(&m_register_cache, high.host_reg, OperandSize_32), high_address, segment);
+    }
+    else
+    {
+      StoreSegmentMemory(Value::FromHostReg(&m_register_cache, store_value.host_reg, memory_size), address, segment);
+    }
+    store_value.ReleaseAndClear();
+
+    Value sw = m_register_cache.AllocateScratch(OperandSize_32);
+    Value tw = m_register_cache.AllocateScratch(OperandSize_32);
+    Value temp = m_register_cache.AllocateScratch(OperandSize_32);
+    const auto sw32 = GetHostReg32(sw);
+    const auto tw32 = GetHostReg32(tw);
+    const auto temp32 = GetHostReg32(temp);
+    EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(cycles));
+    m_emit.movzx(sw32, m_emit.word[cpu + sw_offset]);
+    if (pop_count > 0)
+    {
+      m_emit.mov(temp32, sw32);
+      m_emit.shr(temp32, 11);
+      m_emit.and_(temp32, 7);
+      m_emit.add(temp32, temp32);
+      m_emit.movzx(tw32, m_emit.word[cpu + tw_offset]);
+      m_emit.bts(tw32, temp32);
+      m_emit.inc(temp32);
+      m_emit.bts(tw32, temp32);
+      m_emit.mov(m_emit.word[cpu + tw_offset], tw32.cvt16());
+
+      // TOP is bits 11-13, the carry out of the increment is masked off
+      m_emit.lea(temp32, m_emit.dword[GetHostReg64(sw.host_reg) + (1 << 11)]);
+      m_emit.and_(temp32, 0x3800);
+      m_emit.and_(sw32, ~u32(0x3800));
+      m_emit.or_(sw32, temp32);
+    }
+    m_emit.and_(sw32, ~u32(0x0200));
+    m_emit.mov(m_emit.word[cpu + sw_offset], sw32.cvt16());
+  }
+
+  m_emit.jmp(done_label, CodeEmitter::T_NEAR);
+
+  // Anything the native path can't handle exactly goes through the interpreter.
+  m_emit.L(slow_path_label);
+  EmitInterpreterCall(instruction);
+  m_emit.L(done_label);
+  return true;
+}
+
+bool CodeGenerator::Compile_String(const Instruction& instruction)
+{
+  const CycleCount cycles_base = m_cpu->GetCycles(instruction.IsRep() ? CYCLES_REP_MOVS_BASE : CYCLES_MOVS);
+  const CycleCount cycles_n = m_cpu->GetCycles(CYCLES_REP_MOVS_N) + 1;
+  const u32 data_size = GetOperandSizeInBytes(instruction.operands[0].size);
+  const OperandSize reg_address_size =
+    ((instruction.GetAddressSize() == AddressSize_32) ? OperandSize_32 : OperandSize_16);
+  const bool is_rep = instruction.IsRep();
+  const bool is_32bit = (instruction.GetAddressSize() == AddressSize_32);
+  const bool needs_eax = (instruction.operation == Operation_LODS || instruction.operation == Operation_STOS ||
+                          instruction.operation == Operation_SCAS);
+  const bool needs_esi = (instruction.operation == Operation_MOVS || instruction.operation == Operation_CMPS ||
+                          instruction.operation == Operation_LODS);
+  const bool needs_edi = (instruction.operation == Operation_MOVS || instruction.operation == Operation_CMPS ||
+                          instruction.operation == Operation_STOS || instruction.operation == Operation_SCAS);
+  const bool needs_lhs = (instruction.operation == Operation_MOVS || instruction.operation == Operation_CMPS);
+  const bool needs_rhs = (instruction.operation == Operation_CMPS);
+
+  InstructionPrologue(instruction, cycles_base, true);
+
+  // work out the increment (positive or negative)
+  Value increment = m_register_cache.AllocateScratch(reg_address_size);
+  {
+    Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);
+    Value increment_temp = m_register_cache.AllocateScratch(reg_address_size);
+    if (is_32bit)
+    {
+      EmitCopyValue(increment.GetHostRegister(), Value::FromConstantU32(data_size));
+      EmitCopyValue(increment_temp.GetHostRegister(), Value::FromConstantU32(u32(-s32(data_size))));
+      m_emit.test(GetHostReg32(eflags), Flag_DF);
+      m_emit.cmovnz(GetHostReg32(increment), GetHostReg32(increment_temp));
+    }
+    else
+    {
+      EmitCopyValue(increment.GetHostRegister(), Value::FromConstantU16(u16(data_size)));
+      EmitCopyValue(increment_temp.GetHostRegister(), Value::FromConstantU16(u16(-s16(data_size))));
+      m_emit.test(GetHostReg32(eflags), Flag_DF);
+      m_emit.cmovnz(GetHostReg16(increment), GetHostReg16(increment_temp));
+    }
+  }
+
+  // temporary for the value read, and zero-extended address (if in 16-bit mode)
+  Value lhs;
+  Value rhs;
+  Value address;
+  Value eax;
+  Value ecx;
+  Value esi;
+  Value edi;
+  if (!is_32bit)
+    address = m_register_cache.AllocateScratch(OperandSize_32);
+  if (needs_lhs)
+    lhs = m_register_cache.AllocateScratch(instruction.operands[0].size);
+  if (needs_rhs)
+    rhs = m_register_cache.AllocateScratch(instruction.operands[0].size);
+  if (needs_eax)
+    eax = m_register_cache.ReadGuestRegister(instruction.operands[0].size, Reg32_EAX, true, true);
+  if (needs_esi)
+    esi = m_register_cache.ReadGuestRegister(reg_address_size, Reg32_ESI, true, true);
+  if (needs_edi)
+    edi = m_register_cache.ReadGuestRegister(reg_address_size, Reg32_EDI, true, true);
+  if (is_rep)
+    ecx = m_register_cache.ReadGuestRegister(reg_address_size, Reg32_ECX, true, true);
+
+  // everything should be in the register cache still
+  Assert((!needs_eax || m_register_cache.IsGuestRegisterInHostReg(instruction.operands[0].size, Reg32_EAX)) &&
+         (!needs_esi || m_register_cache.IsGuestRegisterInHostReg(reg_address_size, Reg32_ESI)) &&
+         (!needs_edi || m_register_cache.IsGuestRegisterInHostReg(reg_address_size, Reg32_EDI)) &&
+         (!is_rep || m_register_cache.IsGuestRegisterInHostReg(reg_address_size, Reg32_ECX)));
+
+  Xbyak::Label rep_label;
+  Xbyak::Label done_label;
+  if (is_rep)
+  {
+    m_emit.L(rep_label);
+
+    // add n cycles
+    EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(cycles_n));
+
+    // compare ecx against zero
+    EmitTest(ecx.GetHostRegister(), ecx);
+    m_emit.jz(done_label);
+  }
+
+  switch (instruction.operation)
+  {
+    case Operation_MOVS:
+    {
+      // read from esi, write to es:edi
+      if (is_32bit)
+      {
+        LoadSegmentMemory(&lhs, lhs.size, esi, instruction.GetMemorySegment());
+        StoreSegmentMemory(lhs, edi, Segment_ES);
+      }
+      else
+      {
+        EmitZeroExtend(address.GetHostRegister(), OperandSize_32, esi.GetHostRegister(), OperandSize_16);
+        LoadSegmentMemory(&lhs, lhs.size, address, instruction.GetMemorySegment());
+        EmitZeroExtend(address.GetHostRegister(), OperandSize_32, edi.GetHostRegister(), OperandSize_16);
+        StoreSegmentMemory(lhs, address, Segment_ES);
+      }
+    }
+    break;
+
+    case Operation_LODS:
+    {
+      // read from esi, write to (e)ax
+      if (is_32bit)
+      {
+        LoadSegmentMemory(&eax, eax.size, esi, instruction.GetMemorySegment());
+      }
+      else
+      {
+        EmitZeroExtend(address.GetHostRegister(), OperandSize_32, esi.GetHostRegister(), OperandSize_16);
+        LoadSegmentMemory(&eax, eax.size, address, instruction.GetMemorySegment());
+      }
+      eax = m_register_cache.WriteGuestRegister(eax.size, Reg32_EAX, std::move(eax));
+    }
+    break;
+
+    case Operation_STOS:
+    {
+      // read from (e)ax, write to [es:edi]
+      if (is_32bit)
+      {
+        StoreSegmentMemory(eax, edi, Segment_ES);
+      }
+      else
+      {
+        EmitZeroExtend(address.GetHostRegister(), OperandSize_32, edi.GetHostRegister(), OperandSize_16);
+        StoreSegmentMemory(eax, address, Segment_ES);
+      }
+    }
+    break;
+
+    default:
+      UnreachableCode();
+      break;
+  }
+
+  // increment edi/esi
+  if (needs_esi)
+  {
+    EmitAdd(esi.GetHostRegister(), increment);
+    esi = m_register_cache.WriteGuestRegister(reg_address_size, Reg32_ESI, std::move(esi));
+  }
+  if (needs_edi)
+  {
+    EmitAdd(edi.GetHostRegister(), increment);
+    edi = m_register_cache.WriteGuestRegister(reg_address_size, Reg32_EDI, std::move(edi));
+  }
+
+  if (is_rep)
+  {
+    // reduce ecx
+    EmitDec(ecx.GetHostRegister(), ecx.size);
+    ecx = m_register_cache.WriteGuestRegister(reg_address_size, Reg32_ECX, std::move(ecx));
 
     // flush new esi/edi/ecx values, since we can fault after the next loop
     if (needs_esi)
@@ -1913,9 +3250,6 @@ bool CodeGenerator::Compile_String(const Instruction& instruction)
 bool CodeGenerator::Compile_Jcc_Impl(const Instruction& instruction, CycleCount cycles, CycleCount cycles_not_taken)
 {
   const JumpCondition cc = instruction.operands[0].jump_condition;
-  if (cc == JumpCondition_CXZero)
-    return Compile_Fallback(instruction);
-
   InstructionPrologue(instruction, 0, true);
   CalculateEffectiveAddress(instruction);
   Value target = CalculateJumpTarget(instruction, 1);
@@ -1989,6 +3323,16 @@ bool CodeGenerator::Compile_Jcc_Impl(const Instruction& instruction, CycleCount
       m_emit.jg(take_jump_label);
       break;
 
+    case JumpCondition_CXZero:
+    {
+      // JCXZ/JECXZ test cx or ecx based on the address size
+      const OperandSize count_size = instruction.Is32BitAddressSize() ? OperandSize_32 : OperandSize_16;
+      Value count = m_register_cache.ReadGuestRegister(count_size, Reg32_ECX, true, true);
+      EmitTest(count.GetHostRegister(), count);
+      m_emit.jz(take_jump_label);
+    }
+    break;
+
     default:
       Panic("Unhandled condition");
       break;
@@ -2006,6 +3350,320 @@ bool CodeGenerator::Compile_Jcc_Impl(const Instruction& instruction, CycleCount
   return true;
 }
 
+void CodeGenerator::EmitSegmentChecks(HostReg offset_reg, HostReg temp_reg, u32 access_size, u32 segcache_offset,
+                                      AccessType access, Xbyak::Label& slow_path_label)
+{
+  const auto linear = GetHostReg32(offset_reg);
+  const auto temp = GetHostReg32(temp_reg);
+
+  // Segment access check. Faults are raised by the thunk, so we can just bail out here. Checks which an earlier access
+  // to the instruction's memory operand passed can be skipped, since a failure would have raised an exception.
+  const u8 access_bit = static_cast<u8>(1 << static_cast<u8>(access));
+  const bool tracked = m_current_instruction_info && m_current_instruction_info->track_memory_checks;
+  if (!tracked || !(m_checked_access_types & access_bit))
+  {
+    m_emit.test(m_emit.byte[GetCPUPtrReg() + segcache_offset + offsetof(CPU::SegmentCache, access_mask)], access_bit);
+    m_emit.jz(slow_path_label);
+  }
+  if (!tracked || !m_limit_checked)
+  {
+    m_emit.cmp(linear, m_emit.dword[GetCPUPtrReg() + segcache_offset + offsetof(CPU::SegmentCache, limit_low)]);
+    m_emit.jb(slow_path_label);
+    if (access_size > 1)
+    {
+      // offset + (size - 1) can overflow, which also counts as being outside the limit.
+      m_emit.mov(temp, linear);
+      m_emit.add(temp, access_size - 1);
+      m_emit.jc(slow_path_label);
+      m_emit.cmp(temp,
+                 m_emit.dword[GetCPUPtrReg() + segcache_offset + offsetof(CPU::SegmentCache, limit_high)]);
+    }
+    else
+    {
+      m_emit.cmp(linear, m_emit.dword[GetCPUPtrReg() + segcache_offset + offsetof(CPU::SegmentCache, limit_high)]);
+    }
+    m_emit.ja(slow_path_label);
+  }
+  if (tracked)
+  {
+    m_checked_access_types |= access_bit;
+    m_limit_checked = true;
+  }
+}
+
+void CodeGenerator::EmitGuestMemoryFastPath(HostReg host_ptr_reg, HostReg offset_reg, HostReg temp_reg,
+                                            OperandSize size, const Value& address, Segment segment, AccessType access,
+                                            Xbyak::Label& slow_path_label)
+{
+  const auto host_ptr = GetHostReg64(host_ptr_reg);
+  const auto offset = GetHostReg64(offset_reg);
+  const auto temp = GetHostReg64(temp_reg);
+  const u32 access_size = (size == OperandSize_8) ? 1 : ((size == OperandSize_16) ? 2 : 4);
+  const u32 segcache_offset =
+    static_cast<u32>(offsetof(CPU, m_segment_cache[0]) + sizeof(CPU::SegmentCache) * static_cast<u32>(segment));
+  const auto linear = offset.cvt32();
+  EmitCopyValue(offset_reg, address);
+
+  // Flat segments have a zero base, and allow reads and writes anywhere below 4GiB.
+  const bool flat = (m_current_instruction_info && m_current_instruction_info->flat_segments &&
+                     (segment == Segment_ES || segment == Segment_SS || segment == Segment_DS));
+  if (flat)
+  {
+    if (access_size > 1)
+    {
+      m_emit.cmp(linear, 0xFFFFFFFFu - (access_size - 1));
+      m_emit.ja(slow_path_label);
+    }
+  }
+  else
+  {
+    EmitSegmentChecks(offset_reg, temp_reg, access_size, segcache_offset, access, slow_path_label);
+    m_emit.add(linear, m_emit.dword[GetCPUPtrReg() + segcache_offset + offsetof(CPU::SegmentCache, base_address)]);
+  }
+
+  // Unaligned accesses have to be split when they cross a page, or raise #AC.
+  if (access_size > 1)
+  {
+    Xbyak::Label aligned_label;
+    m_emit.test(linear, access_size - 1);
+    m_emit.jz(aligned_label);
+    m_emit.cmp(m_emit.byte[GetCPUPtrReg() + offsetof(CPU, m_alignment_check_enabled)], 0);
+    m_emit.jne(slow_path_label);
+    m_emit.mov(temp.cvt32(), linear);
+    m_emit.and_(temp.cvt32(), CPU::PAGE_OFFSET_MASK);
+    m_emit.cmp(temp.cvt32(), CPU::PAGE_SIZE - access_size);
+    m_emit.ja(slow_path_label);
+    m_emit.L(aligned_label);
+  }
+
+  Bus* bus = m_cpu->m_bus;
+#ifdef ENABLE_TLB_EMULATION
+  static_assert((CPU::TLB_ENTRY_COUNT & (CPU::TLB_ENTRY_COUNT - 1)) == 0, "TLB entry count is a power of two");
+  static_assert(sizeof(CPU::TLBEntry) == 16, "TLB entry is 16 bytes");
+  const u32 tlb_offset = static_cast<u32>(offsetof(CPU, m_tlb_entries) + static_cast<u32>(access) *
+                                                                            CPU::TLB_ENTRY_COUNT *
+                                                                            sizeof(CPU::TLBEntry));
+
+  // Leaves the byte offset of the TLB entry from tlb_offset in temp, branching to the slow path on a miss.
+  auto EmitTLBLookup = [&]() {
+    // index = (user_bit * 3 * TLB_ENTRY_COUNT) + page_number % TLB_ENTRY_COUNT
+    m_emit.movzx(temp.cvt32(), m_emit.byte[GetCPUPtrReg() + offsetof(CPU, m_tlb_user_bit)]);
+    m_emit.imul(temp.cvt32(), temp.cvt32(), static_cast<u32>(3 * CPU::TLB_ENTRY_COUNT));
+    m_emit.mov(host_ptr.cvt32(), linear);
+    m_emit.shr(host_ptr.cvt32(), CPU::PAGE_SHIFT);
+    m_emit.and_(host_ptr.cvt32(), static_cast<u32>(CPU::TLB_ENTRY_COUNT - 1));
+    m_emit.add(temp.cvt32(), host_ptr.cvt32());
+    m_emit.shl(temp.cvt32(), 4);
+
+    // tag = (linear & PAGE_MASK) | counter, or the global page tag
+    Xbyak::Label hit_label;
+    m_emit.mov(host_ptr.cvt32(), linear);
+    m_emit.and_(host_ptr.cvt32(), CPU::PAGE_MASK);
+    m_emit.or_(host_ptr.cvt32(), m_emit.dword[GetCPUPtrReg() + offsetof(CPU, m_tlb_counter_bits)]);
+    m_emit.cmp(host_ptr.cvt32(),
+               m_emit.dword[GetCPUPtrReg() + temp + tlb_offset + offsetof(CPU::TLBEntry, linear_address)]);
+    m_emit.je(hit_label);
+    m_emit.xor_(host_ptr.cvt32(), m_emit.dword[GetCPUPtrReg() + offsetof(CPU, m_tlb_counter_bits)]);
+    m_emit.or_(host_ptr.cvt32(), m_emit.dword[GetCPUPtrReg() + offsetof(CPU, m_tlb_global_bits)]);
+    m_emit.cmp(host_ptr.cvt32(),
+               m_emit.dword[GetCPUPtrReg() + temp + tlb_offset + offsetof(CPU::TLBEntry, linear_address)]);
+    m_emit.jne(slow_path_label);
+    m_emit.L(hit_label);
+  };
+
+  // Without fastmem, the host pointer cached in the TLB entry completes the translation. Entries are created when
+  // paging is disabled too, so CR0.PG doesn't need to be checked. Null pointers (MMIO, code) use the slow path.
+  if (!bus->GetFastmemBase())
+  {
+    EmitTLBLookup();
+    m_emit.mov(host_ptr, m_emit.qword[GetCPUPtrReg() + temp + tlb_offset + offsetof(CPU::TLBEntry, host_pointer)]);
+    m_emit.test(host_ptr, host_ptr);
+    m_emit.jz(slow_path_label);
+    m_emit.and_(linear, CPU::PAGE_OFFSET_MASK);
+    return;
+  }
+#endif
+
+  // Linear -> physical translation, only hits in the TLB are handled inline.
+  Xbyak::Label translated_label;
+  m_emit.test(m_emit.dword[GetCPUPtrReg() + offsetof(CPU, m_registers.CR0)], static_cast<u32>(CR0Bit_PG));
+  m_emit.jz(translated_label);
+#ifdef ENABLE_TLB_EMULATION
+  EmitTLBLookup();
+  m_emit.and_(linear, CPU::PAGE_OFFSET_MASK);
+  m_emit.or_(linear, m_emit.dword[GetCPUPtrReg() + temp + tlb_offset + offsetof(CPU::TLBEntry, physical_address)]);
+#else
+  m_emit.jmp(slow_path_label);
+#endif
+  m_emit.L(translated_label);
+
+  // Physical -> host pointer. With fastmem, the physical address is the offset into the view, and any faults from
+  // accessing non-RAM pages are handled by patching the access. Otherwise, look up the RAM page pointer, which is
+  // null for pages which are MMIO, read-only or contain code.
+  m_emit.mov(temp, reinterpret_cast<size_t>(&bus->m_physical_memory_address_mask));
+  m_emit.and_(linear, m_emit.dword[temp]);
+  if (bus->GetFastmemBase())
+  {
+    m_emit.mov(host_ptr, reinterpret_cast<size_t>(bus->GetFastmemBase()));
+    return;
+  }
+
+  m_emit.mov(temp.cvt32(), linear);
+  m_emit.shr(temp.cvt32(), Bus::MEMORY_PAGE_NUMBER_SHIFT);
+  m_emit.mov(host_ptr, reinterpret_cast<size_t>(bus->GetRAMPointerIndex()));
+  m_emit.mov(host_ptr, m_emit.qword[host_ptr + temp * 8]);
+  m_emit.test(host_ptr, host_ptr);
+  m_emit.jz(slow_path_label);
+  m_emit.and_(linear, Bus::MEMORY_PAGE_OFFSET_MASK);
+}
+
+void CodeGenerator::EndFastmemAccess(FastmemAccess* access)
+{
+  if (!m_cpu->m_bus->GetFastmemBase())
+    return;
+
+  // The access has to be large enough to be overwritten with a jump to the slow path.
+  const u8* start = static_cast<const u8*>(access->host_code_address);
+  while ((m_emit.getCurr() - start) < 5)
+    m_emit.nop();
+
+  access->host_code_size = static_cast<u32>(m_emit.getCurr() - start);
+}
+
+void CodeGenerator::LoadSegmentMemory(Value* dest_value, OperandSize size, const Value& address, Segment segment)
+{
+  DebugAssert(address.size == OperandSize_32 && dest_value->IsInHostRegister());
+
+  Xbyak::Label slow_path_label;
+  Xbyak::Label done_label;
+  FastmemAccess fastmem_access = {};
+  {
+    Value host_ptr = m_register_cache.AllocateScratch(OperandSize_64);
+    Value offset = m_register_cache.AllocateScratch(OperandSize_64);
+    Value temp = m_register_cache.AllocateScratch(OperandSize_64);
+    EmitGuestMemoryFastPath(host_ptr.GetHostRegister(), offset.GetHostRegister(), temp.GetHostRegister(), size, address,
+                            segment, AccessType::Read, slow_path_label);
+
+    const Xbyak::RegExp mem = GetHostReg64(host_ptr) + GetHostReg64(offset);
+    fastmem_access.host_code_address = const_cast<u8*>(m_emit.getCurr());
+    switch (size)
+    {
+      case OperandSize_8:
+        m_emit.movzx(GetHostReg32(dest_value->host_reg), m_emit.byte[mem]);
+        break;
+      case OperandSize_16:
+        m_emit.movzx(GetHostReg32(dest_value->host_reg), m_emit.word[mem]);
+        break;
+      case OperandSize_32:
+        m_emit.mov(GetHostReg32(dest_value->host_reg), m_emit.dword[mem]);
+        break;
+      default:
+        break;
+    }
+    EndFastmemAccess(&fastmem_access);
+    m_emit.jmp(done_label);
+  }
+
+  m_emit.L(slow_path_label);
+  if (fastmem_access.host_code_size > 0)
+  {
+    fastmem_access.slow_path_address = const_cast<u8*>(m_emit.getCurr());
+    m_fastmem_accesses->push_back(fastmem_access);
+  }
+  switch (size)
+  {
+    case OperandSize_8:
+      EmitFunctionCall(dest_value, m_asm_functions.read_memory_byte, Value::FromConstantU8(segment), address);
+      break;
+    case OperandSize_16:
+      EmitFunctionCall(dest_value, m_asm_functions.read_memory_word, Value::FromConstantU8(segment), address);
+      break;
+    case OperandSize_32:
+      EmitFunctionCall(dest_value, m_asm_functions.read_memory_dword, Value::FromConstantU8(segment), address);
+      break;
+    default:
+      break;
+  }
+
+  m_emit.L(done_label);
+}
+
+void CodeGenerator::StoreSegmentMemory(const Value& value, const Value& address, Segment segment)
+{
+  DebugAssert(address.size == OperandSize_32);
+
+  Xbyak::Label slow_path_label;
+  Xbyak::Label done_label;
+  FastmemAccess fastmem_access = {};
+  {
+    Value host_ptr = m_register_cache.AllocateScratch(OperandSize_64);
+    Value offset = m_register_cache.AllocateScratch(OperandSize_64);
+    Value temp = m_register_cache.AllocateScratch(OperandSize_64);
+    EmitGuestMemoryFastPath(host_ptr.GetHostRegister(), offset.GetHostRegister(), temp.GetHostRegister(), value.size,
+                            address, segment, AccessType::Write, slow_path_label);
+
+    const Xbyak::RegExp mem = GetHostReg64(host_ptr) + GetHostReg64(offset);
+    fastmem_access.host_code_address = const_cast<u8*>(m_emit.getCurr());
+    switch (value.size)
+    {
+      case OperandSize_8:
+      {
+        if (value.IsConstant())
+          m_emit.mov(m_emit.byte[mem], Truncate32(value.constant_value & 0xFF));
+        else
+          m_emit.mov(m_emit.byte[mem], GetHostReg8(value));
+      }
+      break;
+
+      case OperandSize_16:
+      {
+        if (value.IsConstant())
+          m_emit.mov(m_emit.word[mem], Truncate32(value.constant_value & 0xFFFF));
+        else
+          m_emit.mov(m_emit.word[mem], GetHostReg16(value));
+      }
+      break;
+
+      case OperandSize_32:
+      {
+        if (value.IsConstant())
+          m_emit.mov(m_emit.dword[mem], Truncate32(value.constant_value));
+        else
+          m_emit.mov(m_emit.dword[mem], GetHostReg32(value));
+      }
+      break;
+
+      default:
+        break;
+    }
+    EndFastmemAccess(&fastmem_access);
+    m_emit.jmp(done_label);
+  }
+
+  m_emit.L(slow_path_label);
+  if (fastmem_access.host_code_size > 0)
+  {
+    fastmem_access.slow_path_address = const_cast<u8*>(m_emit.getCurr());
+    m_fastmem_accesses->push_back(fastmem_access);
+  }
+  switch (value.size)
+  {
+    case OperandSize_8:
+      EmitFunctionCall(nullptr, m_asm_functions.write_memory_byte, Value::FromConstantU8(segment), address, value);
+      break;
+    case OperandSize_16:
+      EmitFunctionCall(nullptr, m_asm_functions.write_memory_word, Value::FromConstantU8(segment), address, value);
+      break;
+    case OperandSize_32:
+      EmitFunctionCall(nullptr, m_asm_functions.write_memory_dword, Value::FromConstantU8(segment), address, value);
+      break;
+    default:
+      break;
+  }
+
+  m_emit.L(done_label);
+}
+
 class ThunkGenerator
 {
 public:
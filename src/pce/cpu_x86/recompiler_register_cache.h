@@ -177,7 +177,8 @@ public:
   u32 PopCallerSavedRegisters() const;
 
   /// Restore callee-saved registers. Call at the end of the function.
-  u32 PopCalleeSavedRegisters();
+  /// If commit is false, the registers are still considered saved, for emitting additional exit paths.
+  u32 PopCalleeSavedRegisters(bool commit = true);
 
   //////////////////////////////////////////////////////////////////////////
   // Scratch Register Allocation
@@ -20,8 +20,8 @@ constexpr u32 HostReg_Count = 16;
 constexpr HostReg HostReg_Invalid = static_cast<HostReg>(HostReg_Count);
 constexpr OperandSize HostPointerSize = OperandSize_64;
 
-// A reasonable "maximum" number of bytes per instruction.
-constexpr u32 MaximumBytesPerInstruction = 128;
+// A reasonable "maximum" number of bytes per instruction. Memory accesses have an inline fast path, so this is large.
+constexpr u32 MaximumBytesPerInstruction = 512;
 
 #else
 using HostReg = void;
@@ -33,4 +33,30 @@ constexpr OperandSize HostPointerSize = OperandSize_64;
 
 using BlockFunctionType = void (*)(CPU*);
 
+// The code buffer is split into this many regions. When the current region fills up, the oldest region is evicted.
+constexpr u32 CodeRegionCount = 8;
+
+// Tiered mode: number of times a block is interpreted before it is queued for compilation.
+constexpr u32 BackgroundCompileThreshold = 32;
+
+// Tiered mode: size of the code buffer region used by the worker thread. The remainder holds the ASM functions.
+constexpr size_t BackgroundCodeSpaceSize = 60 * 1024 * 1024;
+
+/// An exit from a block with a constant target, which can be patched to jump directly into the target block's code.
+struct BlockLinkSlot
+{
+  u32 target_eip;
+  u32 block_pointer_offset; // offset of the block pointer stored to the backend's current block
+  u32 jump_offset;          // offset of the jump displacement, relative to the block's code pointer
+  BlockBase* linked_block;
+};
+
+/// A guest memory access through the fastmem view. If it faults, the access is patched to jump to its slow path.
+struct FastmemAccess
+{
+  void* host_code_address;
+  void* slow_path_address;
+  u32 host_code_size;
+};
+
 } // namespace CPU_X86::Recompiler
\ No newline at end of file
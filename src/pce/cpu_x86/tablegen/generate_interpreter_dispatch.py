@@ -6,6 +6,19 @@ import sys
 
 MODULE = None
 DISPATCH_FUNCTION_NAME = ""
+EXPAND_AUTO_OPERAND_SIZE = True
+SPECIALIZE_MODRM_FORMS = True
+LAZY_FLAGS = True
+
+# Operations which record their arithmetic flags for the CPU to evaluate later. Must match IsLazyFlagsOperation()
+# in interpreter.h. Handlers for every other operation evaluate pending flags before executing.
+LAZY_FLAGS_OPERATIONS = (Operation.ADD, Operation.SUB, Operation.CMP, Operation.AND, Operation.OR, Operation.XOR,
+                         Operation.TEST)
+
+
+def needs_lazy_flags(opcode):
+    return LAZY_FLAGS and opcode.operation not in LAZY_FLAGS_OPERATIONS
+
 
 def gen_dispatch(writer):
     writer.write("void %s(CPU* cpu)" % DISPATCH_FUNCTION_NAME)
@@ -100,6 +113,8 @@ def gen_opcode(writer, opcode, modrm_fetched, prefix):
             line += ">"
 
         line += "(cpu);"
+        if needs_lazy_flags(opcode):
+            writer.write("cpu->MaterializeLazyFlags();")
         writer.write(line)
         writer.write("return;")
         writer.deindent()
@@ -155,46 +170,74 @@ def gen_opcode(writer, opcode, modrm_fetched, prefix):
 def gen_handler_table(writer, class_name, table_var_name):
     writer.write("%s::HandlerFunctionMap %s::%s = {" % (class_name, class_name, table_var_name))
     writer.indent()
-    gen_handler_table_entries(writer, class_name, "base", "prefix_")
+    for opcode, auto_size in enumerate_handler_opcodes("base", "prefix_"):
+        gen_handler_table_entry(writer, class_name, opcode)
     writer.deindent()
     writer.write("};")
 
 
-def gen_handler_table_entries(writer, class_name, table_name, prefix):
+def enumerate_handler_opcodes(table_name, prefix, modrm_forms=("ModRMForm_Register", "ModRMForm_Memory")):
+    # Yields each handler variant, with auto-sized operands expanded to word and dword.
+    # The 8086 has no operand size prefix, so its handlers are instantiated with the auto size instead.
     table = getattr(MODULE, table_name)
     for encoding in table:
         opcode = table[encoding]
         if opcode.type == OpcodeType.Extension or opcode.type == OpcodeType.ModRMRegExtension:
             child_table_name = prefix + "%02X" % encoding
-            gen_handler_table_entries(writer, class_name, child_table_name, child_table_name)
+            yield from enumerate_handler_opcodes(child_table_name, child_table_name)
             continue
         elif opcode.type == OpcodeType.X87Extension:
-            for suffix in ["reg", "mem"]:
+            # The x87 tables are already split by the form of the r/m operand.
+            for suffix, forms in [("reg", ("ModRMForm_Register",)), ("mem", ("ModRMForm_Memory",))]:
                 child_table_name = prefix + "%02X_%s" % (encoding, suffix)
-                gen_handler_table_entries(writer, class_name, child_table_name, child_table_name)
+                yield from enumerate_handler_opcodes(child_table_name, child_table_name, forms)
             continue
         if opcode.type != OpcodeType.Normal:
             continue
 
         is_auto_size = False
         for operand in opcode.operands:
-            if operand.size == OperandSize.Auto:
-                gen_handler_table_entry(writer, class_name, opcode.override_operand_size(OperandSize.Word))
-                gen_handler_table_entry(writer, class_name, opcode.override_operand_size(OperandSize.DWord))
+            if operand.size == OperandSize.Auto and EXPAND_AUTO_OPERAND_SIZE:
+                for form_opcode in specialize_modrm_form(opcode.override_operand_size(OperandSize.Word), modrm_forms):
+                    yield (form_opcode, OperandSize.Word)
+                for form_opcode in specialize_modrm_form(opcode.override_operand_size(OperandSize.DWord), modrm_forms):
+                    yield (form_opcode, OperandSize.DWord)
                 is_auto_size = True
                 break
         if not is_auto_size:
-            gen_handler_table_entry(writer, class_name, opcode)
+            for form_opcode in specialize_modrm_form(opcode, modrm_forms):
+                yield (form_opcode, None)
 
 
-def gen_handler_table_entry(writer, class_name, opcode):
-    line = "{ HandlerFunctionKey::Build(" + opcode.operation.value
+def specialize_modrm_form(opcode, modrm_forms):
+    # Yields a variant for each form of the ModRM r/m operand, in its constant. The generic handler is only used
+    # by the dispatcher, which runs before the ModRM byte is decoded.
+    if not SPECIALIZE_MODRM_FORMS or not any(operand.mode == OperandMode.ModRM_RM for operand in opcode.operands):
+        yield opcode
+        return
+
+    for form in modrm_forms:
+        op = Opcode(opcode.encoding, opcode.type, opcode.operation, cc=opcode.cc, min_model=opcode.min_model)
+        for operand in opcode.operands:
+            if operand.mode == OperandMode.ModRM_RM:
+                op.operands.append(Operand(operand.text, operand.size, operand.mode, form))
+            else:
+                op.operands.append(operand)
+        yield op
+
+
+def handler_key(opcode):
+    line = "HandlerFunctionKey::Build(" + opcode.operation.value
     if opcode.cc is not None:
         line += ", OperandSize_8, OperandMode_JumpCondition, %s" % opcode.cc.value
     for operand in opcode.operands:
         line += ", " + operand.template_value()
+    line += ")"
+    return line
+
 
-    line += "), &%s::Execute_%s" % (class_name, opcode.operation.value)
+def handler_name(class_name, opcode):
+    line = "&%s::Execute_%s" % (class_name, opcode.operation.value)
     count = 0
     if opcode.cc is not None:
         line += "<" + opcode.cc.value
@@ -204,9 +247,45 @@ def gen_handler_table_entry(writer, class_name, opcode):
         count += 1
     if count > 0:
         line += ">"
+    if needs_lazy_flags(opcode):
+        line = "&%s::Execute_WithFlags<%s>" % (class_name, line)
+    return line
+
+
+def gen_handler_table_entry(writer, class_name, opcode):
+    writer.write("{ %s, %s}," % (handler_key(opcode), handler_name(class_name, opcode)))
+
+
+# Superinstructions for the cached interpreter. The first instruction of each pair must not branch,
+# so the second instruction always executes directly after it.
+def is_fused_pair(first, second):
+    if first.operation == Operation.CMP or first.operation == Operation.TEST:
+        return second.operation == Operation.Jcc and second.cc != JumpCondition.CXZero
+    elif first.operation == Operation.DEC:
+        return second.operation == Operation.Jcc and second.cc == JumpCondition.NotEqual
+    elif first.operation == Operation.PUSH:
+        return (first.operands[0].mode == OperandMode.Register or first.operands[0].mode == OperandMode.Immediate) and \
+               second.operation == Operation.CALL_Near and second.operands[0].mode == OperandMode.Relative
+    return False
+
+
+def gen_fused_handler_table(writer, class_name, table_var_name):
+    opcodes = list(enumerate_handler_opcodes("base", "prefix_"))
+    writer.write("%s::FusedHandlerFunctionMap %s::%s = {" % (class_name, class_name, table_var_name))
+    writer.indent()
+    for first, first_auto_size in opcodes:
+        for second, second_auto_size in opcodes:
+            # Both instructions usually share the same operand size, skip mismatched variants.
+            if first_auto_size is not None and second_auto_size is not None and first_auto_size != second_auto_size:
+                continue
+            if not is_fused_pair(first, second):
+                continue
+            writer.write("{ { %s, %s }, &%s::Execute_Fused<%s, %s> }," %
+                         (handler_key(first), handler_key(second), class_name, handler_name(class_name, first),
+                          handler_name(class_name, second)))
+    writer.deindent()
+    writer.write("};")
 
-    line += "},"
-    writer.write(line)
 
 if __name__ == "__main__":
     if len(sys.argv) < 3:
@@ -217,11 +296,16 @@ if __name__ == "__main__":
     if sys.argv[1] == "8086":
         MODULE = opcodes_8086
         DISPATCH_FUNCTION_NAME = "CPU_8086::Instructions::DispatchInstruction"
+        EXPAND_AUTO_OPERAND_SIZE = False
+        SPECIALIZE_MODRM_FORMS = False
+        LAZY_FLAGS = False
         gen_dispatch(writer)
+        gen_handler_table(writer, "CPU_8086::Instructions", "s_handler_functions")
     elif sys.argv[1] == "x86":
         MODULE = opcodes_x86
         DISPATCH_FUNCTION_NAME = "CPU_X86::Interpreter::Dispatch"
         gen_dispatch(writer)
         gen_handler_table(writer, "CPU_X86::Interpreter", "s_handler_functions")
+        gen_fused_handler_table(writer, "CPU_X86::Interpreter", "s_fused_handler_functions")
     
     writer.close()
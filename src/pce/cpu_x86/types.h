@@ -589,6 +589,15 @@ enum OperandMode : u8
   OperandMode_JumpCondition,
 };
 
+// Constant of ModRM r/m operands in interpreter handlers. Handlers for the register or memory form skip checking the
+// ModRM byte at runtime, the dispatcher uses the generic handlers.
+enum ModRMForm : u32
+{
+  ModRMForm_Any,
+  ModRMForm_Register,
+  ModRMForm_Memory
+};
+
 inline constexpr bool OperandMode_NeedsModRM(OperandSize op_size, OperandMode op_mode, u32 op_idx)
 {
   return op_mode == OperandMode_ModRM_Reg || op_mode == OperandMode_ModRM_RM ||
@@ -610,6 +619,21 @@ enum InstructionFlags : u8
   InstructionFlag_RepNotEqual = (1 << 3)
 };
 
+// ALU operations whose arithmetic flags the interpreter evaluates lazily.
+enum class LazyFlagsOperation : u8
+{
+  None,
+  Add8,
+  Add16,
+  Add32,
+  Sub8,
+  Sub16,
+  Sub32,
+  Logic8,
+  Logic16,
+  Logic32
+};
+
 enum JumpCondition : u8
 {
   JumpCondition_Always,
@@ -6,6 +6,7 @@
 #include "YBaseLib/FileSystem.h"
 #include "YBaseLib/Log.h"
 #include "YBaseLib/Thread.h"
+#include "bus.h"
 #include "common/audio.h"
 #include "common/display_renderer.h"
 #include "system.h"
@@ -182,6 +183,44 @@ void HostInterface::FlushCPUCodeCache()
     false);
 }
 
+void HostInterface::DumpCPUBlockProfile(u32 count /* = 20 */)
+{
+  Assert(m_system);
+  QueueExternalEvent(
+    [this, count]() {
+      m_system->GetCPU()->DumpBlockProfile(count);
+      ReportMessage("Block profile written to log.");
+    },
+    false);
+}
+
+bool HostInterface::IsIOPortProfilingEnabled() const
+{
+  return m_system ? m_system->GetBus()->IsIOPortProfilingEnabled() : false;
+}
+
+void HostInterface::SetIOPortProfilingEnabled(bool enabled)
+{
+  Assert(m_system);
+  QueueExternalEvent(
+    [this, enabled]() {
+      m_system->GetBus()->SetIOPortProfilingEnabled(enabled);
+      ReportMessage(enabled ? "IO port profiling enabled." : "IO port profiling disabled.");
+    },
+    false);
+}
+
+void HostInterface::DumpIOPortProfile(u32 count /* = 20 */)
+{
+  Assert(m_system);
+  QueueExternalEvent(
+    [this, count]() {
+      m_system->GetBus()->DumpIOPortProfile(count);
+      ReportMessage("IO port profile written to log.");
+    },
+    false);
+}
+
 void HostInterface::SetSpeedLimiterEnabled(bool enabled)
 {
   if (m_speed_limiter_enabled == enabled)
@@ -76,6 +76,12 @@ public:
   bool SetCPUBackend(CPU::BackendType backend);
   void SetCPUFrequency(float frequency);
   void FlushCPUCodeCache();
+  void DumpCPUBlockProfile(u32 count = 20);
+
+  // IO port profiling, the profile is written to the log.
+  bool IsIOPortProfilingEnabled() const;
+  void SetIOPortProfilingEnabled(bool enabled);
+  void DumpIOPortProfile(u32 count = 20);
 
   // Speed limiter.
   bool IsSpeedLimiterEnabled() const { return m_speed_limiter_enabled; }
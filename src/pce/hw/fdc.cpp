@@ -820,6 +820,7 @@ void FDC::ConnectIOPorts(Bus* bus)
   bus->ConnectIOPortRead(0x03F2, this, std::bind(&FDC::IOReadDigitalOutputRegister, this));
   bus->ConnectIOPortWrite(0x03F2, this, std::bind(&FDC::IOWriteDigitalOutputRegister, this, std::placeholders::_2));
   bus->ConnectIOPortReadToPointer(0x03F4, this, &m_MSR.bits);
+  bus->SetIOPortReadIdle(0x03F4, this);
   bus->ConnectIOPortWrite(0x03F4, this, std::bind(&FDC::IOWriteDataRateSelectRegister, this, std::placeholders::_2));
   bus->ConnectIOPortRead(0x03F5, this, std::bind(&FDC::IOReadFIFO, this));
   bus->ConnectIOPortWrite(0x03F5, this, std::bind(&FDC::IOWriteFIFO, this, std::placeholders::_2));
@@ -220,59 +220,70 @@ void HDC::ConnectIOPorts(Bus* bus)
   }
 }
 
+template<typename T, T (HDC::*Method)(u32)>
+T HDC::IOPortReadThunk(void* context, u16 port)
+{
+  const Channel* cdata = static_cast<const Channel*>(context);
+  return (cdata->parent->*Method)(cdata->index);
+}
+
+template<typename T, void (HDC::*Method)(u32, T)>
+void HDC::IOPortWriteThunk(void* context, u16 port, T value)
+{
+  const Channel* cdata = static_cast<const Channel*>(context);
+  (cdata->parent->*Method)(cdata->index, value);
+}
+
 void HDC::ConnectIOPorts(Bus* bus, u32 channel, u16 BAR0, u16 BAR1, u8 irq)
 {
+  Channel& cdata = m_channels[channel];
+  cdata.parent = this;
+  cdata.index = channel;
+
   // 01F0 - Data register (R/W)
-  bus->ConnectIOPortRead(BAR0 + 0, this, std::bind(&HDC::IOReadDataRegisterByte, this, channel));
-  bus->ConnectIOPortReadWord(BAR0 + 0, this, std::bind(&HDC::IOReadDataRegisterWord, this, channel));
-  bus->ConnectIOPortReadDWord(BAR0 + 0, this, std::bind(&HDC::IOReadDataRegisterDWord, this, channel));
-  bus->ConnectIOPortWrite(BAR0 + 0, this,
-                          std::bind(&HDC::IOWriteDataRegisterByte, this, channel, std::placeholders::_2));
-  bus->ConnectIOPortWriteWord(BAR0 + 0, this,
-                              std::bind(&HDC::IOWriteDataRegisterWord, this, channel, std::placeholders::_2));
-  bus->ConnectIOPortWriteDWord(BAR0 + 0, this,
-                               std::bind(&HDC::IOWriteDataRegisterDWord, this, channel, std::placeholders::_2));
+  bus->ConnectIOPortRead(BAR0 + 0, this, &IOPortReadThunk<u8, &HDC::IOReadDataRegisterByte>, &cdata);
+  bus->ConnectIOPortReadWord(BAR0 + 0, this, &IOPortReadThunk<u16, &HDC::IOReadDataRegisterWord>, &cdata);
+  bus->ConnectIOPortReadDWord(BAR0 + 0, this, &IOPortReadThunk<u32, &HDC::IOReadDataRegisterDWord>, &cdata);
+  bus->ConnectIOPortWrite(BAR0 + 0, this, &IOPortWriteThunk<u8, &HDC::IOWriteDataRegisterByte>, &cdata);
+  bus->ConnectIOPortWriteWord(BAR0 + 0, this, &IOPortWriteThunk<u16, &HDC::IOWriteDataRegisterWord>, &cdata);
+  bus->ConnectIOPortWriteDWord(BAR0 + 0, this, &IOPortWriteThunk<u32, &HDC::IOWriteDataRegisterDWord>, &cdata);
 
   // 01F1 - Status register (R)
   // 01F1	w	WPC/4  (Write Precompensation Cylinder divided by 4)
-  bus->ConnectIOPortRead(BAR0 + 1, this, std::bind(&HDC::IOReadErrorRegister, this, channel));
-  bus->ConnectIOPortWrite(BAR0 + 1, this,
-                          std::bind(&HDC::IOWriteCommandBlockFeatures, this, channel, std::placeholders::_2));
+  bus->ConnectIOPortRead(BAR0 + 1, this, &IOPortReadThunk<u8, &HDC::IOReadErrorRegister>, &cdata);
+  bus->ConnectIOPortWrite(BAR0 + 1, this, &IOPortWriteThunk<u8, &HDC::IOWriteCommandBlockFeatures>, &cdata);
 
   // Command block
   // 01F2	r/w	sector count
   // 01F3	r/w	sector number
   // 01F4	r/w	cylinder low
   // 01F5	r/w	cylinder high
-  bus->ConnectIOPortRead(BAR0 + 2, this, std::bind(&HDC::IOReadCommandBlockSectorCount, this, channel));
-  bus->ConnectIOPortWrite(BAR0 + 2, this,
-                          std::bind(&HDC::IOWriteCommandBlockSectorCount, this, channel, std::placeholders::_2));
-  bus->ConnectIOPortRead(BAR0 + 3, this, std::bind(&HDC::IOReadCommandBlockSectorNumber, this, channel));
-  bus->ConnectIOPortWrite(BAR0 + 3, this,
-                          std::bind(&HDC::IOWriteCommandBlockSectorNumber, this, channel, std::placeholders::_2));
-  bus->ConnectIOPortRead(BAR0 + 4, this, std::bind(&HDC::IOReadCommandBlockCylinderLow, this, channel));
-  bus->ConnectIOPortWrite(BAR0 + 4, this,
-                          std::bind(&HDC::IOWriteCommandBlockCylinderLow, this, channel, std::placeholders::_2));
-  bus->ConnectIOPortRead(BAR0 + 5, this, std::bind(&HDC::IOReadCommandBlockCylinderHigh, this, channel));
-  bus->ConnectIOPortWrite(BAR0 + 5, this,
-                          std::bind(&HDC::IOWriteCommandBlockCylinderHigh, this, channel, std::placeholders::_2));
+  bus->ConnectIOPortRead(BAR0 + 2, this, &IOPortReadThunk<u8, &HDC::IOReadCommandBlockSectorCount>, &cdata);
+  bus->ConnectIOPortWrite(BAR0 + 2, this, &IOPortWriteThunk<u8, &HDC::IOWriteCommandBlockSectorCount>, &cdata);
+  bus->ConnectIOPortRead(BAR0 + 3, this, &IOPortReadThunk<u8, &HDC::IOReadCommandBlockSectorNumber>, &cdata);
+  bus->ConnectIOPortWrite(BAR0 + 3, this, &IOPortWriteThunk<u8, &HDC::IOWriteCommandBlockSectorNumber>, &cdata);
+  bus->ConnectIOPortRead(BAR0 + 4, this, &IOPortReadThunk<u8, &HDC::IOReadCommandBlockCylinderLow>, &cdata);
+  bus->ConnectIOPortWrite(BAR0 + 4, this, &IOPortWriteThunk<u8, &HDC::IOWriteCommandBlockCylinderLow>, &cdata);
+  bus->ConnectIOPortRead(BAR0 + 5, this, &IOPortReadThunk<u8, &HDC::IOReadCommandBlockCylinderHigh>, &cdata);
+  bus->ConnectIOPortWrite(BAR0 + 5, this, &IOPortWriteThunk<u8, &HDC::IOWriteCommandBlockCylinderHigh>, &cdata);
 
   // 01F6: Drive select (R/W)
-  bus->ConnectIOPortRead(BAR0 + 6, this, std::bind(&HDC::IOReadDriveSelectRegister, this, channel));
-  bus->ConnectIOPortWrite(BAR0 + 6, this,
-                          std::bind(&HDC::IOWriteDriveSelectRegister, this, channel, std::placeholders::_2));
+  bus->ConnectIOPortRead(BAR0 + 6, this, &IOPortReadThunk<u8, &HDC::IOReadDriveSelectRegister>, &cdata);
+  bus->ConnectIOPortWrite(BAR0 + 6, this, &IOPortWriteThunk<u8, &HDC::IOWriteDriveSelectRegister>, &cdata);
 
   // 01F7 - Status register (R) / Command register (W)
-  bus->ConnectIOPortRead(BAR0 + 7, this, std::bind(&HDC::IOReadStatusRegister, this, channel));
-  bus->ConnectIOPortWrite(BAR0 + 7, this,
-                          std::bind(&HDC::IOWriteCommandRegister, this, channel, std::placeholders::_2));
+  bus->ConnectIOPortRead(BAR0 + 7, this, &IOPortReadThunk<u8, &HDC::IOReadStatusRegister>, &cdata);
+  bus->ConnectIOPortWrite(BAR0 + 7, this, &IOPortWriteThunk<u8, &HDC::IOWriteCommandRegister>, &cdata);
 
   // 03F7: Alternate status register (R) / Control register (W)
-  bus->ConnectIOPortRead(BAR1 + 0, this, std::bind(&HDC::IOReadAltStatusRegister, this, channel));
-  bus->ConnectIOPortWrite(BAR1 + 0, this,
-                          std::bind(&HDC::IOWriteControlRegister, this, channel, std::placeholders::_2));
+  bus->ConnectIOPortRead(BAR1 + 0, this, &IOPortReadThunk<u8, &HDC::IOReadAltStatusRegister>, &cdata);
+  bus->ConnectIOPortWrite(BAR1 + 0, this, &IOPortWriteThunk<u8, &HDC::IOWriteControlRegister>, &cdata);
+
+  // Status only changes when a command event completes.
+  bus->SetIOPortReadIdle(BAR0 + 7, this);
+  bus->SetIOPortReadIdle(BAR1 + 0, this);
 
-  m_channels[channel].irq = irq;
+  cdata.irq = irq;
 }
 
 void HDC::DoReset(u32 channel, bool hardware_reset)
@@ -79,6 +79,10 @@ protected:
     } drive_select_register = {};
 
     bool device_interrupt_lines[DEVICES_PER_CHANNEL] = {};
+
+    // Passed as the context to the IO port handlers.
+    HDC* parent = nullptr;
+    u32 index = 0;
   };
 
   Channel m_channels[MAX_CHANNELS];
@@ -93,6 +97,11 @@ protected:
 
   void ConnectIOPorts(Bus* bus, u32 channel, u16 BAR0, u16 BAR1, u8 irq);
 
+  template<typename T, T (HDC::*Method)(u32)>
+  static T IOPortReadThunk(void* context, u16 port);
+  template<typename T, void (HDC::*Method)(u32, T)>
+  static void IOPortWriteThunk(void* context, u16 port, T value);
+
   u8 IOReadStatusRegister(u32 channel);
   u8 IOReadAltStatusRegister(u32 channel);
   void IOWriteCommandRegister(u32 channel, u8 value);
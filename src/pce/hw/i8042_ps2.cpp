@@ -48,6 +48,10 @@ bool i8042_PS2::Initialize(System* system, Bus* bus)
   bus->ConnectIOPortRead(0x64, this, std::bind(&i8042_PS2::IOReadStatusRegister, this));
   bus->ConnectIOPortWrite(0x64, this, std::bind(&i8042_PS2::IOWriteCommandRegister, this, std::placeholders::_2));
 
+  // Both ports only change when a transfer or command completes, so polling them can be skipped.
+  bus->SetIOPortReadIdle(0x60, this);
+  bus->SetIOPortReadIdle(0x64, this);
+
   m_system->GetHostInterface()->AddKeyboardCallback(
     this, std::bind(&i8042_PS2::OnHostKeyboardEvent, this, std::placeholders::_1, std::placeholders::_2));
   m_system->GetHostInterface()->AddMousePositionChangeCallback(
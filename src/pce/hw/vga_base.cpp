@@ -172,6 +172,19 @@ bool VGABase::SaveState(BinaryWriter& writer)
   return !writer.InErrorState();
 }
 
+// Register handlers are connected as plain functions, so the bus can call them without going through std::function.
+template<u8 (VGABase::*Method)()>
+static u8 IOPortReadThunk(void* context, u16 port)
+{
+  return (static_cast<VGABase*>(context)->*Method)();
+}
+
+template<void (VGABase::*Method)(u8)>
+static void IOPortWriteThunk(void* context, u16 port, u8 value)
+{
+  (static_cast<VGABase*>(context)->*Method)(value);
+}
+
 void VGABase::ConnectIOPorts()
 {
   m_bus->ConnectIOPortReadToPointer(0x03B0, this, &m_crtc_index_register);
@@ -180,53 +193,53 @@ void VGABase::ConnectIOPorts()
   m_bus->ConnectIOPortWriteToPointer(0x03B2, this, &m_crtc_index_register);
   m_bus->ConnectIOPortReadToPointer(0x03B4, this, &m_crtc_index_register);
   m_bus->ConnectIOPortWriteToPointer(0x03B4, this, &m_crtc_index_register);
-  m_bus->ConnectIOPortRead(0x03B1, this, [this](u16) { return IOCRTCDataRegisterRead(); });
-  m_bus->ConnectIOPortWrite(0x03B1, this, [this](u16, u8 value) { IOCRTCDataRegisterWrite(value); });
-  m_bus->ConnectIOPortRead(0x03B3, this, [this](u16) { return IOCRTCDataRegisterRead(); });
-  m_bus->ConnectIOPortWrite(0x03B3, this, [this](u16, u8 value) { IOCRTCDataRegisterWrite(value); });
-  m_bus->ConnectIOPortRead(0x03B5, this, [this](u16) { return IOCRTCDataRegisterRead(); });
-  m_bus->ConnectIOPortWrite(0x03B5, this, [this](u16, u8 value) { IOCRTCDataRegisterWrite(value); });
+  m_bus->ConnectIOPortRead(0x03B1, this, &IOPortReadThunk<&VGABase::IOCRTCDataRegisterRead>, this);
+  m_bus->ConnectIOPortWrite(0x03B1, this, &IOPortWriteThunk<&VGABase::IOCRTCDataRegisterWrite>, this);
+  m_bus->ConnectIOPortRead(0x03B3, this, &IOPortReadThunk<&VGABase::IOCRTCDataRegisterRead>, this);
+  m_bus->ConnectIOPortWrite(0x03B3, this, &IOPortWriteThunk<&VGABase::IOCRTCDataRegisterWrite>, this);
+  m_bus->ConnectIOPortRead(0x03B5, this, &IOPortReadThunk<&VGABase::IOCRTCDataRegisterRead>, this);
+  m_bus->ConnectIOPortWrite(0x03B5, this, &IOPortWriteThunk<&VGABase::IOCRTCDataRegisterWrite>, this);
   m_bus->ConnectIOPortReadToPointer(0x03D0, this, &m_crtc_index_register);
   m_bus->ConnectIOPortWriteToPointer(0x03D0, this, &m_crtc_index_register);
   m_bus->ConnectIOPortReadToPointer(0x03D2, this, &m_crtc_index_register);
   m_bus->ConnectIOPortWriteToPointer(0x03D2, this, &m_crtc_index_register);
   m_bus->ConnectIOPortReadToPointer(0x03D4, this, &m_crtc_index_register);
   m_bus->ConnectIOPortWriteToPointer(0x03D4, this, &m_crtc_index_register);
-  m_bus->ConnectIOPortRead(0x03D1, this, [this](u16) { return IOCRTCDataRegisterRead(); });
-  m_bus->ConnectIOPortWrite(0x03D1, this, [this](u16, u8 value) { IOCRTCDataRegisterWrite(value); });
-  m_bus->ConnectIOPortRead(0x03D3, this, [this](u16) { return IOCRTCDataRegisterRead(); });
-  m_bus->ConnectIOPortWrite(0x03D3, this, [this](u16, u8 value) { IOCRTCDataRegisterWrite(value); });
-  m_bus->ConnectIOPortRead(0x03D5, this, [this](u16) { return IOCRTCDataRegisterRead(); });
-  m_bus->ConnectIOPortWrite(0x03D5, this, [this](u16, u8 value) { IOCRTCDataRegisterWrite(value); });
-  m_bus->ConnectIOPortRead(0x03C2, this, [this](u16) { return IOReadStatusRegister0(); });
-  m_bus->ConnectIOPortRead(0x03BA, this, [this](u16) { return IOReadStatusRegister1(); });
-  m_bus->ConnectIOPortRead(0x03DA, this, [this](u16) { return IOReadStatusRegister1(); });
+  m_bus->ConnectIOPortRead(0x03D1, this, &IOPortReadThunk<&VGABase::IOCRTCDataRegisterRead>, this);
+  m_bus->ConnectIOPortWrite(0x03D1, this, &IOPortWriteThunk<&VGABase::IOCRTCDataRegisterWrite>, this);
+  m_bus->ConnectIOPortRead(0x03D3, this, &IOPortReadThunk<&VGABase::IOCRTCDataRegisterRead>, this);
+  m_bus->ConnectIOPortWrite(0x03D3, this, &IOPortWriteThunk<&VGABase::IOCRTCDataRegisterWrite>, this);
+  m_bus->ConnectIOPortRead(0x03D5, this, &IOPortReadThunk<&VGABase::IOCRTCDataRegisterRead>, this);
+  m_bus->ConnectIOPortWrite(0x03D5, this, &IOPortWriteThunk<&VGABase::IOCRTCDataRegisterWrite>, this);
+  m_bus->ConnectIOPortRead(0x03C2, this, &IOPortReadThunk<&VGABase::IOReadStatusRegister0>, this);
+  m_bus->ConnectIOPortRead(0x03BA, this, &IOPortReadThunk<&VGABase::IOReadStatusRegister1>, this);
+  m_bus->ConnectIOPortRead(0x03DA, this, &IOPortReadThunk<&VGABase::IOReadStatusRegister1>, this);
   m_bus->ConnectIOPortReadToPointer(0x03CE, this, &m_graphics_index_register);
   m_bus->ConnectIOPortWriteToPointer(0x03CE, this, &m_graphics_index_register);
-  m_bus->ConnectIOPortRead(0x03CF, this, [this](u16) { return IOGraphicsRegisterRead(); });
-  m_bus->ConnectIOPortWrite(0x03CF, this, [this](u16, u8 value) { IOGraphicsRegisterWrite(value); });
+  m_bus->ConnectIOPortRead(0x03CF, this, &IOPortReadThunk<&VGABase::IOGraphicsRegisterRead>, this);
+  m_bus->ConnectIOPortWrite(0x03CF, this, &IOPortWriteThunk<&VGABase::IOGraphicsRegisterWrite>, this);
   m_bus->ConnectIOPortReadToPointer(0x03CC, this, &m_misc_output_register.bits);
-  m_bus->ConnectIOPortWrite(0x03C2, this, [this](u16, u8 value) { IOMiscOutputRegisterWrite(value); });
+  m_bus->ConnectIOPortWrite(0x03C2, this, &IOPortWriteThunk<&VGABase::IOMiscOutputRegisterWrite>, this);
   m_bus->ConnectIOPortReadToPointer(0x03CA, this, &m_feature_control_register.bits);
   m_bus->ConnectIOPortWriteToPointer(0x03BA, this, &m_feature_control_register.bits);
   m_bus->ConnectIOPortWriteToPointer(0x03DA, this, &m_feature_control_register.bits);
   m_bus->ConnectIOPortReadToPointer(0x03C0, this, &m_attribute_index_register);
-  m_bus->ConnectIOPortWrite(0x03C0, this, [this](u16, u8 value) { IOAttributeAddressDataWrite(value); });
-  m_bus->ConnectIOPortRead(0x03C1, this, [this](u16) { return IOAttributeDataRead(); });
+  m_bus->ConnectIOPortWrite(0x03C0, this, &IOPortWriteThunk<&VGABase::IOAttributeAddressDataWrite>, this);
+  m_bus->ConnectIOPortRead(0x03C1, this, &IOPortReadThunk<&VGABase::IOAttributeDataRead>, this);
   m_bus->ConnectIOPortReadToPointer(0x03C4, this, &m_sequencer_index_register);
   m_bus->ConnectIOPortWriteToPointer(0x03C4, this, &m_sequencer_index_register);
-  m_bus->ConnectIOPortRead(0x03C5, this, [this](u16) { return IOSequencerDataRegisterRead(); });
-  m_bus->ConnectIOPortWrite(0x03C5, this, [this](u16, u8 value) { IOSequencerDataRegisterWrite(value); });
-  m_bus->ConnectIOPortRead(0x03C7, this, [this](u16) { return IODACStateRegisterRead(); });
-  m_bus->ConnectIOPortWrite(0x03C7, this, [this](u16, u8 value) { IODACReadAddressWrite(value); });
-  m_bus->ConnectIOPortRead(0x03C8, this, [this](u16) { return IODACWriteAddressRead(); });
-  m_bus->ConnectIOPortWrite(0x03C8, this, [this](u16, u8 value) { IODACWriteAddressWrite(value); });
-  m_bus->ConnectIOPortRead(0x03C9, this, [this](u16) { return IODACDataRegisterRead(); });
-  m_bus->ConnectIOPortWrite(0x03C9, this, [this](u16, u8 value) { IODACDataRegisterWrite(value); });
+  m_bus->ConnectIOPortRead(0x03C5, this, &IOPortReadThunk<&VGABase::IOSequencerDataRegisterRead>, this);
+  m_bus->ConnectIOPortWrite(0x03C5, this, &IOPortWriteThunk<&VGABase::IOSequencerDataRegisterWrite>, this);
+  m_bus->ConnectIOPortRead(0x03C7, this, &IOPortReadThunk<&VGABase::IODACStateRegisterRead>, this);
+  m_bus->ConnectIOPortWrite(0x03C7, this, &IOPortWriteThunk<&VGABase::IODACReadAddressWrite>, this);
+  m_bus->ConnectIOPortRead(0x03C8, this, &IOPortReadThunk<&VGABase::IODACWriteAddressRead>, this);
+  m_bus->ConnectIOPortWrite(0x03C8, this, &IOPortWriteThunk<&VGABase::IODACWriteAddressWrite>, this);
+  m_bus->ConnectIOPortRead(0x03C9, this, &IOPortReadThunk<&VGABase::IODACDataRegisterRead>, this);
+  m_bus->ConnectIOPortWrite(0x03C9, this, &IOPortWriteThunk<&VGABase::IODACDataRegisterWrite>, this);
   m_bus->ConnectIOPortReadToPointer(0x46E8, this, &m_vga_adapter_enable.bits);
-  m_bus->ConnectIOPortWrite(0x46E8, this, [this](u16, u8 value) { IOVGAAdapterEnableWrite(value); });
+  m_bus->ConnectIOPortWrite(0x46E8, this, &IOPortWriteThunk<&VGABase::IOVGAAdapterEnableWrite>, this);
   m_bus->ConnectIOPortReadToPointer(0x03C3, this, &m_vga_adapter_enable.bits);
-  m_bus->ConnectIOPortWrite(0x03C3, this, [this](u16, u8 value) { IOVGAAdapterEnableWrite(value); });
+  m_bus->ConnectIOPortWrite(0x03C3, this, &IOPortWriteThunk<&VGABase::IOVGAAdapterEnableWrite>, this);
 }
 
 void VGABase::DisconnectIOPorts()
@@ -1,4 +1,4 @@
 #pragma once
 #include "pce/types.h"
 
-constexpr u32 SAVE_STATE_VERSION = 1;
+constexpr u32 SAVE_STATE_VERSION = 2;
@@ -220,7 +220,7 @@ String System::GetMiscDataFilename(const char* suffix) const
 std::unique_ptr<TimingEvent> System::CreateClockedEvent(const char* name, float frequency, CycleCount interval,
                                                         TimingEventCallback callback, bool activate)
 {
-  SimulationTime cycle_period = SimulationTime(double(1000000000.0) / double(frequency));
+  SimulationTicks cycle_period = FrequencyToCyclePeriodTicks(frequency);
   auto evt = std::make_unique<TimingEvent>(this, name, frequency, cycle_period, interval, std::move(callback));
   if (activate)
     evt->Activate();
@@ -231,7 +231,7 @@ std::unique_ptr<TimingEvent> System::CreateClockedEvent(const char* name, float
 std::unique_ptr<TimingEvent> System::CreateFrequencyEvent(const char* name, float frequency,
                                                           TimingEventCallback callback, bool activate)
 {
-  SimulationTime cycle_period = SimulationTime(double(1000000000.0) / double(frequency));
+  SimulationTicks cycle_period = FrequencyToCyclePeriodTicks(frequency);
   auto evt = std::make_unique<TimingEvent>(this, name, frequency, cycle_period, 1, std::move(callback));
   if (activate)
     evt->Activate();
@@ -242,7 +242,8 @@ std::unique_ptr<TimingEvent> System::CreateFrequencyEvent(const char* name, floa
 std::unique_ptr<TimingEvent> System::CreateMillisecondEvent(const char* name, CycleCount ms,
                                                             TimingEventCallback callback, bool activate)
 {
-  auto evt = std::make_unique<TimingEvent>(this, name, 1000.0f, 1000000000 / 1000, ms, std::move(callback));
+  SimulationTicks cycle_period = SimulationTimeToTicks(MillisecondsToSimulationTime(1));
+  auto evt = std::make_unique<TimingEvent>(this, name, 1000.0f, cycle_period, ms, std::move(callback));
   if (activate)
     evt->Activate();
 
@@ -252,7 +253,8 @@ std::unique_ptr<TimingEvent> System::CreateMillisecondEvent(const char* name, Cy
 std::unique_ptr<TimingEvent> System::CreateMicrosecondEvent(const char* name, CycleCount us,
                                                             TimingEventCallback callback, bool activate)
 {
-  auto evt = std::make_unique<TimingEvent>(this, name, 1000000.0f, 1000000000 / 1000000, us, std::move(callback));
+  SimulationTicks cycle_period = SimulationTimeToTicks(MicrosecondsToSimulationTime(1));
+  auto evt = std::make_unique<TimingEvent>(this, name, 1000000.0f, cycle_period, us, std::move(callback));
   if (activate)
     evt->Activate();
 
@@ -262,7 +264,8 @@ std::unique_ptr<TimingEvent> System::CreateMicrosecondEvent(const char* name, Cy
 std::unique_ptr<TimingEvent> System::CreateNanosecondEvent(const char* name, CycleCount ns,
                                                            TimingEventCallback callback, bool activate)
 {
-  auto evt = std::make_unique<TimingEvent>(this, name, 1000.0f, 1000000000 / 1000000000, ns, std::move(callback));
+  SimulationTicks cycle_period = SimulationTimeToTicks(1);
+  auto evt = std::make_unique<TimingEvent>(this, name, 1000000000.0f, cycle_period, ns, std::move(callback));
   if (activate)
     evt->Activate();
 
@@ -359,17 +362,18 @@ void System::RunEvents()
 
     // Apply downcount to all events.
     // This will result in a negative downcount for those events which are late.
+    const SimulationTicks ticks = SimulationTimeToTicks(time);
     for (TimingEvent* evt : m_events)
     {
-      evt->m_downcount = evt->m_downcount - time;
-      evt->m_time_since_last_run += time;
+      evt->m_downcount = evt->m_downcount - ticks;
+      evt->m_time_since_last_run += ticks;
     }
 
     // Now we can actually run the callbacks.
     while (!m_events.empty() && m_events.front()->GetDownCount() <= 0)
     {
       TimingEvent* evt = m_events.front();
-      SimulationTime time_late = -evt->m_downcount;
+      SimulationTicks time_late = -evt->m_downcount;
       std::pop_heap(m_events.begin(), m_events.end(), CompareEvents);
 
       // Don't include overrun cycles in the execution.
@@ -432,9 +436,9 @@ bool System::DoEventsState(StateWrapper& sw)
     {
       SmallString event_name;
       float frequency;
-      SimulationTime cycle_period;
+      SimulationTicks cycle_period;
       CycleCount interval;
-      SimulationTime downcount, time_since_last_run;
+      SimulationTicks downcount, time_since_last_run;
       sw.Do(&event_name);
       sw.Do(&frequency);
       sw.Do(&cycle_period);
@@ -2,7 +2,7 @@
 #include "YBaseLib/Assert.h"
 #include "system.h"
 
-TimingEvent::TimingEvent(System* system, const char* name, float frequency, SimulationTime cycle_period,
+TimingEvent::TimingEvent(System* system, const char* name, float frequency, SimulationTicks cycle_period,
                          CycleCount interval, TimingEventCallback callback)
   : m_system(system), m_name(name), m_frequency(frequency), m_cycle_period(cycle_period), m_interval(interval),
     m_downcount(m_cycle_period * interval), m_time_since_last_run(0), m_callback(std::move(callback)), m_active(false)
@@ -18,17 +18,17 @@ TimingEvent::~TimingEvent()
 
 SimulationTime TimingEvent::GetTimeSinceLastExecution() const
 {
-  return m_system->GetPendingEventTime() + m_time_since_last_run;
+  return m_system->GetPendingEventTime() + SimulationTicksToTime(m_time_since_last_run);
 }
 
 SimulationTime TimingEvent::GetTimeUntilNextExecution() const
 {
-  return std::max(m_downcount - m_system->GetPendingEventTime(), static_cast<SimulationTime>(0));
+  return std::max(GetDownCount() - m_system->GetPendingEventTime(), static_cast<SimulationTime>(0));
 }
 
 CycleCount TimingEvent::GetCyclesSinceLastExecution() const
 {
-  return GetTimeSinceLastExecution() / m_cycle_period;
+  return (SimulationTimeToTicks(m_system->GetPendingEventTime()) + m_time_since_last_run) / m_cycle_period;
 }
 
 void TimingEvent::Reschedule(CycleCount cycles)
@@ -37,7 +37,7 @@ void TimingEvent::Reschedule(CycleCount cycles)
   DebugAssert(m_active);
 
   // We should really be up to date already in terms of cycles, so only take the partial cycles.
-  CycleCount partial_cycles_nodiv = m_time_since_last_run % m_cycle_period;
+  SimulationTicks partial_cycles_nodiv = m_time_since_last_run % m_cycle_period;
 
   // Update the interval and new downcount, subtracting any partial cycles.
   m_interval = cycles;
@@ -45,7 +45,7 @@ void TimingEvent::Reschedule(CycleCount cycles)
 
   // Factor in partial time if this was rescheduled outside of an event handler. Say, an MMIO write.
   if (!m_system->m_running_events)
-    m_downcount += m_system->GetPendingEventTime();
+    m_downcount += SimulationTimeToTicks(m_system->GetPendingEventTime());
 
   // If this is a call from an IO handler for example, re-sort the event queue.
   m_system->SortEvents();
@@ -69,13 +69,14 @@ void TimingEvent::InvokeEarly(bool force /* = false */)
   // Remove the pending time, since we want this to be included in the cycles we pass through.
   // We could just force an event sync here, but this would mean that InvokeEarly could be
   // called recursively, which would be a bad thing.
-  const u64 pending_time = m_system->m_running_events ? 0 : m_system->GetPendingEventTime();
+  const SimulationTicks pending_time =
+    m_system->m_running_events ? 0 : SimulationTimeToTicks(m_system->GetPendingEventTime());
   m_downcount -= pending_time;
   m_time_since_last_run += pending_time;
 
   // Try to maintain partial cycles as best as possible.
   CycleCount cycles_to_execute = m_time_since_last_run / m_cycle_period;
-  CycleCount partial_time = m_time_since_last_run % m_cycle_period;
+  SimulationTicks partial_time = m_time_since_last_run % m_cycle_period;
   m_downcount = (m_interval * m_cycle_period) - partial_time;
   m_time_since_last_run = partial_time;
 
@@ -101,7 +102,7 @@ void TimingEvent::Activate()
 
   // Since we can be running behind, if we want to trigger this event on the correct
   // number of cycles, not immediately (and many times).
-  const u64 pending_time = m_system->GetPendingEventTime();
+  const SimulationTicks pending_time = SimulationTimeToTicks(m_system->GetPendingEventTime());
   m_downcount += pending_time;
   m_time_since_last_run -= pending_time;
 
@@ -124,12 +125,12 @@ void TimingEvent::Deactivate()
 
 void TimingEvent::SetFrequency(float new_frequency, u32 interval /* = 1 */)
 {
-  SimulationTime new_cycle_period = SimulationTime(double(1000000000.0) / double(new_frequency));
+  SimulationTicks new_cycle_period = FrequencyToCyclePeriodTicks(new_frequency);
 
   // Adjust downcount if active.
   if (m_active)
   {
-    SimulationTime diff = new_cycle_period - m_cycle_period;
+    SimulationTicks diff = new_cycle_period - m_cycle_period;
     m_downcount += diff;
   }
 
@@ -157,7 +158,7 @@ void TimingEvent::SetDowncount(SimulationTime downcount)
   if (!m_active)
     Activate();
 
-  m_downcount = downcount + m_system->GetPendingEventTime();
+  m_downcount = SimulationTimeToTicks(downcount + m_system->GetPendingEventTime());
   m_system->SortEvents();
 }
 
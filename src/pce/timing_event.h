@@ -19,7 +19,7 @@ class TimingEvent
   friend class Clock;
 
 public:
-  TimingEvent(System* system, const char* name, float frequency, SimulationTime cycle_period, CycleCount interval,
+  TimingEvent(System* system, const char* name, float frequency, SimulationTicks cycle_period, CycleCount interval,
               TimingEventCallback callback);
   ~TimingEvent();
 
@@ -29,12 +29,13 @@ public:
 
   // Returns the frequency of a single cycle for this event.
   float GetFrequency() const { return m_frequency; }
-  SimulationTime GetCyclePeriod() const { return m_cycle_period; }
+  SimulationTicks GetCyclePeriod() const { return m_cycle_period; }
 
   // Returns the number of cycles between each event.
   CycleCount GetInterval() const { return m_interval; }
 
-  SimulationTime GetDownCount() const { return m_downcount; }
+  // Rounded up to whole nanoseconds, so the event is not run before it is due.
+  SimulationTime GetDownCount() const { return SimulationTicksToTimeCeil(m_downcount); }
 
   // Includes pending time.
   SimulationTime GetTimeSinceLastExecution() const;
@@ -76,11 +77,12 @@ private:
   String m_name;
 
   float m_frequency;
-  SimulationTime m_cycle_period;
+  SimulationTicks m_cycle_period;
   CycleCount m_interval;
 
-  SimulationTime m_downcount;
-  SimulationTime m_time_since_last_run;
+  // Tracked in fixed-point ticks, so that partial cycles are not lost between invocations.
+  SimulationTicks m_downcount;
+  SimulationTicks m_time_since_last_run;
 
   TimingEventCallback m_callback;
   bool m_active;
@@ -5,6 +5,35 @@
 using PhysicalMemoryAddress = u32;
 using LinearMemoryAddress = u32;
 
+// Fixed-point simulation time, used for converting between clock cycles and time. Each nanosecond is split into
+// 2^SIMULATION_TICK_FRACTION_BITS ticks, so cycle periods which are not a whole number of nanoseconds (e.g. the
+// 1.193182MHz PIT clock) can be represented without accumulating rounding error over long periods of uptime.
+using SimulationTicks = int64_t;
+constexpr u32 SIMULATION_TICK_FRACTION_BITS = 16;
+constexpr SimulationTicks SIMULATION_TICK_FRACTION_MASK = (SimulationTicks(1) << SIMULATION_TICK_FRACTION_BITS) - 1;
+constexpr SimulationTicks SimulationTimeToTicks(SimulationTime time)
+{
+  return time * (SimulationTicks(1) << SIMULATION_TICK_FRACTION_BITS);
+}
+
+// Rounds down to whole nanoseconds.
+constexpr SimulationTime SimulationTicksToTime(SimulationTicks ticks)
+{
+  return ticks >> SIMULATION_TICK_FRACTION_BITS;
+}
+
+// Rounds up to whole nanoseconds.
+constexpr SimulationTime SimulationTicksToTimeCeil(SimulationTicks ticks)
+{
+  return (ticks + SIMULATION_TICK_FRACTION_MASK) >> SIMULATION_TICK_FRACTION_BITS;
+}
+
+// Returns the period of a single cycle at the specified frequency, rounded to the nearest tick.
+inline SimulationTicks FrequencyToCyclePeriodTicks(double frequency)
+{
+  return static_cast<SimulationTicks>(double(SimulationTimeToTicks(1000000000)) / frequency + 0.5);
+}
+
 // IO port read/write sizes
 enum IOPortDataSize : u32
 {